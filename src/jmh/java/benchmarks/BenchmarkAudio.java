@@ -0,0 +1,98 @@
+package benchmarks;
+
+import java.io.IOException;
+import java.io.OutputStream;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.util.SplittableRandom;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+import lombok.NonNull;
+
+/**
+ * Audio files for the benchmarks, named by a {@code @Param} value: either a file in the test
+ * resources ({@code freerecall.wav}, {@code sweep.wav}), or {@code generated-<minutes>m} for a
+ * synthetic recording of that length, written once per machine and reused by later runs.
+ *
+ * <p>The generated files are 16 kHz mono 16-bit PCM, like the lab's recordings: bursts of
+ * voice-band harmonics separated by pauses, over a low noise floor.
+ */
+public final class BenchmarkAudio {
+
+    private static final Pattern GENERATED = Pattern.compile("generated-(\\d+)m");
+
+    public static final int GENERATED_SAMPLE_RATE = 16000;
+
+    private BenchmarkAudio() {}
+
+    /** Resolve a benchmark file name to a path, generating it first if need be. */
+    public static Path resolve(@NonNull String name) throws IOException {
+        Matcher generated = GENERATED.matcher(name);
+        if (generated.matches()) {
+            Path dir = Path.of(System.getProperty("bench.generated.dir", "build/jmh/audio"));
+            Path file = dir.resolve(name + ".wav");
+            if (!Files.exists(file)) {
+                Files.createDirectories(dir);
+                Path partial = Files.createTempFile(dir, name, ".part");
+                writeSpeechLike(partial, Integer.parseInt(generated.group(1)) * 60L);
+                Files.move(partial, file, StandardCopyOption.REPLACE_EXISTING);
+            }
+            return file;
+        }
+        Path dir = Path.of(System.getProperty("bench.audio.dir", "src/test/resources/audio"));
+        Path file = dir.resolve(name);
+        if (!Files.exists(file)) {
+            throw new IOException("Benchmark audio not found: " + file.toAbsolutePath());
+        }
+        return file;
+    }
+
+    private static void writeSpeechLike(@NonNull Path file, long seconds) throws IOException {
+        long frames = seconds * GENERATED_SAMPLE_RATE;
+        long dataBytes = frames * 2;
+        if (dataBytes > 0xFFFF_FFFFL - 36) {
+            throw new IOException("Too long for a WAV file: " + seconds + " s");
+        }
+        try (OutputStream out = Files.newOutputStream(file)) {
+            ByteBuffer header = ByteBuffer.allocate(44).order(ByteOrder.LITTLE_ENDIAN);
+            header.put("RIFF".getBytes()).putInt((int) (36 + dataBytes)).put("WAVE".getBytes());
+            header.put("fmt ".getBytes()).putInt(16).putShort((short) 1).putShort((short) 1);
+            header.putInt(GENERATED_SAMPLE_RATE).putInt(GENERATED_SAMPLE_RATE * 2);
+            header.putShort((short) 2).putShort((short) 16);
+            header.put("data".getBytes()).putInt((int) dataBytes);
+            out.write(header.array());
+
+            SplittableRandom random = new SplittableRandom(1234);
+            ByteBuffer block = ByteBuffer.allocate(GENERATED_SAMPLE_RATE * 2);
+            block.order(ByteOrder.LITTLE_ENDIAN);
+            double phase = 0;
+            double pitch = 140;
+            boolean voiced = false;
+            long nextSwitch = 0;
+            for (long i = 0; i < frames; i++) {
+                if (i == nextSwitch) {
+                    voiced = !voiced;
+                    pitch = 100 + 150 * random.nextDouble();
+                    double length = voiced ? 0.2 + random.nextDouble() : 0.1 + random.nextDouble();
+                    nextSwitch = i + (long) (length * GENERATED_SAMPLE_RATE);
+                }
+                phase += 2 * Math.PI * pitch / GENERATED_SAMPLE_RATE;
+                double sample = 0.002 * (random.nextDouble() - 0.5);
+                if (voiced) {
+                    for (int harmonic = 1; harmonic <= 8; harmonic++) {
+                        sample += 0.3 / harmonic * Math.sin(harmonic * phase);
+                    }
+                }
+                block.putShort((short) Math.round(Math.clamp(sample, -1, 1) * Short.MAX_VALUE));
+                if (!block.hasRemaining()) {
+                    out.write(block.array(), 0, block.position());
+                    block.clear();
+                }
+            }
+            out.write(block.array(), 0, block.position());
+        }
+    }
+}
@@ -0,0 +1,49 @@
+package core.audio.fmod;
+
+import java.util.SplittableRandom;
+import java.util.concurrent.TimeUnit;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+/**
+ * PCM to sample conversion ({@link FmodPcmConverter#toDouble}, formerly {@code convertToDouble})
+ * of one 10 s chunk of 44.1 kHz stereo, at each bit depth the decoder produces.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.SECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+public class FmodPcmConverterBenchmark {
+
+    private static final int SAMPLES = 44100 * 2 * 10;
+
+    @Param({"16", "24", "32"})
+    public int bitsPerSample;
+
+    private byte[] pcm;
+    private double[] samples;
+
+    @Setup
+    public void fill() {
+        pcm = new byte[SAMPLES * bitsPerSample / 8];
+        new SplittableRandom(7).nextBytes(pcm);
+        samples = new double[SAMPLES];
+    }
+
+    @Benchmark
+    public double[] toDouble() {
+        FmodPcmConverter.toDouble(pcm, samples, bitsPerSample, SAMPLES);
+        return samples;
+    }
+}
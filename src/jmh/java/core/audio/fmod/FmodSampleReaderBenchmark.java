@@ -0,0 +1,109 @@
+package core.audio.fmod;
+
+import benchmarks.BenchmarkAudio;
+import core.audio.AudioData;
+import core.audio.AudioMetadata;
+import core.env.Platform;
+import core.waveform.signal.WaveformProcessor;
+import java.nio.file.Path;
+import java.util.SplittableRandom;
+import java.util.concurrent.TimeUnit;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+
+/**
+ * {@link FmodSampleReader#readSamples} reading the waveform's standard chunk. A cold read is the
+ * first from a fresh reader, so it includes FMOD decoding the whole file into the sample cache;
+ * warm reads come from that cache at random offsets.
+ */
+@State(Scope.Benchmark)
+@Fork(1)
+public class FmodSampleReaderBenchmark {
+
+    @Param({"freerecall.wav", "sweep.wav", "generated-30m"})
+    public String file;
+
+    Path path;
+    FmodLibraryLoader libraryLoader;
+    long chunkFrames;
+    long lastStart;
+
+    @Setup(Level.Trial)
+    public void resolveFile() throws Exception {
+        path = BenchmarkAudio.resolve(file);
+        libraryLoader =
+                new FmodLibraryLoader(new FmodProperties("unpackaged", "standard"), new Platform());
+        try (var probe = new FmodSampleReader(libraryLoader)) {
+            AudioMetadata metadata = probe.getMetadata(path).join();
+            chunkFrames =
+                    Math.round(
+                            metadata.sampleRate()
+                                    * WaveformProcessor.STANDARD_CHUNK_DURATION_SECONDS);
+            lastStart = Math.max(0, metadata.frameCount() - chunkFrames);
+        }
+    }
+
+    /** A reader with nothing decoded, replaced before every (single-shot) iteration. */
+    @State(Scope.Thread)
+    public static class ColdReader {
+        FmodSampleReader reader;
+
+        @Setup(Level.Iteration)
+        public void open(FmodSampleReaderBenchmark files) {
+            reader = new FmodSampleReader(files.libraryLoader);
+        }
+
+        @TearDown(Level.Iteration)
+        public void close() throws Exception {
+            reader.close();
+        }
+    }
+
+    /** A reader that has already decoded the file. */
+    @State(Scope.Thread)
+    public static class WarmReader {
+        FmodSampleReader reader;
+        final SplittableRandom random = new SplittableRandom(42);
+
+        @Setup(Level.Trial)
+        public void open(FmodSampleReaderBenchmark files) {
+            reader = new FmodSampleReader(files.libraryLoader);
+            reader.readSamples(files.path, 0, files.chunkFrames).join();
+        }
+
+        @TearDown(Level.Trial)
+        public void close() throws Exception {
+            reader.close();
+        }
+    }
+
+    @Benchmark
+    @BenchmarkMode(Mode.SingleShotTime)
+    @OutputTimeUnit(TimeUnit.MILLISECONDS)
+    @Warmup(iterations = 2)
+    @Measurement(iterations = 10)
+    public AudioData readCold(ColdReader cold) {
+        return cold.reader.readSamples(path, 0, chunkFrames).join();
+    }
+
+    @Benchmark
+    @BenchmarkMode(Mode.AverageTime)
+    @OutputTimeUnit(TimeUnit.MICROSECONDS)
+    @Warmup(iterations = 3, time = 1)
+    @Measurement(iterations = 5, time = 1)
+    public AudioData readWarm(WarmReader warm) {
+        long start = lastStart > 0 ? warm.random.nextLong(lastStart) : 0;
+        return warm.reader.readSamples(path, start, chunkFrames).join();
+    }
+}
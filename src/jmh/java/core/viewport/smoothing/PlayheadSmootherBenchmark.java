@@ -0,0 +1,76 @@
+package core.viewport.smoothing;
+
+import core.audio.session.AudioSessionStateMachine;
+import java.util.SplittableRandom;
+import java.util.concurrent.TimeUnit;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+/**
+ * Per-frame cost of each {@link PlayheadSmoother} during playback: 60 Hz frames of 44.1 kHz audio
+ * whose reported position advances in jittery steps, as FMOD's mixer-block updates do.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+public class PlayheadSmootherBenchmark {
+
+    private static final long FRAME_NANOS = TimeUnit.SECONDS.toNanos(1) / 60;
+    private static final int SAMPLE_RATE = 44100;
+    private static final int MIXER_BLOCK = 1024;
+    private static final int STEPS = 4096;
+
+    @Param({"none", "linear", "predictive", "pll", "metrics-pll"})
+    public String smoother;
+
+    private PlayheadSmoother playhead;
+    private final long[] targets = new long[STEPS];
+    private int step;
+    private long frameTime;
+
+    @Setup
+    public void prepare() {
+        playhead =
+                switch (smoother) {
+                    case "none" -> new NoSmoother();
+                    case "linear" -> new LinearInterpolationSmoother();
+                    case "predictive" -> new PredictiveExtrapolationSmoother();
+                    case "pll" -> new PhaseLockedLoopSmoother();
+                    case "metrics-pll" ->
+                            new MetricsAwarePlayheadSmoother(new PhaseLockedLoopSmoother(), 600);
+                    default -> throw new IllegalArgumentException("Unknown smoother: " + smoother);
+                };
+
+        // Reported positions lag true time by up to a mixer block, quantised to whole blocks
+        SplittableRandom random = new SplittableRandom(11);
+        for (int i = 0; i < STEPS; i++) {
+            long truth = i * (long) SAMPLE_RATE / 60;
+            long lagged = truth - random.nextInt(MIXER_BLOCK);
+            targets[i] = Math.max(0, lagged / MIXER_BLOCK * MIXER_BLOCK);
+        }
+    }
+
+    @Benchmark
+    public PlayheadSmoother.SmoothingResult update() {
+        if (step == STEPS) {
+            // Wrap as a seek back to the start would
+            step = 0;
+            playhead.reset();
+        }
+        frameTime += FRAME_NANOS;
+        return playhead.updateAndGetSmoothedPosition(
+                targets[step++], frameTime, AudioSessionStateMachine.State.PLAYING);
+    }
+}
@@ -0,0 +1,134 @@
+package core.waveform;
+
+import benchmarks.BenchmarkAudio;
+import core.audio.AudioMetadata;
+import core.audio.fmod.FmodLibraryLoader;
+import core.audio.fmod.FmodProperties;
+import core.audio.fmod.FmodSampleReader;
+import core.dispatch.EventDispatchBus;
+import core.env.Platform;
+import java.awt.Image;
+import java.awt.image.BufferedImage;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Optional;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.TimeUnit;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+
+/**
+ * {@link WaveformRenderer} once its peak pyramid is built: drawing one segment from the pyramid,
+ * and compositing a viewport's worth of finished segments into one image (what {@link
+ * WaveformTileSet#toImage} does for {@link WaveformRenderer#renderViewport}).
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+public class WaveformRendererBenchmark {
+
+    private static final int WIDTH = 1000;
+
+    @Param({"freerecall.wav", "generated-30m"})
+    public String file;
+
+    @Param({"100", "400"})
+    public int pixelsPerSecond;
+
+    @Param({"200", "600"})
+    public int heightPx;
+
+    private FmodSampleReader reader;
+    private ExecutorService renderPool;
+    private WaveformRenderer renderer;
+    private Path sidecars;
+    private long segmentCount;
+    private long nextSegment;
+    private WaveformViewportSpec viewport;
+    private List<Image> viewportSegments;
+
+    @Setup(Level.Trial)
+    public void open() throws Exception {
+        Path audio = BenchmarkAudio.resolve(file);
+        reader =
+                new FmodSampleReader(
+                        new FmodLibraryLoader(
+                                new FmodProperties("unpackaged", "standard"), new Platform()));
+        AudioMetadata metadata = reader.getMetadata(audio).join();
+        renderPool = Executors.newSingleThreadExecutor();
+        EventDispatchBus quietBus =
+                new EventDispatchBus(null) {
+                    @Override
+                    public void subscribe(Object subscriber) {}
+
+                    @Override
+                    public void unsubscribe(Object subscriber) {}
+
+                    @Override
+                    public void publish(Object event) {}
+                };
+        var cache = new WaveformSegmentCache(new CacheStats(quietBus));
+        double duration = metadata.durationSeconds();
+        double end = (double) WIDTH / pixelsPerSecond;
+        viewport = new WaveformViewportSpec(0, end, WIDTH, heightPx, pixelsPerSecond, duration);
+        cache.initialize(viewport);
+        sidecars = Files.createTempDirectory("jmh-sidecars");
+        renderer =
+                new WaveformRenderer(
+                        audio.toString(),
+                        cache,
+                        renderPool,
+                        reader,
+                        metadata.sampleRate(),
+                        metadata,
+                        new PeakPyramidStore(sidecars, false),
+                        Optional.empty());
+
+        // Waits for the pyramid, then keeps one viewport of segments to composite
+        renderer.peakPyramid().join();
+        viewportSegments = new ArrayList<>();
+        for (var key : WaveformRenderer.calculateVisibleSegments(viewport)) {
+            viewportSegments.add(renderer.renderSegment(key).join());
+        }
+        double segmentSeconds = (double) WaveformSegmentCache.SEGMENT_WIDTH_PX / pixelsPerSecond;
+        segmentCount = Math.max(1, (long) (duration / segmentSeconds));
+    }
+
+    @TearDown(Level.Trial)
+    public void close() throws Exception {
+        renderPool.shutdownNow();
+        reader.close();
+        Files.deleteIfExists(sidecars);
+    }
+
+    @Benchmark
+    public Image renderSegment() {
+        // Walk through the file so successive segments read different parts of the pyramid
+        long index = nextSegment;
+        nextSegment = (nextSegment + 1) % segmentCount;
+        var key = new WaveformSegmentCache.SegmentKey(index, pixelsPerSecond, heightPx);
+        return renderer.renderSegment(key).join();
+    }
+
+    @Benchmark
+    public BufferedImage compositeSegments() {
+        return WaveformRenderer.tileSet(viewportSegments, viewport).toImage();
+    }
+}
@@ -0,0 +1,103 @@
+package core.waveform;
+
+import core.dispatch.EventDispatchBus;
+import java.awt.Image;
+import java.awt.image.BufferedImage;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ThreadLocalRandom;
+import java.util.concurrent.TimeUnit;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Group;
+import org.openjdk.jmh.annotations.GroupThreads;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Threads;
+import org.openjdk.jmh.annotations.Warmup;
+
+/**
+ * {@link WaveformSegmentCache} lookups and stores over one cache shared by several threads, as
+ * the paint thread, render pool and prefetcher share it. Keys stay within the cache's capacity,
+ * so lookups hit and stores replace rather than evict.
+ */
+@State(Scope.Group)
+@BenchmarkMode(Mode.Throughput)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+public class WaveformSegmentCacheBenchmark {
+
+    private static final int PIXELS_PER_SECOND = 100;
+    private static final int HEIGHT = 200;
+    private static final int KEYS = 30;
+
+    private WaveformSegmentCache cache;
+    private WaveformSegmentCache.SegmentKey[] keys;
+    private CompletableFuture<Image> segment;
+
+    @Setup
+    public void fill() {
+        EventDispatchBus quietBus =
+                new EventDispatchBus(null) {
+                    @Override
+                    public void subscribe(Object subscriber) {}
+
+                    @Override
+                    public void unsubscribe(Object subscriber) {}
+
+                    @Override
+                    public void publish(Object event) {}
+                };
+        cache = new WaveformSegmentCache(new CacheStats(quietBus));
+        cache.initialize(new WaveformViewportSpec(0, 10, 1000, HEIGHT, PIXELS_PER_SECOND, 3600));
+        segment =
+                CompletableFuture.completedFuture(
+                        new BufferedImage(
+                                WaveformSegmentCache.SEGMENT_WIDTH_PX,
+                                HEIGHT,
+                                BufferedImage.TYPE_INT_ARGB));
+        keys = new WaveformSegmentCache.SegmentKey[KEYS];
+        for (int i = 0; i < KEYS; i++) {
+            keys[i] = new WaveformSegmentCache.SegmentKey(i, PIXELS_PER_SECOND, HEIGHT);
+            cache.put(keys[i], segment);
+        }
+    }
+
+    private WaveformSegmentCache.SegmentKey anyKey() {
+        return keys[ThreadLocalRandom.current().nextInt(KEYS)];
+    }
+
+    @Benchmark
+    @Group("readers")
+    @GroupThreads(4)
+    public CompletableFuture<Image> getOnly() {
+        return cache.get(anyKey());
+    }
+
+    @Benchmark
+    @Group("mixed")
+    @GroupThreads(3)
+    public CompletableFuture<Image> get() {
+        return cache.get(anyKey());
+    }
+
+    @Benchmark
+    @Group("mixed")
+    @GroupThreads(1)
+    public void put() {
+        cache.put(anyKey(), segment);
+    }
+
+    /** Uncontended baseline for the figures above. */
+    @Benchmark
+    @Threads(1)
+    public CompletableFuture<Image> getSingleThread() {
+        return cache.get(anyKey());
+    }
+}
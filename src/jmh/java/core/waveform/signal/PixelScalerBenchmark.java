@@ -0,0 +1,63 @@
+package core.waveform.signal;
+
+import java.util.SplittableRandom;
+import java.util.concurrent.TimeUnit;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.Warmup;
+
+/** {@link PixelScaler} on a 10 s chunk of 44.1 kHz mono scaled to display widths. */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Warmup(iterations = 3, time = 1)
+@Measurement(iterations = 5, time = 1)
+@Fork(1)
+public class PixelScalerBenchmark {
+
+    private static final int SAMPLES = 441_000;
+
+    @Param({"1000", "4000"})
+    public int pixelWidth;
+
+    private final PixelScaler scaler = new PixelScaler();
+    private double[] samples;
+    private double[] pixels;
+    private double[] scratch;
+
+    @Setup
+    public void fill() {
+        SplittableRandom random = new SplittableRandom(3);
+        samples = new double[SAMPLES];
+        for (int i = 0; i < SAMPLES; i++) {
+            samples[i] = Math.abs(random.nextGaussian()) * 0.2;
+        }
+        pixels = scaler.toPixelResolution(samples, 0, pixelWidth, SAMPLES);
+        scratch = new double[pixelWidth];
+    }
+
+    @Benchmark
+    public double[] toPixelResolution() {
+        return scaler.toPixelResolution(samples, 0, pixelWidth, SAMPLES);
+    }
+
+    @Benchmark
+    public double[] smoothPixels() {
+        // Smoothing works in place, so start each call from the unsmoothed pixels
+        System.arraycopy(pixels, 0, scratch, 0, pixelWidth);
+        return scaler.smoothPixels(scratch);
+    }
+
+    @Benchmark
+    public double getRenderingPeak() {
+        return scaler.getRenderingPeak(pixels, 0);
+    }
+}
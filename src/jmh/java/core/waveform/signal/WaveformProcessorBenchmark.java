@@ -0,0 +1,88 @@
+package core.waveform.signal;
+
+import benchmarks.BenchmarkAudio;
+import core.audio.AudioMetadata;
+import core.audio.fmod.FmodLibraryLoader;
+import core.audio.fmod.FmodProperties;
+import core.audio.fmod.FmodSampleReader;
+import core.env.Platform;
+import java.nio.file.Path;
+import java.util.concurrent.TimeUnit;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Measurement;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+import org.openjdk.jmh.annotations.Warmup;
+
+/**
+ * {@link WaveformProcessor#processAudioForDisplay} over warm (already decoded) audio, so the
+ * figures are the band-pass filter and pixel scaling alone. Sequential chunks continue the
+ * filter's state as playback does; scattered chunks each pay the filter warm-up, as seeks do.
+ */
+@State(Scope.Thread)
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MILLISECONDS)
+@Warmup(iterations = 3, time = 2)
+@Measurement(iterations = 5, time = 2)
+@Fork(1)
+public class WaveformProcessorBenchmark {
+
+    private static final int PIXEL_WIDTH = 1000;
+
+    @Param({"freerecall.wav", "sweep.wav", "generated-30m"})
+    public String file;
+
+    private FmodSampleReader reader;
+    private WaveformProcessor processor;
+    private String path;
+    private int chunks;
+    private int next;
+
+    @Setup(Level.Trial)
+    public void open() throws Exception {
+        path = BenchmarkAudio.resolve(file).toString();
+        reader =
+                new FmodSampleReader(
+                        new FmodLibraryLoader(
+                                new FmodProperties("unpackaged", "standard"), new Platform()));
+        AudioMetadata metadata = reader.getMetadata(Path.of(path)).join();
+        processor = new WaveformProcessor(reader, metadata.sampleRate(), new PixelScaler());
+        chunks =
+                Math.max(
+                        1,
+                        (int)
+                                (metadata.durationSeconds()
+                                        / WaveformProcessor.STANDARD_CHUNK_DURATION_SECONDS));
+    }
+
+    @TearDown(Level.Trial)
+    public void close() throws Exception {
+        reader.close();
+    }
+
+    @Benchmark
+    public double[] sequentialChunks() {
+        int chunk = next;
+        next = (next + 1) % chunks;
+        return processor.processAudioForDisplay(path, chunk, PIXEL_WIDTH);
+    }
+
+    @Benchmark
+    public double[] scatteredChunks() {
+        // Stride by a prime so no call follows its predecessor (unless there is only one chunk)
+        int chunk = next;
+        next = (next + 7919) % chunks;
+        if (chunks > 1 && next == (chunk + 1) % chunks) {
+            next = (next + 1) % chunks;
+        }
+        return processor.processAudioForDisplay(path, chunk, PIXEL_WIDTH);
+    }
+}
@@ -0,0 +1,436 @@
+package app.headless;
+
+import core.audio.AudioMetadata;
+import core.audio.SampleReader;
+import core.audio.fmod.FmodStreamingSampleReader;
+import core.env.AppConfig;
+import core.env.Constants;
+import core.waveform.PeakPyramidStore;
+import core.waveform.signal.PeakPyramid;
+import core.waveform.signal.PixelScaler;
+import core.waveform.signal.WaveformProcessor;
+import jakarta.inject.Inject;
+import jakarta.inject.Provider;
+import java.io.BufferedWriter;
+import java.io.IOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Comparator;
+import java.util.HashMap;
+import java.util.LinkedHashSet;
+import java.util.List;
+import java.util.Locale;
+import java.util.Map;
+import java.util.Optional;
+import java.util.Set;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ForkJoinPool;
+import java.util.concurrent.ForkJoinWorkerThread;
+import java.util.concurrent.Semaphore;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.function.Supplier;
+import java.util.stream.Stream;
+import lombok.NonNull;
+import lombok.extern.slf4j.Slf4j;
+
+/**
+ * Precomputes waveform sidecars for a batch of recordings, so annotators can open them later
+ * without waiting for a decode.
+ *
+ * <p>Files run on a work-stealing pool, largest first, so a few long recordings do not end up
+ * queued behind each other at the end of the run. Each worker thread owns one streaming sample
+ * reader, and with it one FMOD system, for as long as it lives; FMOD systems are never shared
+ * between workers, so there are at most {@link FmodStreamingSampleReader#MAX_OPEN_READERS}
+ * workers, whatever is configured. Each file is decoded once, straight into {@link
+ * WaveformProcessor#buildPeakPyramid}, and the pyramid is written through {@link
+ * PeakPyramidStore} with the file's metadata and global peak, so the application reads all three
+ * back from the sidecar. Files that already have a current sidecar are not opened again.
+ *
+ * <p>Memory is capped by {@link #MAX_MEMORY_KEY}: a file starts only once its estimated
+ * footprint (its pyramid, the reader's decoded windows and the chunk buffers) fits in what the
+ * running files leave free. A file larger than the whole cap runs on its own.
+ */
+@Slf4j
+public class BatchPrecompute {
+
+    static final String WORKERS_KEY = "batch.workers";
+    static final String MAX_MEMORY_KEY = "batch.max_memory_mb";
+
+    private static final int DEFAULT_MAX_MEMORY_MB = 1024;
+    private static final long BYTES_PER_MB = 1024 * 1024;
+
+    // Builder arrays plus the packed levels of the finished pyramid, per base bin
+    private static final long PYRAMID_BYTES_PER_BIN = 32;
+
+    // Streaming reader window cache (see FmodStreamingSampleReader), in frames
+    private static final long READER_CACHE_FRAMES = 32L * 65536;
+
+    /** Outcome of one file. */
+    public enum Status {
+        /** Decoded and its sidecar written. */
+        DECODED,
+        /** Already had a current sidecar; only the sidecar was read. */
+        CACHED,
+        /** Could not be read. */
+        FAILED
+    }
+
+    /**
+     * What was learned about one file.
+     *
+     * @param metadata The file's format, or null if it could not be read
+     * @param peak Largest band-passed sample magnitude, the waveform's global peak
+     * @param error Why the file failed, or null
+     */
+    public record FileResult(
+            @NonNull Path path,
+            @NonNull Status status,
+            AudioMetadata metadata,
+            double peak,
+            long fileBytes,
+            long elapsedNanos,
+            String error) {}
+
+    /** Results of a batch, in input order, with throughput over the whole run. */
+    public record Report(@NonNull List<FileResult> files, int workers, long wallNanos) {
+
+        public long count(@NonNull Status status) {
+            return files.stream().filter(f -> f.status() == status).count();
+        }
+
+        /** Seconds of audio decoded. */
+        public double decodedSeconds() {
+            return decoded().mapToDouble(f -> f.metadata().durationSeconds()).sum();
+        }
+
+        /** Bytes of audio files decoded. */
+        public long decodedBytes() {
+            return decoded().mapToLong(FileResult::fileBytes).sum();
+        }
+
+        /** Seconds of audio decoded per second of wall time. */
+        public double realtimeFactor() {
+            return wallNanos > 0 ? decodedSeconds() / (wallNanos / 1e9) : 0;
+        }
+
+        /** Megabytes of audio files decoded per second of wall time. */
+        public double megabytesPerSecond() {
+            return wallNanos > 0 ? decodedBytes() / (double) BYTES_PER_MB / (wallNanos / 1e9) : 0;
+        }
+
+        public String summary() {
+            return String.format(
+                    Locale.ROOT,
+                    "%d files (%d decoded, %d cached, %d failed) in %.1f s on %d workers:"
+                            + " %.1f h of audio, %.0fx realtime, %.1f MB/s",
+                    files.size(),
+                    count(Status.DECODED),
+                    count(Status.CACHED),
+                    count(Status.FAILED),
+                    wallNanos / 1e9,
+                    workers,
+                    decodedSeconds() / 3600,
+                    realtimeFactor(),
+                    megabytesPerSecond());
+        }
+
+        /**
+         * Writes one tab-separated line per file: path, status, sample rate, channels, bits per
+         * sample, frames, duration, peak, milliseconds taken and any error.
+         */
+        public void write(@NonNull Path target) throws IOException {
+            try (BufferedWriter out = Files.newBufferedWriter(target, StandardCharsets.UTF_8)) {
+                out.write(
+                        "path\tstatus\tsample_rate\tchannels\tbits\tframes\tduration_s\tpeak"
+                                + "\telapsed_ms\terror\n");
+                for (FileResult f : files) {
+                    AudioMetadata m = f.metadata();
+                    out.write(
+                            String.format(
+                                    Locale.ROOT,
+                                    "%s\t%s\t%s\t%s\t%s\t%s\t%s\t%s\t%d\t%s%n",
+                                    f.path(),
+                                    f.status(),
+                                    m != null ? m.sampleRate() : "",
+                                    m != null ? m.channelCount() : "",
+                                    m != null ? m.bitsPerSample() : "",
+                                    m != null ? m.frameCount() : "",
+                                    m != null ? m.durationSeconds() : "",
+                                    f.status() != Status.FAILED ? f.peak() : "",
+                                    TimeUnit.NANOSECONDS.toMillis(f.elapsedNanos()),
+                                    f.error() != null ? f.error().replaceAll("\\s+", " ") : ""));
+                }
+            }
+        }
+
+        private Stream<FileResult> decoded() {
+            return files.stream().filter(f -> f.status() == Status.DECODED);
+        }
+    }
+
+    private final PeakPyramidStore store;
+    private final Supplier<SampleReader> readers;
+    private final int defaultWorkers;
+    private final long maxMemoryBytes;
+
+    @Inject
+    public BatchPrecompute(
+            @NonNull AppConfig config,
+            @NonNull PeakPyramidStore store,
+            @NonNull Provider<FmodStreamingSampleReader> readers) {
+        this(
+                store,
+                readers::get,
+                config.getIntProperty(WORKERS_KEY, 0),
+                config.getIntProperty(MAX_MEMORY_KEY, DEFAULT_MAX_MEMORY_MB) * BYTES_PER_MB);
+    }
+
+    /**
+     * @param readers Creates one reader per worker thread
+     * @param workers Worker threads, or 0 for one per processor
+     */
+    BatchPrecompute(
+            @NonNull PeakPyramidStore store,
+            @NonNull Supplier<SampleReader> readers,
+            int workers,
+            long maxMemoryBytes) {
+        this.store = store;
+        this.readers = readers;
+        this.defaultWorkers = workers;
+        this.maxMemoryBytes = Math.max(BYTES_PER_MB, maxMemoryBytes);
+    }
+
+    /** Runs the batch with the configured number of workers. */
+    public Report run(@NonNull List<Path> inputs) throws IOException {
+        return run(inputs, defaultWorkers);
+    }
+
+    /**
+     * Precomputes every supported audio file among the inputs, searching directories
+     * recursively, and waits for them all.
+     *
+     * @param workers Worker threads, or 0 for one per processor; at most {@link
+     *     FmodStreamingSampleReader#MAX_OPEN_READERS} either way
+     * @throws IOException If an input cannot be listed
+     */
+    public Report run(@NonNull List<Path> inputs, int workers) throws IOException {
+        List<Path> files = expand(inputs);
+        int requested = workers > 0 ? workers : Runtime.getRuntime().availableProcessors();
+        if (workers > FmodStreamingSampleReader.MAX_OPEN_READERS) {
+            log.warn(
+                    "Limiting {} workers to {}, the FMOD systems left beside the engine's",
+                    workers,
+                    FmodStreamingSampleReader.MAX_OPEN_READERS);
+        }
+        int limit = Math.min(FmodStreamingSampleReader.MAX_OPEN_READERS, Math.max(1, files.size()));
+        int parallelism = Math.clamp(requested, 1, limit);
+        log.info(
+                "Precomputing {} files on {} workers within {} MB",
+                files.size(),
+                parallelism,
+                maxMemoryBytes / BYTES_PER_MB);
+
+        // Permits are megabytes of the memory cap
+        int capMb = (int) Math.min(Integer.MAX_VALUE, maxMemoryBytes / BYTES_PER_MB);
+        Semaphore memory = new Semaphore(capMb, true);
+        AtomicInteger done = new AtomicInteger();
+
+        long started = System.nanoTime();
+        // Waiting on a read must not add spare workers, each of which would open an FMOD system
+        ForkJoinPool pool =
+                new ForkJoinPool(
+                        parallelism,
+                        Worker::new,
+                        null,
+                        false,
+                        parallelism,
+                        parallelism,
+                        1,
+                        _ -> true,
+                        60,
+                        TimeUnit.SECONDS);
+        try {
+            // Largest first so the longest files are not the last to start
+            Map<Path, Long> sizes = new HashMap<>();
+            files.forEach(file -> sizes.put(file, sizeOf(file)));
+            List<Path> bySize = new ArrayList<>(files);
+            bySize.sort(Comparator.comparing(sizes::get, Comparator.reverseOrder()));
+            Map<Path, CompletableFuture<FileResult>> futures = new HashMap<>();
+            for (Path file : bySize) {
+                futures.put(
+                        file,
+                        CompletableFuture.supplyAsync(
+                                () -> {
+                                    FileResult r =
+                                            process(file, sizes.get(file), memory, capMb);
+                                    log.info(
+                                            "[{}/{}] {} {}",
+                                            done.incrementAndGet(),
+                                            files.size(),
+                                            r.status(),
+                                            file);
+                                    return r;
+                                },
+                                pool));
+            }
+            List<FileResult> results = new ArrayList<>();
+            for (Path file : files) {
+                results.add(futures.get(file).join());
+            }
+            Report report = new Report(results, parallelism, System.nanoTime() - started);
+            log.info("Precompute finished: {}", report.summary());
+            return report;
+        } finally {
+            // Workers close their readers as they terminate
+            pool.shutdown();
+            try {
+                pool.awaitTermination(30, TimeUnit.SECONDS);
+            } catch (InterruptedException e) {
+                Thread.currentThread().interrupt();
+            }
+        }
+    }
+
+    /** Runs on a worker: decode the file once under the memory cap and store its pyramid. */
+    private FileResult process(
+            @NonNull Path file, long fileBytes, @NonNull Semaphore memory, int capMb) {
+        long started = System.nanoTime();
+        SampleReader reader = null;
+        AudioMetadata metadata = null;
+        int permits = 0;
+        try {
+            Optional<PeakPyramidStore.Sidecar> stored =
+                    store.loadSidecar(file, WaveformProcessor.PYRAMID_PARAMETERS);
+            if (stored.isPresent()) {
+                return new FileResult(
+                        file,
+                        Status.CACHED,
+                        stored.get().metadata(),
+                        stored.get().pyramid().peak(),
+                        fileBytes,
+                        System.nanoTime() - started,
+                        null);
+            }
+
+            reader = ((Worker) Thread.currentThread()).reader();
+            metadata = reader.getMetadata(file).join();
+
+            int needed = (int) Math.min(capMb, Math.ceilDiv(footprint(metadata), BYTES_PER_MB));
+            memory.acquire(needed);
+            permits = needed;
+            var processor = new WaveformProcessor(reader, metadata.sampleRate(), new PixelScaler());
+            PeakPyramid pyramid = processor.buildPeakPyramid(file.toString(), metadata);
+            store.save(file, WaveformProcessor.PYRAMID_PARAMETERS, pyramid, metadata);
+            return new FileResult(
+                    file,
+                    Status.DECODED,
+                    metadata,
+                    pyramid.peak(),
+                    fileBytes,
+                    System.nanoTime() - started,
+                    null);
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            return failed(file, metadata, fileBytes, started, "interrupted");
+        } catch (IOException | RuntimeException e) {
+            Throwable cause = e.getCause() != null ? e.getCause() : e;
+            log.warn("Failed to precompute {}: {}", file, cause.getMessage());
+            return failed(file, metadata, fileBytes, started, String.valueOf(cause.getMessage()));
+        } finally {
+            // Free the reader's windows for this file before its share of the cap
+            if (reader != null) {
+                reader.release(file);
+            }
+            memory.release(permits);
+        }
+    }
+
+    private static FileResult failed(
+            Path file, AudioMetadata metadata, long fileBytes, long started, String error) {
+        return new FileResult(
+                file, Status.FAILED, metadata, 0, fileBytes, System.nanoTime() - started, error);
+    }
+
+    /** Estimated bytes held while the file is decoded. */
+    static long footprint(@NonNull AudioMetadata metadata) {
+        long channels = Math.max(1, metadata.channelCount());
+        long bins = Math.ceilDiv(Math.max(0, metadata.frameCount()), PeakPyramid.BASE_BIN_FRAMES);
+        // Each chunk is read into a new array and copied into the processor's buffer
+        long chunkFrames =
+                (long) (WaveformProcessor.STANDARD_CHUNK_DURATION_SECONDS * metadata.sampleRate());
+        long samples = channels * (READER_CACHE_FRAMES + 2 * chunkFrames);
+        return bins * PYRAMID_BYTES_PER_BIN + samples * Double.BYTES;
+    }
+
+    /** Supported audio files among the inputs, directories searched recursively, in order. */
+    private List<Path> expand(@NonNull List<Path> inputs) throws IOException {
+        Set<Path> files = new LinkedHashSet<>();
+        for (Path input : inputs) {
+            if (Files.isDirectory(input)) {
+                try (Stream<Path> walk = Files.walk(input)) {
+                    walk.filter(Files::isRegularFile)
+                            .filter(BatchPrecompute::isAudioFile)
+                            .sorted()
+                            .forEach(p -> files.add(p.toAbsolutePath().normalize()));
+                }
+            } else if (Files.isRegularFile(input)) {
+                files.add(input.toAbsolutePath().normalize());
+            } else {
+                throw new IOException("No such file or directory: " + input);
+            }
+        }
+        return List.copyOf(files);
+    }
+
+    /** Files the application lists as audio, by {@link Constants#audioFormatsLowerCase}. */
+    private static boolean isAudioFile(@NonNull Path file) {
+        String name = file.getFileName().toString().toLowerCase(Locale.ROOT);
+        return Constants.audioFormatsLowerCase.stream().anyMatch(ext -> name.endsWith("." + ext));
+    }
+
+    private static long sizeOf(@NonNull Path file) {
+        try {
+            return Files.size(file);
+        } catch (IOException e) {
+            return 0;
+        }
+    }
+
+    /** Pool thread owning one reader, and so one FMOD system, for its whole life. */
+    private final class Worker extends ForkJoinWorkerThread {
+        private SampleReader reader;
+
+        Worker(ForkJoinPool pool) {
+            super(null, pool, true);
+        }
+
+        @Override
+        protected void onStart() {
+            super.onStart();
+            setName("BatchPrecompute-" + getPoolIndex());
+        }
+
+        SampleReader reader() {
+            if (reader == null) {
+                reader = readers.get();
+            }
+            return reader;
+        }
+
+        @Override
+        protected void onTermination(Throwable exception) {
+            if (reader != null) {
+                try {
+                    reader.close();
+                } catch (IOException e) {
+                    log.warn("Failed to close batch reader: {}", e.getMessage());
+                }
+                reader = null;
+            }
+            super.onTermination(exception);
+        }
+    }
+}
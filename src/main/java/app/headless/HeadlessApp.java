@@ -3,6 +3,10 @@ package app.headless;
 import com.google.inject.Guice;
 import com.google.inject.Injector;
 import core.actions.ActionRegistry;
+import java.io.IOException;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.List;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
@@ -32,6 +36,49 @@ public class HeadlessApp {
         // Additional headless initialization would go here
     }
 
+    /**
+     * Runs {@link BatchPrecompute} from command-line arguments and returns the process exit code:
+     * 0 if every file was precomputed, 1 if any failed, 2 for bad arguments.
+     *
+     * <p>Arguments: {@code [--workers N] [--report FILE] PATH...}, where each path is an audio file
+     * or a directory searched recursively for audio files. The report, if requested, lists each
+     * file's metadata and global peak.
+     */
+    public static int precompute(String[] args) {
+        int workers = 0;
+        Path report = null;
+        List<Path> inputs = new ArrayList<>();
+        try {
+            for (int i = 0; i < args.length; i++) {
+                switch (args[i]) {
+                    case "--workers" -> workers = Integer.parseInt(args[++i]);
+                    case "--report" -> report = Path.of(args[++i]);
+                    default -> inputs.add(Path.of(args[i]));
+                }
+            }
+        } catch (ArrayIndexOutOfBoundsException | NumberFormatException e) {
+            inputs.clear();
+        }
+        if (inputs.isEmpty()) {
+            System.err.println("Usage: --precompute [--workers N] [--report FILE] PATH...");
+            return 2;
+        }
+
+        create();
+        try {
+            BatchPrecompute.Report result =
+                    getInjectedInstance(BatchPrecompute.class).run(inputs, workers);
+            if (report != null) {
+                result.write(report);
+            }
+            System.out.println(result.summary());
+            return result.count(BatchPrecompute.Status.FAILED) == 0 ? 0 : 1;
+        } catch (IOException e) {
+            logger.error("Precompute failed: {}", e.getMessage());
+            return 1;
+        }
+    }
+
     /**
      * Gets an instance from the global injector.
      *
@@ -46,6 +46,11 @@ public class HeadlessEventDispatcher implements EventDispatcher {
         }
     }
 
+    @Override
+    public void dispatchLater(Runnable task) {
+        executor.submit(task);
+    }
+
     /** Shutdown the executor service. */
     public void shutdown() {
         executor.shutdown();
@@ -1,6 +1,7 @@
 package app.swing;
 
 import app.AudioIntegrationMode;
+import app.headless.HeadlessApp;
 import java.util.Arrays;
 import javax.swing.SwingUtilities;
 
@@ -12,6 +13,10 @@ public class Main {
      * dispatch thread, as per Java Swing policy.
      */
     public static void main(String[] args) {
+        if (args.length > 0 && args[0].equals("--precompute")) {
+            System.setProperty("java.awt.headless", "true");
+            System.exit(HeadlessApp.precompute(Arrays.copyOfRange(args, 1, args.length)));
+        }
         boolean integrationTestMode = Arrays.asList(args).contains("--integration-test");
         if (integrationTestMode) {
             AudioIntegrationMode.exitWithTestResult(AudioIntegrationMode.runTest());
@@ -0,0 +1,96 @@
+package core.actions.impl;
+
+import core.actions.Action;
+import core.dispatch.EventDispatchBus;
+import core.env.UserHomeProvider;
+import core.events.DialogEvent;
+import core.telemetry.PerformanceTelemetry;
+import jakarta.inject.Inject;
+import jakarta.inject.Singleton;
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.time.LocalDateTime;
+import java.time.format.DateTimeFormatter;
+import java.util.ArrayList;
+import java.util.List;
+import jdk.jfr.FlightRecorder;
+import jdk.jfr.Recording;
+import jdk.jfr.RecordingState;
+import lombok.extern.slf4j.Slf4j;
+
+/**
+ * Writes the current performance figures to a text report in the user's home directory, along
+ * with the contents of any running Java Flight Recorder recording (started e.g. with {@code
+ * -XX:StartFlightRecording}), and shows the report.
+ */
+@Singleton
+@Slf4j
+public class DumpPerformanceAction extends Action {
+
+    private static final DateTimeFormatter STAMP = DateTimeFormatter.ofPattern("yyyyMMdd-HHmmss");
+
+    private final PerformanceTelemetry telemetry;
+    private final UserHomeProvider userHomeProvider;
+    private final EventDispatchBus eventBus;
+
+    @Inject
+    public DumpPerformanceAction(
+            PerformanceTelemetry telemetry,
+            UserHomeProvider userHomeProvider,
+            EventDispatchBus eventBus) {
+        this.telemetry = telemetry;
+        this.userHomeProvider = userHomeProvider;
+        this.eventBus = eventBus;
+    }
+
+    @Override
+    public void execute() {
+        String report = PerformanceTelemetry.report(telemetry.snapshot());
+        log.info("Performance report:\n{}", report);
+
+        String base = "totalrecall-perf-" + LocalDateTime.now().format(STAMP);
+        Path dir = Path.of(userHomeProvider.getUserHomeDir());
+        List<Path> written = new ArrayList<>();
+        try {
+            Path text = dir.resolve(base + ".txt");
+            Files.writeString(text, report);
+            written.add(text);
+            written.addAll(dumpRecordings(dir, base));
+        } catch (IOException | RuntimeException e) {
+            log.warn("Could not write performance report", e);
+            eventBus.publish(
+                    new DialogEvent(
+                            "Could not write performance report: " + e.getMessage(),
+                            DialogEvent.Type.ERROR));
+            return;
+        }
+
+        StringBuilder message = new StringBuilder(report).append("\nWritten to:");
+        for (Path path : written) {
+            message.append("\n  ").append(path);
+        }
+        eventBus.publish(new DialogEvent(message.toString(), DialogEvent.Type.INFO));
+    }
+
+    /** Dump each running flight recording next to the report; none is started here. */
+    private static List<Path> dumpRecordings(Path dir, String base) throws IOException {
+        List<Path> dumped = new ArrayList<>();
+        if (!FlightRecorder.isAvailable() || !FlightRecorder.isInitialized()) {
+            return dumped;
+        }
+        for (Recording recording : FlightRecorder.getFlightRecorder().getRecordings()) {
+            if (recording.getState() == RecordingState.RUNNING) {
+                Path file = dir.resolve(base + "-" + recording.getId() + ".jfr");
+                recording.dump(file);
+                dumped.add(file);
+            }
+        }
+        return dumped;
+    }
+
+    @Override
+    public boolean isEnabled() {
+        return true; // Always enabled
+    }
+}
@@ -3,7 +3,7 @@ package core.actions.impl;
 import core.actions.Action;
 import core.dispatch.EventDispatchBus;
 import core.env.PreferenceKeys;
-import core.events.AudioFilesSelectedEvent;
+import core.events.AudioFolderSelectedEvent;
 import core.preferences.PreferencesManager;
 import core.services.FileSelectionService;
 import core.services.FileSelectionService.FileSelectionRequest;
@@ -13,7 +13,7 @@ import java.io.File;
 
 /**
  * Presents a directory chooser to the user for selecting audio folders and then publishes an event
- * with the files from that folder.
+ * naming the folder.
  */
 @Singleton
 public class OpenAudioFolderAction extends Action {
@@ -58,10 +58,8 @@ public class OpenAudioFolderAction extends Action {
                                     folder.getParentFile().getPath());
 
                             if (folder.isDirectory()) {
-                                File[] files = folder.listFiles();
-                                if (files != null && files.length > 0) {
-                                    eventBus.publish(new AudioFilesSelectedEvent(files));
-                                }
+                                // Listed off the EDT by whoever handles the event
+                                eventBus.publish(new AudioFolderSelectedEvent(folder));
                             }
                         });
     }
@@ -0,0 +1,29 @@
+package core.actions.impl;
+
+import core.actions.Action;
+import core.telemetry.PerformanceTelemetry;
+import jakarta.inject.Inject;
+import jakarta.inject.Singleton;
+
+/** Shows or hides the performance figures drawn over the waveform. */
+@Singleton
+public class TogglePerformanceOverlayAction extends Action {
+
+    private final PerformanceTelemetry telemetry;
+
+    @Inject
+    public TogglePerformanceOverlayAction(PerformanceTelemetry telemetry) {
+        this.telemetry = telemetry;
+    }
+
+    @Override
+    public void execute() {
+        // The viewport picks the change up on its next frame
+        telemetry.setOverlayVisible(!telemetry.isOverlayVisible());
+    }
+
+    @Override
+    public boolean isEnabled() {
+        return true; // Always enabled
+    }
+}
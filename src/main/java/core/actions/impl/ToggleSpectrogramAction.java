@@ -0,0 +1,29 @@
+package core.actions.impl;
+
+import core.actions.Action;
+import core.viewport.ViewportSessionManager;
+import jakarta.inject.Inject;
+import jakarta.inject.Singleton;
+
+/** Switches the viewport between the waveform and the spectrogram of the open file. */
+@Singleton
+public class ToggleSpectrogramAction extends Action {
+
+    private final ViewportSessionManager viewport;
+
+    @Inject
+    public ToggleSpectrogramAction(ViewportSessionManager viewport) {
+        this.viewport = viewport;
+    }
+
+    @Override
+    public void execute() {
+        // The viewport picks the change up on its next frame
+        viewport.setSpectrogramVisible(!viewport.isSpectrogramVisible());
+    }
+
+    @Override
+    public boolean isEnabled() {
+        return true; // Always enabled
+    }
+}
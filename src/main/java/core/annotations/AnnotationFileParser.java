@@ -10,27 +10,77 @@ import java.io.IOException;
 import java.nio.file.Files;
 import java.nio.file.Path;
 import java.nio.file.StandardCopyOption;
+import java.nio.file.attribute.BasicFileAttributes;
+import java.nio.file.attribute.FileTime;
 import java.time.Instant;
 import java.time.format.DateTimeFormatter;
-import java.util.Collections;
-import java.util.Comparator;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.HashSet;
 import java.util.LinkedHashMap;
 import java.util.List;
-import java.util.Objects;
+import java.util.Map;
+import java.util.Set;
 import org.checkerframework.checker.nullness.qual.NonNull;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
 
 // Annotation is in same package now
 
+/**
+ * Reads and edits annotation files. The canonical file is JSON ({@link AnnotationFile}); edits to a
+ * file are held in memory and recorded in its {@link AnnotationJournal}, and only written into the
+ * JSON by {@link #compact}, which {@link #close} and marking a file done call, and which runs on
+ * its own once a journal passes {@link #COMPACT_THRESHOLD_BYTES}. Opening a file with a journal
+ * left by a crash replays the journal over it.
+ */
 @Singleton
 public class AnnotationFileParser {
+    private static final Logger logger = LoggerFactory.getLogger(AnnotationFileParser.class);
+
+    /** Journal size past which an edit rewrites the JSON and starts a fresh journal. */
+    static final long COMPACT_THRESHOLD_BYTES = 64 * 1024;
 
     private final ObjectMapper mapper;
+    private final ObjectMapper journalMapper;
     private final ProgramVersion programVersion;
 
+    // Files with edits in memory, by absolute path; guarded by this
+    private final Map<Path, Session> sessions = new HashMap<>();
+
+    /** An open file's contents, the edits journalled since it was last written, and its stamp. */
+    private static final class Session {
+        final Path file;
+        final AnnotationFile content;
+        final Set<Annotation> present;
+        AnnotationJournal journal;
+        FileTime modified;
+        long length;
+
+        Session(@NonNull Path file, @NonNull AnnotationFile content) {
+            this.file = file;
+            this.content = content;
+            this.present = new HashSet<>(content.getAnnotations());
+        }
+
+        /** Whether something other than this parser has rewritten the file since it was read. */
+        boolean staleOnDisk() throws IOException {
+            var attributes = Files.readAttributes(file, BasicFileAttributes.class);
+            return !attributes.lastModifiedTime().equals(modified) || attributes.size() != length;
+        }
+
+        void stamp() throws IOException {
+            var attributes = Files.readAttributes(file, BasicFileAttributes.class);
+            modified = attributes.lastModifiedTime();
+            length = attributes.size();
+        }
+    }
+
     @Inject
     public AnnotationFileParser(
             @NonNull ObjectMapper mapper, @NonNull ProgramVersion programVersion) {
         this.mapper = mapper.copy().enable(SerializationFeature.INDENT_OUTPUT);
+        this.journalMapper = mapper.copy().disable(SerializationFeature.INDENT_OUTPUT);
         this.programVersion = programVersion;
     }
 
@@ -38,71 +88,49 @@ public class AnnotationFileParser {
         this(new ObjectMapper(), programVersion);
     }
 
-    public List<Annotation> parse(@NonNull File file) throws IOException {
-        if (!file.exists()) {
-            throw new IOException("Annotation file does not exist: " + file.getAbsolutePath());
-        }
-        var annotationFile = mapper.readValue(file, AnnotationFile.class);
-        return annotationFile.getAnnotations();
+    public synchronized List<Annotation> parse(@NonNull File file) throws IOException {
+        requireExists(file);
+        return new ArrayList<>(session(file).content.getAnnotations());
     }
 
-    public boolean removeAnnotation(@NonNull Annotation annToDelete, @NonNull File file)
-            throws IOException {
-        if (!file.exists()) {
-            throw new IOException("Annotation file does not exist: " + file.getAbsolutePath());
-        }
-        var annotationFile = mapper.readValue(file, AnnotationFile.class);
-        var removed = annotationFile.getAnnotations().removeIf(ann -> ann.equals(annToDelete));
-
-        if (removed) {
-            writeAtomically(file.toPath(), annotationFile);
+    public synchronized boolean removeAnnotation(
+            @NonNull Annotation annToDelete, @NonNull File file) throws IOException {
+        requireExists(file);
+        var session = session(file);
+        if (!session.present.contains(annToDelete)) {
+            return false;
         }
-
-        return removed;
+        journal(session, AnnotationJournal.Entry.remove(annToDelete));
+        apply(session, AnnotationJournal.Entry.remove(annToDelete));
+        compactIfLarge(session);
+        return true;
     }
 
-    public void appendAnnotation(@NonNull Annotation ann, @NonNull File file) throws IOException {
-        if (!file.exists()) {
-            throw new IOException("Annotation file does not exist: " + file.getAbsolutePath());
-        }
-        var annotationFile = mapper.readValue(file, AnnotationFile.class);
-        var annotations = annotationFile.getAnnotations();
+    public synchronized void appendAnnotation(@NonNull Annotation ann, @NonNull File file)
+            throws IOException {
+        requireExists(file);
+        var session = session(file);
 
         // Check if this exact annotation already exists
-        if (annotations.contains(ann)) {
+        if (session.present.contains(ann)) {
             return; // Already exists, do nothing
         }
-
-        var insertIndex =
-                Collections.binarySearch(
-                        annotations, ann, Comparator.comparingDouble(Annotation::time));
-        if (insertIndex < 0) {
-            insertIndex = -insertIndex - 1;
-        }
-
-        annotations.add(insertIndex, ann);
-        writeAtomically(file.toPath(), annotationFile);
+        journal(session, AnnotationJournal.Entry.add(ann));
+        apply(session, AnnotationJournal.Entry.add(ann));
+        compactIfLarge(session);
     }
 
-    public boolean headerExists(@NonNull File file) throws IOException {
-        if (!file.exists() || file.length() == 0) {
+    public synchronized boolean headerExists(@NonNull File file) throws IOException {
+        if (!file.exists() || (file.length() == 0 && !sessions.containsKey(key(file)))) {
             return false;
         }
-        var annotationFile = mapper.readValue(file, AnnotationFile.class);
-        return annotationFile.getMetadata().isPresent();
+        return session(file).content.getMetadata().isPresent();
     }
 
-    public void prependHeader(@NonNull File file, @NonNull String annotatorName)
+    public synchronized void prependHeader(@NonNull File file, @NonNull String annotatorName)
             throws IOException {
-
-        if (!file.exists()) {
-            throw new IOException("Annotation file does not exist: " + file.getAbsolutePath());
-        }
-
-        var annotationFile =
-                file.length() > 0
-                        ? mapper.readValue(file, AnnotationFile.class)
-                        : new AnnotationFile();
+        requireExists(file);
+        var session = session(file);
 
         var systemInfo = new LinkedHashMap<String, String>();
         systemInfo.put("os", System.getProperty("os.name"));
@@ -119,39 +147,147 @@ public class AnnotationFileParser {
                         this.programVersion.toString(),
                         systemInfo);
 
-        annotationFile.setMetadata(metadata);
-        writeAtomically(file.toPath(), annotationFile);
+        // Written once per file, so it goes straight into the JSON rather than the journal
+        session.content.setMetadata(metadata);
+        rewrite(session);
     }
 
-    public void addField(@NonNull File file, @NonNull String fieldName, @NonNull String value)
+    public synchronized void addField(
+            @NonNull File file, @NonNull String fieldName, @NonNull String value)
             throws IOException {
+        requireExists(file);
+        var session = session(file);
+        journal(session, AnnotationJournal.Entry.field(fieldName, value));
+        apply(session, AnnotationJournal.Entry.field(fieldName, value));
+        compactIfLarge(session);
+    }
+
+    /**
+     * Write the file's journalled edits into its JSON and remove the journal. Does nothing for a
+     * file with no edits pending.
+     */
+    public synchronized void compact(@NonNull File file) throws IOException {
+        var session = sessions.get(key(file));
+        if (session == null && Files.exists(AnnotationJournal.pathFor(key(file)))) {
+            session = session(file); // A journal left by a crash: replay it, then fold it in
+        }
+        if (session != null && session.journal != null) {
+            rewrite(session);
+        }
+    }
+
+    /** Compact the file and forget it, e.g. when its audio file is closed or marked done. */
+    public synchronized void close(@NonNull File file) throws IOException {
+        compact(file);
+        var session = sessions.remove(key(file));
+        if (session != null && session.journal != null) {
+            session.journal.close();
+        }
+    }
+
+    /** Compact and forget every open file, carrying on past failures and rethrowing the first. */
+    public synchronized void closeAll() throws IOException {
+        IOException failure = null;
+        for (Path file : List.copyOf(sessions.keySet())) {
+            try {
+                close(file.toFile());
+            } catch (IOException e) {
+                logger.warn("Failed to compact annotation file {}", file, e);
+                failure = failure == null ? e : failure;
+                sessions.remove(file);
+            }
+        }
+        if (failure != null) {
+            throw failure;
+        }
+    }
+
+    private static void requireExists(@NonNull File file) throws IOException {
         if (!file.exists()) {
             throw new IOException("Annotation file does not exist: " + file.getAbsolutePath());
         }
-        var annotationFile = mapper.readValue(file, AnnotationFile.class);
+    }
 
-        var metadata =
-                annotationFile
-                        .getMetadata()
-                        .orElseGet(
-                                () -> {
-                                    var newMetadata = new AnnotationFile.Metadata();
-                                    annotationFile.setMetadata(newMetadata);
-                                    return newMetadata;
-                                });
+    private static Path key(@NonNull File file) {
+        return file.toPath().toAbsolutePath().normalize();
+    }
 
-        var system =
-                Objects.requireNonNullElseGet(
-                        metadata.getSystem(), () -> new LinkedHashMap<String, String>());
-        metadata.setSystem(system);
+    /**
+     * The file's session, loading it (and replaying any journal) if it is not open or was rewritten
+     * behind the parser's back. Pending edits survive a reload, since the journal is replayed.
+     */
+    private Session session(@NonNull File file) throws IOException {
+        Path path = key(file);
+        var session = sessions.get(path);
+        if (session != null && !session.staleOnDisk()) {
+            return session;
+        }
+        if (session != null) {
+            logger.info("Annotation file {} changed on disk; reloading", path);
+            if (session.journal != null) {
+                session.journal.close();
+            }
+        }
+
+        var content =
+                Files.size(path) > 0
+                        ? mapper.readValue(path.toFile(), AnnotationFile.class)
+                        : new AnnotationFile();
+        session = new Session(path, content);
+        session.stamp();
+
+        Path journalPath = AnnotationJournal.pathFor(path);
+        if (Files.exists(journalPath)) {
+            var replay = AnnotationJournal.read(journalPath, journalMapper);
+            for (var entry : replay.entries()) {
+                apply(session, entry);
+            }
+            session.journal =
+                    AnnotationJournal.open(journalPath, journalMapper, replay.validBytes());
+            logger.info(
+                    "Replayed {} journalled edits onto annotation file {}",
+                    replay.entries().size(),
+                    path);
+        }
+        sessions.put(path, session);
+        return session;
+    }
+
+    private void journal(@NonNull Session session, @NonNull AnnotationJournal.Entry entry)
+            throws IOException {
+        if (session.journal == null) {
+            session.journal =
+                    AnnotationJournal.open(
+                            AnnotationJournal.pathFor(session.file), journalMapper, 0);
+        }
+        session.journal.append(entry);
+    }
+
+    /** Apply an edit to the session's contents; idempotent, as replay requires. */
+    private static void apply(@NonNull Session session, @NonNull AnnotationJournal.Entry entry) {
+        AnnotationJournal.apply(session.content, session.present, entry);
+    }
 
-        system.put(fieldName, value);
-        writeAtomically(file.toPath(), annotationFile);
+    private void compactIfLarge(@NonNull Session session) throws IOException {
+        if (session.journal != null && session.journal.size() >= COMPACT_THRESHOLD_BYTES) {
+            rewrite(session);
+        }
+    }
+
+    /** Write the session's contents as the file's JSON, then drop the journal it now includes. */
+    private void rewrite(@NonNull Session session) throws IOException {
+        writeAtomically(session.file, session.content);
+        session.stamp();
+        if (session.journal != null) {
+            session.journal.delete();
+            session.journal = null;
+        }
     }
 
     private void writeAtomically(@NonNull Path target, @NonNull AnnotationFile content)
             throws IOException {
-        var tempFile = Files.createTempFile("ann", ".ann.json");
+        // Beside the target, so the move stays on one file system and can be atomic
+        var tempFile = Files.createTempFile(target.getParent(), "ann", ".ann.json");
         try {
             mapper.writeValue(tempFile.toFile(), content);
             Files.move(
@@ -0,0 +1,246 @@
+package core.annotations;
+
+import com.fasterxml.jackson.annotation.JsonInclude;
+import com.fasterxml.jackson.annotation.JsonProperty;
+import com.fasterxml.jackson.databind.ObjectMapper;
+import java.io.Closeable;
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.FileChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Objects;
+import java.util.Set;
+import org.checkerframework.checker.nullness.qual.NonNull;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+/**
+ * Append-only log of the edits made to one annotation file since it was last written in full. It
+ * lives beside the file ({@code <file>.journal}), one JSON record per line, and each record is
+ * forced to disk before the edit returns, so an edit costs one short write however many
+ * annotations the file holds.
+ *
+ * <p>Every record is idempotent (adds skip annotations already present, removes of absent ones do
+ * nothing, fields are overwritten), so replaying the whole journal over the file gives the same
+ * result whether or not a compaction finished writing the file before a crash. A final record cut
+ * short by a crash is dropped on replay and truncated away before the next append.
+ */
+final class AnnotationJournal implements Closeable {
+    private static final Logger logger = LoggerFactory.getLogger(AnnotationJournal.class);
+
+    static final String SUFFIX = ".journal";
+
+    enum Op {
+        @JsonProperty("add")
+        ADD,
+        @JsonProperty("remove")
+        REMOVE,
+        @JsonProperty("field")
+        FIELD
+    }
+
+    /** One journalled edit: an annotation for adds and removes, a name and value for fields. */
+    @JsonInclude(JsonInclude.Include.NON_NULL)
+    record Entry(
+            @JsonProperty("op") Op op,
+            @JsonProperty("annotation") Annotation annotation,
+            @JsonProperty("name") String name,
+            @JsonProperty("value") String value) {
+
+        static Entry add(@NonNull Annotation annotation) {
+            return new Entry(Op.ADD, annotation, null, null);
+        }
+
+        static Entry remove(@NonNull Annotation annotation) {
+            return new Entry(Op.REMOVE, annotation, null, null);
+        }
+
+        static Entry field(@NonNull String name, @NonNull String value) {
+            return new Entry(Op.FIELD, null, name, value);
+        }
+    }
+
+    /** Records read back from a journal, and the length of the intact part of the file. */
+    record Contents(@NonNull List<Entry> entries, long validBytes) {}
+
+    private final Path path;
+    private final ObjectMapper mapper;
+    private final FileChannel channel;
+    private long size;
+
+    private AnnotationJournal(
+            @NonNull Path path, @NonNull ObjectMapper mapper, @NonNull FileChannel channel) {
+        this.path = path;
+        this.mapper = mapper;
+        this.channel = channel;
+    }
+
+    /** The journal belonging to an annotation file. */
+    static Path pathFor(@NonNull Path annotationFile) {
+        return annotationFile.resolveSibling(annotationFile.getFileName() + SUFFIX);
+    }
+
+    /**
+     * Read a journal's records. A last line that is unterminated or does not parse is taken to be a
+     * torn write and dropped; any earlier bad line means the journal is damaged.
+     *
+     * @param mapper Mapper that writes each record on one line
+     */
+    static Contents read(@NonNull Path path, @NonNull ObjectMapper mapper) throws IOException {
+        List<Entry> entries = new ArrayList<>();
+        if (!Files.exists(path)) {
+            return new Contents(entries, 0);
+        }
+        byte[] bytes = Files.readAllBytes(path);
+        int start = 0;
+        while (start < bytes.length) {
+            int end = start;
+            while (end < bytes.length && bytes[end] != '\n') {
+                end++;
+            }
+            if (end == bytes.length) {
+                // The crash came before the record's newline, so its append never returned
+                logger.warn("Dropping incomplete last record of {}", path);
+                return new Contents(entries, start);
+            }
+            String line = new String(bytes, start, end - start, StandardCharsets.UTF_8);
+            if (!line.isBlank()) {
+                try {
+                    entries.add(mapper.readValue(line, Entry.class));
+                } catch (IOException e) {
+                    if (end < bytes.length - 1) {
+                        throw new IOException("Damaged annotation journal " + path, e);
+                    }
+                    logger.warn("Dropping unreadable last record of {}", path);
+                    return new Contents(entries, start);
+                }
+            }
+            start = end + 1;
+        }
+        return new Contents(entries, bytes.length);
+    }
+
+    /**
+     * Open a journal for appending, first cutting it back to {@code validBytes} so a torn record
+     * never has new ones written after it.
+     */
+    static AnnotationJournal open(@NonNull Path path, @NonNull ObjectMapper mapper, long validBytes)
+            throws IOException {
+        FileChannel channel =
+                FileChannel.open(path, StandardOpenOption.CREATE, StandardOpenOption.WRITE);
+        try {
+            if (channel.size() > validBytes) {
+                channel.truncate(validBytes);
+                channel.force(true);
+            }
+            channel.position(validBytes);
+        } catch (IOException e) {
+            channel.close();
+            throw e;
+        }
+        var journal = new AnnotationJournal(path, mapper, channel);
+        journal.size = validBytes;
+        return journal;
+    }
+
+    /** Append a record and force it to disk. */
+    void append(@NonNull Entry entry) throws IOException {
+        byte[] record = mapper.writeValueAsBytes(entry);
+        ByteBuffer buffer = ByteBuffer.allocate(record.length + 1).put(record).put((byte) '\n');
+        buffer.flip();
+        while (buffer.hasRemaining()) {
+            channel.write(buffer);
+        }
+        channel.force(false);
+        size += record.length + 1;
+    }
+
+    /**
+     * Apply a record to a file's contents. Idempotent, as replay requires.
+     *
+     * @param present The annotations in {@code content}, kept in step with it
+     */
+    static void apply(
+            @NonNull AnnotationFile content,
+            @NonNull Set<Annotation> present,
+            @NonNull Entry entry) {
+        var annotations = content.getAnnotations();
+        switch (entry.op()) {
+            case ADD -> {
+                var ann = entry.annotation();
+                if (!present.add(ann)) {
+                    return;
+                }
+                // After any annotations at the same time, as the file has always ordered them
+                int insertIndex = Collections.binarySearch(annotations, ann);
+                if (insertIndex < 0) {
+                    insertIndex = -insertIndex - 1;
+                }
+                while (insertIndex < annotations.size()
+                        && annotations.get(insertIndex).time() == ann.time()) {
+                    insertIndex++;
+                }
+                annotations.add(insertIndex, ann);
+            }
+            case REMOVE -> {
+                var ann = entry.annotation();
+                if (!present.remove(ann)) {
+                    return;
+                }
+                int index = Collections.binarySearch(annotations, ann);
+                if (index < 0) {
+                    annotations.removeIf(ann::equals); // Out of order on disk
+                    return;
+                }
+                // Remove it (and any copies an older version wrote) from among those at its time
+                int from = index;
+                int to = index + 1;
+                while (from > 0 && annotations.get(from - 1).time() == ann.time()) {
+                    from--;
+                }
+                while (to < annotations.size() && annotations.get(to).time() == ann.time()) {
+                    to++;
+                }
+                annotations.subList(from, to).removeIf(ann::equals);
+            }
+            case FIELD -> {
+                var metadata =
+                        content.getMetadata()
+                                .orElseGet(
+                                        () -> {
+                                            var newMetadata = new AnnotationFile.Metadata();
+                                            content.setMetadata(newMetadata);
+                                            return newMetadata;
+                                        });
+                var system =
+                        Objects.requireNonNullElseGet(
+                                metadata.getSystem(), () -> new LinkedHashMap<String, String>());
+                metadata.setSystem(system);
+                system.put(entry.name(), entry.value());
+            }
+        }
+    }
+
+    /** Bytes of records written so far. */
+    long size() {
+        return size;
+    }
+
+    /** Close and remove the journal, once its records are all in the annotation file. */
+    void delete() throws IOException {
+        close();
+        Files.deleteIfExists(path);
+    }
+
+    @Override
+    public void close() throws IOException {
+        channel.close();
+    }
+}
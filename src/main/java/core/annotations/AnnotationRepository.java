@@ -13,6 +13,7 @@ import java.nio.file.StandardCopyOption;
 import java.time.Instant;
 import java.time.format.DateTimeFormatter;
 import java.util.ArrayList;
+import java.util.HashSet;
 import java.util.LinkedHashMap;
 import java.util.List;
 import java.util.Optional;
@@ -36,12 +37,26 @@ public class AnnotationRepository {
         this.programVersion = programVersion;
     }
 
+    /** Read an annotation file, with any edits still in its {@link AnnotationJournal} applied. */
     public List<AnnotationEntry> load(@NonNull Path file) throws IOException {
         if (!Files.exists(file)) {
             throw new IOException("Annotation file does not exist: " + file);
         }
 
         var annotationFile = mapper.readValue(file.toFile(), AnnotationFile.class);
+
+        // Edits the parser journalled but never compacted, e.g. before a crash
+        var journal = AnnotationJournal.read(AnnotationJournal.pathFor(file), mapper);
+        if (!journal.entries().isEmpty()) {
+            var present = new HashSet<>(annotationFile.getAnnotations());
+            for (var entry : journal.entries()) {
+                AnnotationJournal.apply(annotationFile, present, entry);
+            }
+            logger.info(
+                    "Replayed {} journalled edits onto annotation file {}",
+                    journal.entries().size(),
+                    file);
+        }
         var metadata = annotationFile.getMetadata().orElse(null);
 
         // Get annotator name from metadata, or use default
@@ -67,6 +82,7 @@ public class AnnotationRepository {
                 .collect(Collectors.toList());
     }
 
+    /** Write an annotation file in full, replacing its contents and any journal beside it. */
     public void save(@NonNull List<AnnotationEntry> annotations, @NonNull Path file)
             throws IOException {
 
@@ -104,6 +120,9 @@ public class AnnotationRepository {
         // Write atomically to avoid corruption
         writeAtomically(file, annotationFile);
 
+        // The file now holds every edit, so a journal left beside it would replay stale ones
+        Files.deleteIfExists(AnnotationJournal.pathFor(file));
+
         logger.debug("Saved {} annotations to {}", annotations.size(), file);
     }
 
@@ -24,6 +24,10 @@ import org.slf4j.LoggerFactory;
 /**
  * Central service for managing annotations. Provides a unified interface for all annotation
  * operations.
+ *
+ * <p>Edits may come from any thread. Each one changes the list and the {@link AnnotationTimeIndex}
+ * together under the service's lock before its event is published, so the queries answered from
+ * the index never lag behind an edit that has returned.
  */
 @Singleton
 public class AnnotationService {
@@ -33,6 +37,7 @@ public class AnnotationService {
     private final EventDispatchBus eventBus;
     private final AudioSessionDataSource audioState;
     private final AnnotationRepository repository;
+    private final AnnotationTimeIndex timeIndex;
 
     private Optional<String> currentAnnotatorName = Optional.empty();
     private Optional<Path> currentFile = Optional.empty();
@@ -42,10 +47,12 @@ public class AnnotationService {
     public AnnotationService(
             @NonNull EventDispatchBus eventBus,
             @NonNull AudioSessionDataSource audioState,
-            @NonNull AnnotationRepository repository) {
+            @NonNull AnnotationRepository repository,
+            @NonNull AnnotationTimeIndex timeIndex) {
         this.eventBus = eventBus;
         this.audioState = audioState;
         this.repository = repository;
+        this.timeIndex = timeIndex;
     }
 
     /** Sets the current annotator name for new annotations. */
@@ -59,7 +66,7 @@ public class AnnotationService {
     }
 
     /** Adds a new annotation at the specified time. */
-    public AnnotationEntry addAnnotation(
+    public synchronized AnnotationEntry addAnnotation(
             @NonNull String text, @NonNull AnnotationType type, double time) {
         validateTime(time);
 
@@ -75,6 +82,7 @@ public class AnnotationService {
             index = -index - 1;
         }
         annotations.add(index, entry);
+        timeIndex.add(entry);
 
         hasUnsavedChanges = true;
         eventBus.publish(new AnnotationAddedEvent(entry));
@@ -99,10 +107,11 @@ public class AnnotationService {
     }
 
     /** Deletes the specified annotation. */
-    public boolean deleteAnnotation(@NonNull AnnotationEntry entry) {
+    public synchronized boolean deleteAnnotation(@NonNull AnnotationEntry entry) {
 
         boolean removed = annotations.remove(entry);
         if (removed) {
+            timeIndex.remove(entry);
             hasUnsavedChanges = true;
             eventBus.publish(new AnnotationDeletedEvent(entry));
             logger.debug("Deleted annotation: {} at {} ms", entry.text(), entry.time());
@@ -111,7 +120,7 @@ public class AnnotationService {
     }
 
     /** Deletes annotation by ID. */
-    public boolean deleteAnnotationById(@NonNull UUID id) {
+    public synchronized boolean deleteAnnotationById(@NonNull UUID id) {
 
         return annotations.stream()
                 .filter(e -> e.id().equals(id))
@@ -121,13 +130,14 @@ public class AnnotationService {
     }
 
     /** Updates an existing annotation's text. */
-    public boolean updateAnnotation(@NonNull UUID id, @NonNull String newText) {
+    public synchronized boolean updateAnnotation(@NonNull UUID id, @NonNull String newText) {
 
         for (int i = 0; i < annotations.size(); i++) {
             var entry = annotations.get(i);
             if (entry.id().equals(id)) {
                 var newEntry = entry.withText(newText);
                 annotations.set(i, newEntry);
+                timeIndex.update(entry, newEntry);
                 hasUnsavedChanges = true;
                 eventBus.publish(new AnnotationUpdatedEvent(entry, newEntry));
                 logger.debug("Updated annotation: {} -> {}", entry.text(), newText);
@@ -139,14 +149,12 @@ public class AnnotationService {
 
     /** Gets the next annotation after the specified time. */
     public Optional<AnnotationEntry> getNextAnnotation(double fromTime) {
-        return annotations.stream().filter(a -> a.time() > fromTime + 1.0).findFirst();
+        return timeIndex.firstAfter(fromTime + 1.0);
     }
 
     /** Gets the previous annotation before the specified time. */
     public Optional<AnnotationEntry> getPreviousAnnotation(double fromTime) {
-        return annotations.stream()
-                .filter(a -> a.time() < fromTime - 1.0)
-                .reduce((_, second) -> second); // Get last matching
+        return timeIndex.lastBefore(fromTime - 1.0);
     }
 
     /** Gets all annotations in time order. */
@@ -156,7 +164,7 @@ public class AnnotationService {
 
     /** Gets annotations within a time range. */
     public Stream<AnnotationEntry> getAnnotationsInRange(double startTime, double endTime) {
-        return annotations.stream().filter(a -> a.time() >= startTime && a.time() <= endTime);
+        return timeIndex.between(startTime, endTime).stream();
     }
 
     /** Gets annotation by ID. */
@@ -165,12 +173,13 @@ public class AnnotationService {
     }
 
     /** Loads annotations from a file. */
-    public void loadAnnotations(@NonNull Path file) {
+    public synchronized void loadAnnotations(@NonNull Path file) {
 
         try {
             var loaded = repository.load(file);
             annotations.clear();
             annotations.addAll(loaded);
+            timeIndex.reset(loaded);
             currentFile = Optional.of(file);
             hasUnsavedChanges = false;
 
@@ -203,8 +212,9 @@ public class AnnotationService {
     }
 
     /** Clears all annotations. */
-    public void clearAnnotations() {
+    public synchronized void clearAnnotations() {
         annotations.clear();
+        timeIndex.reset(List.of());
         hasUnsavedChanges = false;
         currentFile = Optional.empty();
         eventBus.publish(new AnnotationsClearedEvent());
@@ -231,7 +241,7 @@ public class AnnotationService {
         }
         validateTime(time);
         // Check for conflicts within 50ms
-        return annotations.stream().noneMatch(a -> Math.abs(a.time() - time) < 50);
+        return !timeIndex.anyWithin(time, 50);
     }
 
     /** Gets the total number of annotations. */
@@ -0,0 +1,192 @@
+package core.annotations;
+
+import jakarta.inject.Inject;
+import jakarta.inject.Singleton;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.List;
+import java.util.Optional;
+import java.util.UUID;
+import lombok.NonNull;
+
+/**
+ * Annotations sorted by time, so navigation and visible-range queries are binary searches rather
+ * than scans however dense a session is.
+ *
+ * <p>The index is an immutable sorted array swapped on each edit: an edit copies it once, which
+ * annotating at human speed can afford, while the painter and the navigation actions read it
+ * without locking. {@link AnnotationService} updates it within each edit, on whatever thread the
+ * edit runs, so a query made straight after an edit sees it; updates are idempotent by id.
+ */
+@Singleton
+public class AnnotationTimeIndex {
+
+    /** The entries in time order, and their times alongside for the searches. */
+    private record Snapshot(double[] times, AnnotationEntry[] entries) {
+        static final Snapshot EMPTY = new Snapshot(new double[0], new AnnotationEntry[0]);
+
+        static Snapshot of(@NonNull AnnotationEntry[] sorted) {
+            double[] times = new double[sorted.length];
+            for (int i = 0; i < sorted.length; i++) {
+                times[i] = sorted[i].time();
+            }
+            return new Snapshot(times, sorted);
+        }
+    }
+
+    private volatile Snapshot snapshot = Snapshot.EMPTY;
+
+    @Inject
+    public AnnotationTimeIndex() {}
+
+    /** Insert an annotation, after any others at its time. */
+    public void add(@NonNull AnnotationEntry entry) {
+        replace(null, entry);
+    }
+
+    /** Remove an annotation, found by id. */
+    public void remove(@NonNull AnnotationEntry entry) {
+        replace(entry, null);
+    }
+
+    /** Replace an annotation with its edited version. */
+    public void update(@NonNull AnnotationEntry oldEntry, @NonNull AnnotationEntry newEntry) {
+        replace(oldEntry, newEntry);
+    }
+
+    /** Replace the whole index, e.g. when a file is loaded. */
+    public synchronized void reset(@NonNull List<AnnotationEntry> annotations) {
+        AnnotationEntry[] sorted = annotations.toArray(AnnotationEntry[]::new);
+        Arrays.sort(sorted); // Stable, so entries at one time keep their order
+        snapshot = Snapshot.of(sorted);
+    }
+
+    /** The first annotation strictly after {@code time} (ms). */
+    public Optional<AnnotationEntry> firstAfter(double time) {
+        var s = snapshot;
+        int i = upperBound(s.times, time);
+        return i < s.entries.length ? Optional.of(s.entries[i]) : Optional.empty();
+    }
+
+    /** The last annotation strictly before {@code time} (ms). */
+    public Optional<AnnotationEntry> lastBefore(double time) {
+        var s = snapshot;
+        int i = lowerBound(s.times, time) - 1;
+        return i >= 0 ? Optional.of(s.entries[i]) : Optional.empty();
+    }
+
+    /** Annotations from {@code startTime} to {@code endTime} (ms) inclusive, in time order. */
+    public List<AnnotationEntry> between(double startTime, double endTime) {
+        var s = snapshot;
+        int from = lowerBound(s.times, startTime);
+        int to = upperBound(s.times, endTime);
+        if (from >= to) {
+            return List.of();
+        }
+        // The snapshot is never modified, so a view of it stays valid
+        return Collections.unmodifiableList(Arrays.asList(s.entries).subList(from, to));
+    }
+
+    /** Whether any annotation lies strictly within {@code radius} ms of {@code time}. */
+    public boolean anyWithin(double time, double radius) {
+        var s = snapshot;
+        int i = upperBound(s.times, time - radius);
+        return i < s.times.length && s.times[i] < time + radius;
+    }
+
+    public int size() {
+        return snapshot.entries.length;
+    }
+
+    /** Remove {@code oldEntry} (by id) and insert {@code newEntry}; either may be null. */
+    private synchronized void replace(AnnotationEntry oldEntry, AnnotationEntry newEntry) {
+        var s = snapshot;
+        if (newEntry != null) {
+            int present = indexOf(s, newEntry.id(), newEntry.time());
+            if (present >= 0 && s.entries[present].equals(newEntry)) {
+                return; // Already applied
+            }
+        }
+        AnnotationEntry[] entries = s.entries;
+        if (oldEntry != null) {
+            int i = indexOf(s, oldEntry.id(), oldEntry.time());
+            if (i >= 0) {
+                entries = remove(entries, i);
+            }
+        }
+        if (newEntry != null) {
+            entries = insert(entries, newEntry);
+        }
+        if (entries != s.entries) {
+            snapshot = Snapshot.of(entries);
+        }
+    }
+
+    private static AnnotationEntry[] remove(@NonNull AnnotationEntry[] entries, int index) {
+        var result = new AnnotationEntry[entries.length - 1];
+        System.arraycopy(entries, 0, result, 0, index);
+        System.arraycopy(entries, index + 1, result, index, entries.length - index - 1);
+        return result;
+    }
+
+    /** Insert after any entries at the same time, as {@link AnnotationService} orders them. */
+    private static AnnotationEntry[] insert(
+            @NonNull AnnotationEntry[] entries, @NonNull AnnotationEntry entry) {
+        int index = 0;
+        int high = entries.length;
+        while (index < high) {
+            int mid = (index + high) >>> 1;
+            if (entries[mid].time() <= entry.time()) {
+                index = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        var result = new AnnotationEntry[entries.length + 1];
+        System.arraycopy(entries, 0, result, 0, index);
+        result[index] = entry;
+        System.arraycopy(entries, index, result, index + 1, entries.length - index);
+        return result;
+    }
+
+    /** Position of the entry with this id among those at {@code time}, or -1. */
+    private static int indexOf(@NonNull Snapshot s, @NonNull UUID id, double time) {
+        int end = upperBound(s.times, time);
+        for (int i = lowerBound(s.times, time); i < end; i++) {
+            if (s.entries[i].id().equals(id)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    /** First index whose time is at least {@code time}. */
+    private static int lowerBound(@NonNull double[] times, double time) {
+        int low = 0;
+        int high = times.length;
+        while (low < high) {
+            int mid = (low + high) >>> 1;
+            if (times[mid] < time) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    /** First index whose time is greater than {@code time}. */
+    private static int upperBound(@NonNull double[] times, double time) {
+        int low = 0;
+        int high = times.length;
+        while (low < high) {
+            int mid = (low + high) >>> 1;
+            if (times[mid] <= time) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+}
@@ -6,17 +6,23 @@ import lombok.NonNull;
  * Immutable audio data returned from sample reading operations.
  *
  * <p>This record encapsulates raw audio samples along with their metadata. It is designed to be a
- * simple, library-agnostic data carrier.
+ * simple, library-agnostic data carrier. Samples are held as a read-only {@link SampleView}, which
+ * lets readers hand out slices of their own storage (including compact {@code float} storage)
+ * without copying.
  *
- * @param samples Audio samples as doubles normalized to [-1.0, 1.0]. For multi-channel audio,
- *     samples are interleaved (e.g., [L0, R0, L1, R1, ...] for stereo)
+ * <p>Equality follows {@link SampleView#equals}: two instances are equal when they view the same
+ * samples in the same storage, as they were when this record held the array itself. Samples are
+ * never compared element by element.
+ *
+ * @param view Audio samples normalized to [-1.0, 1.0]. For multi-channel audio, samples are
+ *     interleaved (e.g., [L0, R0, L1, R1, ...] for stereo)
  * @param sampleRate Sample rate in Hz (e.g., 44100)
  * @param channelCount Number of channels (1 for mono, 2 for stereo, etc.)
  * @param startFrame Starting frame position in the original file
  * @param frameCount Number of frames actually read (may be less than requested if EOF reached)
  */
 public record AudioData(
-        @NonNull double[] samples,
+        @NonNull SampleView view,
         int sampleRate,
         int channelCount,
         long startFrame,
@@ -35,16 +41,39 @@ public record AudioData(
         if (frameCount < 0) {
             throw new IllegalArgumentException("Frame count cannot be negative: " + frameCount);
         }
-        if (samples.length != channelCount * frameCount && frameCount > 0) {
+        if (view.length() != channelCount * frameCount && frameCount > 0) {
             throw new IllegalArgumentException(
                     "Sample array length ("
-                            + samples.length
+                            + view.length()
                             + ") doesn't match channelCount * frameCount ("
                             + (channelCount * frameCount)
                             + ")");
         }
     }
 
+    /** Creates audio data backed by a heap array, which is wrapped without copying. */
+    public AudioData(
+            @NonNull double[] samples,
+            int sampleRate,
+            int channelCount,
+            long startFrame,
+            long frameCount) {
+        this(SampleView.of(samples), sampleRate, channelCount, startFrame, frameCount);
+    }
+
+    /**
+     * Gets the samples as a {@code double[]}, copying unless this data wraps a whole array.
+     *
+     * <p>Data created from a whole array returns that array; data backed by a slice or by {@code
+     * float} storage is copied into a new array on every call. Production code reads through
+     * {@link #view()} instead; this accessor is for tests and one-off callers.
+     *
+     * @return Interleaved samples, which callers must not modify
+     */
+    public double[] samples() {
+        return view.toArray();
+    }
+
     /**
      * Gets the duration of this audio data in seconds.
      *
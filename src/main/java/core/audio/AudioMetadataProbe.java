@@ -0,0 +1,25 @@
+package core.audio;
+
+import java.io.Closeable;
+import java.nio.file.Path;
+import java.util.concurrent.CompletableFuture;
+import lombok.NonNull;
+
+/**
+ * Reads the format and length of audio files from their headers, without decoding them or keeping
+ * them open, for listing many files at once.
+ *
+ * <p>Thread-safe. Probes run in parallel on the implementation's own threads.
+ */
+public interface AudioMetadataProbe extends Closeable {
+
+    /**
+     * Probe a file's header.
+     *
+     * @param audioFile Path to the audio file
+     * @return Future containing the audio metadata
+     * @throws CompletionException wrapping AudioReadException if the file cannot be opened
+     */
+    @NonNull
+    CompletableFuture<AudioMetadata> probe(@NonNull Path audioFile);
+}
@@ -1,12 +1,18 @@
 package core.audio;
 
 import com.google.inject.AbstractModule;
+import com.google.inject.Provider;
+import com.google.inject.Provides;
 import com.google.inject.Singleton;
 import core.audio.fmod.FmodAudioEngine;
+import core.audio.fmod.FmodMetadataProbe;
 import core.audio.fmod.FmodSampleReader;
+import core.audio.fmod.FmodStreamingSampleReader;
 import core.audio.session.AudioSessionDataSource;
 import core.audio.session.AudioSessionManager;
 import core.audio.session.AudioSessionStateMachine;
+import core.env.AppConfig;
+import lombok.NonNull;
 
 /**
  * Guice module for the a2 (audio engine) package.
@@ -15,14 +21,14 @@ import core.audio.session.AudioSessionStateMachine;
  */
 public class Module extends AbstractModule {
 
+    /** Selects the SampleReader implementation: "memory" (whole-file decode) or "streaming". */
+    static final String SAMPLE_READER_MODE_KEY = "audio.sample_reader.mode";
+
     @Override
     protected void configure() {
         // Bind audio engine interface to FMOD implementation
         bind(AudioEngine.class).to(FmodAudioEngine.class).in(Singleton.class);
-
-        // Bind sample reader interface to FMOD implementation
-        // Note: Not singleton because each Waveform needs its own reader instance
-        bind(SampleReader.class).to(FmodSampleReader.class);
+        bind(AudioMetadataProbe.class).to(FmodMetadataProbe.class).in(Singleton.class);
 
         // Core session management
         bind(AudioSessionManager.class).in(Singleton.class);
@@ -31,4 +37,17 @@ public class Module extends AbstractModule {
         // Bind the interface to the implementation for session data
         bind(AudioSessionDataSource.class).to(AudioSessionManager.class).in(Singleton.class);
     }
+
+    /**
+     * Provides the configured sample reader. Not singleton because each Waveform needs its own
+     * reader instance.
+     */
+    @Provides
+    SampleReader provideSampleReader(
+            @NonNull AppConfig config,
+            @NonNull Provider<FmodSampleReader> memoryReader,
+            @NonNull Provider<FmodStreamingSampleReader> streamingReader) {
+        String mode = config.getProperty(SAMPLE_READER_MODE_KEY, "memory");
+        return "streaming".equalsIgnoreCase(mode) ? streamingReader.get() : memoryReader.get();
+    }
 }
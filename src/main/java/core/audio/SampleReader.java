@@ -111,6 +111,15 @@ public interface SampleReader extends Closeable {
         }
     }
 
+    /**
+     * Releases whatever the reader holds open or cached for a file, for callers that read many
+     * files one after another and are done with this one. A later read of the file still works.
+     * The default holds nothing per file and does nothing.
+     *
+     * @param audioFile Path of the file that will not be read again soon
+     */
+    default void release(@NonNull Path audioFile) {}
+
     /**
      * Checks if this reader supports a given audio format.
      *
@@ -0,0 +1,136 @@
+package core.audio;
+
+import com.google.errorprone.annotations.ThreadSafe;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import lombok.NonNull;
+
+/**
+ * Read-only view over a run of normalized audio samples.
+ *
+ * <p>Samples may be stored as {@code double} (typically a heap {@code double[]}) or as {@code
+ * float} (typically off-heap). Slicing a view never copies; only {@link #toArray()} and {@link
+ * #copyTo} materialize samples into a caller-visible array.
+ *
+ * <p>Views are equal when they cover the same run of the same storage, not when their samples
+ * happen to be equal. Two views of one array are equal; a view of a copy is not.
+ */
+@ThreadSafe
+public final class SampleView {
+
+    private static final SampleView EMPTY = new SampleView(new double[0]);
+
+    private final MemorySegment segment;
+    private final boolean floatStorage;
+
+    // Set only when this view covers an entire double[], so toArray() can return it uncopied
+    private final double[] wholeArray;
+
+    private SampleView(MemorySegment segment, boolean floatStorage) {
+        this.segment = segment.asReadOnly();
+        this.floatStorage = floatStorage;
+        this.wholeArray = null;
+    }
+
+    private SampleView(double[] array) {
+        this.segment = MemorySegment.ofArray(array).asReadOnly();
+        this.floatStorage = false;
+        this.wholeArray = array;
+    }
+
+    /** Wraps a whole {@code double[]} without copying. */
+    public static SampleView of(@NonNull double[] samples) {
+        return samples.length == 0 ? EMPTY : new SampleView(samples);
+    }
+
+    /** Wraps a segment of {@code float} samples without copying. */
+    public static SampleView ofFloats(@NonNull MemorySegment floatSamples) {
+        if (floatSamples.byteSize() % Float.BYTES != 0) {
+            throw new IllegalArgumentException(
+                    "Segment size is not a whole number of floats: " + floatSamples.byteSize());
+        }
+        return new SampleView(floatSamples, true);
+    }
+
+    /** Wraps a segment of {@code double} samples without copying. */
+    public static SampleView ofDoubles(@NonNull MemorySegment doubleSamples) {
+        if (doubleSamples.byteSize() % Double.BYTES != 0) {
+            throw new IllegalArgumentException(
+                    "Segment size is not a whole number of doubles: " + doubleSamples.byteSize());
+        }
+        return new SampleView(doubleSamples, false);
+    }
+
+    /** Number of samples in this view. */
+    public int length() {
+        return (int) (segment.byteSize() / bytesPerSample());
+    }
+
+    /** Whether samples are stored as 32-bit floats. */
+    public boolean isFloatStorage() {
+        return floatStorage;
+    }
+
+    /** Reads one sample. */
+    public double get(int index) {
+        return floatStorage
+                ? segment.getAtIndex(ValueLayout.JAVA_FLOAT, index)
+                : segment.getAtIndex(ValueLayout.JAVA_DOUBLE, index);
+    }
+
+    /** Returns a view over {@code [offset, offset + count)} of this view, without copying. */
+    public SampleView slice(int offset, int count) {
+        if (offset == 0 && count == length()) {
+            return this;
+        }
+        long bytes = bytesPerSample();
+        return new SampleView(segment.asSlice(offset * bytes, count * bytes), floatStorage);
+    }
+
+    /** Copies {@code count} samples starting at {@code offset} into {@code dst[dstOffset..]}. */
+    public void copyTo(int offset, @NonNull double[] dst, int dstOffset, int count) {
+        if (floatStorage) {
+            for (int i = 0; i < count; i++) {
+                dst[dstOffset + i] = segment.getAtIndex(ValueLayout.JAVA_FLOAT, offset + i);
+            }
+        } else {
+            MemorySegment.copy(
+                    segment,
+                    ValueLayout.JAVA_DOUBLE,
+                    offset * (long) Double.BYTES,
+                    dst,
+                    dstOffset,
+                    count);
+        }
+    }
+
+    /**
+     * Returns the samples as a {@code double[]}. A view that wraps a whole array returns that
+     * array without copying, so callers must treat the result as read-only; any other view
+     * returns a fresh copy.
+     */
+    public double[] toArray() {
+        if (wholeArray != null) {
+            return wholeArray;
+        }
+        double[] result = new double[length()];
+        copyTo(0, result, 0, result.length);
+        return result;
+    }
+
+    @Override
+    public boolean equals(Object o) {
+        return o instanceof SampleView other
+                && floatStorage == other.floatStorage
+                && segment.equals(other.segment);
+    }
+
+    @Override
+    public int hashCode() {
+        return 31 * segment.hashCode() + Boolean.hashCode(floatStorage);
+    }
+
+    private int bytesPerSample() {
+        return floatStorage ? Float.BYTES : Double.BYTES;
+    }
+}
@@ -12,7 +12,7 @@ import core.audio.exceptions.AudioEngineException;
 import core.audio.exceptions.AudioLoadException;
 import core.audio.exceptions.AudioPlaybackException;
 import core.audio.fmod.panama.FmodCore;
-import java.lang.foreign.Arena;
+import core.telemetry.PerformanceTelemetry;
 import java.lang.foreign.MemorySegment;
 import java.lang.foreign.ValueLayout;
 import java.util.Timer;
@@ -26,6 +26,9 @@ import lombok.extern.slf4j.Slf4j;
 @Slf4j
 public class FmodAudioEngine implements AudioEngine {
 
+    // How often FMOD's CPU and memory use is sampled for the performance telemetry
+    private static final long USAGE_SAMPLE_MS = 1000;
+
     private final ReentrantLock operationLock = new ReentrantLock();
 
     // Injected dependencies
@@ -35,6 +38,7 @@ public class FmodAudioEngine implements AudioEngine {
     private final FmodListenerManager listenerManager;
     private final FmodSystemStateManager systemStateManager;
     private final FmodHandleLifecycleManager lifecycleManager;
+    private final PerformanceTelemetry telemetry;
 
     // Runtime state
     private FmodPlaybackHandle currentPlayback;
@@ -48,7 +52,8 @@ public class FmodAudioEngine implements AudioEngine {
             @NonNull FmodPlaybackManager playbackManager,
             @NonNull FmodListenerManager listenerManager,
             @NonNull FmodSystemStateManager systemStateManager,
-            @NonNull FmodHandleLifecycleManager lifecycleManager) {
+            @NonNull FmodHandleLifecycleManager lifecycleManager,
+            @NonNull PerformanceTelemetry telemetry) {
 
         this.systemManager = systemManager;
         this.loadingManager = loadingManager;
@@ -56,6 +61,7 @@ public class FmodAudioEngine implements AudioEngine {
         this.listenerManager = listenerManager;
         this.systemStateManager = systemStateManager;
         this.lifecycleManager = lifecycleManager;
+        this.telemetry = telemetry;
 
         if (!systemStateManager.compareAndSetState(
                 FmodSystemStateManager.State.UNINITIALIZED,
@@ -91,6 +97,19 @@ public class FmodAudioEngine implements AudioEngine {
                     },
                     0,
                     20); // 20ms = 50Hz updates
+            updateTimer.scheduleAtFixedRate(
+                    new TimerTask() {
+                        @Override
+                        public void run() {
+                            try {
+                                systemManager.sampleUsage().ifPresent(telemetry::recordAudioUsage);
+                            } catch (Exception e) {
+                                log.debug("Error sampling FMOD usage", e);
+                            }
+                        }
+                    },
+                    USAGE_SAMPLE_MS,
+                    USAGE_SAMPLE_MS);
 
         } catch (Exception e) {
             if (systemManager != null) {
@@ -113,10 +132,17 @@ public class FmodAudioEngine implements AudioEngine {
     @Override
     public AudioHandle loadAudio(@NonNull String filePath) throws AudioLoadException {
         checkOperational();
+        // Opening can take a while for long files; only swapping in the new sound needs the
+        // operation lock, so playback controls stay responsive meanwhile
+        FmodAudioLoadingManager.PendingSound pending = loadingManager.open(filePath);
         operationLock.lock();
         try {
-            AudioHandle handle = loadingManager.loadAudio(filePath);
+            AudioHandle handle = loadingManager.commit(pending);
             currentSound = loadingManager.getCurrentSound().orElse(null);
+            if (currentSound != null) {
+                // So the first replay of the file starts as promptly as later ones
+                playbackManager.prewarm(currentSound, 0);
+            }
             return handle;
         } finally {
             operationLock.unlock();
@@ -145,6 +171,8 @@ public class FmodAudioEngine implements AudioEngine {
     private PlaybackHandle playInternal(
             @NonNull AudioHandle audio, long startFrame, long endFrame) {
         checkOperational();
+        // Outside the lock, so the engine stays responsive while the decode gets ahead
+        loadingManager.awaitPlayable(startFrame);
         operationLock.lock();
         try {
             checkOperational();
@@ -171,8 +199,8 @@ public class FmodAudioEngine implements AudioEngine {
             // Check for existing playback
             if (currentPlayback != null && currentPlayback.isActive()) {
                 if (isRangePlayback) {
-                    // Range playback stops current playback
-                    playbackManager.stop();
+                    // Range playback replaces the current one; playRange stops its channel itself
+                    // and keeps the pre-warmed one, which a stop would discard
                     currentPlayback.markInactive();
                     listenerManager.stopMonitoring();
                     listenerManager.notifyStateChanged(
@@ -232,6 +260,7 @@ public class FmodAudioEngine implements AudioEngine {
                 currentPlayback = null;
                 return;
             }
+            listenerManager.onPausedChanged(fmodPlayback, true);
             listenerManager.notifyStateChanged(
                     fmodPlayback, PlaybackState.PAUSED, PlaybackState.PLAYING);
         } finally {
@@ -261,6 +290,7 @@ public class FmodAudioEngine implements AudioEngine {
                 currentPlayback = null;
                 throw new AudioPlaybackException("Channel was stopped, cannot resume");
             }
+            listenerManager.onPausedChanged(fmodPlayback, false);
             listenerManager.notifyStateChanged(
                     fmodPlayback, PlaybackState.PLAYING, PlaybackState.PAUSED);
         } finally {
@@ -298,6 +328,7 @@ public class FmodAudioEngine implements AudioEngine {
     @Override
     public void seek(@NonNull PlaybackHandle playback, long frame) {
         checkOperational();
+        loadingManager.awaitPlayable(frame);
         operationLock.lock();
         try {
             checkOperational();
@@ -314,8 +345,8 @@ public class FmodAudioEngine implements AudioEngine {
             if (frame < 0) {
                 throw new AudioPlaybackException("Invalid seek position: " + frame);
             }
-            try (Arena arena = Arena.ofConfined()) {
-                var pausedRef = arena.allocate(ValueLayout.JAVA_INT);
+            try (FmodScratch scratch = FmodScratch.open()) {
+                var pausedRef = scratch.allocate(ValueLayout.JAVA_INT);
                 int result = FmodCore.FMOD_Channel_GetPaused(fmodPlayback.getChannel(), pausedRef);
                 boolean wasPaused =
                         (result == FmodConstants.FMOD_OK
@@ -354,8 +385,8 @@ public class FmodAudioEngine implements AudioEngine {
             return PlaybackState.STOPPED;
         }
         MemorySegment channel = fmodPlayback.getChannel();
-        try (Arena arena = Arena.ofConfined()) {
-            var isPlayingRef = arena.allocate(ValueLayout.JAVA_INT);
+        try (FmodScratch scratch = FmodScratch.open()) {
+            var isPlayingRef = scratch.allocate(ValueLayout.JAVA_INT);
             int result = FmodCore.FMOD_Channel_IsPlaying(channel, isPlayingRef);
             if (result == FmodConstants.FMOD_ERR_INVALID_HANDLE
                     || result == FmodConstants.FMOD_ERR_CHANNEL_STOLEN) {
@@ -372,7 +403,7 @@ public class FmodAudioEngine implements AudioEngine {
                 currentPlayback = null;
                 return PlaybackState.STOPPED;
             }
-            var isPausedRef = arena.allocate(ValueLayout.JAVA_INT);
+            var isPausedRef = scratch.allocate(ValueLayout.JAVA_INT);
             result = FmodCore.FMOD_Channel_GetPaused(channel, isPausedRef);
             if (result != FmodConstants.FMOD_OK) {
                 throw new AudioPlaybackException(
@@ -394,8 +425,9 @@ public class FmodAudioEngine implements AudioEngine {
         if (!fmodPlayback.isActive()) {
             return 0L;
         }
-        // Return position from playback manager
-        return playbackManager.getPosition();
+        // Read the snapshot the progress poller keeps; query the channel only when none is kept
+        long position = listenerManager.getPosition(fmodPlayback);
+        return position >= 0 ? position : playbackManager.getPosition();
     }
 
     @Override
@@ -479,6 +511,9 @@ public class FmodAudioEngine implements AudioEngine {
                 updateTimer = null;
             }
 
+            // Stops the pre-warmed channel too, which no playback handle refers to
+            playbackManager.shutdown();
+
             if (listenerManager != null) {
                 try {
                     listenerManager.shutdown();
@@ -494,6 +529,8 @@ public class FmodAudioEngine implements AudioEngine {
                 currentSound = null;
             }
 
+            // Decodes into shared PCM run on the system, so they must stop before it goes
+            loadingManager.close();
             if (systemManager != null) {
                 systemManager.shutdown();
             }
@@ -5,13 +5,19 @@ import core.audio.AudioHandle;
 import core.audio.AudioMetadata;
 import core.audio.exceptions.AudioEngineException;
 import core.audio.exceptions.AudioLoadException;
+import core.audio.fmod.FmodDecodedAudioStore.DecodedAudio;
+import core.audio.fmod.panama.FMOD_CREATESOUNDEXINFO;
 import core.audio.fmod.panama.FmodCore;
 import java.io.File;
 import java.io.IOException;
 import java.lang.foreign.Arena;
 import java.lang.foreign.MemorySegment;
 import java.lang.foreign.ValueLayout;
+import java.nio.file.Path;
 import java.util.Optional;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.TimeoutException;
 import java.util.concurrent.locks.ReentrantLock;
 import lombok.NonNull;
 import lombok.extern.slf4j.Slf4j;
@@ -19,19 +25,41 @@ import lombok.extern.slf4j.Slf4j;
 /**
  * Manages audio file loading and lifecycle for the FMOD audio engine. Maintains the single-audio
  * paradigm where only one audio file is "current" at a time.
+ *
+ * <p>Loading is split into {@link #open}, which may take a while for long files and holds no lock,
+ * and {@link #commit}, which swaps the current audio under the loadingLock. Concurrent loads
+ * become current in the order their opens finish.
+ *
+ * <p>With a {@link FmodDecodedAudioStore} a file is current as soon as its header is read, and
+ * plays from PCM that is still being decoded; {@link #awaitPlayable} lets playback wait for the
+ * decode to get ahead of it. Without one each file is opened as an ordinary sample, as {@link
+ * FmodPlaybackManager} prewarms a second channel on the current sound and a stream allows only
+ * one.
  */
 @ThreadSafe
 @Slf4j
 class FmodAudioLoadingManager {
 
     // Immutable record to hold current audio state atomically
+    // A shared-decode sound plays straight from the decoded PCM, which must outlive it
     private record CurrentAudio(
-            @NonNull FmodAudioHandle handle, @NonNull MemorySegment sound, @NonNull String path) {}
+            @NonNull FmodAudioHandle handle,
+            @NonNull MemorySegment sound,
+            @NonNull String path,
+            @NonNull Optional<DecodedAudio> decoded) {}
+
+    // Audio past the play position that should be decoded before playback starts on it
+    static final double PLAYABLE_LEAD_SECONDS = 1.0;
+
+    // Longest a play or seek waits for the decode; after that it starts and catches up
+    static final long PLAYABLE_WAIT_MILLIS = 2000;
 
     private final MemorySegment system;
     private final FmodSystemStateManager stateManager;
     private final FmodHandleLifecycleManager lifecycleManager;
     private final ReentrantLock loadingLock = new ReentrantLock();
+    private final boolean nonBlocking;
+    private final Optional<FmodDecodedAudioStore> decodedAudioStore;
 
     // Current loaded audio (single-audio paradigm) - guarded by loadingLock
     private volatile Optional<CurrentAudio> current = Optional.empty();
@@ -40,58 +68,122 @@ class FmodAudioLoadingManager {
             @NonNull MemorySegment system,
             @NonNull FmodSystemStateManager stateManager,
             @NonNull FmodHandleLifecycleManager lifecycleManager) {
+        this(system, stateManager, lifecycleManager, false, Optional.empty());
+    }
+
+    /**
+     * @param nonBlocking Open sounds with {@code FMOD_NONBLOCKING} and poll their open state,
+     *     rather than blocking inside {@code FMOD_System_CreateSound}
+     * @param decodedAudioStore If present, play each file from the PCM this store decodes (and
+     *     shares with the waveform reader) instead of opening the file again; the store then
+     *     applies its own non-blocking setting to the decode
+     */
+    FmodAudioLoadingManager(
+            @NonNull MemorySegment system,
+            @NonNull FmodSystemStateManager stateManager,
+            @NonNull FmodHandleLifecycleManager lifecycleManager,
+            boolean nonBlocking,
+            @NonNull Optional<FmodDecodedAudioStore> decodedAudioStore) {
         this.system = system;
         this.stateManager = stateManager;
         this.lifecycleManager = lifecycleManager;
+        this.nonBlocking = nonBlocking;
+        this.decodedAudioStore = decodedAudioStore;
     }
 
     /**
-     * Load an audio file. Returns the same handle if the file is already loaded. This method
-     * acquires the loadingLock for thread-safe operations.
+     * A sound opened by {@link #open} but not yet made current.
+     *
+     * @param path Canonical path of the file
+     * @param sound The opened sound, or empty if the file was already current when opened
+     * @param decoded Shared PCM the sound plays from, if it was created from decoded audio
+     */
+    record PendingSound(
+            @NonNull String path,
+            @NonNull Optional<MemorySegment> sound,
+            @NonNull Optional<DecodedAudio> decoded) {}
+
+    /**
+     * Load an audio file. Returns the same handle if the file is already loaded. Equivalent to
+     * {@link #open} followed by {@link #commit}.
      *
      * @param filePath Path to the audio file
      * @return Handle to the loaded audio
      * @throws AudioLoadException if the file cannot be loaded
      */
     AudioHandle loadAudio(@NonNull String filePath) throws AudioLoadException {
+        return commit(open(filePath));
+    }
+
+    /**
+     * Open an audio file as a new sound without making it current. Does not hold the loadingLock,
+     * so the current audio stays usable while a long file opens. In non-blocking mode the open
+     * runs on FMOD's loader thread and this thread polls for it, so an interrupt abandons the
+     * load. With a decoded audio store this returns once the header is read and the decode has
+     * started; without one the sound is a sample, which is decoded whole before this returns.
+     *
+     * @param filePath Path to the audio file
+     * @return The opened sound, or no sound if the file is already current
+     * @throws AudioLoadException if the file cannot be opened
+     */
+    PendingSound open(@NonNull String filePath) throws AudioLoadException {
+        String canonicalPath = validateAndNormalize(filePath);
+        Optional<CurrentAudio> existing = current;
+        if (existing.isPresent() && existing.get().path().equals(canonicalPath)) {
+            return new PendingSound(canonicalPath, Optional.empty(), Optional.empty());
+        }
+        return openNew(canonicalPath);
+    }
+
+    /** Create a sound for a file, from shared decoded PCM if there is a store. */
+    private PendingSound openNew(@NonNull String canonicalPath) throws AudioLoadException {
+        if (decodedAudioStore.isEmpty()) {
+            return new PendingSound(
+                    canonicalPath, Optional.of(createSound(canonicalPath)), Optional.empty());
+        }
+        DecodedAudio decoded = decodedAudioStore.get().acquire(Path.of(canonicalPath));
+        return new PendingSound(
+                canonicalPath,
+                Optional.of(createSound(decoded, canonicalPath)),
+                Optional.of(decoded));
+    }
+
+    /**
+     * Make an opened sound the current audio, releasing the previous one. If the file became
+     * current through another load in the meantime, the pending sound is released and the
+     * existing handle returned. This method acquires the loadingLock for thread-safe operations.
+     *
+     * @param pending Result of {@link #open}
+     * @return Handle to the now current audio
+     * @throws AudioLoadException if the file had to be reopened and that failed
+     */
+    AudioHandle commit(@NonNull PendingSound pending) throws AudioLoadException {
         loadingLock.lock();
         try {
-            // Validate and normalize the path
-            String canonicalPath = validateAndNormalize(filePath);
-
             // Check if this file is already loaded
             Optional<CurrentAudio> existing = current;
-            if (existing.isPresent() && existing.get().path().equals(canonicalPath)) {
+            if (existing.isPresent() && existing.get().path().equals(pending.path())) {
                 // Same file already loaded, return existing handle
+                pending.sound().ifPresent(sound -> release(sound, pending.path()));
                 return existing.get().handle();
             }
 
-            // Create new sound BEFORE releasing old one (to ensure we always have valid audio)
-            MemorySegment newSound;
-            try {
-                newSound = createSound(canonicalPath);
-            } catch (AudioLoadException e) {
-                // Failed to create new sound - keep the old one
-                throw e;
-            }
+            // The file was current when opened but another load replaced it since
+            PendingSound opened = pending.sound().isPresent() ? pending : openNew(pending.path());
+            MemorySegment newSound = opened.sound().orElseThrow();
 
-            // Only release previous audio after successfully creating new one
-            if (existing.isPresent()) {
-                int result = FmodCore.FMOD_Sound_Release(existing.get().sound());
-                if (result != FmodConstants.FMOD_OK
-                        && result != FmodConstants.FMOD_ERR_INVALID_HANDLE) {
-                    log.warn(
-                            "Error releasing previous sound '{}': error code {}",
-                            existing.get().path(),
-                            result);
-                }
-            }
+            // Only release previous audio now that the new one is open (to ensure we always have
+            // valid audio)
+            existing.ifPresent(audio -> release(audio.sound(), audio.path()));
 
             // Create handle for the new audio using the lifecycle manager
-            FmodAudioHandle newHandle = lifecycleManager.createHandle(newSound, canonicalPath);
+            FmodAudioHandle newHandle = lifecycleManager.createHandle(newSound, pending.path());
 
             // Update current state atomically
-            current = Optional.of(new CurrentAudio(newHandle, newSound, canonicalPath));
+            current =
+                    Optional.of(
+                            new CurrentAudio(
+                                    newHandle, newSound, pending.path(), opened.decoded()));
 
             return newHandle;
 
@@ -100,6 +192,13 @@ class FmodAudioLoadingManager {
         }
     }
 
+    private void release(@NonNull MemorySegment sound, @NonNull String path) {
+        int result = FmodCore.FMOD_Sound_Release(sound);
+        if (result != FmodConstants.FMOD_OK && result != FmodConstants.FMOD_ERR_INVALID_HANDLE) {
+            log.warn("Error releasing sound '{}': error code {}", path, result);
+        }
+    }
+
     /**
      * Get metadata for the currently loaded core.audio. This method acquires the loadingLock for
      * thread-safe operations.
@@ -112,6 +211,10 @@ class FmodAudioLoadingManager {
             return current.map(
                     audio -> {
                         try {
+                            // A raw sound reports the decoded format, not the file's
+                            if (audio.decoded().isPresent()) {
+                                return audio.decoded().get().metadata();
+                            }
                             return extractMetadata(audio.sound());
                         } catch (AudioLoadException e) {
                             log.warn(
@@ -132,6 +235,45 @@ class FmodAudioLoadingManager {
         }
     }
 
+    /**
+     * Wait until the current audio is decoded {@value #PLAYABLE_LEAD_SECONDS} s past {@code
+     * frame}, so playback starting there does not run straight into frames not decoded yet. Gives
+     * up after {@value #PLAYABLE_WAIT_MILLIS} ms, or at once if the decode failed or the thread is
+     * interrupted: playback then goes ahead and plays silence wherever it overtakes the decode.
+     * Returns at once for audio not played from a decoded audio store, which is always whole.
+     *
+     * @param frame Frame playback is about to start from
+     */
+    void awaitPlayable(long frame) {
+        Optional<DecodedAudio> decoded = current.flatMap(CurrentAudio::decoded);
+        if (decoded.isEmpty()) {
+            return;
+        }
+        AudioMetadata metadata = decoded.get().metadata();
+        long lead = Math.round(PLAYABLE_LEAD_SECONDS * metadata.sampleRate());
+        long target = Math.min(metadata.frameCount(), Math.max(0, frame) + lead);
+        try {
+            decoded.get()
+                    .progress()
+                    .whenDecoded(target)
+                    .get(PLAYABLE_WAIT_MILLIS, TimeUnit.MILLISECONDS);
+        } catch (TimeoutException e) {
+            log.debug("Playing frame {} ahead of the decode ({} frames)", frame, target);
+        } catch (ExecutionException e) {
+            log.warn("Playing a partly decoded file: {}", e.getCause().getMessage());
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+        }
+    }
+
+    /**
+     * Stop the decoded audio store's decodes, which run on this manager's system. Must be called
+     * before the system is released.
+     */
+    void close() {
+        decodedAudioStore.ifPresent(FmodDecodedAudioStore::close);
+    }
+
     /**
      * Check if the given handle represents the current core.audio.
      *
@@ -167,17 +309,7 @@ class FmodAudioLoadingManager {
     void releaseAll() {
         loadingLock.lock();
         try {
-            current.ifPresent(
-                    audio -> {
-                        int result = FmodCore.FMOD_Sound_Release(audio.sound());
-                        if (result != FmodConstants.FMOD_OK
-                                && result != FmodConstants.FMOD_ERR_INVALID_HANDLE) {
-                            log.warn(
-                                    "Error releasing sound for '{}': error code {}",
-                                    audio.path(),
-                                    result);
-                        }
-                    });
+            current.ifPresent(audio -> release(audio.sound(), audio.path()));
             // Always clear reference even if release failed to prevent use-after-free
             current = Optional.empty();
             // Clear the lifecycle manager's current handle
@@ -214,7 +346,8 @@ class FmodAudioLoadingManager {
     }
 
     /**
-     * Create an FMOD sound from a file. This method must be called while holding the loadingLock.
+     * Create an FMOD sound from a file. In non-blocking mode this returns once the sound is
+     * playable.
      */
     private MemorySegment createSound(@NonNull String canonicalPath) throws AudioLoadException {
         // Check we're in the right state
@@ -226,8 +359,12 @@ class FmodAudioLoadingManager {
 
         // Set appropriate flags for playback
         int flags = FmodConstants.FMOD_DEFAULT | FmodConstants.FMOD_ACCURATETIME;
+        if (nonBlocking) {
+            flags |= FmodConstants.FMOD_NONBLOCKING;
+        }
 
         // Create the sound
+        MemorySegment sound;
         try (Arena arena = Arena.ofConfined()) {
             MemorySegment soundRef = arena.allocate(ValueLayout.ADDRESS);
             MemorySegment path = arena.allocateFrom(canonicalPath);
@@ -239,11 +376,69 @@ class FmodAudioLoadingManager {
                 throw FmodError.toLoadException(result, canonicalPath);
             }
 
-            MemorySegment sound = soundRef.get(ValueLayout.ADDRESS, 0);
-            if (sound == null) {
+            sound = soundRef.get(ValueLayout.ADDRESS, 0);
+            if (sound == null || sound.equals(MemorySegment.NULL)) {
                 throw new AudioLoadException("FMOD returned null sound for: " + canonicalPath);
             }
+        }
+
+        if (nonBlocking) {
+            try {
+                FmodOpenState.awaitReady(sound, canonicalPath);
+            } catch (AudioLoadException e) {
+                release(sound, canonicalPath);
+                throw e;
+            }
+        }
+        return sound;
+    }
+
+    /**
+     * Create a sample sound that plays decoded PCM in place: {@code FMOD_OPENMEMORY_POINT} with
+     * {@code FMOD_OPENRAW} makes FMOD use the floats directly rather than copy or decode them, so
+     * the sound plays frames the store decodes after it was created.
+     */
+    private MemorySegment createSound(@NonNull DecodedAudio decoded, @NonNull String canonicalPath)
+            throws AudioLoadException {
+        try {
+            stateManager.checkState(FmodSystemStateManager.State.INITIALIZED);
+        } catch (AudioEngineException e) {
+            throw new AudioLoadException("Audio engine not initialized");
+        }
+
+        long bytes = decoded.samples().byteSize();
+        if (bytes > 0xFFFF_FFFFL) {
+            throw new AudioLoadException(
+                    "Audio file too long to play from memory: " + canonicalPath);
+        }
+        AudioMetadata metadata = decoded.metadata();
+        int flags =
+                FmodConstants.FMOD_OPENMEMORY_POINT
+                        | FmodConstants.FMOD_OPENRAW
+                        | FmodConstants.FMOD_CREATESAMPLE
+                        | FmodConstants.FMOD_ACCURATETIME;
+
+        try (Arena arena = Arena.ofConfined()) {
+            // Zero-initialized, so every field not set here keeps its default
+            MemorySegment exinfo = FMOD_CREATESOUNDEXINFO.allocate(arena);
+            FMOD_CREATESOUNDEXINFO.cbsize(exinfo, (int) FMOD_CREATESOUNDEXINFO.sizeof());
+            FMOD_CREATESOUNDEXINFO.length(exinfo, (int) bytes); // unsigned int
+            FMOD_CREATESOUNDEXINFO.numchannels(exinfo, metadata.channelCount());
+            FMOD_CREATESOUNDEXINFO.defaultfrequency(exinfo, metadata.sampleRate());
+            FMOD_CREATESOUNDEXINFO.format(exinfo, FmodConstants.FMOD_SOUND_FORMAT_PCMFLOAT);
+
+            MemorySegment soundRef = arena.allocate(ValueLayout.ADDRESS);
+            int result =
+                    FmodCore.FMOD_System_CreateSound(
+                            system, decoded.samples(), flags, exinfo, soundRef);
+            if (result != FmodConstants.FMOD_OK) {
+                throw FmodError.toLoadException(result, canonicalPath);
+            }
 
+            MemorySegment sound = soundRef.get(ValueLayout.ADDRESS, 0);
+            if (sound == null || sound.equals(MemorySegment.NULL)) {
+                throw new AudioLoadException("FMOD returned null sound for: " + canonicalPath);
+            }
             return sound;
         }
     }
@@ -256,11 +451,11 @@ class FmodAudioLoadingManager {
      */
     private AudioMetadata extractMetadata(@NonNull MemorySegment sound) throws AudioLoadException {
         // Get sound format info
-        try (Arena arena = Arena.ofConfined()) {
-            var typeRef = arena.allocate(ValueLayout.JAVA_INT); // File type (WAV, MP3, etc.)
-            var formatRef = arena.allocate(ValueLayout.JAVA_INT); // Sample format (not used)
-            var channelsRef = arena.allocate(ValueLayout.JAVA_INT); // Number of channels
-            var bitsRef = arena.allocate(ValueLayout.JAVA_INT); // Bits per sample
+        try (FmodScratch scratch = FmodScratch.open()) {
+            var typeRef = scratch.allocate(ValueLayout.JAVA_INT); // File type (WAV, MP3, etc.)
+            var formatRef = scratch.allocate(ValueLayout.JAVA_INT); // Sample format (not used)
+            var channelsRef = scratch.allocate(ValueLayout.JAVA_INT); // Number of channels
+            var bitsRef = scratch.allocate(ValueLayout.JAVA_INT); // Bits per sample
 
             int result =
                     FmodCore.FMOD_Sound_GetFormat(sound, typeRef, formatRef, channelsRef, bitsRef);
@@ -271,7 +466,7 @@ class FmodAudioLoadingManager {
             }
 
             // Get length in milliseconds
-            var lengthMsRef = arena.allocate(ValueLayout.JAVA_INT);
+            var lengthMsRef = scratch.allocate(ValueLayout.JAVA_INT);
             result =
                     FmodCore.FMOD_Sound_GetLength(
                             sound, lengthMsRef, FmodConstants.FMOD_TIMEUNIT_MS);
@@ -282,8 +477,8 @@ class FmodAudioLoadingManager {
             }
 
             // Get the actual sample rate from the sound
-            var frequencyRef = arena.allocate(ValueLayout.JAVA_FLOAT);
-            var priorityRef = arena.allocate(ValueLayout.JAVA_INT); // Not used
+            var frequencyRef = scratch.allocate(ValueLayout.JAVA_FLOAT);
+            var priorityRef = scratch.allocate(ValueLayout.JAVA_INT); // Not used
             result = FmodCore.FMOD_Sound_GetDefaults(sound, frequencyRef, priorityRef);
 
             if (result != FmodConstants.FMOD_OK) {
@@ -292,7 +487,7 @@ class FmodAudioLoadingManager {
             }
 
             // Get total samples for precise duration
-            var lengthSamplesRef = arena.allocate(ValueLayout.JAVA_INT);
+            var lengthSamplesRef = scratch.allocate(ValueLayout.JAVA_INT);
             result =
                     FmodCore.FMOD_Sound_GetLength(
                             sound, lengthSamplesRef, FmodConstants.FMOD_TIMEUNIT_PCM);
@@ -307,7 +502,7 @@ class FmodAudioLoadingManager {
             int sampleRate = Math.round(frequencyRef.get(ValueLayout.JAVA_FLOAT, 0));
 
             // Map sound type to format string
-            String format = mapSoundTypeToFormat(typeRef.get(ValueLayout.JAVA_INT, 0));
+            String format = FmodDecodedAudioStore.formatName(typeRef.get(ValueLayout.JAVA_INT, 0));
 
             // Calculate precise duration from samples
             double durationSeconds = totalSamples / (double) sampleRate;
@@ -321,18 +516,4 @@ class FmodAudioLoadingManager {
                     durationSeconds);
         }
     }
-
-    /** Map FMOD sound type to human-readable format string. */
-    private String mapSoundTypeToFormat(int soundType) {
-        return switch (soundType) {
-            case FmodConstants.FMOD_SOUND_TYPE_WAV -> "WAV";
-            case FmodConstants.FMOD_SOUND_TYPE_AIFF -> "AIFF";
-            case FmodConstants.FMOD_SOUND_TYPE_MPEG -> "MP3";
-            case FmodConstants.FMOD_SOUND_TYPE_OGGVORBIS -> "OGG";
-            case FmodConstants.FMOD_SOUND_TYPE_FLAC -> "FLAC";
-            case FmodConstants.FMOD_SOUND_TYPE_OPUS -> "Opus";
-            case FmodConstants.FMOD_SOUND_TYPE_RAW -> "RAW";
-            default -> "Unknown";
-        };
-    }
 }
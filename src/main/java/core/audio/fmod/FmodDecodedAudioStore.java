@@ -0,0 +1,531 @@
+package core.audio.fmod;
+
+import com.google.errorprone.annotations.ThreadSafe;
+import core.audio.AudioMetadata;
+import core.audio.exceptions.AudioLoadException;
+import core.audio.fmod.panama.FmodCore;
+import core.telemetry.DecodeEvent;
+import core.util.ByteBoundedLruCache;
+import java.io.IOException;
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.Comparator;
+import java.util.List;
+import java.util.PriorityQueue;
+import java.util.Set;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.atomic.AtomicInteger;
+import lombok.NonNull;
+import lombok.extern.slf4j.Slf4j;
+
+/**
+ * Decodes each audio file once into off-heap PCM shared by playback and waveform reads.
+ *
+ * <p>Files are decoded to interleaved native-order floats. {@link FmodSampleReader} serves sample
+ * views straight from that memory, and {@link FmodAudioLoadingManager} plays it in place as a raw
+ * {@code FMOD_OPENMEMORY_POINT} sound, so a file is read and decoded once and held in memory once
+ * however many consumers it has.
+ *
+ * <p>Decoding is progressive. {@link #acquire} opens the file as a stream, reads only its header
+ * and returns at once with the full-length buffer, zero-filled; one of the store's own threads
+ * then decodes the stream front to back into it in blocks of {@value #DECODE_BLOCK_FRAMES}
+ * frames. {@link DecodeProgress} says how far it has got, so playback can start and the waveform
+ * can fill in while the rest of the file is still decoding. The decode runs at the highest
+ * priority of the threads that asked for the file, so a background preload stays in the
+ * background until playback wants the same file.
+ *
+ * <p>Decoded files are kept in an LRU cache bounded by {@value #CACHE_BUDGET_KEY} (megabytes); the
+ * most recently decoded file is always retained. The memory lives in an automatic arena, so a
+ * file evicted while a sound or a sample view still uses it stays valid until the last user drops
+ * it. Concurrent requests for the same file share a single decode.
+ *
+ * <p>The shared store decodes on the playback system. Each {@code FMOD_Sound_ReadData} holds that
+ * system's API lock only for one block, so position, seek and play calls are never held up behind
+ * a long decode. In non-blocking mode ({@code audio.open.nonblocking}) the header is also read on
+ * FMOD's loader thread while the caller polls.
+ */
+@ThreadSafe
+@Slf4j
+class FmodDecodedAudioStore {
+
+    static final String CACHE_BUDGET_KEY = "audio.sample_cache.max_mb";
+    static final int DEFAULT_CACHE_BUDGET_MB = 512;
+
+    // Frames decoded per FMOD_Sound_ReadData call, each of which holds the system's API lock
+    static final int DECODE_BLOCK_FRAMES = 16384;
+
+    /**
+     * One decoded file. Only the first {@link DecodeProgress#framesDecoded} frames of {@code
+     * samples} hold audio yet; the rest are silence until the decode reaches them.
+     *
+     * @param samples Interleaved native-order floats, {@code frameCount * channelCount} of them
+     * @param metadata Properties of the source file: its own bit depth, and its container name
+     *     (e.g. {@code "WAV"}) as the format, as the playback engine reports it; {@link
+     *     FmodSampleReader} substitutes the sample readers' description
+     * @param progress How far the decode into {@code samples} has got
+     */
+    record DecodedAudio(
+            @NonNull MemorySegment samples,
+            @NonNull AudioMetadata metadata,
+            @NonNull DecodeProgress progress) {
+        long sizeBytes() {
+            return samples.byteSize();
+        }
+    }
+
+    /**
+     * How far a file's decode has got. Frames decode in order from the start, and a frame is
+     * written before it is counted, so the first {@link #framesDecoded} frames may be read freely.
+     */
+    @ThreadSafe
+    static final class DecodeProgress {
+
+        private record Waiter(long frame, CompletableFuture<Void> ready) {}
+
+        private final CompletableFuture<Void> done = new CompletableFuture<>();
+        private volatile long framesDecoded = 0;
+        private volatile boolean cancelled = false;
+        private volatile int priority;
+
+        // Whether the decode has ended, and the reads waiting for frames not decoded yet, nearest
+        // first - guarded by this
+        private boolean ended = false;
+        private final PriorityQueue<Waiter> waiters =
+                new PriorityQueue<>(Comparator.comparingLong(Waiter::frame));
+
+        DecodeProgress(int priority) {
+            this.priority = priority;
+        }
+
+        /** Frames decoded so far, from the start of the file. */
+        long framesDecoded() {
+            return framesDecoded;
+        }
+
+        /** Completes when the whole file is decoded, or exceptionally if the decode failed. */
+        CompletableFuture<Void> done() {
+            return done.copy();
+        }
+
+        /**
+         * Completes once the first {@code frame} frames are decoded. If the decode ends first it
+         * completes with the decode: normally if the file just turned out shorter than its header
+         * said, exceptionally if the decode failed or was cancelled.
+         */
+        CompletableFuture<Void> whenDecoded(long frame) {
+            if (frame <= framesDecoded) {
+                return CompletableFuture.completedFuture(null);
+            }
+            synchronized (this) {
+                if (frame <= framesDecoded) {
+                    return CompletableFuture.completedFuture(null);
+                }
+                if (ended) {
+                    return done.copy();
+                }
+                CompletableFuture<Void> ready = new CompletableFuture<>();
+                waiters.add(new Waiter(frame, ready));
+                return ready;
+            }
+        }
+
+        /** Run the rest of the decode at no lower than {@code priority}. */
+        synchronized void raisePriority(int priority) {
+            this.priority = Math.max(this.priority, priority);
+        }
+
+        private int priority() {
+            return priority;
+        }
+
+        private void cancel() {
+            cancelled = true;
+        }
+
+        private boolean isCancelled() {
+            return cancelled;
+        }
+
+        private void advance(long frames) {
+            framesDecoded = frames;
+            List<CompletableFuture<Void>> ready = new ArrayList<>();
+            synchronized (this) {
+                while (!waiters.isEmpty() && waiters.peek().frame() <= frames) {
+                    ready.add(waiters.poll().ready());
+                }
+            }
+            // Outside the lock, as completing runs the readers' continuations
+            ready.forEach(future -> future.complete(null));
+        }
+
+        private void finish() {
+            end().forEach(future -> future.complete(null));
+            done.complete(null);
+        }
+
+        private void fail(@NonNull Throwable cause) {
+            end().forEach(future -> future.completeExceptionally(cause));
+            done.completeExceptionally(cause);
+        }
+
+        /** Mark the decode ended and take every waiter, to be completed outside the lock. */
+        private synchronized List<CompletableFuture<Void>> end() {
+            ended = true;
+            List<CompletableFuture<Void>> pending = new ArrayList<>();
+            while (!waiters.isEmpty()) {
+                pending.add(waiters.poll().ready());
+            }
+            return pending;
+        }
+    }
+
+    /** A file whose header has been read, ready for {@link #decodeRest}. */
+    private record OpenStream(
+            @NonNull Path key, @NonNull MemorySegment sound, @NonNull DecodedAudio decoded) {}
+
+    private final MemorySegment system;
+    private final boolean nonBlocking;
+    private final ByteBoundedLruCache<Path, DecodedAudio> cache;
+    private final ConcurrentHashMap<Path, CompletableFuture<DecodedAudio>> decoding =
+            new ConcurrentHashMap<>();
+    private final Set<DecodeProgress> running = ConcurrentHashMap.newKeySet();
+    private final ExecutorService decodeExecutor = newDecodeExecutor();
+    private volatile boolean closed = false;
+
+    /**
+     * @param system Initialized FMOD system to decode with
+     * @param cacheBudgetBytes Byte budget for decoded files
+     */
+    FmodDecodedAudioStore(@NonNull MemorySegment system, long cacheBudgetBytes) {
+        this(system, cacheBudgetBytes, false);
+    }
+
+    /**
+     * @param system Initialized FMOD system to decode with
+     * @param cacheBudgetBytes Byte budget for decoded files
+     * @param nonBlocking Open files with {@code FMOD_NONBLOCKING} and poll for the header, rather
+     *     than blocking inside {@code FMOD_System_CreateSound}
+     */
+    FmodDecodedAudioStore(
+            @NonNull MemorySegment system, long cacheBudgetBytes, boolean nonBlocking) {
+        this.system = system;
+        this.nonBlocking = nonBlocking;
+        this.cache = new ByteBoundedLruCache<>(cacheBudgetBytes, DecodedAudio::sizeBytes);
+    }
+
+    /**
+     * Get the audio for a file, starting its decode if it is not cached. Returns once the header
+     * has been read; wait on {@link DecodedAudio#progress} for the samples. Blocks while another
+     * thread opens the same file.
+     *
+     * @throws AudioLoadException if the file cannot be opened
+     */
+    DecodedAudio acquire(@NonNull Path audioFile) throws AudioLoadException {
+        Path key = keyFor(audioFile);
+        int priority = Thread.currentThread().getPriority();
+        DecodedAudio cached = cache.get(key);
+        if (cached != null) {
+            cached.progress().raisePriority(priority);
+            return cached;
+        }
+
+        CompletableFuture<DecodedAudio> claim = new CompletableFuture<>();
+        CompletableFuture<DecodedAudio> pending = decoding.putIfAbsent(key, claim);
+        if (pending != null) {
+            try {
+                DecodedAudio decoded = pending.join();
+                decoded.progress().raisePriority(priority);
+                return decoded;
+            } catch (CompletionException e) {
+                if (e.getCause() instanceof AudioLoadException loadException) {
+                    throw loadException;
+                }
+                throw new AudioLoadException("Failed to decode audio file: " + key, e.getCause());
+            }
+        }
+
+        try {
+            // A decode may have started between the cache check and the claim
+            DecodedAudio decoded = cache.get(key);
+            if (decoded == null) {
+                var event = new DecodeEvent();
+                event.start();
+                OpenStream stream = open(key, priority);
+                decoded = stream.decoded();
+                cache.put(key, decoded);
+                start(stream, event);
+            } else {
+                decoded.progress().raisePriority(priority);
+            }
+            claim.complete(decoded);
+            return decoded;
+        } catch (AudioLoadException | RuntimeException | Error e) {
+            claim.completeExceptionally(e);
+            throw e;
+        } finally {
+            decoding.remove(key, claim);
+        }
+    }
+
+    /** Get the audio for a file if it is cached, without starting a decode. */
+    DecodedAudio getIfDecoded(@NonNull Path audioFile) {
+        return cache.get(keyFor(audioFile));
+    }
+
+    /** Drop all cached files. Memory still in use by sounds or views is freed once unused. */
+    void clear() {
+        log.debug("Decoded audio cache final stats: {}", cache);
+        cache.clear();
+    }
+
+    /**
+     * Stop all decodes and drop the cache. Returns once no decode is using the system any more, so
+     * the system may be released afterwards. Frames already decoded stay readable.
+     */
+    void close() {
+        closed = true;
+        decodeExecutor.shutdown();
+        running.forEach(DecodeProgress::cancel);
+        for (DecodeProgress progress : running) {
+            progress.done().exceptionally(e -> null).join();
+        }
+        clear();
+    }
+
+    /** Canonical key, so a file reached through different paths is decoded once. */
+    private static Path keyFor(@NonNull Path audioFile) {
+        try {
+            return audioFile.toRealPath();
+        } catch (IOException e) {
+            // Let the decode report the missing or unreadable file
+            return audioFile.toAbsolutePath().normalize();
+        }
+    }
+
+    private static ExecutorService newDecodeExecutor() {
+        AtomicInteger threadCount = new AtomicInteger();
+        return Executors.newCachedThreadPool(
+                r -> {
+                    Thread t = new Thread(r, "FmodPcmDecode-" + threadCount.incrementAndGet());
+                    t.setDaemon(true);
+                    return t;
+                });
+    }
+
+    /** Open a file as a stream and allocate its buffer, without decoding any samples. */
+    private OpenStream open(@NonNull Path key, int priority) throws AudioLoadException {
+        if (closed) {
+            throw new AudioLoadException("Decoded audio store is closed");
+        }
+        String filePath = key.toString();
+        MemorySegment sound;
+
+        // OPENONLY reads just the header; the samples are pulled with ReadData as they decode
+        int flags =
+                FmodConstants.FMOD_CREATESTREAM
+                        | FmodConstants.FMOD_OPENONLY
+                        | FmodConstants.FMOD_ACCURATETIME;
+        if (nonBlocking) {
+            flags |= FmodConstants.FMOD_NONBLOCKING;
+        }
+        try (Arena arena = Arena.ofConfined()) {
+            var soundRef = arena.allocate(ValueLayout.ADDRESS);
+            var path = arena.allocateFrom(filePath);
+            int result =
+                    FmodCore.FMOD_System_CreateSound(
+                            system, path, flags, MemorySegment.NULL, soundRef);
+            if (result != FmodConstants.FMOD_OK) {
+                throw FmodError.toLoadException(result, filePath);
+            }
+            sound = soundRef.get(ValueLayout.ADDRESS, 0);
+        }
+
+        try {
+            if (nonBlocking) {
+                FmodOpenState.awaitReady(sound, filePath, () -> closed);
+            }
+            return new OpenStream(key, sound, allocate(sound, filePath, priority));
+        } catch (AudioLoadException | RuntimeException e) {
+            FmodCore.FMOD_Sound_Release(sound);
+            throw e;
+        }
+    }
+
+    private static DecodedAudio allocate(
+            @NonNull MemorySegment sound, @NonNull String filePath, int priority)
+            throws AudioLoadException {
+        try (FmodScratch scratch = FmodScratch.open()) {
+            var typeRef = scratch.allocate(ValueLayout.JAVA_INT);
+            var channelsRef = scratch.allocate(ValueLayout.JAVA_INT);
+            var bitsRef = scratch.allocate(ValueLayout.JAVA_INT);
+            int result =
+                    FmodCore.FMOD_Sound_GetFormat(
+                            sound, typeRef, MemorySegment.NULL, channelsRef, bitsRef);
+            check(result, "get sound format", filePath);
+
+            var frequencyRef = scratch.allocate(ValueLayout.JAVA_FLOAT);
+            result = FmodCore.FMOD_Sound_GetDefaults(sound, frequencyRef, MemorySegment.NULL);
+            check(result, "get sample rate", filePath);
+
+            var lengthRef = scratch.allocate(ValueLayout.JAVA_INT);
+            result =
+                    FmodCore.FMOD_Sound_GetLength(
+                            sound, lengthRef, FmodConstants.FMOD_TIMEUNIT_PCM);
+            check(result, "get sound length", filePath);
+
+            int sampleRate = Math.round(frequencyRef.get(ValueLayout.JAVA_FLOAT, 0));
+            int channelCount = channelsRef.get(ValueLayout.JAVA_INT, 0);
+            int bitsPerSample = bitsRef.get(ValueLayout.JAVA_INT, 0);
+            long totalFrames = Integer.toUnsignedLong(lengthRef.get(ValueLayout.JAVA_INT, 0));
+            if (bitsPerSample / 8 <= 0 || channelCount <= 0) {
+                throw new AudioLoadException(
+                        "Unsupported sample layout (" + bitsPerSample + " bit) in: " + filePath);
+            }
+
+            // Zero-filled, so frames not decoded yet play and draw as silence
+            MemorySegment floats =
+                    Arena.ofAuto().allocate(ValueLayout.JAVA_FLOAT, totalFrames * channelCount);
+            AudioMetadata metadata =
+                    new AudioMetadata(
+                            sampleRate,
+                            channelCount,
+                            bitsPerSample,
+                            formatName(typeRef.get(ValueLayout.JAVA_INT, 0)),
+                            totalFrames,
+                            totalFrames / (double) sampleRate);
+            return new DecodedAudio(floats, metadata, new DecodeProgress(priority));
+        }
+    }
+
+    private void start(@NonNull OpenStream stream, @NonNull DecodeEvent event)
+            throws AudioLoadException {
+        DecodeProgress progress = stream.decoded().progress();
+        running.add(progress);
+        try {
+            decodeExecutor.execute(() -> decodeRest(stream, event));
+        } catch (RejectedExecutionException e) {
+            running.remove(progress);
+            FmodCore.FMOD_Sound_Release(stream.sound());
+            cache.remove(stream.key());
+            var closedException = new AudioLoadException("Decoded audio store is closed");
+            progress.fail(closedException);
+            throw closedException;
+        }
+    }
+
+    /** Decode a stream front to back into its buffer, then release it. */
+    private void decodeRest(@NonNull OpenStream stream, @NonNull DecodeEvent event) {
+        DecodedAudio decoded = stream.decoded();
+        DecodeProgress progress = decoded.progress();
+        AudioMetadata meta = decoded.metadata();
+        int bitsPerSample = meta.bitsPerSample();
+        int channelCount = meta.channelCount();
+        int bytesPerFrame = bitsPerSample / 8 * channelCount;
+        int blockBytes = DECODE_BLOCK_FRAMES * bytesPerFrame;
+        String filePath = stream.key().toString();
+        Thread thread = Thread.currentThread();
+
+        long frames = 0;
+        try (Arena arena = Arena.ofConfined()) {
+            MemorySegment buffer = arena.allocate(blockBytes);
+            MemorySegment readRef = arena.allocate(ValueLayout.JAVA_INT);
+            byte[] block = new byte[blockBytes];
+            while (frames < meta.frameCount()) {
+                if (progress.isCancelled()) {
+                    throw new AudioLoadException("Decode cancelled: " + filePath);
+                }
+                thread.setPriority(progress.priority());
+                int bytes =
+                        (int) Math.min(blockBytes, (meta.frameCount() - frames) * bytesPerFrame);
+                int result = FmodCore.FMOD_Sound_ReadData(stream.sound(), buffer, bytes, readRef);
+                // FMOD reports EOF alongside a partial read at the end of the stream
+                if (result != FmodConstants.FMOD_OK && result != FmodConstants.FMOD_ERR_FILE_EOF) {
+                    check(result, "decode audio data", filePath);
+                }
+                int framesRead = readRef.get(ValueLayout.JAVA_INT, 0) / bytesPerFrame;
+                if (framesRead > 0) {
+                    int byteCount = framesRead * bytesPerFrame;
+                    MemorySegment.copy(buffer, ValueLayout.JAVA_BYTE, 0, block, 0, byteCount);
+                    FmodPcmConverter.toFloat(
+                            block,
+                            decoded.samples(),
+                            frames * channelCount,
+                            bitsPerSample,
+                            framesRead * channelCount);
+                    frames += framesRead;
+                    progress.advance(frames);
+                }
+                if (result == FmodConstants.FMOD_ERR_FILE_EOF || framesRead == 0) {
+                    break;
+                }
+            }
+        } catch (AudioLoadException | RuntimeException e) {
+            release(stream);
+            // A later acquire starts afresh rather than getting a half-decoded file
+            synchronized (cache) {
+                if (cache.get(stream.key()) == decoded) {
+                    cache.remove(stream.key());
+                }
+            }
+            if (progress.isCancelled()) {
+                log.debug("Stopped decoding {} after {} frames", filePath, frames);
+            } else {
+                log.warn("Failed to decode {}: {}", filePath, e.getMessage());
+            }
+            progress.fail(e);
+            return;
+        }
+
+        release(stream);
+        event.file = filePath;
+        event.frames = frames;
+        event.finish();
+        log.debug(
+                "Decoded {} ({} frames, {} MB as float)",
+                stream.key().getFileName(),
+                frames,
+                String.format("%.2f", decoded.sizeBytes() / 1_000_000.0));
+        progress.finish();
+    }
+
+    /** Release the stream once its samples are ours; done before the decode counts as ended. */
+    private void release(@NonNull OpenStream stream) {
+        FmodCore.FMOD_Sound_Release(stream.sound());
+        running.remove(stream.decoded().progress());
+    }
+
+    private static void check(int result, String operation, String filePath)
+            throws AudioLoadException {
+        if (result != FmodConstants.FMOD_OK) {
+            throw new AudioLoadException(
+                    "Failed to "
+                            + operation
+                            + " for "
+                            + filePath
+                            + ": "
+                            + FmodError.describe(result));
+        }
+    }
+
+    /** Map FMOD sound type to human-readable format string. */
+    static String formatName(int soundType) {
+        return switch (soundType) {
+            case FmodConstants.FMOD_SOUND_TYPE_WAV -> "WAV";
+            case FmodConstants.FMOD_SOUND_TYPE_AIFF -> "AIFF";
+            case FmodConstants.FMOD_SOUND_TYPE_MPEG -> "MP3";
+            case FmodConstants.FMOD_SOUND_TYPE_OGGVORBIS -> "OGG";
+            case FmodConstants.FMOD_SOUND_TYPE_FLAC -> "FLAC";
+            case FmodConstants.FMOD_SOUND_TYPE_OPUS -> "Opus";
+            case FmodConstants.FMOD_SOUND_TYPE_RAW -> "RAW";
+            default -> "Unknown";
+        };
+    }
+}
@@ -0,0 +1,309 @@
+package core.audio.fmod;
+
+import com.google.errorprone.annotations.ThreadSafe;
+import core.audio.fmod.panama.FMOD_ASYNCREADINFO;
+import core.audio.fmod.panama.FMOD_FILE_ASYNCCANCEL_CALLBACK;
+import core.audio.fmod.panama.FMOD_FILE_ASYNCDONE_FUNC;
+import core.audio.fmod.panama.FMOD_FILE_ASYNCREAD_CALLBACK;
+import core.audio.fmod.panama.FMOD_FILE_CLOSE_CALLBACK;
+import core.audio.fmod.panama.FMOD_FILE_OPEN_CALLBACK;
+import core.audio.fmod.panama.FmodCore_1;
+import java.io.IOException;
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.nio.channels.FileChannel;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.Map;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.PriorityBlockingQueue;
+import java.util.concurrent.ThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.atomic.LongAccumulator;
+import java.util.concurrent.atomic.LongAdder;
+import lombok.NonNull;
+import lombok.extern.slf4j.Slf4j;
+
+/**
+ * File system FMOD reads audio files through, in place of its own blocking reads.
+ *
+ * <p>Each file FMOD opens is memory-mapped once. FMOD's reads are queued and served on dedicated
+ * I/O threads, highest FMOD priority first, by copying from the mapping into FMOD's buffer, so a
+ * slow network share stalls only those threads (in page faults) and never FMOD's mixer or stream
+ * thread. Reads that FMOD cancels before they start are dropped; a cancel for a read already being
+ * copied waits for the copy, as FMOD requires.
+ *
+ * <p>Counts reads, bytes and read latency (request to completion) for diagnostics; see {@link
+ * #stats()}.
+ */
+@ThreadSafe
+@Slf4j
+class FmodFileSystem implements AutoCloseable {
+
+    // Let FMOD choose its read block size (2 KB)
+    private static final int DEFAULT_BLOCK_ALIGN = -1;
+
+    // FMOD's file size and offsets are unsigned 32-bit
+    private static final long MAX_FILE_BYTES = 0xFFFF_FFFFL;
+
+    /**
+     * Read counters since the file system was created.
+     *
+     * @param reads Completed reads
+     * @param bytesRead Bytes delivered to FMOD
+     * @param totalLatencyNanos Sum of request-to-completion times
+     * @param maxLatencyNanos Slowest single read
+     */
+    record Stats(long reads, long bytesRead, long totalLatencyNanos, long maxLatencyNanos) {
+        double meanLatencyMillis() {
+            return reads == 0 ? 0 : totalLatencyNanos / (double) reads / 1_000_000.0;
+        }
+    }
+
+    /** One open file: its mapping and the arena that unmaps it. */
+    private record OpenFile(
+            @NonNull Path path, @NonNull Arena arena, @NonNull MemorySegment data) {}
+
+    /** One queued FMOD read. */
+    private final class AsyncRead implements Runnable, Comparable<AsyncRead> {
+        static final int PENDING = 0;
+        static final int RUNNING = 1;
+        static final int FINISHED = 2;
+
+        final MemorySegment info;
+        final OpenFile file;
+        final int priority;
+        final long sequence;
+        final long requestedAtNanos = System.nanoTime();
+        final AtomicInteger state = new AtomicInteger(PENDING);
+        final CompletableFuture<Void> finished = new CompletableFuture<>();
+
+        AsyncRead(MemorySegment info, OpenFile file, int priority, long sequence) {
+            this.info = info;
+            this.file = file;
+            this.priority = priority;
+            this.sequence = sequence;
+        }
+
+        @Override
+        public void run() {
+            if (!state.compareAndSet(PENDING, RUNNING)) {
+                return; // Cancelled while queued
+            }
+            int result;
+            int bytesRead = 0;
+            try {
+                long offset = Integer.toUnsignedLong(FMOD_ASYNCREADINFO.offset(info));
+                long size = Integer.toUnsignedLong(FMOD_ASYNCREADINFO.sizebytes(info));
+                long available = Math.max(0, file.data().byteSize() - offset);
+                bytesRead = (int) Math.min(size, available);
+                if (bytesRead > 0) {
+                    MemorySegment buffer = FMOD_ASYNCREADINFO.buffer(info).reinterpret(bytesRead);
+                    MemorySegment.copy(file.data(), offset, buffer, 0, bytesRead);
+                }
+                result = bytesRead < size ? FmodConstants.FMOD_ERR_FILE_EOF : FmodConstants.FMOD_OK;
+            } catch (RuntimeException e) {
+                log.warn("Read from {} failed: {}", file.path().getFileName(), e.toString());
+                bytesRead = 0;
+                result = FmodConstants.FMOD_ERR_FILE_BAD;
+            }
+            complete(bytesRead, result);
+        }
+
+        /** Report the read to FMOD; FMOD may free {@link #info} once this returns. */
+        void complete(int bytesRead, int result) {
+            pending.remove(info.address());
+            FMOD_ASYNCREADINFO.bytesread(info, bytesRead);
+            if (result != FmodConstants.FMOD_ERR_FILE_DISKEJECTED) {
+                record(Integer.toUnsignedLong(bytesRead), System.nanoTime() - requestedAtNanos);
+            }
+            try {
+                FMOD_FILE_ASYNCDONE_FUNC.invoke(FMOD_ASYNCREADINFO.done(info), info, result);
+            } finally {
+                state.set(FINISHED);
+                finished.complete(null);
+            }
+        }
+
+        @Override
+        public int compareTo(AsyncRead other) {
+            int byPriority = Integer.compare(other.priority, priority);
+            return byPriority != 0 ? byPriority : Long.compare(sequence, other.sequence);
+        }
+    }
+
+    private final Arena callbackArena = Arena.ofShared();
+    private final MemorySegment openCallback;
+    private final MemorySegment closeCallback;
+    private final MemorySegment asyncReadCallback;
+    private final MemorySegment asyncCancelCallback;
+
+    private final ThreadPoolExecutor executor;
+    private final Map<Long, OpenFile> openFiles = new ConcurrentHashMap<>();
+    private final Map<Long, AsyncRead> pending = new ConcurrentHashMap<>();
+    private final AtomicLong nextHandle = new AtomicLong(1);
+    private final AtomicLong nextSequence = new AtomicLong();
+
+    private final LongAdder reads = new LongAdder();
+    private final LongAdder bytesRead = new LongAdder();
+    private final LongAdder totalLatencyNanos = new LongAdder();
+    private final LongAccumulator maxLatencyNanos = new LongAccumulator(Math::max, 0);
+
+    /**
+     * @param ioThreads Threads serving reads; more lets reads of different files overlap
+     */
+    FmodFileSystem(int ioThreads) {
+        int threads = Math.max(1, ioThreads);
+        AtomicInteger threadCount = new AtomicInteger();
+        this.executor =
+                new ThreadPoolExecutor(
+                        threads,
+                        threads,
+                        0,
+                        TimeUnit.MILLISECONDS,
+                        new PriorityBlockingQueue<>(),
+                        r -> {
+                            Thread t = new Thread(r, "FmodFileIO-" + threadCount.incrementAndGet());
+                            t.setDaemon(true);
+                            return t;
+                        });
+
+        this.openCallback = FMOD_FILE_OPEN_CALLBACK.allocate(this::openFile, callbackArena);
+        this.closeCallback = FMOD_FILE_CLOSE_CALLBACK.allocate(this::closeFile, callbackArena);
+        this.asyncReadCallback =
+                FMOD_FILE_ASYNCREAD_CALLBACK.allocate(this::asyncRead, callbackArena);
+        this.asyncCancelCallback =
+                FMOD_FILE_ASYNCCANCEL_CALLBACK.allocate(this::asyncCancel, callbackArena);
+    }
+
+    /**
+     * Route a system's file access through this file system. Call before the system opens any
+     * sound; the file system must outlive the system.
+     *
+     * @return FMOD result code
+     */
+    int attach(@NonNull MemorySegment system) {
+        return FmodCore_1.FMOD_System_SetFileSystem(
+                system,
+                openCallback,
+                closeCallback,
+                MemorySegment.NULL,
+                MemorySegment.NULL,
+                asyncReadCallback,
+                asyncCancelCallback,
+                DEFAULT_BLOCK_ALIGN);
+    }
+
+    /** Current read counters. */
+    Stats stats() {
+        return new Stats(
+                reads.sum(), bytesRead.sum(), totalLatencyNanos.sum(), maxLatencyNanos.get());
+    }
+
+    /** Stop the I/O threads and free the callbacks. Only once no system is attached any more. */
+    @Override
+    public void close() {
+        executor.shutdownNow();
+        openFiles.values().forEach(file -> file.arena().close());
+        openFiles.clear();
+        callbackArena.close();
+    }
+
+    private int openFile(
+            MemorySegment name,
+            MemorySegment fileSize,
+            MemorySegment handle,
+            MemorySegment userData) {
+        Path path;
+        try {
+            path = Path.of(name.reinterpret(Long.MAX_VALUE).getString(0));
+        } catch (RuntimeException e) {
+            return FmodConstants.FMOD_ERR_FILE_NOTFOUND;
+        }
+
+        Arena arena = Arena.ofShared();
+        try (FileChannel channel = FileChannel.open(path, StandardOpenOption.READ)) {
+            long size = channel.size();
+            if (size > MAX_FILE_BYTES) {
+                log.warn("{} is too large for FMOD ({} bytes)", path.getFileName(), size);
+                arena.close();
+                return FmodConstants.FMOD_ERR_FILE_BAD;
+            }
+            MemorySegment data = channel.map(FileChannel.MapMode.READ_ONLY, 0, size, arena);
+            long id = nextHandle.getAndIncrement();
+            openFiles.put(id, new OpenFile(path, arena, data));
+            fileSize.reinterpret(Integer.BYTES).set(ValueLayout.JAVA_INT, 0, (int) size);
+            handle.reinterpret(ValueLayout.ADDRESS.byteSize())
+                    .set(ValueLayout.ADDRESS, 0, MemorySegment.ofAddress(id));
+            return FmodConstants.FMOD_OK;
+        } catch (IOException | RuntimeException e) {
+            log.debug("FMOD could not open {}: {}", path, e.toString());
+            arena.close();
+            return FmodConstants.FMOD_ERR_FILE_NOTFOUND;
+        }
+    }
+
+    private int closeFile(MemorySegment handle, MemorySegment userData) {
+        OpenFile file = openFiles.remove(handle.address());
+        if (file == null) {
+            return FmodConstants.FMOD_ERR_INVALID_HANDLE;
+        }
+        // FMOD cancels outstanding reads first; drop any it did not before unmapping
+        pending.values().stream()
+                .filter(read -> read.file == file)
+                .forEach(this::cancel);
+        file.arena().close();
+        return FmodConstants.FMOD_OK;
+    }
+
+    private int asyncRead(MemorySegment info, MemorySegment userData) {
+        MemorySegment request = info.reinterpret(FMOD_ASYNCREADINFO.sizeof());
+        OpenFile file = openFiles.get(FMOD_ASYNCREADINFO.handle(request).address());
+        if (file == null) {
+            return FmodConstants.FMOD_ERR_INVALID_HANDLE;
+        }
+        AsyncRead read =
+                new AsyncRead(
+                        request,
+                        file,
+                        FMOD_ASYNCREADINFO.priority(request),
+                        nextSequence.getAndIncrement());
+        pending.put(request.address(), read);
+        try {
+            executor.execute(read);
+        } catch (RuntimeException e) {
+            pending.remove(request.address());
+            return FmodConstants.FMOD_ERR_FILE_BAD;
+        }
+        return FmodConstants.FMOD_OK;
+    }
+
+    private int asyncCancel(MemorySegment info, MemorySegment userData) {
+        AsyncRead read = pending.get(info.address());
+        if (read != null) {
+            cancel(read);
+        }
+        return FmodConstants.FMOD_OK;
+    }
+
+    /** Cancel a queued read, or wait out one already being copied. */
+    private void cancel(@NonNull AsyncRead read) {
+        if (read.state.compareAndSet(AsyncRead.PENDING, AsyncRead.FINISHED)) {
+            executor.remove(read);
+            read.complete(0, FmodConstants.FMOD_ERR_FILE_DISKEJECTED);
+        } else {
+            read.finished.join();
+        }
+    }
+
+    private void record(long bytes, long latencyNanos) {
+        reads.increment();
+        bytesRead.add(bytes);
+        totalLatencyNanos.add(latencyNanos);
+        maxLatencyNanos.accumulate(latencyNanos);
+    }
+}
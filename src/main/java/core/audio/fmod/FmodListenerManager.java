@@ -8,15 +8,16 @@ import core.audio.exceptions.AudioEngineException;
 import core.audio.exceptions.AudioPlaybackException;
 import core.audio.fmod.panama.FmodCore;
 import core.audio.fmod.panama.FmodCore_1;
-import java.lang.foreign.Arena;
 import java.lang.foreign.MemorySegment;
 import java.lang.foreign.ValueLayout;
 import java.util.List;
+import java.util.OptionalLong;
 import java.util.concurrent.CopyOnWriteArrayList;
 import java.util.concurrent.Executors;
 import java.util.concurrent.ScheduledExecutorService;
 import java.util.concurrent.TimeUnit;
 import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicReference;
 import lombok.NonNull;
 import lombok.extern.slf4j.Slf4j;
 
@@ -35,6 +36,14 @@ import lombok.extern.slf4j.Slf4j;
  *
  * <p>Thread Safety: All listener notifications are executed on a dedicated timer thread to avoid
  * blocking audio operations. Listener registration is thread-safe.
+ *
+ * <p>The timer thread is also the single writer of an immutable {@link PositionSnapshot}, derived
+ * from the channel's DSP clock. Position queries read it wait-free, with no lock, native call or
+ * allocation; playback control (seek, pause, resume) replaces it directly, and a poll that raced
+ * with such a change is discarded rather than published. Between seeks, pauses and resumes the
+ * reported position never decreases, though a poll may read behind the previous sample's
+ * extrapolation; a pause or resume snaps it to the channel's own reading, so extrapolation that ran
+ * ahead of a pausing channel does not leave the playhead stuck in front of the audio.
  */
 @ThreadSafe
 @Slf4j
@@ -42,7 +51,87 @@ class FmodListenerManager {
 
     private static final long DEFAULT_PROGRESS_INTERVAL_MS = 15;
 
+    // Polls this many intervals late mean the poller has stalled; stop extrapolating past that
+    private static final int MAX_EXTRAPOLATED_POLLS = 4;
+
+    /**
+     * Playback position as of one DSP clock sample.
+     *
+     * @param handle Playback the sample belongs to
+     * @param baseFrame Absolute frame at {@code dspBaseline} (playback start or the last seek)
+     * @param dspBaseline Channel DSP clock at {@code baseFrame}
+     * @param positionFrames Absolute frame when sampled
+     * @param floorFrames Frame the reported position never falls below: how far readers may
+     *     already have seen the previous sample of the same playback extrapolated
+     * @param sampledAtNanos {@link System#nanoTime()} when sampled
+     * @param paused Whether the channel was paused, so the position is not advancing
+     * @param sourceRate Source sample rate (Hz) the position advances at
+     * @param limitFrame Frame the position never passes (end of range or file)
+     */
+    record PositionSnapshot(
+            @NonNull FmodPlaybackHandle handle,
+            long baseFrame,
+            long dspBaseline,
+            long positionFrames,
+            long floorFrames,
+            long sampledAtNanos,
+            boolean paused,
+            int sourceRate,
+            long limitFrame) {
+
+        /**
+         * Position at {@code nanos}, extrapolated for at most {@code maxNanos} past the sample and
+         * never below {@link #floorFrames}.
+         */
+        long positionAt(long nanos, long maxNanos) {
+            if (paused || sourceRate <= 0) {
+                return Math.max(positionFrames, floorFrames);
+            }
+            long elapsed = Math.clamp(nanos - sampledAtNanos, 0, maxNanos);
+            long advanced = positionFrames + elapsed * sourceRate / 1_000_000_000L;
+            return Math.max(Math.min(advanced, limitFrame), floorFrames);
+        }
+
+        /**
+         * The next sample of the same playback. Extrapolation runs on the wall clock while the DSP
+         * clock advances a mix block at a time, so a sample can read behind what this one has
+         * reached by {@code nanos}; the position holds there until playback catches up rather
+         * than stepping back.
+         */
+        PositionSnapshot withPosition(long frames, long nanos, boolean nowPaused, long maxNanos) {
+            return new PositionSnapshot(
+                    handle,
+                    baseFrame,
+                    dspBaseline,
+                    Math.min(frames, limitFrame),
+                    positionAt(nanos, maxNanos),
+                    nanos,
+                    nowPaused,
+                    sourceRate,
+                    limitFrame);
+        }
+
+        /**
+         * A sample taken from a reading known to be exact (the clock of a channel that has just
+         * paused or resumed), which the position restarts from even if it is behind this one.
+         */
+        PositionSnapshot resetTo(long frames, long nanos, boolean nowPaused) {
+            long position = Math.min(frames, limitFrame);
+            return new PositionSnapshot(
+                    handle,
+                    baseFrame,
+                    dspBaseline,
+                    position,
+                    position,
+                    nanos,
+                    nowPaused,
+                    sourceRate,
+                    limitFrame);
+        }
+    }
+
     private final long progressIntervalMs;
+    private final long maxExtrapolationNanos;
     private final MemorySegment system; // FMOD system pointer
     private ScheduledExecutorService progressTimer;
 
@@ -50,14 +139,11 @@ class FmodListenerManager {
     private volatile FmodPlaybackHandle currentHandle;
     // Total duration in frames for the monitored segment
     private volatile long totalFrames;
-    // Start frame offset for the current segment
-    private volatile long startFrame;
-    // Current position in frames
-    private volatile long currentPositionFrames;
-
-    // DSP clock tracking for accurate position
-    private volatile int sourceRate; // Source sample rate (Hz) of the current channel
-    private volatile long dspStartSamples; // DSP clock baseline at start of monitoring
+    // Whether the timer is running, so the snapshot keeps up with playback
+    private volatile boolean polling;
+
+    // DSP clock tracking for accurate position; null when nothing is monitored
+    private final AtomicReference<PositionSnapshot> snapshot = new AtomicReference<>();
     private final int mixRate; // FMOD software mix rate (samples per second)
 
     // Listener management
@@ -84,6 +170,8 @@ class FmodListenerManager {
             throws AudioEngineException {
         this.system = system;
         this.progressIntervalMs = progressIntervalMs;
+        this.maxExtrapolationNanos =
+                TimeUnit.MILLISECONDS.toNanos(progressIntervalMs * MAX_EXTRAPOLATED_POLLS);
         // Query FMOD software format once for mix rate
         this.mixRate = FmodSystemUtil.getSoftwareMixRate(system);
     }
@@ -133,27 +221,28 @@ class FmodListenerManager {
         // Store the new handle and duration
         this.currentHandle = handle;
         this.totalFrames = totalFrames;
-        this.startFrame = handle.getStartFrame();
-        this.currentPositionFrames = startFrame;
 
         // Get source sample rate from channel
-        this.sourceRate = FmodSystemUtil.getSourceSampleRate(system, handle);
+        int sourceRate = FmodSystemUtil.getSourceSampleRate(system, handle);
 
         // Capture DSP start clock for relative timing
-        try (Arena arena = Arena.ofConfined()) {
-            var dspClockRef = arena.allocate(ValueLayout.JAVA_LONG);
-            var parentClockRef = arena.allocate(ValueLayout.JAVA_LONG);
-            int result =
-                    FmodCore_1.FMOD_Channel_GetDSPClock(
-                            handle.getChannel(), dspClockRef, parentClockRef);
-            this.dspStartSamples =
-                    (result == FmodConstants.FMOD_OK)
-                            ? dspClockRef.get(ValueLayout.JAVA_LONG, 0)
-                            : 0L;
-        }
+        long startFrame = handle.getStartFrame();
+        long limitFrame = Math.min(handle.getEndFrame(), startFrame + totalFrames);
+        snapshot.set(
+                new PositionSnapshot(
+                        handle,
+                        startFrame,
+                        readStartClock(handle).orElse(0L),
+                        startFrame,
+                        startFrame,
+                        System.nanoTime(),
+                        false,
+                        sourceRate,
+                        limitFrame));
 
         // Start progress timer if we have listeners
         if (!listeners.isEmpty()) {
+            polling = true;
             progressTimer =
                     Executors.newSingleThreadScheduledExecutor(
                             r -> {
@@ -176,6 +265,7 @@ class FmodListenerManager {
     void stopMonitoring() {
         // Clear handle first to prevent any further updates
         currentHandle = null;
+        polling = false;
 
         // Shut down the timer before resetting state
         ScheduledExecutorService timer = progressTimer;
@@ -194,9 +284,7 @@ class FmodListenerManager {
 
         // Now reset state after timer is stopped
         totalFrames = 0L;
-        currentPositionFrames = 0L;
-        sourceRate = 0;
-        dspStartSamples = 0L;
+        snapshot.set(null);
     }
 
     /**
@@ -314,9 +402,15 @@ class FmodListenerManager {
             return;
         }
 
+        // The sample this poll builds on; a seek or pause meanwhile replaces it
+        PositionSnapshot observed = snapshot.get();
+        if (observed == null || observed.handle() != handle) {
+            return;
+        }
+
         // Check if channel is still playing (FMOD may have stopped it via SetDelay)
-        try (Arena arena = Arena.ofConfined()) {
-            var isPlayingRef = arena.allocate(ValueLayout.JAVA_INT);
+        try (FmodScratch scratch = FmodScratch.open()) {
+            var isPlayingRef = scratch.allocate(ValueLayout.JAVA_INT);
             int result = FmodCore.FMOD_Channel_IsPlaying(handle.getChannel(), isPlayingRef);
 
             if (result == FmodConstants.FMOD_ERR_INVALID_HANDLE) {
@@ -332,10 +426,24 @@ class FmodListenerManager {
             }
 
             // Check if channel is paused - if so, don't update position
-            var isPausedRef = arena.allocate(ValueLayout.JAVA_INT);
+            var isPausedRef = scratch.allocate(ValueLayout.JAVA_INT);
             result = FmodCore.FMOD_Channel_GetPaused(handle.getChannel(), isPausedRef);
             if (result == FmodConstants.FMOD_OK && isPausedRef.get(ValueLayout.JAVA_INT, 0) == 1) {
-                // Channel is paused, skip position update
+                // Channel is paused; hold the position where the channel stopped
+                if (!observed.paused()) {
+                    OptionalLong dspClock = readDspClock(handle);
+                    long nanos = System.nanoTime();
+                    snapshot.compareAndSet(
+                            observed,
+                            dspClock.isPresent()
+                                    ? observed.resetTo(
+                                            framesAt(observed, dspClock.getAsLong()), nanos, true)
+                                    : observed.withPosition(
+                                            observed.positionFrames(),
+                                            nanos,
+                                            true,
+                                            maxExtrapolationNanos));
+                }
                 return;
             }
         } catch (Exception e) {
@@ -343,9 +451,9 @@ class FmodListenerManager {
         }
 
         // Query current DSP clock position from FMOD
-        try (Arena arena = Arena.ofConfined()) {
-            var dspClockRef = arena.allocate(ValueLayout.JAVA_LONG);
-            var parentClockRef = arena.allocate(ValueLayout.JAVA_LONG);
+        try (FmodScratch scratch = FmodScratch.open()) {
+            var dspClockRef = scratch.allocate(ValueLayout.JAVA_LONG);
+            var parentClockRef = scratch.allocate(ValueLayout.JAVA_LONG);
 
             int result =
                     FmodCore_1.FMOD_Channel_GetDSPClock(
@@ -353,16 +461,8 @@ class FmodListenerManager {
 
             if (result == FmodConstants.FMOD_OK) {
                 // DSP clock gives us the sample-accurate position that's actually playing
-                long currentDspSamples = dspClockRef.get(ValueLayout.JAVA_LONG, 0);
-
-                // Calculate elapsed DSP samples since start
-                long dspDelta = Math.max(0, currentDspSamples - dspStartSamples);
-
-                // Convert DSP samples (at mixRate) to source frames (at sourceRate)
-                long elapsedFrames =
-                        sourceRate > 0 && mixRate > 0 ? (dspDelta * sourceRate) / mixRate : 0;
-                long absoluteFrames = startFrame + elapsedFrames;
-                currentPositionFrames = absoluteFrames;
+                long absoluteFrames =
+                        framesAt(observed, dspClockRef.get(ValueLayout.JAVA_LONG, 0));
 
                 // Check if we've reached or passed the end frame
                 if (handle.getEndFrame() != Long.MAX_VALUE) {
@@ -373,8 +473,19 @@ class FmodListenerManager {
                     }
                 }
 
+                // Publish unless a seek or pause replaced the sample while we polled
+                PositionSnapshot sampled =
+                        observed.withPosition(
+                                absoluteFrames, System.nanoTime(), false, maxExtrapolationNanos);
+                if (!snapshot.compareAndSet(observed, sampled)) {
+                    return;
+                }
+
                 // Notify progress with frame values
-                notifyProgress(handle, currentPositionFrames, totalFrames);
+                notifyProgress(
+                        handle,
+                        sampled.positionAt(sampled.sampledAtNanos(), maxExtrapolationNanos),
+                        totalFrames);
             } else if (result == FmodConstants.FMOD_ERR_INVALID_HANDLE) {
                 // Channel has been released
                 handlePlaybackStopped();
@@ -386,6 +497,51 @@ class FmodListenerManager {
         }
     }
 
+    /** Absolute frame of a DSP clock reading, relative to the snapshot's baseline. */
+    private long framesAt(@NonNull PositionSnapshot base, long dspClock) {
+        // Convert DSP samples (at mixRate) to source frames (at sourceRate)
+        long dspDelta = Math.max(0, dspClock - base.dspBaseline());
+        long elapsedFrames =
+                base.sourceRate() > 0 && mixRate > 0
+                        ? (dspDelta * base.sourceRate()) / mixRate
+                        : 0;
+        return base.baseFrame() + elapsedFrames;
+    }
+
+    private static OptionalLong readDspClock(@NonNull FmodPlaybackHandle handle) {
+        try (FmodScratch scratch = FmodScratch.open()) {
+            var dspClockRef = scratch.allocate(ValueLayout.JAVA_LONG);
+            var parentClockRef = scratch.allocate(ValueLayout.JAVA_LONG);
+            int result =
+                    FmodCore_1.FMOD_Channel_GetDSPClock(
+                            handle.getChannel(), dspClockRef, parentClockRef);
+            return result == FmodConstants.FMOD_OK
+                    ? OptionalLong.of(dspClockRef.get(ValueLayout.JAVA_LONG, 0))
+                    : OptionalLong.empty();
+        }
+    }
+
+    /**
+     * Channel DSP clock at which the handle's first frame plays: now, or the scheduled start still
+     * ahead of the parent clock, so the position holds at the start frame until then.
+     */
+    private static OptionalLong readStartClock(@NonNull FmodPlaybackHandle handle) {
+        try (FmodScratch scratch = FmodScratch.open()) {
+            var dspClockRef = scratch.allocate(ValueLayout.JAVA_LONG);
+            var parentClockRef = scratch.allocate(ValueLayout.JAVA_LONG);
+            int result =
+                    FmodCore_1.FMOD_Channel_GetDSPClock(
+                            handle.getChannel(), dspClockRef, parentClockRef);
+            if (result != FmodConstants.FMOD_OK) {
+                return OptionalLong.empty();
+            }
+            long now = dspClockRef.get(ValueLayout.JAVA_LONG, 0);
+            long parentNow = parentClockRef.get(ValueLayout.JAVA_LONG, 0);
+            long pending = handle.getStartClock() > 0 ? handle.getStartClock() - parentNow : 0;
+            return OptionalLong.of(now + Math.max(0, pending));
+        }
+    }
+
     /** Handle playback stopping - notify and clean up. */
     private void handlePlaybackStopped() {
         FmodPlaybackHandle handle = currentHandle;
@@ -402,8 +558,7 @@ class FmodListenerManager {
                 finalPosition = handle.getStartFrame() + totalFrames;
             }
 
-            // Update internal position and notify listeners
-            currentPositionFrames = finalPosition;
+            // Notify listeners of the final position
             notifyProgress(handle, finalPosition, totalFrames);
 
             handle.markInactive();
@@ -437,33 +592,66 @@ class FmodListenerManager {
         return isShutdown.get();
     }
 
-    /** Get current position in frames. */
+    /** Get current position in frames, or 0 when nothing is monitored. */
     long getCurrentPositionFrames() {
-        // Return cached position from update thread
-        return currentPositionFrames;
+        PositionSnapshot current = snapshot.get();
+        return current == null ? 0L : current.positionAt(System.nanoTime(), maxExtrapolationNanos);
+    }
+
+    /**
+     * Get the position of a playback from the published snapshot, without locking or calling FMOD.
+     *
+     * @return The position in frames, or -1 if the snapshot is not being kept current for this
+     *     playback (it is not monitored, or no progress timer is running)
+     */
+    long getPosition(@NonNull FmodPlaybackHandle handle) {
+        PositionSnapshot current = snapshot.get();
+        if (current == null || current.handle() != handle || !polling) {
+            return -1L;
+        }
+        return current.positionAt(System.nanoTime(), maxExtrapolationNanos);
     }
 
     /** Update position after a seek to a new absolute frame position. */
     void onSeek(@NonNull FmodPlaybackHandle handle, long newFrame) {
-        if (currentHandle != handle) {
+        PositionSnapshot current = snapshot.get();
+        if (currentHandle != handle || current == null || current.handle() != handle) {
             return;
         }
         long clamped = Math.max(handle.getStartFrame(), Math.min(newFrame, handle.getEndFrame()));
-        this.currentPositionFrames = clamped;
-        this.startFrame = clamped; // Update start frame to the seek position
 
-        // Reset DSP clock baseline after seek
-        try (Arena arena = Arena.ofConfined()) {
-            var dspClockRef = arena.allocate(ValueLayout.JAVA_LONG);
-            var parentClockRef = arena.allocate(ValueLayout.JAVA_LONG);
-            int result =
-                    FmodCore_1.FMOD_Channel_GetDSPClock(
-                            handle.getChannel(), dspClockRef, parentClockRef);
-            if (result == FmodConstants.FMOD_OK) {
-                // Capture new DSP baseline at seek position
-                this.dspStartSamples = dspClockRef.get(ValueLayout.JAVA_LONG, 0);
-            }
-        } catch (Exception ignored) {
+        // Rebase the DSP clock at the seek position
+        OptionalLong dspClock = readDspClock(handle);
+        snapshot.set(
+                new PositionSnapshot(
+                        handle,
+                        clamped,
+                        dspClock.orElse(current.dspBaseline()),
+                        clamped,
+                        clamped,
+                        System.nanoTime(),
+                        current.paused(),
+                        current.sourceRate(),
+                        current.limitFrame()));
+    }
+
+    /**
+     * Record a pause or resume at once, so readers neither run past a pause nor hold still after a
+     * resume until the next poll.
+     */
+    void onPausedChanged(@NonNull FmodPlaybackHandle handle, boolean paused) {
+        PositionSnapshot current = snapshot.get();
+        if (currentHandle != handle || current == null || current.handle() != handle) {
+            return;
         }
+        // The channel clock stands still while paused, so the current reading is exact: restart
+        // from it, even behind where extrapolation had got to, rather than holding the floor
+        OptionalLong dspClock = readDspClock(handle);
+        long nanos = System.nanoTime();
+        snapshot.set(
+                dspClock.isPresent()
+                        ? current.resetTo(framesAt(current, dspClock.getAsLong()), nanos, paused)
+                        : current.withPosition(
+                                current.positionFrames(), nanos, paused, maxExtrapolationNanos));
     }
 }
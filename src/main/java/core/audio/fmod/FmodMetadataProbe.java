@@ -0,0 +1,160 @@
+package core.audio.fmod;
+
+import com.google.inject.Inject;
+import core.audio.AudioMetadata;
+import core.audio.AudioMetadataProbe;
+import core.audio.AudioReadException;
+import core.audio.fmod.panama.FmodCore;
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.nio.file.Path;
+import java.util.List;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
+import java.util.concurrent.CopyOnWriteArrayList;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import lombok.NonNull;
+import lombok.extern.slf4j.Slf4j;
+
+/**
+ * FMOD-based metadata probe. Each probe opens the file with {@code FMOD_CREATESTREAM |
+ * FMOD_OPENONLY}, which reads only the header, takes its format and length and releases it.
+ *
+ * <p>Probes run on {@link #PROBE_THREADS} threads, so the latency of a slow (e.g. network) file
+ * system overlaps across files. FMOD serializes calls into one system, so each thread opens files
+ * through an FMOD system of its own, none of them shared with playback; the thread count is kept
+ * low because FMOD allows only eight systems per process. {@code FMOD_ACCURATETIME} is left off:
+ * WAV headers give the exact length, and for other formats it would mean reading the whole file.
+ */
+@Slf4j
+public class FmodMetadataProbe implements AudioMetadataProbe {
+
+    static final int PROBE_THREADS = 3;
+
+    private final FmodLibraryLoader libraryLoader;
+    private final ExecutorService executor;
+    private final List<MemorySegment> systems = new CopyOnWriteArrayList<>();
+    private final ThreadLocal<MemorySegment> threadSystem = new ThreadLocal<>();
+    private volatile boolean closed = false;
+
+    @Inject
+    public FmodMetadataProbe(@NonNull FmodLibraryLoader libraryLoader) {
+        this.libraryLoader = libraryLoader;
+        AtomicInteger threadCount = new AtomicInteger();
+        this.executor =
+                Executors.newFixedThreadPool(
+                        PROBE_THREADS,
+                        r -> {
+                            Thread t =
+                                    new Thread(r, "FmodProbe-" + threadCount.incrementAndGet());
+                            t.setDaemon(true);
+                            return t;
+                        });
+    }
+
+    @Override
+    public CompletableFuture<AudioMetadata> probe(@NonNull Path audioFile) {
+        if (closed) {
+            return CompletableFuture.failedFuture(
+                    new AudioReadException("Probe is closed", audioFile));
+        }
+        return CompletableFuture.supplyAsync(
+                () -> {
+                    try {
+                        return probeNow(audioFile);
+                    } catch (AudioReadException e) {
+                        throw new CompletionException(e);
+                    }
+                },
+                executor);
+    }
+
+    private AudioMetadata probeNow(@NonNull Path audioFile) throws AudioReadException {
+        if (closed) {
+            throw new AudioReadException("Probe is closed", audioFile);
+        }
+        MemorySegment system = system(audioFile);
+        int flags = FmodConstants.FMOD_CREATESTREAM | FmodConstants.FMOD_OPENONLY;
+        MemorySegment sound;
+        try (Arena arena = Arena.ofConfined()) {
+            var soundRef = arena.allocate(ValueLayout.ADDRESS);
+            var path = arena.allocateFrom(audioFile.toAbsolutePath().toString());
+            int result =
+                    FmodCore.FMOD_System_CreateSound(
+                            system, path, flags, MemorySegment.NULL, soundRef);
+            if (result != FmodConstants.FMOD_OK) {
+                throw new AudioReadException(
+                        "Failed to open audio file: " + FmodError.describe(result), audioFile);
+            }
+            sound = soundRef.get(ValueLayout.ADDRESS, 0);
+        }
+        try {
+            return FmodStreamingSampleReader.readMetadata(sound, audioFile);
+        } finally {
+            FmodCore.FMOD_Sound_Release(sound);
+        }
+    }
+
+    /** This probe thread's FMOD system, created on its first probe. */
+    private MemorySegment system(@NonNull Path audioFile) throws AudioReadException {
+        MemorySegment system = threadSystem.get();
+        if (system != null) {
+            return system;
+        }
+        libraryLoader.loadNativeLibrary();
+        try (FmodScratch scratch = FmodScratch.open()) {
+            var systemRef = scratch.allocate(ValueLayout.ADDRESS);
+            int result = FmodCore.FMOD_System_Create(systemRef, FmodConstants.FMOD_VERSION);
+            if (result != FmodConstants.FMOD_OK) {
+                throw new AudioReadException(
+                        "Failed to create FMOD system: " + FmodError.describe(result), audioFile);
+            }
+            system = systemRef.get(ValueLayout.ADDRESS, 0);
+
+            result =
+                    FmodCore.FMOD_System_Init(
+                            system, 1, FmodConstants.FMOD_INIT_NORMAL, MemorySegment.NULL);
+            if (result != FmodConstants.FMOD_OK) {
+                FmodCore.FMOD_System_Release(system);
+                throw new AudioReadException(
+                        "Failed to initialize FMOD system: " + FmodError.describe(result),
+                        audioFile);
+            }
+        }
+        threadSystem.set(system);
+        systems.add(system);
+        log.debug("Created FMOD system for {}", Thread.currentThread().getName());
+        return system;
+    }
+
+    /**
+     * Stop probing and release the FMOD systems. Probes still queued are dropped and never
+     * complete.
+     */
+    @Override
+    public void close() {
+        synchronized (this) {
+            if (closed) {
+                return;
+            }
+            closed = true;
+        }
+        executor.shutdownNow();
+        try {
+            // Release only once no probe is inside FMOD
+            if (!executor.awaitTermination(5, TimeUnit.SECONDS)) {
+                log.warn("Metadata probes still running; leaking their FMOD systems");
+                return;
+            }
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            return;
+        }
+        systems.forEach(FmodCore::FMOD_System_Release);
+        systems.clear();
+    }
+}
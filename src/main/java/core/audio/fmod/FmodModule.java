@@ -3,7 +3,9 @@ package core.audio.fmod;
 import com.google.inject.AbstractModule;
 import com.google.inject.Provides;
 import com.google.inject.Singleton;
+import core.env.AppConfig;
 import java.lang.foreign.MemorySegment;
+import java.util.Optional;
 import lombok.NonNull;
 
 /**
@@ -34,14 +36,36 @@ public class FmodModule extends AbstractModule {
     FmodAudioLoadingManager provideFmodAudioLoadingManager(
             @NonNull MemorySegment fmodSystemPointer,
             @NonNull FmodSystemStateManager stateManager,
-            @NonNull FmodHandleLifecycleManager lifecycleManager) {
-        return new FmodAudioLoadingManager(fmodSystemPointer, stateManager, lifecycleManager);
+            @NonNull FmodHandleLifecycleManager lifecycleManager,
+            @NonNull FmodProperties properties,
+            @NonNull FmodDecodedAudioStore decodedAudioStore) {
+        return new FmodAudioLoadingManager(
+                fmodSystemPointer,
+                stateManager,
+                lifecycleManager,
+                properties.nonBlockingOpen(),
+                properties.sharedDecode() ? Optional.of(decodedAudioStore) : Optional.empty());
     }
 
     @Provides
     @Singleton
-    FmodPlaybackManager provideFmodPlaybackManager(@NonNull MemorySegment fmodSystemPointer) {
-        return new FmodPlaybackManager(fmodSystemPointer);
+    FmodDecodedAudioStore provideFmodDecodedAudioStore(
+            @NonNull MemorySegment fmodSystemPointer,
+            @NonNull AppConfig config,
+            @NonNull FmodProperties properties) {
+        long budgetMb =
+                config.getIntProperty(
+                        FmodDecodedAudioStore.CACHE_BUDGET_KEY,
+                        FmodDecodedAudioStore.DEFAULT_CACHE_BUDGET_MB);
+        return new FmodDecodedAudioStore(
+                fmodSystemPointer, budgetMb * 1024 * 1024, properties.nonBlockingOpen());
+    }
+
+    @Provides
+    @Singleton
+    FmodPlaybackManager provideFmodPlaybackManager(
+            @NonNull MemorySegment fmodSystemPointer, @NonNull FmodProperties properties) {
+        return new FmodPlaybackManager(fmodSystemPointer, properties.prewarmReplay());
     }
 
     @Provides
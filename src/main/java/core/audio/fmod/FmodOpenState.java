@@ -0,0 +1,86 @@
+package core.audio.fmod;
+
+import core.audio.exceptions.AudioLoadException;
+import core.audio.fmod.panama.FmodCore;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.util.concurrent.TimeUnit;
+import java.util.function.BooleanSupplier;
+import lombok.NonNull;
+
+/** Waiting on sounds created with {@code FMOD_NONBLOCKING}. */
+final class FmodOpenState {
+
+    private static final long OPEN_POLL_MILLIS = 2;
+
+    // An open showing no sign of progress for this long is taken to have hung
+    static final long STALL_TIMEOUT_NANOS = TimeUnit.SECONDS.toNanos(30);
+
+    private FmodOpenState() {}
+
+    /** {@link #awaitReady(MemorySegment, String, BooleanSupplier)} cancelled only by interrupt. */
+    static void awaitReady(@NonNull MemorySegment sound, @NonNull String path)
+            throws AudioLoadException {
+        awaitReady(sound, path, () -> false);
+    }
+
+    /**
+     * Poll a non-blocking sound until it is ready or its open fails. The open runs on FMOD's
+     * loader thread, so the system stays free for other calls meanwhile. There is no overall
+     * deadline, so a slow (e.g. network) file system may take as long as it needs; the wait is
+     * abandoned only once the open stops making progress for {@link #STALL_TIMEOUT_NANOS}, when
+     * the thread is interrupted, or when {@code cancelled} turns true. The caller still owns the
+     * sound when this throws.
+     */
+    static void awaitReady(
+            @NonNull MemorySegment sound, @NonNull String path, @NonNull BooleanSupplier cancelled)
+            throws AudioLoadException {
+        long lastProgress = System.nanoTime();
+        int lastState = -1;
+        int lastPercent = -1;
+        try (FmodScratch scratch = FmodScratch.open()) {
+            MemorySegment stateRef = scratch.allocate(ValueLayout.JAVA_INT);
+            MemorySegment percentRef = scratch.allocate(ValueLayout.JAVA_INT);
+            MemorySegment starvingRef = scratch.allocate(ValueLayout.JAVA_INT);
+            MemorySegment diskBusyRef = scratch.allocate(ValueLayout.JAVA_INT);
+            while (true) {
+                int result =
+                        FmodCore.FMOD_Sound_GetOpenState(
+                                sound, stateRef, percentRef, starvingRef, diskBusyRef);
+                int state = stateRef.get(ValueLayout.JAVA_INT, 0);
+                // A failed open reports its error through the return code
+                if (result != FmodConstants.FMOD_OK) {
+                    throw FmodError.toLoadException(result, path);
+                }
+                if (state == FmodConstants.FMOD_OPENSTATE_ERROR) {
+                    throw new AudioLoadException("Failed to open audio file: " + path);
+                }
+                if (state == FmodConstants.FMOD_OPENSTATE_READY
+                        || state == FmodConstants.FMOD_OPENSTATE_PLAYING) {
+                    return;
+                }
+
+                // A state change, more buffered or the disk being read all count as progress
+                int percent = percentRef.get(ValueLayout.JAVA_INT, 0);
+                boolean diskBusy = diskBusyRef.get(ValueLayout.JAVA_INT, 0) != 0;
+                long now = System.nanoTime();
+                if (state != lastState || percent != lastPercent || diskBusy) {
+                    lastProgress = now;
+                    lastState = state;
+                    lastPercent = percent;
+                } else if (now - lastProgress > STALL_TIMEOUT_NANOS) {
+                    throw new AudioLoadException("Opening audio file stalled: " + path);
+                }
+                if (cancelled.getAsBoolean()) {
+                    throw new AudioLoadException("Cancelled opening audio file: " + path);
+                }
+                try {
+                    Thread.sleep(OPEN_POLL_MILLIS);
+                } catch (InterruptedException e) {
+                    Thread.currentThread().interrupt();
+                    throw new AudioLoadException("Interrupted opening audio file: " + path);
+                }
+            }
+        }
+    }
+}
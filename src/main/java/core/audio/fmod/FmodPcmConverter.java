@@ -0,0 +1,59 @@
+package core.audio.fmod;
+
+import core.util.simd.SampleKernels;
+import java.lang.foreign.MemorySegment;
+
+/**
+ * Converts interleaved little-endian PCM bytes, as returned by FMOD, to normalized doubles or
+ * floats. The loops themselves are {@link SampleKernels}, vectorized where supported.
+ */
+final class FmodPcmConverter {
+
+    private FmodPcmConverter() {}
+
+    /**
+     * Convert {@code numSamples} samples from {@code buffer} into {@code samples}.
+     *
+     * @param buffer Raw PCM bytes (little-endian, interleaved)
+     * @param samples Destination array, at least {@code numSamples} long
+     * @param bitsPerSample 16, 24 or 32
+     * @param numSamples Number of samples (not frames) to convert
+     */
+    static void toDouble(byte[] buffer, double[] samples, int bitsPerSample, int numSamples) {
+        toDouble(buffer, 0, samples, 0, bitsPerSample, numSamples);
+    }
+
+    /**
+     * Convert {@code numSamples} samples starting at {@code byteOffset} in {@code buffer} into
+     * {@code samples} starting at {@code sampleOffset}.
+     */
+    static void toDouble(
+            byte[] buffer,
+            int byteOffset,
+            double[] samples,
+            int sampleOffset,
+            int bitsPerSample,
+            int numSamples) {
+        SampleKernels.pcmToDouble(
+                buffer, byteOffset, samples, sampleOffset, bitsPerSample, numSamples);
+    }
+
+    /**
+     * Convert {@code numSamples} samples from {@code buffer} into a segment of {@code float}s. 16-
+     * and 24-bit samples are represented exactly; 32-bit samples are rounded to float precision.
+     *
+     * @param dst Destination segment, at least {@code numSamples * Float.BYTES} long
+     */
+    static void toFloat(byte[] buffer, MemorySegment dst, int bitsPerSample, int numSamples) {
+        toFloat(buffer, dst, 0, bitsPerSample, numSamples);
+    }
+
+    /**
+     * Convert {@code numSamples} samples from the start of {@code buffer} into a segment of {@code
+     * float}s starting at float index {@code dstIndex}.
+     */
+    static void toFloat(
+            byte[] buffer, MemorySegment dst, long dstIndex, int bitsPerSample, int numSamples) {
+        SampleKernels.pcmToFloat(buffer, 0, dst, dstIndex, bitsPerSample, numSamples);
+    }
+}
@@ -18,6 +18,9 @@ class FmodPlaybackHandle implements PlaybackHandle {
     @Getter private final long startFrame;
     @Getter private final long endFrame;
 
+    // Parent DSP clock the first frame plays at, or 0 if it plays as soon as unpaused
+    @Getter private final long startClock;
+
     private final MemorySegment channel;
     private final AtomicBoolean active;
 
@@ -26,11 +29,21 @@ class FmodPlaybackHandle implements PlaybackHandle {
             @NonNull MemorySegment channel,
             long startFrame,
             long endFrame) {
+        this(audioHandle, channel, startFrame, endFrame, 0);
+    }
+
+    FmodPlaybackHandle(
+            @NonNull AudioHandle audioHandle,
+            @NonNull MemorySegment channel,
+            long startFrame,
+            long endFrame,
+            long startClock) {
         this.id = ID_GENERATOR.incrementAndGet();
         this.audioHandle = audioHandle;
         this.channel = channel;
         this.startFrame = startFrame;
         this.endFrame = endFrame;
+        this.startClock = startClock;
         this.active = new AtomicBoolean(true);
     }
 
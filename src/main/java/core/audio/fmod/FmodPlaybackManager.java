@@ -5,7 +5,6 @@ import core.audio.AudioHandle;
 import core.audio.exceptions.AudioPlaybackException;
 import core.audio.fmod.panama.FmodCore;
 import core.audio.fmod.panama.FmodCore_1;
-import java.lang.foreign.Arena;
 import java.lang.foreign.MemorySegment;
 import java.lang.foreign.ValueLayout;
 import java.util.Optional;
@@ -23,6 +22,11 @@ import lombok.extern.slf4j.Slf4j;
 class FmodPlaybackManager {
 
     private final MemorySegment system;
+    private final boolean prewarm;
+
+    // Software mix rate, and the samples FMOD mixes at a time; both fixed once it is initialized
+    private final int mixRate;
+    private final long mixBlockLength;
 
     private final ReentrantLock playbackLock = new ReentrantLock();
 
@@ -30,8 +34,27 @@ class FmodPlaybackManager {
     private Optional<FmodPlaybackHandle> currentPlayback = Optional.empty();
     private Optional<MemorySegment> currentChannel = Optional.empty();
 
+    // A paused channel on warmSound at warmFrame, ready for the next range playback
+    private Optional<MemorySegment> warmChannel = Optional.empty();
+    private MemorySegment warmSound = MemorySegment.NULL;
+    private long warmFrame;
+
+    // Set by shutdown, after which no channel is pre-warmed - guarded by playbackLock
+    private boolean shutDown = false;
+
     FmodPlaybackManager(@NonNull MemorySegment system) {
+        this(system, true);
+    }
+
+    /**
+     * @param system The initialized FMOD system pointer
+     * @param prewarm Whether to keep a paused channel ready for the next range playback
+     */
+    FmodPlaybackManager(@NonNull MemorySegment system, boolean prewarm) {
         this.system = system;
+        this.prewarm = prewarm;
+        this.mixRate = FmodSystemUtil.getSoftwareMixRate(system);
+        this.mixBlockLength = FmodSystemUtil.getDspBufferLength(system);
     }
 
     /**
@@ -52,8 +75,8 @@ class FmodPlaybackManager {
             }
 
             // Play the sound - start paused so we can get the channel handle first
-            try (Arena arena = Arena.ofConfined()) {
-                var channelRef = arena.allocate(ValueLayout.ADDRESS);
+            try (FmodScratch scratch = FmodScratch.open()) {
+                var channelRef = scratch.allocate(ValueLayout.ADDRESS);
                 int result =
                         FmodCore.FMOD_System_PlaySound(
                                 system, sound, MemorySegment.NULL, 1, channelRef);
@@ -90,6 +113,11 @@ class FmodPlaybackManager {
      * Starts playback of a specific range within the core.audio. This method acquires the
      * playbackLock internally.
      *
+     * <p>The range is scheduled on the DSP clock while its channel is still paused: it starts on
+     * the next mix block and FMOD stops it after exactly its frames, so neither boundary depends
+     * on when this thread or the progress poller runs. When pre-warming, the channel comes ready
+     * from the previous call and another is readied for the next.
+     *
      * @param sound The FMOD sound pointer to play (may be preloaded or streaming)
      * @param audioHandle The audio handle for metadata
      * @param startFrame The starting frame (inclusive)
@@ -112,91 +140,184 @@ class FmodPlaybackManager {
                 cleanupCurrentPlayback();
             }
 
-            // Play the sound - start paused so we can set position first
-            try (Arena arena = Arena.ofConfined()) {
-                var channelRef = arena.allocate(ValueLayout.ADDRESS);
-                int result =
-                        FmodCore.FMOD_System_PlaySound(
-                                system, sound, MemorySegment.NULL, 1, channelRef);
+            long position = needsPositioning ? startFrame : 0;
+            MemorySegment channel =
+                    takeWarmChannel(sound, position).orElseGet(() -> openChannel(sound, position));
 
-                if (result != FmodConstants.FMOD_OK) {
-                    throw FmodError.toPlaybackException(result, "play sound");
-                }
+            long startClock = scheduleRange(channel, startFrame, endFrame);
 
-                MemorySegment channel = channelRef.get(ValueLayout.ADDRESS, 0);
+            // Now unpause; the channel starts playing at startClock
+            int result = FmodCore.FMOD_Channel_SetPaused(channel, 0);
+            if (result != FmodConstants.FMOD_OK) {
+                FmodCore.FMOD_Channel_Stop(channel);
+                throw FmodError.toPlaybackException(result, "start playback");
+            }
 
-                // Set position if needed (for streaming sounds)
-                if (needsPositioning && startFrame > 0) {
-                    result =
-                            FmodCore.FMOD_Channel_SetPosition(
-                                    channel, (int) startFrame, FmodConstants.FMOD_TIMEUNIT_PCM);
-                    if (result != FmodConstants.FMOD_OK) {
-                        FmodCore.FMOD_Channel_Stop(channel);
-                        throw FmodError.toPlaybackException(result, "set position");
-                    }
-                }
+            // Create and track playback handle
+            FmodPlaybackHandle playbackHandle =
+                    new FmodPlaybackHandle(audioHandle, channel, startFrame, endFrame, startClock);
 
-                // Now unpause to start playback
-                result = FmodCore.FMOD_Channel_SetPaused(channel, 0);
-                if (result != FmodConstants.FMOD_OK) {
-                    FmodCore.FMOD_Channel_Stop(channel);
-                    throw FmodError.toPlaybackException(result, "start playback");
-                }
+            currentPlayback = Optional.of(playbackHandle);
+            currentChannel = Optional.of(channel);
 
-                // Create and track playback handle
-                FmodPlaybackHandle playbackHandle =
-                        new FmodPlaybackHandle(audioHandle, channel, startFrame, endFrame);
+            // Replays repeat the same range more often than not
+            prewarm(sound, position);
 
-                currentPlayback = Optional.of(playbackHandle);
-                currentChannel = Optional.of(channel);
+            return playbackHandle;
+        } finally {
+            playbackLock.unlock();
+        }
+    }
 
-                // Schedule an automatic stop at the end frame using DSP clock delay for
-                // frame-accurate range termination.
-                try {
-                    // Get current DSP clock
-                    var dspClockRef = arena.allocate(ValueLayout.JAVA_LONG);
-                    var parentClockRef = arena.allocate(ValueLayout.JAVA_LONG);
-                    int res =
-                            FmodCore_1.FMOD_Channel_GetDSPClock(
-                                    channel, dspClockRef, parentClockRef);
-                    if (res != FmodConstants.FMOD_OK) {
-                        throw FmodError.toPlaybackException(
-                                res, "get DSP clock for delay scheduling");
-                    }
-                    long parentNow = parentClockRef.get(ValueLayout.JAVA_LONG, 0);
-
-                    // Get channel frequency (source rate under resampling)
-                    var freqRef = arena.allocate(ValueLayout.JAVA_FLOAT);
-                    res = FmodCore.FMOD_Channel_GetFrequency(channel, freqRef);
-                    if (res != FmodConstants.FMOD_OK) {
-                        throw FmodError.toPlaybackException(
-                                res, "get channel frequency for delay scheduling");
-                    }
-                    float chanHz = freqRef.get(ValueLayout.JAVA_FLOAT, 0);
-                    if (chanHz <= 0) {
-                        throw new AudioPlaybackException("Invalid channel frequency: " + chanHz);
-                    }
+    /**
+     * Readies a paused channel on the sound at the given frame, so the next range playback from
+     * there skips creating and positioning one. Does nothing unless pre-warming is enabled. This
+     * method acquires the playbackLock internally.
+     *
+     * @param sound The FMOD sound pointer the next range will play
+     * @param frame The frame to position the channel at
+     */
+    void prewarm(@NonNull MemorySegment sound, long frame) {
+        if (!prewarm) {
+            return;
+        }
+        playbackLock.lock();
+        try {
+            if (shutDown) {
+                return;
+            }
+            if (warmChannel.isPresent() && warmSound.equals(sound) && warmFrame == frame) {
+                return;
+            }
+            discardWarmChannel();
+            try {
+                warmChannel = Optional.of(openChannel(sound, frame));
+                warmSound = sound;
+                warmFrame = frame;
+            } catch (AudioPlaybackException e) {
+                log.debug("Could not pre-warm a channel for range playback", e);
+            }
+        } finally {
+            playbackLock.unlock();
+        }
+    }
 
-                    // Get software mix rate
-                    int mixRate = FmodSystemUtil.getSoftwareMixRate(system);
+    /**
+     * Takes the warm channel for the sound, positioned at the frame, if it is still valid. FMOD
+     * stops a sound's channels when the sound is released, which shows here as a failed call.
+     * REQUIRES: Caller must hold the playbackLock.
+     */
+    private Optional<MemorySegment> takeWarmChannel(@NonNull MemorySegment sound, long frame) {
+        if (warmChannel.isEmpty() || !warmSound.equals(sound)) {
+            discardWarmChannel();
+            return Optional.empty();
+        }
+        MemorySegment channel = warmChannel.get();
+        long preparedFrame = warmFrame;
+        warmChannel = Optional.empty();
+        warmSound = MemorySegment.NULL;
+        try (FmodScratch scratch = FmodScratch.open()) {
+            int result;
+            if (preparedFrame == frame) {
+                // Already in place; just check FMOD has not dropped it
+                result =
+                        FmodCore.FMOD_Channel_GetPaused(
+                                channel, scratch.allocate(ValueLayout.JAVA_INT));
+            } else {
+                result =
+                        FmodCore.FMOD_Channel_SetPosition(
+                                channel, (int) frame, FmodConstants.FMOD_TIMEUNIT_PCM);
+            }
+            if (result != FmodConstants.FMOD_OK) {
+                FmodCore.FMOD_Channel_Stop(channel);
+                return Optional.empty();
+            }
+        }
+        return Optional.of(channel);
+    }
 
-                    // Convert frame range to seconds, then to mix-rate samples
-                    long frames = Math.max(0, endFrame - startFrame);
-                    double durSec = frames / chanHz;
-                    long endParent = parentNow + (long) (durSec * mixRate);
+    /** Stops the warm channel, if any. REQUIRES: Caller must hold the playbackLock. */
+    private void discardWarmChannel() {
+        warmChannel.ifPresent(FmodCore::FMOD_Channel_Stop);
+        warmChannel = Optional.empty();
+        warmSound = MemorySegment.NULL;
+    }
 
-                    // Set start and end delay in parent clock; stopchannels=1 to force stop
-                    FmodCore_1.FMOD_Channel_SetDelay(channel, parentNow, endParent, 1);
-                } catch (Throwable t) {
-                    // Non-fatal: if scheduling fails, playback will continue; higher layers may
-                    // stop it
-                    log.debug("Failed to schedule end delay for range playback", t);
+    /**
+     * Plays the sound on a new channel, paused and positioned at the frame.
+     *
+     * @throws AudioPlaybackException if the channel cannot be created or positioned
+     */
+    private MemorySegment openChannel(@NonNull MemorySegment sound, long frame) {
+        try (FmodScratch scratch = FmodScratch.open()) {
+            var channelRef = scratch.allocate(ValueLayout.ADDRESS);
+            int result =
+                    FmodCore.FMOD_System_PlaySound(
+                            system, sound, MemorySegment.NULL, 1, channelRef);
+            if (result != FmodConstants.FMOD_OK) {
+                throw FmodError.toPlaybackException(result, "play sound");
+            }
+
+            MemorySegment channel = channelRef.get(ValueLayout.ADDRESS, 0);
+            if (frame > 0) {
+                result =
+                        FmodCore.FMOD_Channel_SetPosition(
+                                channel, (int) frame, FmodConstants.FMOD_TIMEUNIT_PCM);
+                if (result != FmodConstants.FMOD_OK) {
+                    FmodCore.FMOD_Channel_Stop(channel);
+                    throw FmodError.toPlaybackException(result, "set position");
                 }
+            }
+            return channel;
+        }
+    }
 
-                return playbackHandle;
+    /**
+     * Schedules a paused channel to start one mix block from now and to stop after the range's
+     * frames, both on its parent DSP clock.
+     *
+     * @return The parent clock the first frame plays at, or 0 if scheduling failed and the channel
+     *     plays as soon as it is unpaused, until something stops it
+     */
+    private long scheduleRange(@NonNull MemorySegment channel, long startFrame, long endFrame) {
+        try (FmodScratch scratch = FmodScratch.open()) {
+            // Get current DSP clock
+            var dspClockRef = scratch.allocate(ValueLayout.JAVA_LONG);
+            var parentClockRef = scratch.allocate(ValueLayout.JAVA_LONG);
+            int res = FmodCore_1.FMOD_Channel_GetDSPClock(channel, dspClockRef, parentClockRef);
+            if (res != FmodConstants.FMOD_OK) {
+                throw FmodError.toPlaybackException(res, "get DSP clock for delay scheduling");
             }
-        } finally {
-            playbackLock.unlock();
+            long parentNow = parentClockRef.get(ValueLayout.JAVA_LONG, 0);
+
+            // Get channel frequency (source rate under resampling)
+            var freqRef = scratch.allocate(ValueLayout.JAVA_FLOAT);
+            res = FmodCore.FMOD_Channel_GetFrequency(channel, freqRef);
+            if (res != FmodConstants.FMOD_OK) {
+                throw FmodError.toPlaybackException(
+                        res, "get channel frequency for delay scheduling");
+            }
+            float chanHz = freqRef.get(ValueLayout.JAVA_FLOAT, 0);
+            if (chanHz <= 0) {
+                throw new AudioPlaybackException("Invalid channel frequency: " + chanHz);
+            }
+
+            // Convert the frame range to mix-rate samples. The block being mixed now may
+            // already be partly out, so start on the next one
+            long frames = Math.max(0, endFrame - startFrame);
+            long startParent = parentNow + mixBlockLength;
+            long endParent = startParent + Math.round(frames * (double) mixRate / chanHz);
+
+            // stopchannels=1 so FMOD stops the channel, not just silences it, at the end
+            res = FmodCore_1.FMOD_Channel_SetDelay(channel, startParent, endParent, 1);
+            if (res != FmodConstants.FMOD_OK) {
+                throw FmodError.toPlaybackException(res, "set delay for range playback");
+            }
+            return startParent;
+        } catch (AudioPlaybackException e) {
+            // Non-fatal: playback starts unscheduled; higher layers may stop it
+            log.debug("Failed to schedule DSP clock boundaries for range playback", e);
+            return 0;
         }
     }
 
@@ -259,18 +380,41 @@ class FmodPlaybackManager {
     }
 
     /**
-     * Stops the current playback if any. This method acquires the playbackLock internally.
+     * Stops the current playback if any, and the pre-warmed channel. This method acquires the
+     * playbackLock internally.
      *
      * @throws AudioPlaybackException if the playback cannot be stopped
      */
     void stop() throws AudioPlaybackException {
+        releaseAll();
+    }
+
+    /**
+     * Stops and forgets every channel this manager holds: the current playback and the pre-warmed
+     * channel. Call before the sounds they play are released. This method acquires the
+     * playbackLock internally.
+     */
+    void releaseAll() {
         playbackLock.lock();
         try {
-            if (!currentChannel.isPresent()) {
-                return; // Nothing to stop
+            discardWarmChannel();
+            if (currentChannel.isPresent()) {
+                cleanupCurrentPlayback();
             }
+        } finally {
+            playbackLock.unlock();
+        }
+    }
 
-            cleanupCurrentPlayback();
+    /**
+     * Releases every channel as {@link #releaseAll} does and stops pre-warming, before the system
+     * is shut down. This method acquires the playbackLock internally.
+     */
+    void shutdown() {
+        playbackLock.lock();
+        try {
+            shutDown = true;
+            releaseAll();
         } finally {
             playbackLock.unlock();
         }
@@ -329,8 +473,8 @@ class FmodPlaybackManager {
                 return 0;
             }
 
-            try (Arena arena = Arena.ofConfined()) {
-                var positionRef = arena.allocate(ValueLayout.JAVA_INT);
+            try (FmodScratch scratch = FmodScratch.open()) {
+                var positionRef = scratch.allocate(ValueLayout.JAVA_INT);
                 int result =
                         FmodCore.FMOD_Channel_GetPosition(
                                 currentChannel.get(), positionRef, FmodConstants.FMOD_TIMEUNIT_PCM);
@@ -366,8 +510,8 @@ class FmodPlaybackManager {
             }
 
             // Check if channel is still playing
-            try (Arena arena = Arena.ofConfined()) {
-                var isPlayingRef = arena.allocate(ValueLayout.JAVA_INT);
+            try (FmodScratch scratch = FmodScratch.open()) {
+                var isPlayingRef = scratch.allocate(ValueLayout.JAVA_INT);
                 int result = FmodCore.FMOD_Channel_IsPlaying(currentChannel.get(), isPlayingRef);
 
                 // FMOD_ERR_INVALID_HANDLE means channel already stopped
@@ -413,8 +557,8 @@ class FmodPlaybackManager {
             }
 
             // Check if the channel is actually playing or paused
-            try (Arena arena = Arena.ofConfined()) {
-                var isPlayingRef = arena.allocate(ValueLayout.JAVA_INT);
+            try (FmodScratch scratch = FmodScratch.open()) {
+                var isPlayingRef = scratch.allocate(ValueLayout.JAVA_INT);
                 int result = FmodCore_1.FMOD_Channel_IsPlaying(currentChannel.get(), isPlayingRef);
 
                 if (result != FmodConstants.FMOD_OK) {
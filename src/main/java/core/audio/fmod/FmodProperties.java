@@ -10,18 +10,41 @@ public class FmodProperties {
     private static final String KEY_LIBRARY_PATH_MACOS = "audio.library.path.macos";
     private static final String KEY_LIBRARY_PATH_WINDOWS = "audio.library.path.windows";
     private static final String KEY_LIBRARY_PATH_LINUX = "audio.library.path.linux";
+    private static final String KEY_NONBLOCKING_OPEN = "audio.open.nonblocking";
+    private static final String KEY_SHARED_DECODE = "audio.decode.shared";
+    private static final String KEY_MAPPED_FILE_SYSTEM = "audio.filesystem.mapped";
+    private static final String KEY_FILE_SYSTEM_THREADS = "audio.filesystem.io_threads";
+    private static final String KEY_DSP_BUFFER_LENGTH = "audio.dsp.buffer_length";
+    private static final String KEY_DSP_BUFFER_COUNT = "audio.dsp.buffer_count";
+    private static final String KEY_PREWARM_REPLAY = "audio.replay.prewarm";
 
     private static final String DEFAULT_LOADING_MODE = "packaged";
     private static final String DEFAULT_LIBRARY_TYPE = "standard";
     private static final String DEFAULT_LIBRARY_PATH_MACOS = "src/main/resources/fmod/macos";
     private static final String DEFAULT_LIBRARY_PATH_WINDOWS = "src/main/resources/fmod/windows";
     private static final String DEFAULT_LIBRARY_PATH_LINUX = "src/main/resources/fmod/linux";
+    private static final boolean DEFAULT_NONBLOCKING_OPEN = true;
+    private static final boolean DEFAULT_SHARED_DECODE = true;
+    private static final boolean DEFAULT_MAPPED_FILE_SYSTEM = true;
+    private static final int DEFAULT_FILE_SYSTEM_THREADS = 2;
+    private static final int DEFAULT_DSP_BUFFER_LENGTH =
+            FmodSystemManager.DspBufferConfig.LOW_LATENCY.bufferLength();
+    private static final int DEFAULT_DSP_BUFFER_COUNT =
+            FmodSystemManager.DspBufferConfig.LOW_LATENCY.numBuffers();
+    private static final boolean DEFAULT_PREWARM_REPLAY = true;
 
     private final String loadingMode;
     private final String libraryType;
     private final String libraryPathMacos;
     private final String libraryPathWindows;
     private final String libraryPathLinux;
+    private final boolean nonBlockingOpen;
+    private final boolean sharedDecode;
+    private final boolean mappedFileSystem;
+    private final int fileSystemThreads;
+    private final int dspBufferLength;
+    private final int dspBufferCount;
+    private final boolean prewarmReplay;
 
     public FmodProperties() {
         this(new AppConfig());
@@ -36,6 +59,17 @@ public class FmodProperties {
                 config.getProperty(KEY_LIBRARY_PATH_WINDOWS, DEFAULT_LIBRARY_PATH_WINDOWS);
         this.libraryPathLinux =
                 config.getProperty(KEY_LIBRARY_PATH_LINUX, DEFAULT_LIBRARY_PATH_LINUX);
+        this.nonBlockingOpen =
+                config.getBooleanProperty(KEY_NONBLOCKING_OPEN, DEFAULT_NONBLOCKING_OPEN);
+        this.sharedDecode = config.getBooleanProperty(KEY_SHARED_DECODE, DEFAULT_SHARED_DECODE);
+        this.mappedFileSystem =
+                config.getBooleanProperty(KEY_MAPPED_FILE_SYSTEM, DEFAULT_MAPPED_FILE_SYSTEM);
+        this.fileSystemThreads =
+                config.getIntProperty(KEY_FILE_SYSTEM_THREADS, DEFAULT_FILE_SYSTEM_THREADS);
+        this.dspBufferLength =
+                config.getIntProperty(KEY_DSP_BUFFER_LENGTH, DEFAULT_DSP_BUFFER_LENGTH);
+        this.dspBufferCount = config.getIntProperty(KEY_DSP_BUFFER_COUNT, DEFAULT_DSP_BUFFER_COUNT);
+        this.prewarmReplay = config.getBooleanProperty(KEY_PREWARM_REPLAY, DEFAULT_PREWARM_REPLAY);
     }
 
     public FmodProperties(@NonNull String loadingMode, @NonNull String libraryType) {
@@ -44,6 +78,13 @@ public class FmodProperties {
         this.libraryPathMacos = DEFAULT_LIBRARY_PATH_MACOS;
         this.libraryPathWindows = DEFAULT_LIBRARY_PATH_WINDOWS;
         this.libraryPathLinux = DEFAULT_LIBRARY_PATH_LINUX;
+        this.nonBlockingOpen = DEFAULT_NONBLOCKING_OPEN;
+        this.sharedDecode = DEFAULT_SHARED_DECODE;
+        this.mappedFileSystem = DEFAULT_MAPPED_FILE_SYSTEM;
+        this.fileSystemThreads = DEFAULT_FILE_SYSTEM_THREADS;
+        this.dspBufferLength = DEFAULT_DSP_BUFFER_LENGTH;
+        this.dspBufferCount = DEFAULT_DSP_BUFFER_COUNT;
+        this.prewarmReplay = DEFAULT_PREWARM_REPLAY;
     }
 
     public FmodProperties(
@@ -57,6 +98,13 @@ public class FmodProperties {
         this.libraryPathMacos = libraryPathMacos;
         this.libraryPathWindows = libraryPathWindows;
         this.libraryPathLinux = libraryPathLinux;
+        this.nonBlockingOpen = DEFAULT_NONBLOCKING_OPEN;
+        this.sharedDecode = DEFAULT_SHARED_DECODE;
+        this.mappedFileSystem = DEFAULT_MAPPED_FILE_SYSTEM;
+        this.fileSystemThreads = DEFAULT_FILE_SYSTEM_THREADS;
+        this.dspBufferLength = DEFAULT_DSP_BUFFER_LENGTH;
+        this.dspBufferCount = DEFAULT_DSP_BUFFER_COUNT;
+        this.prewarmReplay = DEFAULT_PREWARM_REPLAY;
     }
 
     public String loadingMode() {
@@ -79,6 +127,47 @@ public class FmodProperties {
         return libraryPathLinux;
     }
 
+    /**
+     * Whether sounds open, and shared decodes read their headers, asynchronously ({@code
+     * FMOD_NONBLOCKING}) with polled completion.
+     */
+    public boolean nonBlockingOpen() {
+        return nonBlockingOpen;
+    }
+
+    /**
+     * Whether playback plays from the PCM decoded for the waveform instead of decoding again.
+     * Shared decodes are progressive, so playback can start before the file is fully decoded.
+     */
+    public boolean sharedDecode() {
+        return sharedDecode;
+    }
+
+    /** Whether FMOD reads files through memory mappings on our own I/O threads. */
+    public boolean mappedFileSystem() {
+        return mappedFileSystem;
+    }
+
+    /** Number of I/O threads serving the mapped file system's reads. */
+    public int fileSystemThreads() {
+        return fileSystemThreads;
+    }
+
+    /** Samples per mixer DSP buffer; with {@link #dspBufferCount()}, sets output latency. */
+    public int dspBufferLength() {
+        return dspBufferLength;
+    }
+
+    /** Number of mixer DSP buffers queued to the output device. */
+    public int dspBufferCount() {
+        return dspBufferCount;
+    }
+
+    /** Whether a paused, positioned channel is kept ready so range replays start at once. */
+    public boolean prewarmReplay() {
+        return prewarmReplay;
+    }
+
     /** Defaults helper retained for test compatibility. */
     public static class FmodDefaults {
         public static final String MACOS_LIB_PATH = DEFAULT_LIBRARY_PATH_MACOS;
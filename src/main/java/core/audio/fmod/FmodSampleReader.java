@@ -5,70 +5,95 @@ import core.audio.AudioData;
 import core.audio.AudioMetadata;
 import core.audio.AudioReadException;
 import core.audio.SampleReader;
+import core.audio.SampleView;
 import core.audio.exceptions.AudioEngineException;
+import core.audio.exceptions.AudioLoadException;
 import core.audio.fmod.panama.FmodCore;
 import java.io.IOException;
-import java.lang.foreign.Arena;
 import java.lang.foreign.MemorySegment;
 import java.lang.foreign.ValueLayout;
 import java.nio.file.Path;
-import java.util.Map;
 import java.util.concurrent.CompletableFuture;
 import java.util.concurrent.CompletionException;
-import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.atomic.AtomicInteger;
 import lombok.NonNull;
 import lombok.extern.slf4j.Slf4j;
 
 /**
  * Simple FMOD-based SampleReader that loads entire files into memory.
  *
- * <p>Since we use FMOD_CREATESAMPLE which loads the entire file into memory, we don't need complex
- * parallel infrastructure. We just cache the loaded audio data and serve reads directly from
- * memory.
+ * <p>Files are decoded once by a {@link FmodDecodedAudioStore}, and reads return {@link
+ * SampleView} slices of its off-heap float samples rather than copies. The injected reader shares
+ * the application's store, so the waveform reads the very PCM the playback engine plays and a
+ * file is never decoded twice. Readers created from a {@link FmodLibraryLoader} (tests and tools)
+ * run a private FMOD system and store instead.
+ *
+ * <p>The store's LRU cache is bounded by {@value FmodDecodedAudioStore#CACHE_BUDGET_KEY}
+ * (megabytes), so moving through a long list of files keeps memory use fixed. Views handed to
+ * callers can outlive the cache entry they came from; the memory is released by the garbage
+ * collector once the last view is unreachable.
+ *
+ * <p>The store decodes progressively, so a read completes as soon as the decode has reached the
+ * end of its range: reads near the start of a long file, and the waveform's pyramid pass chunk by
+ * chunk, proceed while the rest of the file is still decoding. Metadata needs only the header.
+ * Reads of frames already decoded complete on the calling thread. Opening a file not yet cached
+ * happens on one of the reader's own daemon threads, never the common fork-join pool, and the
+ * decode runs at the priority of the thread that asked for it.
  */
 @Slf4j
 public class FmodSampleReader implements SampleReader {
 
-    private final MemorySegment system;
-    private final Map<Path, CachedAudio> cache = new ConcurrentHashMap<>();
-    private volatile boolean closed = false;
+    private final FmodDecodedAudioStore store;
+    private final ExecutorService decodeExecutor = newDecodeExecutor();
 
-    private static class CachedAudio {
-        final double[] samples;
-        final AudioMetadata metadata;
+    // Set only when this reader owns a private system and store
+    private final MemorySegment ownedSystem;
+    private volatile boolean closed = false;
 
-        CachedAudio(double[] samples, AudioMetadata metadata) {
-            this.samples = samples;
-            this.metadata = metadata;
-        }
+    @Inject
+    FmodSampleReader(@NonNull FmodDecodedAudioStore store) {
+        this.store = store;
+        this.ownedSystem = null;
     }
 
-    @Inject
     public FmodSampleReader(@NonNull FmodLibraryLoader libraryLoader) {
+        this(libraryLoader, FmodDecodedAudioStore.DEFAULT_CACHE_BUDGET_MB * 1024L * 1024L);
+    }
+
+    FmodSampleReader(@NonNull FmodLibraryLoader libraryLoader, long cacheBudgetBytes) {
         try {
             // Load FMOD native library and create a system using Panama
             libraryLoader.loadNativeLibrary();
-            try (Arena arena = Arena.ofConfined()) {
-                var systemRef = arena.allocate(ValueLayout.ADDRESS);
+            try (FmodScratch scratch = FmodScratch.open()) {
+                var systemRef = scratch.allocate(ValueLayout.ADDRESS);
                 int result = FmodCore.FMOD_System_Create(systemRef, FmodConstants.FMOD_VERSION);
                 if (result != FmodConstants.FMOD_OK) {
                     throw new AudioEngineException(
                             "Failed to create FMOD system: " + FmodError.describe(result));
                 }
-                this.system = systemRef.get(ValueLayout.ADDRESS, 0);
+                this.ownedSystem = systemRef.get(ValueLayout.ADDRESS, 0);
 
                 // Initialize with minimal settings since we're just loading files
                 result =
                         FmodCore.FMOD_System_Init(
-                                system, 32, FmodConstants.FMOD_INIT_NORMAL, MemorySegment.NULL);
+                                ownedSystem,
+                                32,
+                                FmodConstants.FMOD_INIT_NORMAL,
+                                MemorySegment.NULL);
                 if (result != FmodConstants.FMOD_OK) {
-                    FmodCore.FMOD_System_Release(system);
+                    FmodCore.FMOD_System_Release(ownedSystem);
                     throw new AudioEngineException(
                             "Failed to initialize FMOD system: " + FmodError.describe(result));
                 }
             }
+            this.store = new FmodDecodedAudioStore(ownedSystem, cacheBudgetBytes);
 
-            log.info("Created simple FMOD sample reader");
+            log.info(
+                    "Created simple FMOD sample reader (cache budget {} MB)",
+                    cacheBudgetBytes / (1024 * 1024));
         } catch (AudioEngineException e) {
             throw new RuntimeException("Failed to initialize FMOD system", e);
         }
@@ -88,16 +113,41 @@ public class FmodSampleReader implements SampleReader {
                     new IllegalArgumentException("Negative frame values not allowed"));
         }
 
-        // Load file if not cached, then read from memory
-        return CompletableFuture.supplyAsync(
-                () -> {
-                    try {
-                        CachedAudio cached = loadOrGetCached(audioFile);
-                        return readFromCache(cached, startFrame, frameCount);
-                    } catch (AudioReadException e) {
-                        throw new CompletionException(e);
-                    }
-                });
+        // Start the decode if needed, then read from memory once it covers the range
+        return decodedAsync(audioFile)
+                .thenCompose(decoded -> whenDecoded(audioFile, decoded, startFrame, frameCount));
+    }
+
+    private CompletableFuture<AudioData> whenDecoded(
+            @NonNull Path audioFile,
+            FmodDecodedAudioStore.DecodedAudio decoded,
+            long startFrame,
+            long frameCount) {
+        long totalFrames = decoded.metadata().frameCount();
+        long endFrame;
+        if (startFrame >= totalFrames) {
+            endFrame = 0; // An empty read past the end need not wait
+        } else {
+            endFrame = Math.min(totalFrames, startFrame + Math.min(frameCount, totalFrames));
+        }
+        return decoded.progress()
+                .whenDecoded(endFrame)
+                .handle(
+                        (_, e) -> {
+                            if (e != null) {
+                                Throwable cause =
+                                        e instanceof CompletionException ? e.getCause() : e;
+                                throw new CompletionException(
+                                        new AudioReadException(
+                                                "Failed to decode audio file: "
+                                                        + cause.getMessage(),
+                                                audioFile,
+                                                startFrame,
+                                                frameCount,
+                                                cause));
+                            }
+                            return readFromCache(decoded, startFrame, frameCount);
+                        });
     }
 
     @Override
@@ -107,211 +157,77 @@ public class FmodSampleReader implements SampleReader {
                     new AudioReadException("Reader is closed", audioFile));
         }
 
-        return CompletableFuture.supplyAsync(
-                () -> {
-                    try {
-                        CachedAudio cached = loadOrGetCached(audioFile);
-                        return cached.metadata;
-                    } catch (AudioReadException e) {
-                        throw new CompletionException(e);
-                    }
-                });
+        return decodedAsync(audioFile).thenApply(FmodSampleReader::readerMetadata);
+    }
+
+    /**
+     * The store's metadata with the format described as every sample reader describes it, rather
+     * than by the container name the playback engine reports.
+     */
+    private static AudioMetadata readerMetadata(FmodDecodedAudioStore.DecodedAudio decoded) {
+        AudioMetadata meta = decoded.metadata();
+        return new AudioMetadata(
+                meta.sampleRate(),
+                meta.channelCount(),
+                meta.bitsPerSample(),
+                FmodStreamingSampleReader.describeFormat(
+                        meta.sampleRate(), meta.bitsPerSample(), meta.channelCount()),
+                meta.frameCount(),
+                meta.durationSeconds());
     }
 
-    private synchronized CachedAudio loadOrGetCached(Path audioFile) throws AudioReadException {
-        // Check cache first
-        CachedAudio cached = cache.get(audioFile);
+    /** The file's decode, at once if it is cached, otherwise opened on a reader thread. */
+    private CompletableFuture<FmodDecodedAudioStore.DecodedAudio> decodedAsync(
+            @NonNull Path audioFile) {
+        FmodDecodedAudioStore.DecodedAudio cached = store.getIfDecoded(audioFile);
         if (cached != null) {
-            return cached;
+            return CompletableFuture.completedFuture(cached);
         }
-
-        // Load the entire file into memory
-        String filePath = audioFile.toAbsolutePath().toString();
-        MemorySegment sound = null;
-
+        // Decode at the caller's priority, so a background preload stays in the background
+        int priority = Thread.currentThread().getPriority();
         try {
-            // Update system
-            FmodCore.FMOD_System_Update(system);
-
-            // Create sound as sample (loads entire file into memory)
-            // Don't use FMOD_OPENONLY - that prevents actual data loading!
-            int flags = FmodConstants.FMOD_CREATESAMPLE;
-            try (Arena arena = Arena.ofConfined()) {
-                var soundRef = arena.allocate(ValueLayout.ADDRESS);
-                var path = arena.allocateFrom(filePath);
-                int result =
-                        FmodCore.FMOD_System_CreateSound(
-                                system, path, flags, MemorySegment.NULL, soundRef);
-                if (result != FmodConstants.FMOD_OK) {
-                    throw new AudioReadException(
-                            "Failed to open audio file: " + FmodError.describe(result), audioFile);
-                }
-                sound = soundRef.get(ValueLayout.ADDRESS, 0);
-            }
-
-            // Get format info
-            int sampleRate;
-            int channelCount;
-            int bitsPerSample;
-            long totalFrames;
-            double durationSec;
-            int result;
-            try (Arena arena = Arena.ofConfined()) {
-                var channelsRef = arena.allocate(ValueLayout.JAVA_INT);
-                var bitsRef = arena.allocate(ValueLayout.JAVA_INT);
-                result =
-                        FmodCore.FMOD_Sound_GetFormat(
-                                sound,
-                                MemorySegment.NULL,
-                                MemorySegment.NULL,
-                                channelsRef,
-                                bitsRef);
-                if (result != FmodConstants.FMOD_OK) {
-                    throw new AudioReadException(
-                            "Failed to get sound format: " + FmodError.describe(result), audioFile);
-                }
-                // Get sample rate
-                var frequencyRef = arena.allocate(ValueLayout.JAVA_FLOAT);
-                result = FmodCore.FMOD_Sound_GetDefaults(sound, frequencyRef, MemorySegment.NULL);
-                if (result != FmodConstants.FMOD_OK) {
-                    throw new AudioReadException(
-                            "Failed to get sample rate: " + FmodError.describe(result), audioFile);
-                }
-                // Get total length
-                var lengthRef = arena.allocate(ValueLayout.JAVA_INT);
-                result =
-                        FmodCore.FMOD_Sound_GetLength(
-                                sound, lengthRef, FmodConstants.FMOD_TIMEUNIT_PCM);
-                if (result != FmodConstants.FMOD_OK) {
-                    throw new AudioReadException(
-                            "Failed to get sound length: " + FmodError.describe(result), audioFile);
-                }
-                sampleRate = Math.round(frequencyRef.get(ValueLayout.JAVA_FLOAT, 0));
-                channelCount = channelsRef.get(ValueLayout.JAVA_INT, 0);
-                bitsPerSample = bitsRef.get(ValueLayout.JAVA_INT, 0);
-                int bytesPerSample = bitsPerSample / 8;
-                totalFrames = Integer.toUnsignedLong(lengthRef.get(ValueLayout.JAVA_INT, 0));
-
-                // Get duration in ms
-                var msLengthRef = arena.allocate(ValueLayout.JAVA_INT);
-                result =
-                        FmodCore.FMOD_Sound_GetLength(
-                                sound, msLengthRef, FmodConstants.FMOD_TIMEUNIT_MS);
-                if (result != FmodConstants.FMOD_OK) {
-                    throw new AudioReadException(
-                            "Failed to get duration: " + FmodError.describe(result), audioFile);
-                }
-                durationSec =
-                        Integer.toUnsignedLong(msLengthRef.get(ValueLayout.JAVA_INT, 0)) / 1000.0;
-
-                // Lock entire sound to read all data at once
-                int totalBytes = (int) (totalFrames * channelCount * bytesPerSample);
-                var ptr1Ref = arena.allocate(ValueLayout.ADDRESS);
-                var ptr2Ref = arena.allocate(ValueLayout.ADDRESS);
-                var len1Ref = arena.allocate(ValueLayout.JAVA_INT);
-                var len2Ref = arena.allocate(ValueLayout.JAVA_INT);
-
-                result =
-                        FmodCore.FMOD_Sound_Lock(
-                                sound, 0, totalBytes, ptr1Ref, ptr2Ref, len1Ref, len2Ref);
-                if (result != FmodConstants.FMOD_OK) {
-                    throw new AudioReadException(
-                            "Failed to lock sound data: " + FmodError.describe(result), audioFile);
-                }
-
-                int len1 = 0;
-                int len2 = 0;
-                MemorySegment p1 = MemorySegment.NULL;
-                MemorySegment p2 = MemorySegment.NULL;
-                try {
-                    // Read all PCM data
-                    len1 = len1Ref.get(ValueLayout.JAVA_INT, 0);
-                    len2 = len2Ref.get(ValueLayout.JAVA_INT, 0);
-                    int totalBytesRead = len1 + len2;
-                    byte[] buffer = new byte[totalBytesRead];
-
-                    p1 = ptr1Ref.get(ValueLayout.ADDRESS, 0);
-                    p2 = ptr2Ref.get(ValueLayout.ADDRESS, 0);
-                    if (len1 > 0 && p1 != null) {
-                        var seg1 = p1.reinterpret(len1);
-                        seg1.asByteBuffer().get(buffer, 0, len1);
-                    }
-
-                    if (len2 > 0 && p2 != null) {
-                        var seg2 = p2.reinterpret(len2);
-                        seg2.asByteBuffer().get(buffer, len1, len2);
-                    }
-
-                    // Debug: Check raw byte data
-                    boolean hasNonZero = false;
-                    for (int i = 0; i < Math.min(1000, buffer.length); i++) {
-                        if (buffer[i] != 0) {
-                            hasNonZero = true;
-                            break;
-                        }
-                    }
-                    log.debug(
-                            "Raw PCM bytes: {} total, has non-zero data: {}",
-                            totalBytesRead,
-                            hasNonZero);
-
-                    // Convert to normalized doubles
-                    int totalSamples = totalBytesRead / bytesPerSample;
-                    double[] samples = new double[totalSamples];
-                    convertToDouble(buffer, samples, bitsPerSample, totalSamples);
-
-                    // Create metadata
-                    String formatStr =
-                            String.format(
-                                    "%d Hz, %d bit, %s",
-                                    sampleRate,
-                                    bitsPerSample,
-                                    channelCount == 1 ? "Mono" : "Stereo");
-
-                    AudioMetadata metadata =
-                            new AudioMetadata(
-                                    sampleRate,
-                                    channelCount,
-                                    bitsPerSample,
-                                    formatStr,
-                                    totalFrames,
-                                    durationSec);
-
-                    // Debug: Check if samples have actual data
-                    double maxSample = 0;
-                    for (double s : samples) {
-                        if (Math.abs(s) > maxSample) maxSample = Math.abs(s);
-                    }
-
-                    // Cache and return
-                    cached = new CachedAudio(samples, metadata);
-                    cache.put(audioFile, cached);
-
-                    log.debug(
-                            "Loaded and cached {} ({} frames, {} MB, max amplitude: {})",
-                            audioFile.getFileName(),
-                            totalFrames,
-                            String.format("%.2f", totalBytesRead / 1_000_000.0),
-                            maxSample);
-
-                    return cached;
+            return CompletableFuture.supplyAsync(
+                    () -> decodedAt(priority, audioFile), decodeExecutor);
+        } catch (RejectedExecutionException e) {
+            return CompletableFuture.failedFuture(
+                    new AudioReadException("Reader is closed", audioFile));
+        }
+    }
 
-                } finally {
-                    // Unlock the sound
-                    FmodCore.FMOD_Sound_Unlock(sound, p1, p2, len1, len2);
-                }
-            } // end Arena scope for format/lock/read
+    private static ExecutorService newDecodeExecutor() {
+        AtomicInteger threadCount = new AtomicInteger();
+        return Executors.newCachedThreadPool(
+                r -> {
+                    Thread t = new Thread(r, "FmodDecode-" + threadCount.incrementAndGet());
+                    t.setDaemon(true);
+                    return t;
+                });
+    }
 
+    private FmodDecodedAudioStore.DecodedAudio decodedAt(int priority, @NonNull Path audioFile) {
+        Thread thread = Thread.currentThread();
+        int previous = thread.getPriority();
+        thread.setPriority(priority);
+        try {
+            return decoded(audioFile);
         } finally {
-            // Release the sound object
-            if (sound != null) {
-                FmodCore.FMOD_Sound_Release(sound);
-            }
+            thread.setPriority(previous);
+        }
+    }
+
+    private FmodDecodedAudioStore.DecodedAudio decoded(@NonNull Path audioFile) {
+        try {
+            return store.acquire(audioFile);
+        } catch (AudioLoadException e) {
+            throw new CompletionException(
+                    new AudioReadException(
+                            "Failed to open audio file: " + e.getMessage(), audioFile, e));
         }
     }
 
-    private AudioData readFromCache(CachedAudio cached, long startFrame, long frameCount) {
-        AudioMetadata meta = cached.metadata;
+    private AudioData readFromCache(
+            FmodDecodedAudioStore.DecodedAudio cached, long startFrame, long frameCount) {
+        AudioMetadata meta = cached.metadata();
         int channelCount = meta.channelCount();
         long totalFrames = meta.frameCount();
 
@@ -329,47 +245,10 @@ public class FmodSampleReader implements SampleReader {
         int startSample = (int) (startFrame * channelCount);
         int sampleCount = (int) (actualFrameCount * channelCount);
 
-        // Copy the requested range from cached samples
-        double[] resultSamples = new double[sampleCount];
-        System.arraycopy(cached.samples, startSample, resultSamples, 0, sampleCount);
+        // Slice the requested range out of the cached samples (no copy)
+        SampleView slice = SampleView.ofFloats(cached.samples()).slice(startSample, sampleCount);
 
-        return new AudioData(
-                resultSamples, meta.sampleRate(), channelCount, startFrame, actualFrameCount);
-    }
-
-    private void convertToDouble(
-            byte[] buffer, double[] samples, int bitsPerSample, int numSamples) {
-        if (bitsPerSample == 16) {
-            for (int i = 0; i < numSamples; i++) {
-                int byteIndex = i * 2;
-                short value = (short) ((buffer[byteIndex] & 0xFF) | (buffer[byteIndex + 1] << 8));
-                samples[i] = value / 32768.0;
-            }
-        } else if (bitsPerSample == 24) {
-            for (int i = 0; i < numSamples; i++) {
-                int byteIndex = i * 3;
-                int value =
-                        (buffer[byteIndex] & 0xFF)
-                                | ((buffer[byteIndex + 1] & 0xFF) << 8)
-                                | (buffer[byteIndex + 2] << 16);
-                if ((value & 0x800000) != 0) {
-                    value |= 0xFF000000;
-                }
-                samples[i] = value / 8388608.0;
-            }
-        } else if (bitsPerSample == 32) {
-            for (int i = 0; i < numSamples; i++) {
-                int byteIndex = i * 4;
-                int value =
-                        (buffer[byteIndex] & 0xFF)
-                                | ((buffer[byteIndex + 1] & 0xFF) << 8)
-                                | ((buffer[byteIndex + 2] & 0xFF) << 16)
-                                | (buffer[byteIndex + 3] << 24);
-                samples[i] = value / 2147483648.0;
-            }
-        } else {
-            throw new UnsupportedOperationException("Unsupported bit depth: " + bitsPerSample);
-        }
+        return new AudioData(slice, meta.sampleRate(), channelCount, startFrame, actualFrameCount);
     }
 
     @Override
@@ -379,13 +258,13 @@ public class FmodSampleReader implements SampleReader {
         }
 
         closed = true;
+        decodeExecutor.shutdown();
 
-        // Clear cache
-        cache.clear();
-
-        // Release FMOD system
-        if (system != null) {
-            FmodCore.FMOD_System_Release(system);
+        // A shared store outlives this reader; only a private one goes with it
+        if (ownedSystem != null) {
+            // Decodes still running use the system, so they must stop before it goes
+            store.close();
+            FmodCore.FMOD_System_Release(ownedSystem);
             log.info("Released FMOD system");
         }
     }
@@ -0,0 +1,64 @@
+package core.audio.fmod;
+
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.SegmentAllocator;
+
+/**
+ * Per-thread native scratch memory for the out-parameters of FMOD calls.
+ *
+ * <p>Each thread owns one small native block, allocated once. {@link #open()} marks a frame on it;
+ * allocations from the frame bump a pointer and come back zeroed, as from a fresh arena, and
+ * {@link #close()} releases everything allocated since the mark. Hot paths such as position and
+ * state queries therefore make no arena or native allocation. Frames nest (a helper may open its
+ * own inside a caller's) and must be closed in reverse order, which try-with-resources guarantees.
+ *
+ * <p>Segments are only valid until their frame closes, and only on the opening thread. Large or
+ * long-lived buffers (paths, PCM) still belong in an {@link Arena}.
+ */
+final class FmodScratch implements SegmentAllocator, AutoCloseable {
+
+    private static final long CAPACITY_BYTES = 1024;
+    private static final int MAX_DEPTH = 16;
+
+    private static final ThreadLocal<FmodScratch> SCRATCH =
+            ThreadLocal.withInitial(FmodScratch::new);
+
+    // Freed once the owning thread, and with it this scratch, is gone
+    private final MemorySegment memory = Arena.ofAuto().allocate(CAPACITY_BYTES, Long.BYTES);
+    private final long[] marks = new long[MAX_DEPTH];
+    private int depth;
+    private long offset;
+
+    private FmodScratch() {}
+
+    /** Open a scratch frame on the calling thread. */
+    static FmodScratch open() {
+        FmodScratch scratch = SCRATCH.get();
+        if (scratch.depth == MAX_DEPTH) {
+            throw new IllegalStateException("FMOD scratch frames nested too deeply");
+        }
+        scratch.marks[scratch.depth++] = scratch.offset;
+        return scratch;
+    }
+
+    @Override
+    public MemorySegment allocate(long byteSize, long byteAlignment) {
+        if (depth == 0) {
+            throw new IllegalStateException("No open FMOD scratch frame");
+        }
+        long start = (offset + byteAlignment - 1) & -byteAlignment;
+        if (start + byteSize > CAPACITY_BYTES) {
+            throw new IllegalStateException(
+                    "FMOD scratch exhausted: " + byteSize + " bytes requested at " + start);
+        }
+        offset = start + byteSize;
+        return memory.asSlice(start, byteSize).fill((byte) 0);
+    }
+
+    /** Release the current frame. */
+    @Override
+    public void close() {
+        offset = marks[--depth];
+    }
+}
@@ -0,0 +1,445 @@
+package core.audio.fmod;
+
+import com.google.inject.Inject;
+import core.audio.AudioData;
+import core.audio.AudioMetadata;
+import core.audio.AudioReadException;
+import core.audio.SampleReader;
+import core.audio.exceptions.AudioEngineException;
+import core.audio.fmod.panama.FmodCore;
+import core.telemetry.DecodeEvent;
+import java.io.IOException;
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.nio.file.Path;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.locks.ReentrantLock;
+import lombok.NonNull;
+import lombok.extern.slf4j.Slf4j;
+
+/**
+ * FMOD-based SampleReader that streams audio from disk instead of decoding whole files.
+ *
+ * <p>Files are opened with {@code FMOD_CREATESTREAM | FMOD_OPENONLY}, so opening is limited to
+ * parsing headers. Reads are served by seeking and decoding fixed-size windows with {@code
+ * FMOD_Sound_SeekData}/{@code FMOD_Sound_ReadData}, and decoded windows are kept in a small LRU
+ * cache. Resident memory is therefore bounded by {@link #MAX_CACHED_WINDOWS} regardless of file
+ * length. Each open stream decodes into one window-sized native buffer of its own, so a window read
+ * allocates only the samples it returns.
+ */
+@Slf4j
+public class FmodStreamingSampleReader implements SampleReader {
+
+    /** Frames decoded per window (~1.5s at 44.1kHz). */
+    static final int WINDOW_FRAMES = 65536;
+
+    /** Maximum decoded windows kept across all open files. */
+    static final int MAX_CACHED_WINDOWS = 32;
+
+    /**
+     * Readers that can be open at once alongside the playback engine. Each runs an FMOD system of
+     * its own, and FMOD allows only {@code FMOD_MAX_SYSTEMS} (8) per process.
+     */
+    public static final int MAX_OPEN_READERS = 8 - 1;
+
+    private final MemorySegment system;
+    private final Map<Path, StreamSource> sources = new ConcurrentHashMap<>();
+    private final Map<WindowKey, double[]> windows =
+            new LinkedHashMap<>(MAX_CACHED_WINDOWS, 0.75f, true) {
+                @Override
+                protected boolean removeEldestEntry(Map.Entry<WindowKey, double[]> eldest) {
+                    return size() > MAX_CACHED_WINDOWS;
+                }
+            };
+    private volatile boolean closed = false;
+
+    private record WindowKey(@NonNull Path path, long windowIndex) {}
+
+    /** An open FMOD stream. Seek and read must happen together, so access is serialized. */
+    private static final class StreamSource {
+        final MemorySegment sound;
+        final AudioMetadata metadata;
+        final int bytesPerSample;
+        final ReentrantLock lock = new ReentrantLock();
+        boolean released; // Guarded by lock
+
+        // One window of raw PCM, reused by every read of this stream; guarded by lock
+        private MemorySegment readBuffer;
+        private byte[] readBytes;
+
+        StreamSource(MemorySegment sound, AudioMetadata metadata) {
+            this.sound = sound;
+            this.metadata = metadata;
+            this.bytesPerSample = metadata.bitsPerSample() / 8;
+        }
+
+        /** The native read buffer, allocated on the first read. Call holding the lock. */
+        MemorySegment readBuffer() {
+            if (readBuffer == null) {
+                int windowBytes = WINDOW_FRAMES * bytesPerSample * metadata.channelCount();
+                // Freed with the source once the stream is released and unreachable
+                readBuffer = Arena.ofAuto().allocate(windowBytes);
+                readBytes = new byte[windowBytes];
+            }
+            return readBuffer;
+        }
+    }
+
+    @Inject
+    public FmodStreamingSampleReader(@NonNull FmodLibraryLoader libraryLoader) {
+        try {
+            libraryLoader.loadNativeLibrary();
+            try (FmodScratch scratch = FmodScratch.open()) {
+                var systemRef = scratch.allocate(ValueLayout.ADDRESS);
+                int result = FmodCore.FMOD_System_Create(systemRef, FmodConstants.FMOD_VERSION);
+                if (result != FmodConstants.FMOD_OK) {
+                    throw new AudioEngineException(
+                            "Failed to create FMOD system: " + FmodError.describe(result));
+                }
+                this.system = systemRef.get(ValueLayout.ADDRESS, 0);
+
+                result =
+                        FmodCore.FMOD_System_Init(
+                                system, 32, FmodConstants.FMOD_INIT_NORMAL, MemorySegment.NULL);
+                if (result != FmodConstants.FMOD_OK) {
+                    FmodCore.FMOD_System_Release(system);
+                    throw new AudioEngineException(
+                            "Failed to initialize FMOD system: " + FmodError.describe(result));
+                }
+            }
+
+            log.info("Created streaming FMOD sample reader");
+        } catch (AudioEngineException e) {
+            throw new RuntimeException("Failed to initialize FMOD system", e);
+        }
+    }
+
+    @Override
+    public CompletableFuture<AudioData> readSamples(
+            @NonNull Path audioFile, long startFrame, long frameCount) {
+
+        if (closed) {
+            return CompletableFuture.failedFuture(
+                    new AudioReadException("Reader is closed", audioFile));
+        }
+
+        if (startFrame < 0 || frameCount < 0) {
+            return CompletableFuture.failedFuture(
+                    new IllegalArgumentException("Negative frame values not allowed"));
+        }
+
+        return CompletableFuture.supplyAsync(
+                () -> {
+                    try {
+                        StreamSource source = openOrGetSource(audioFile);
+                        return readRange(audioFile, source, startFrame, frameCount);
+                    } catch (AudioReadException e) {
+                        throw new CompletionException(e);
+                    }
+                });
+    }
+
+    @Override
+    public CompletableFuture<AudioMetadata> getMetadata(@NonNull Path audioFile) {
+        if (closed) {
+            return CompletableFuture.failedFuture(
+                    new AudioReadException("Reader is closed", audioFile));
+        }
+
+        return CompletableFuture.supplyAsync(
+                () -> {
+                    try {
+                        return openOrGetSource(audioFile).metadata;
+                    } catch (AudioReadException e) {
+                        throw new CompletionException(e);
+                    }
+                });
+    }
+
+    private synchronized StreamSource openOrGetSource(Path audioFile) throws AudioReadException {
+        if (closed) {
+            throw new AudioReadException("Reader is closed", audioFile);
+        }
+        StreamSource source = sources.get(audioFile);
+        if (source != null) {
+            return source;
+        }
+
+        String filePath = audioFile.toAbsolutePath().toString();
+        int flags =
+                FmodConstants.FMOD_CREATESTREAM
+                        | FmodConstants.FMOD_OPENONLY
+                        | FmodConstants.FMOD_ACCURATETIME;
+        MemorySegment sound;
+        try (Arena arena = Arena.ofConfined()) {
+            var soundRef = arena.allocate(ValueLayout.ADDRESS);
+            var path = arena.allocateFrom(filePath);
+            int result =
+                    FmodCore.FMOD_System_CreateSound(
+                            system, path, flags, MemorySegment.NULL, soundRef);
+            if (result != FmodConstants.FMOD_OK) {
+                throw new AudioReadException(
+                        "Failed to open audio stream: " + FmodError.describe(result), audioFile);
+            }
+            sound = soundRef.get(ValueLayout.ADDRESS, 0);
+        }
+
+        try {
+            source = new StreamSource(sound, readMetadata(sound, audioFile));
+        } catch (AudioReadException e) {
+            FmodCore.FMOD_Sound_Release(sound);
+            throw e;
+        }
+        sources.put(audioFile, source);
+
+        log.debug(
+                "Opened stream for {} ({} frames, {})",
+                audioFile.getFileName(),
+                source.metadata.frameCount(),
+                source.metadata.format());
+        return source;
+    }
+
+    /**
+     * The format description sample readers report in {@link AudioMetadata#format}, e.g. {@code
+     * "44100 Hz, 16 bit, Mono"}. The file list shows it next to each file's duration.
+     */
+    static String describeFormat(int sampleRate, int bitsPerSample, int channelCount) {
+        return String.format(
+                "%d Hz, %d bit, %s",
+                sampleRate, bitsPerSample, channelCount == 1 ? "Mono" : "Stereo");
+    }
+
+    /** Format, rate and length of an open sound; also used by {@link FmodMetadataProbe}. */
+    static AudioMetadata readMetadata(MemorySegment sound, Path audioFile)
+            throws AudioReadException {
+        try (FmodScratch scratch = FmodScratch.open()) {
+            var channelsRef = scratch.allocate(ValueLayout.JAVA_INT);
+            var bitsRef = scratch.allocate(ValueLayout.JAVA_INT);
+            int result =
+                    FmodCore.FMOD_Sound_GetFormat(
+                            sound, MemorySegment.NULL, MemorySegment.NULL, channelsRef, bitsRef);
+            if (result != FmodConstants.FMOD_OK) {
+                throw new AudioReadException(
+                        "Failed to get sound format: " + FmodError.describe(result), audioFile);
+            }
+
+            var frequencyRef = scratch.allocate(ValueLayout.JAVA_FLOAT);
+            result = FmodCore.FMOD_Sound_GetDefaults(sound, frequencyRef, MemorySegment.NULL);
+            if (result != FmodConstants.FMOD_OK) {
+                throw new AudioReadException(
+                        "Failed to get sample rate: " + FmodError.describe(result), audioFile);
+            }
+
+            var lengthRef = scratch.allocate(ValueLayout.JAVA_INT);
+            result =
+                    FmodCore.FMOD_Sound_GetLength(
+                            sound, lengthRef, FmodConstants.FMOD_TIMEUNIT_PCM);
+            if (result != FmodConstants.FMOD_OK) {
+                throw new AudioReadException(
+                        "Failed to get sound length: " + FmodError.describe(result), audioFile);
+            }
+
+            int sampleRate = Math.round(frequencyRef.get(ValueLayout.JAVA_FLOAT, 0));
+            int channelCount = channelsRef.get(ValueLayout.JAVA_INT, 0);
+            int bitsPerSample = bitsRef.get(ValueLayout.JAVA_INT, 0);
+            long totalFrames = Integer.toUnsignedLong(lengthRef.get(ValueLayout.JAVA_INT, 0));
+
+            return new AudioMetadata(
+                    sampleRate,
+                    channelCount,
+                    bitsPerSample,
+                    describeFormat(sampleRate, bitsPerSample, channelCount),
+                    totalFrames,
+                    totalFrames / (double) sampleRate);
+        }
+    }
+
+    private AudioData readRange(
+            Path audioFile, StreamSource source, long startFrame, long frameCount)
+            throws AudioReadException {
+        AudioMetadata meta = source.metadata;
+        int channelCount = meta.channelCount();
+        long totalFrames = meta.frameCount();
+
+        if (startFrame >= totalFrames) {
+            return AudioData.empty(meta.sampleRate(), channelCount, startFrame);
+        }
+
+        long actualFrameCount = Math.min(frameCount, totalFrames - startFrame);
+        if (actualFrameCount <= 0) {
+            return AudioData.empty(meta.sampleRate(), channelCount, startFrame);
+        }
+
+        double[] result = new double[(int) (actualFrameCount * channelCount)];
+        long endFrame = startFrame + actualFrameCount;
+        long firstWindow = startFrame / WINDOW_FRAMES;
+        long lastWindow = (endFrame - 1) / WINDOW_FRAMES;
+
+        for (long w = firstWindow; w <= lastWindow; w++) {
+            double[] window = getWindow(audioFile, source, w);
+            long windowStart = w * WINDOW_FRAMES;
+            long copyFrom = Math.max(startFrame, windowStart);
+            long copyTo = Math.min(endFrame, windowStart + window.length / channelCount);
+            if (copyTo <= copyFrom) {
+                // Stream ended early (decoder reported fewer frames than GetLength)
+                break;
+            }
+            System.arraycopy(
+                    window,
+                    (int) ((copyFrom - windowStart) * channelCount),
+                    result,
+                    (int) ((copyFrom - startFrame) * channelCount),
+                    (int) ((copyTo - copyFrom) * channelCount));
+        }
+
+        return new AudioData(result, meta.sampleRate(), channelCount, startFrame, actualFrameCount);
+    }
+
+    private double[] getWindow(Path audioFile, StreamSource source, long windowIndex)
+            throws AudioReadException {
+        WindowKey key = new WindowKey(audioFile, windowIndex);
+        synchronized (windows) {
+            double[] cached = windows.get(key);
+            if (cached != null) {
+                return cached;
+            }
+        }
+
+        source.lock.lock();
+        try {
+            if (source.released) {
+                throw new AudioReadException("Stream was released", audioFile);
+            }
+            // Another thread may have decoded this window while we waited for the stream
+            synchronized (windows) {
+                double[] cached = windows.get(key);
+                if (cached != null) {
+                    return cached;
+                }
+            }
+
+            var event = new DecodeEvent();
+            event.start();
+            double[] decoded = decodeWindow(audioFile, source, windowIndex);
+            event.file = audioFile.toString();
+            event.frames = decoded.length / Math.max(1, source.metadata.channelCount());
+            event.streaming = true;
+            event.finish();
+            synchronized (windows) {
+                windows.put(key, decoded);
+            }
+            return decoded;
+        } finally {
+            source.lock.unlock();
+        }
+    }
+
+    /** Seek and decode one window. Must be called while holding the source lock. */
+    private double[] decodeWindow(Path audioFile, StreamSource source, long windowIndex)
+            throws AudioReadException {
+        AudioMetadata meta = source.metadata;
+        long windowStart = windowIndex * WINDOW_FRAMES;
+        long framesToRead = Math.min(WINDOW_FRAMES, meta.frameCount() - windowStart);
+        int bytesPerFrame = source.bytesPerSample * meta.channelCount();
+        int bytesToRead = (int) (framesToRead * bytesPerFrame);
+
+        int result = FmodCore.FMOD_Sound_SeekData(source.sound, (int) windowStart);
+        if (result != FmodConstants.FMOD_OK) {
+            throw new AudioReadException(
+                    "Failed to seek stream: " + FmodError.describe(result),
+                    audioFile,
+                    windowStart,
+                    framesToRead);
+        }
+
+        MemorySegment buffer = source.readBuffer();
+        try (FmodScratch scratch = FmodScratch.open()) {
+            var readRef = scratch.allocate(ValueLayout.JAVA_INT);
+            result = FmodCore.FMOD_Sound_ReadData(source.sound, buffer, bytesToRead, readRef);
+            // FMOD reports EOF alongside a partial read at the end of the stream
+            if (result != FmodConstants.FMOD_OK && result != FmodConstants.FMOD_ERR_FILE_EOF) {
+                throw new AudioReadException(
+                        "Failed to read stream data: " + FmodError.describe(result),
+                        audioFile,
+                        windowStart,
+                        framesToRead);
+            }
+
+            int bytesRead = readRef.get(ValueLayout.JAVA_INT, 0);
+            int framesRead = bytesRead / bytesPerFrame;
+            int samplesRead = framesRead * meta.channelCount();
+            byte[] bytes = source.readBytes;
+            MemorySegment.copy(
+                    buffer, ValueLayout.JAVA_BYTE, 0, bytes, 0, framesRead * bytesPerFrame);
+            double[] samples = new double[samplesRead];
+            FmodPcmConverter.toDouble(bytes, samples, meta.bitsPerSample(), samplesRead);
+
+            log.trace(
+                    "Decoded window {} of {} ({} frames)",
+                    windowIndex,
+                    audioFile.getFileName(),
+                    framesRead);
+            return samples;
+        }
+    }
+
+    /**
+     * Closes the stream for the file and drops its decoded windows. Reads still in flight for the
+     * file fail; a later read reopens it.
+     */
+    @Override
+    public void release(@NonNull Path audioFile) {
+        StreamSource source;
+        synchronized (this) {
+            source = sources.remove(audioFile);
+        }
+        synchronized (windows) {
+            windows.keySet().removeIf(key -> key.path().equals(audioFile));
+        }
+        if (source == null) {
+            return;
+        }
+        source.lock.lock();
+        try {
+            source.released = true;
+            FmodCore.FMOD_Sound_Release(source.sound);
+        } finally {
+            source.lock.unlock();
+        }
+    }
+
+    @Override
+    public void close() throws IOException {
+        synchronized (this) {
+            if (closed) {
+                return;
+            }
+            closed = true;
+        }
+
+        synchronized (windows) {
+            windows.clear();
+        }
+
+        for (StreamSource source : sources.values()) {
+            source.lock.lock();
+            try {
+                FmodCore.FMOD_Sound_Release(source.sound);
+            } finally {
+                source.lock.unlock();
+            }
+        }
+        sources.clear();
+
+        if (system != null) {
+            FmodCore.FMOD_System_Release(system);
+            log.info("Released streaming FMOD system");
+        }
+    }
+}
@@ -3,10 +3,13 @@ package core.audio.fmod;
 import com.google.errorprone.annotations.ThreadSafe;
 import com.google.inject.Inject;
 import core.audio.exceptions.AudioEngineException;
+import core.audio.fmod.panama.FMOD_CPU_USAGE;
 import core.audio.fmod.panama.FmodCore;
+import core.telemetry.AudioEngineUsage;
 import java.lang.foreign.Arena;
 import java.lang.foreign.MemorySegment;
 import java.lang.foreign.ValueLayout;
+import java.util.Optional;
 import java.util.concurrent.locks.ReentrantLock;
 import lombok.NonNull;
 import lombok.extern.slf4j.Slf4j;
@@ -19,6 +22,29 @@ import lombok.extern.slf4j.Slf4j;
 @Slf4j
 class FmodSystemManager {
 
+    /**
+     * Size of the mixer's DSP buffers. FMOD mixes {@code bufferLength} samples at a time and queues
+     * {@code numBuffers} of them to the device, so output latency is about {@code bufferLength *
+     * numBuffers} samples, and DSP clock scheduling lands on {@code bufferLength} boundaries.
+     *
+     * @param bufferLength Samples per buffer
+     * @param numBuffers Buffers queued to the output device
+     */
+    record DspBufferConfig(int bufferLength, int numBuffers) {
+        /** 256 x 4, about 21 ms at 48 kHz: short enough that replays feel immediate. */
+        static final DspBufferConfig LOW_LATENCY = new DspBufferConfig(256, 4);
+
+        /** FMOD's own default of 1024 x 4, more tolerant of a busy machine. */
+        static final DspBufferConfig FMOD_DEFAULT = new DspBufferConfig(1024, 4);
+
+        DspBufferConfig {
+            if (bufferLength <= 0 || numBuffers < 2) {
+                throw new IllegalArgumentException(
+                        "Invalid DSP buffer size: " + bufferLength + " x " + numBuffers);
+            }
+        }
+    }
+
     // Core FMOD resources
     private volatile MemorySegment system;
     private volatile boolean initialized = false;
@@ -29,10 +55,46 @@ class FmodSystemManager {
     // Library loader
     private final FmodLibraryLoader libraryLoader;
 
-    /** Creates a new FMOD system manager with injected library loader. */
-    @Inject
+    // Threads for the mapped file system; 0 leaves file access to FMOD
+    private final int fileSystemThreads;
+    private volatile FmodFileSystem fileSystem;
+
+    private final DspBufferConfig dspBuffer;
+
+    /** Creates a new FMOD system manager that leaves file access to FMOD. */
     FmodSystemManager(FmodLibraryLoader libraryLoader) {
+        this(libraryLoader, 0);
+    }
+
+    /** Creates a new FMOD system manager configured from the FMOD properties. */
+    @Inject
+    FmodSystemManager(FmodLibraryLoader libraryLoader, FmodProperties properties) {
+        this(
+                libraryLoader,
+                properties.mappedFileSystem() ? properties.fileSystemThreads() : 0,
+                new DspBufferConfig(properties.dspBufferLength(), properties.dspBufferCount()));
+    }
+
+    /**
+     * @param fileSystemThreads I/O threads for an {@link FmodFileSystem}, or 0 for FMOD's own
+     *     file access
+     */
+    FmodSystemManager(FmodLibraryLoader libraryLoader, int fileSystemThreads) {
+        this(libraryLoader, fileSystemThreads, DspBufferConfig.LOW_LATENCY);
+    }
+
+    /**
+     * @param fileSystemThreads I/O threads for an {@link FmodFileSystem}, or 0 for FMOD's own
+     *     file access
+     * @param dspBuffer The mixer buffer size to request before initialization
+     */
+    FmodSystemManager(
+            FmodLibraryLoader libraryLoader,
+            int fileSystemThreads,
+            @NonNull DspBufferConfig dspBuffer) {
         this.libraryLoader = libraryLoader;
+        this.fileSystemThreads = fileSystemThreads;
+        this.dspBuffer = dspBuffer;
     }
 
     /**
@@ -62,9 +124,12 @@ class FmodSystemManager {
 
             // Configure for playback
             configureForPlayback(system);
+            attachFileSystem(system);
 
             // Initialize FMOD system
-            int maxChannels = 2; // Stereo playback
+            // The playing channel and the paused one kept warm for replays, with headroom so a
+            // channel FMOD has yet to reclaim never steals either
+            int maxChannels = 4;
             int initFlags = FmodConstants.FMOD_INIT_NORMAL;
             int result =
                     FmodCore.FMOD_System_Init(system, maxChannels, initFlags, MemorySegment.NULL);
@@ -83,14 +148,13 @@ class FmodSystemManager {
     /**
      * Configure the FMOD system for low-latency playback.
      *
-     * @param fmodLib The FMOD library interface
      * @param sys The FMOD system pointer
-     * @throws AudioEngineException if configuration fails
      */
     private void configureForPlayback(@NonNull MemorySegment sys) {
-        // Low latency configuration for playback
-        // Smaller buffer for lower latency (256 samples, 4 buffers)
-        int result = FmodCore.FMOD_System_SetDSPBufferSize(sys, 256, 4);
+        // Must precede FMOD_System_Init; the default buffer is four times the low-latency one
+        int result =
+                FmodCore.FMOD_System_SetDSPBufferSize(
+                        sys, dspBuffer.bufferLength(), dspBuffer.numBuffers());
         if (result != FmodConstants.FMOD_OK) {
             log.warn(
                     "Could not set DSP buffer size for low latency: {}",
@@ -106,6 +170,21 @@ class FmodSystemManager {
         }
     }
 
+    /** Serve the system's file reads from mapped files on our own I/O threads, if configured. */
+    private void attachFileSystem(@NonNull MemorySegment sys) {
+        if (fileSystemThreads <= 0) {
+            return;
+        }
+        FmodFileSystem mapped = new FmodFileSystem(fileSystemThreads);
+        int result = mapped.attach(sys);
+        if (result != FmodConstants.FMOD_OK) {
+            log.warn("Could not attach mapped file system: {}", FmodError.describe(result));
+            mapped.close();
+            return;
+        }
+        fileSystem = mapped;
+    }
+
     /**
      * Log FMOD system information for debugging. Logs version, DSP buffer configuration, and
      * software format.
@@ -145,6 +224,19 @@ class FmodSystemManager {
                 }
             }
 
+            // Only once the system is gone, as FMOD calls into it until released
+            if (fileSystem != null) {
+                FmodFileSystem.Stats stats = fileSystem.stats();
+                log.debug(
+                        "File system: {} reads, {} bytes, mean {} ms, max {} ms",
+                        stats.reads(),
+                        stats.bytesRead(),
+                        String.format("%.2f", stats.meanLatencyMillis()),
+                        String.format("%.2f", stats.maxLatencyNanos() / 1_000_000.0));
+                fileSystem.close();
+                fileSystem = null;
+            }
+
             system = null;
             initialized = false;
 
@@ -176,6 +268,55 @@ class FmodSystemManager {
         return system;
     }
 
+    /**
+     * Get the read counters of the mapped file system.
+     *
+     * @return The counters, or empty if FMOD does its own file access
+     */
+    Optional<FmodFileSystem.Stats> getFileSystemStats() {
+        FmodFileSystem current = fileSystem;
+        return current == null ? Optional.empty() : Optional.of(current.stats());
+    }
+
+    /**
+     * Sample FMOD's own CPU use (from {@code FMOD_System_GetCPUUsage}) and the memory it has
+     * allocated (from {@code FMOD_Memory_GetStats}).
+     *
+     * @return The sample, or empty if the system is not initialized or FMOD reports an error
+     */
+    Optional<AudioEngineUsage> sampleUsage() {
+        systemLock.lock();
+        try {
+            if (!initialized || system == null) {
+                return Optional.empty();
+            }
+            // Sampled periodically, so no arena per call; the usage struct fits the scratch block
+            try (FmodScratch scratch = FmodScratch.open()) {
+                MemorySegment usage = FMOD_CPU_USAGE.allocate(scratch);
+                int result = FmodCore.FMOD_System_GetCPUUsage(system, usage);
+                if (result != FmodConstants.FMOD_OK) {
+                    log.debug("Could not read FMOD CPU usage: {}", FmodError.describe(result));
+                    return Optional.empty();
+                }
+                var current = scratch.allocate(ValueLayout.JAVA_INT);
+                var peak = scratch.allocate(ValueLayout.JAVA_INT);
+                // Non-blocking: the figures may lag a concurrent allocation slightly
+                result = FmodCore.FMOD_Memory_GetStats(current, peak, 0);
+                boolean memory = result == FmodConstants.FMOD_OK;
+                return Optional.of(
+                        new AudioEngineUsage(
+                                FMOD_CPU_USAGE.dsp(usage),
+                                FMOD_CPU_USAGE.stream(usage),
+                                FMOD_CPU_USAGE.update(usage),
+                                memory ? current.get(ValueLayout.JAVA_INT, 0) : 0,
+                                memory ? peak.get(ValueLayout.JAVA_INT, 0) : 0,
+                                System.nanoTime()));
+            }
+        } finally {
+            systemLock.unlock();
+        }
+    }
+
     /**
      * Get version information about the loaded FMOD library.
      *
@@ -203,6 +344,16 @@ class FmodSystemManager {
         return "";
     }
 
+    /**
+     * Get the DSP buffer size requested at initialization. FMOD may adjust it for the device; see
+     * {@link #getBufferInfo()} for what it uses.
+     *
+     * @return The requested buffer size
+     */
+    DspBufferConfig getDspBufferConfig() {
+        return dspBuffer;
+    }
+
     /**
      * Get the current DSP buffer configuration.
      *
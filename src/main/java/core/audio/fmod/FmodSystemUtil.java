@@ -2,7 +2,6 @@ package core.audio.fmod;
 
 import core.audio.exceptions.AudioEngineException;
 import core.audio.exceptions.AudioPlaybackException;
-import java.lang.foreign.Arena;
 import java.lang.foreign.MemorySegment;
 import java.lang.foreign.ValueLayout;
 import lombok.NonNull;
@@ -13,10 +12,10 @@ final class FmodSystemUtil {
     private FmodSystemUtil() {}
 
     static int getSoftwareMixRate(@NonNull MemorySegment system) throws AudioEngineException {
-        try (Arena arena = Arena.ofConfined()) {
-            var sampleRate = arena.allocate(ValueLayout.JAVA_INT);
-            var speakerMode = arena.allocate(ValueLayout.JAVA_INT);
-            var numRaw = arena.allocate(ValueLayout.JAVA_INT);
+        try (FmodScratch scratch = FmodScratch.open()) {
+            var sampleRate = scratch.allocate(ValueLayout.JAVA_INT);
+            var speakerMode = scratch.allocate(ValueLayout.JAVA_INT);
+            var numRaw = scratch.allocate(ValueLayout.JAVA_INT);
             int result =
                     core.audio.fmod.panama.FmodCore.FMOD_System_GetSoftwareFormat(
                             system, sampleRate, speakerMode, numRaw);
@@ -31,11 +30,26 @@ final class FmodSystemUtil {
         }
     }
 
+    /** Length in samples of one mix block, the granularity FMOD mixes and schedules at. */
+    static int getDspBufferLength(@NonNull MemorySegment system) throws AudioEngineException {
+        try (FmodScratch scratch = FmodScratch.open()) {
+            var bufferLength = scratch.allocate(ValueLayout.JAVA_INT);
+            var numBuffers = scratch.allocate(ValueLayout.JAVA_INT);
+            int result =
+                    core.audio.fmod.panama.FmodCore.FMOD_System_GetDSPBufferSize(
+                            system, bufferLength, numBuffers);
+            if (result != FmodConstants.FMOD_OK) {
+                throw FmodError.toEngineException(result, "get DSP buffer size");
+            }
+            return bufferLength.get(ValueLayout.JAVA_INT, 0);
+        }
+    }
+
     static int getSourceSampleRate(
             @NonNull MemorySegment system, @NonNull FmodPlaybackHandle handle)
             throws AudioPlaybackException {
-        try (Arena arena = Arena.ofConfined()) {
-            var freq = arena.allocate(ValueLayout.JAVA_FLOAT);
+        try (FmodScratch scratch = FmodScratch.open()) {
+            var freq = scratch.allocate(ValueLayout.JAVA_FLOAT);
             int result =
                     core.audio.fmod.panama.FmodCore.FMOD_Channel_GetFrequency(
                             handle.getChannel(), freq);
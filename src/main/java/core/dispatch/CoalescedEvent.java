@@ -0,0 +1,37 @@
+package core.dispatch;
+
+/**
+ * Marks an event type whose bursts may be collapsed. {@link EventDispatchBus} always queues such an
+ * event for the EDT, and an event published while another of its class is still queued is folded
+ * into that one by {@link #coalesceWith}, so a burst that arrives faster than the EDT takes it (key
+ * repeat, say) is delivered once.
+ *
+ * <p>Only for events whose handlers care about the outcome of a burst rather than each step, and
+ * that need not be handled before the publisher carries on. A merge must leave the handlers where
+ * the separate events would have: where it might not (a relative step whose handler clamps, say),
+ * {@link #canCoalesceWith} refuses it, and the later event is queued after this one instead.
+ *
+ * @param <E> the event type itself
+ */
+public interface CoalescedEvent<E extends CoalescedEvent<E>> {
+
+    /**
+     * Whether {@link #coalesceWith} may replace this queued event and a later one.
+     *
+     * @param later An event of the same class published after this one
+     * @return True by default
+     */
+    default boolean canCoalesceWith(E later) {
+        return true;
+    }
+
+    /**
+     * The single event to deliver in place of this queued event and a later one.
+     *
+     * @param later An event of the same class published after this one
+     * @return The later event by default, so only the latest value is delivered
+     */
+    default E coalesceWith(E later) {
+        return later;
+    }
+}
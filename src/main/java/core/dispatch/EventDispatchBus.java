@@ -2,11 +2,15 @@ package core.dispatch;
 
 import jakarta.inject.Inject;
 import jakarta.inject.Singleton;
+import java.lang.invoke.MethodHandle;
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.MethodType;
 import java.lang.reflect.Method;
 import java.util.ArrayList;
 import java.util.List;
 import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.ConcurrentMap;
+import java.util.concurrent.atomic.AtomicReference;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
@@ -20,18 +24,57 @@ import org.slf4j.LoggerFactory;
  *   <li>All subscribers are executed on the Event Dispatch Thread
  *   <li>If published from EDT, subscribers execute immediately
  *   <li>If published from other threads, subscribers are queued to EDT
+ *   <li>Events implementing {@link CoalescedEvent} are always queued, and replace (or merge into)
+ *       the last one of their type still waiting in the queue, or queue behind it when the two
+ *       cannot be merged. This holds on the EDT too: their handlers
+ *       run only after the publishing code returns, never inside {@link #publish}, so the
+ *       publisher cannot see the handlers' effects straight away
  * </ul>
  *
  * This design ensures thread safety for applications where event handlers need synchronized
  * execution.
+ *
+ * <h3>Dispatch</h3>
+ *
+ * {@code @Subscribe} methods are resolved once, when their object subscribes, into method handles.
+ * An event reaches every handler whose parameter type it is an instance of, supertypes and
+ * interfaces included, in the order the handlers subscribed; the handlers for each event class are
+ * gathered into a table the first time one is published, and kept until the subscribers change.
  */
 @Singleton
 public class EventDispatchBus {
     private static final Logger logger = LoggerFactory.getLogger(EventDispatchBus.class);
 
-    private final ConcurrentMap<Class<?>, List<Object>> subscribers = new ConcurrentHashMap<>();
+    private static final MethodType HANDLER_TYPE = MethodType.methodType(void.class, Object.class);
+
     private final EventDispatcher dispatcher;
 
+    // Replaced whole on (un)subscribe, so a dispatch table always matches its handler list
+    private volatile Registry registry = new Registry(List.of());
+
+    // Coalesced events waiting for the EDT, by event class, in publishing order
+    private final ConcurrentMap<Class<?>, AtomicReference<List<Object>>> pending =
+            new ConcurrentHashMap<>();
+
+    /** One {@code @Subscribe} method bound to its subscriber. */
+    private record Handler(Object subscriber, Class<?> eventType, MethodHandle handle) {}
+
+    /** The subscribed handlers, and the dispatch tables derived from them so far. */
+    private record Registry(List<Handler> handlers, ConcurrentMap<Class<?>, Handler[]> tables) {
+        Registry(List<Handler> handlers) {
+            this(List.copyOf(handlers), new ConcurrentHashMap<>());
+        }
+
+        Handler[] table(Class<?> eventClass) {
+            return tables.computeIfAbsent(
+                    eventClass,
+                    c ->
+                            handlers.stream()
+                                    .filter(h -> h.eventType().isAssignableFrom(c))
+                                    .toArray(Handler[]::new));
+        }
+    }
+
     @Inject
     public EventDispatchBus(EventDispatcher dispatcher) {
         this.dispatcher = dispatcher;
@@ -39,24 +82,49 @@ public class EventDispatchBus {
 
     /**
      * Subscribe an object to events. The object must have methods annotated with @Subscribe that
-     * take a single parameter of the event type.
+     * take a single parameter of the event type. Subscribing an object again has no effect.
      *
      * @param subscriber The object containing @Subscribe methods
      */
     public void subscribe(Object subscriber) {
-        Method[] methods = subscriber.getClass().getMethods();
-        for (Method method : methods) {
-            if (method.isAnnotationPresent(Subscribe.class)) {
-                Class<?>[] parameterTypes = method.getParameterTypes();
-                if (parameterTypes.length == 1) {
-                    Class<?> eventType = parameterTypes[0];
-                    subscribers.computeIfAbsent(eventType, _ -> new ArrayList<>()).add(subscriber);
-                    logger.debug(
-                            "Subscribed {} to {}",
-                            subscriber.getClass().getSimpleName(),
-                            eventType.getSimpleName());
-                }
+        List<Handler> resolved = new ArrayList<>();
+        for (Method method : subscriber.getClass().getMethods()) {
+            if (!method.isAnnotationPresent(Subscribe.class)
+                    || method.getParameterCount() != 1
+                    || method.isBridge()) {
+                continue;
+            }
+            Class<?> eventType = method.getParameterTypes()[0];
+            try {
+                method.trySetAccessible(); // Public methods of non-public classes
+                MethodHandle handle =
+                        MethodHandles.lookup()
+                                .unreflect(method)
+                                .bindTo(subscriber)
+                                .asType(HANDLER_TYPE);
+                resolved.add(new Handler(subscriber, eventType, handle));
+                logger.debug(
+                        "Subscribed {} to {}",
+                        subscriber.getClass().getSimpleName(),
+                        eventType.getSimpleName());
+            } catch (IllegalAccessException e) {
+                logger.error(
+                        "Cannot subscribe {}.{}",
+                        subscriber.getClass().getSimpleName(),
+                        method.getName(),
+                        e);
+            }
+        }
+
+        synchronized (this) {
+            var current = registry.handlers();
+            if (current.stream().anyMatch(h -> h.subscriber() == subscriber)) {
+                logger.debug("{} is already subscribed", subscriber.getClass().getSimpleName());
+                return;
             }
+            List<Handler> handlers = new ArrayList<>(current);
+            handlers.addAll(resolved);
+            registry = new Registry(handlers);
         }
     }
 
@@ -71,16 +139,20 @@ public class EventDispatchBus {
             return;
         }
 
-        int removedCount = 0;
-        for (List<Object> eventSubscribers : subscribers.values()) {
-            if (eventSubscribers.remove(subscriber)) {
-                removedCount++;
+        int removedCount;
+        synchronized (this) {
+            var current = registry.handlers();
+            List<Handler> handlers =
+                    current.stream().filter(h -> h.subscriber() != subscriber).toList();
+            removedCount = current.size() - handlers.size();
+            if (removedCount > 0) {
+                registry = new Registry(handlers);
             }
         }
 
         if (removedCount > 0) {
             logger.debug(
-                    "Unsubscribed {} from {} event type(s)",
+                    "Unsubscribed {} ({} handler(s))",
                     subscriber.getClass().getSimpleName(),
                     removedCount);
         } else {
@@ -92,7 +164,8 @@ public class EventDispatchBus {
      * Publish an event to all subscribers.
      *
      * <p>Events can be published from any thread. All subscribers will be executed on the Event
-     * Dispatch Thread (EDT) to ensure thread safety for UI operations.
+     * Dispatch Thread (EDT) to ensure thread safety for UI operations. {@link CoalescedEvent}s are
+     * queued even when published on the EDT, so their handlers run later.
      *
      * @param event The event to publish
      */
@@ -102,30 +175,71 @@ public class EventDispatchBus {
             return;
         }
 
-        List<Object> eventSubscribers = subscribers.get(event.getClass());
-        if (eventSubscribers == null || eventSubscribers.isEmpty()) {
+        Handler[] handlers = registry.table(event.getClass());
+        if (handlers.length == 0) {
             logger.trace("No subscribers for event type: {}", event.getClass().getSimpleName());
             return;
         }
 
-        // Create a snapshot of subscribers to avoid concurrent modification
-        List<Object> subscriberSnapshot = new ArrayList<>(eventSubscribers);
-
-        Runnable notificationTask = () -> notifySubscribers(event, subscriberSnapshot);
+        if (event instanceof CoalescedEvent<?>) {
+            publishCoalesced(event);
+            return;
+        }
 
-        dispatcher.dispatch(notificationTask);
+        dispatcher.dispatch(() -> notifySubscribers(event, handlers));
         if (!dispatcher.isEventDispatchThread()) {
             logger.trace("Queued event {} for EDT execution", event.getClass().getSimpleName());
         }
     }
 
+    /**
+     * Queue a coalesced event, or fold it into the last one of its class already queued. Events of
+     * a class queued together are delivered in order by one dispatch, each to the handlers
+     * subscribed when it is delivered.
+     */
+    private void publishCoalesced(Object event) {
+        Class<?> eventClass = event.getClass();
+        var slot = pending.computeIfAbsent(eventClass, _ -> new AtomicReference<>());
+        List<Object> previous = slot.getAndAccumulate(List.of(event), EventDispatchBus::coalesce);
+        if (previous != null) {
+            logger.trace("Coalesced event {}", eventClass.getSimpleName());
+            return;
+        }
+        dispatcher.dispatchLater(
+                () -> {
+                    List<Object> queued = slot.getAndSet(null);
+                    if (queued != null) {
+                        for (Object latest : queued) {
+                            notifySubscribers(latest, registry.table(latest.getClass()));
+                        }
+                    }
+                });
+    }
+
+    /** The queue with {@code later}'s one event merged into its last, or appended if it cannot. */
+    @SuppressWarnings("unchecked")
+    private static List<Object> coalesce(List<Object> queued, List<Object> later) {
+        if (queued == null) {
+            return later;
+        }
+        var last = (CoalescedEvent<Object>) queued.getLast();
+        Object event = later.getFirst();
+        var result = new ArrayList<>(queued);
+        if (last.canCoalesceWith(event)) {
+            result.set(result.size() - 1, last.coalesceWith(event));
+        } else {
+            result.add(event);
+        }
+        return List.copyOf(result);
+    }
+
     /**
      * Notify all subscribers of an event. This method must be called on the EDT.
      *
      * @param event The event to deliver
-     * @param eventSubscribers The list of subscribers to notify
+     * @param handlers The handlers to notify
      */
-    private void notifySubscribers(Object event, List<Object> eventSubscribers) {
+    private void notifySubscribers(Object event, Handler[] handlers) {
         if (!dispatcher.isEventDispatchThread()) {
             logger.error(
                     "notifySubscribers called from non-EDT thread: {}",
@@ -133,26 +247,20 @@ public class EventDispatchBus {
             return;
         }
 
-        for (Object subscriber : eventSubscribers) {
+        for (Handler handler : handlers) {
             try {
-                Method[] methods = subscriber.getClass().getMethods();
-                for (Method method : methods) {
-                    if (method.isAnnotationPresent(Subscribe.class)
-                            && method.getParameterTypes().length == 1
-                            && method.getParameterTypes()[0].isAssignableFrom(event.getClass())) {
-                        method.invoke(subscriber, event);
-                        logger.trace(
-                                "Delivered event {} to {}",
-                                event.getClass().getSimpleName(),
-                                subscriber.getClass().getSimpleName());
-                        break;
-                    }
-                }
-            } catch (Exception e) {
+                handler.handle().invokeExact(event);
+                logger.trace(
+                        "Delivered event {} to {}",
+                        event.getClass().getSimpleName(),
+                        handler.subscriber().getClass().getSimpleName());
+            } catch (VirtualMachineError e) {
+                throw e;
+            } catch (Throwable e) {
                 logger.error(
                         "Error delivering event {} to subscriber {}",
                         event.getClass().getSimpleName(),
-                        subscriber.getClass().getSimpleName(),
+                        handler.subscriber().getClass().getSimpleName(),
                         e);
                 // Continue processing other subscribers even if one fails
             }
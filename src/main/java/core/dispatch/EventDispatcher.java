@@ -21,4 +21,14 @@ public interface EventDispatcher {
      * @param task the task to execute
      */
     void dispatch(Runnable task);
+
+    /**
+     * Queue a task for the event dispatch thread, even when already on it, so it runs after the
+     * work already queued. Implementations that cannot queue run it as {@link #dispatch} would.
+     *
+     * @param task the task to execute
+     */
+    default void dispatchLater(Runnable task) {
+        dispatch(task);
+    }
 }
@@ -0,0 +1,10 @@
+package core.events;
+
+import java.io.File;
+import lombok.NonNull;
+
+/**
+ * Event published when a folder of audio files is selected for opening. The UI layer handles this
+ * by scanning the folder in the background and adding its files to the audio file display.
+ */
+public record AudioFolderSelectedEvent(@NonNull File folder) {}
@@ -1,10 +1,18 @@
 package core.events;
 
+import core.dispatch.CoalescedEvent;
+
 /**
  * Event to request seeking by a relative amount in the audio. The audio session manager handles the
  * actual frame calculations.
+ *
+ * <p>Coalesced: seeks in one direction queued faster than the EDT handles them (a held arrow key)
+ * are delivered as one seek by their total amount, so the playhead ends where the separate seeks
+ * would have put it. Seeks in opposite directions are not merged, since each is clamped to the
+ * file: near the start, back 500 ms then forward 500 ms ends 500 ms in, not where it began.
  */
-public record SeekByAmountEvent(Direction direction, int milliseconds) {
+public record SeekByAmountEvent(Direction direction, int milliseconds)
+        implements CoalescedEvent<SeekByAmountEvent> {
 
     public enum Direction {
         FORWARD,
@@ -16,4 +24,15 @@ public record SeekByAmountEvent(Direction direction, int milliseconds) {
             throw new IllegalArgumentException("Milliseconds must be non-negative");
         }
     }
+
+    @Override
+    public boolean canCoalesceWith(SeekByAmountEvent later) {
+        return later.direction == direction;
+    }
+
+    @Override
+    public SeekByAmountEvent coalesceWith(SeekByAmountEvent later) {
+        long total = (long) milliseconds + later.milliseconds;
+        return new SeekByAmountEvent(direction, (int) Math.min(Integer.MAX_VALUE, total));
+    }
 }
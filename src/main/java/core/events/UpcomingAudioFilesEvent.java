@@ -0,0 +1,16 @@
+package core.events;
+
+import java.io.File;
+import java.util.List;
+import lombok.NonNull;
+
+/**
+ * Event published when the audio files the user is likely to open next change, nearest first. The
+ * waveform preloader prepares them in the background.
+ */
+public record UpcomingAudioFilesEvent(@NonNull List<File> files) {
+
+    public UpcomingAudioFilesEvent {
+        files = List.copyOf(files);
+    }
+}
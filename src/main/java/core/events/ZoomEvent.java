@@ -1,9 +1,42 @@
 package core.events;
 
-/** Event published when zoom is requested for the waveform display. */
-public record ZoomEvent(Direction direction) {
+import core.dispatch.CoalescedEvent;
+
+/**
+ * Event published when zoom is requested for the waveform display, by a number of steps in one
+ * direction.
+ *
+ * <p>Coalesced: zooms in one direction queued faster than the EDT handles them (a held zoom key,
+ * several quick presses) are delivered as one event by their total step count. Zooms in opposite
+ * directions are not merged, since the handler clamps each zoom to its limits: at the closest zoom,
+ * IN then OUT zooms out a step, while their net of zero would leave the zoom where it was.
+ */
+public record ZoomEvent(Direction direction, int steps) implements CoalescedEvent<ZoomEvent> {
+
     public enum Direction {
         IN,
         OUT
     }
+
+    public ZoomEvent {
+        if (steps < 0) {
+            throw new IllegalArgumentException("Steps must be non-negative");
+        }
+    }
+
+    /** A single zoom step. */
+    public ZoomEvent(Direction direction) {
+        this(direction, 1);
+    }
+
+    @Override
+    public boolean canCoalesceWith(ZoomEvent later) {
+        return later.direction == direction;
+    }
+
+    @Override
+    public ZoomEvent coalesceWith(ZoomEvent later) {
+        long total = (long) steps + later.steps;
+        return new ZoomEvent(direction, (int) Math.min(Integer.MAX_VALUE, total));
+    }
 }
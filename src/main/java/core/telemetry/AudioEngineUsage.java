@@ -0,0 +1,19 @@
+package core.telemetry;
+
+/**
+ * One sample of the audio engine's own load.
+ *
+ * @param dspPercent Share of a core spent mixing and running DSP
+ * @param streamPercent Share of a core spent decoding streams
+ * @param updatePercent Share of a core spent in the engine's update call
+ * @param memoryBytes Memory the engine has allocated now
+ * @param peakMemoryBytes Most memory the engine has had allocated at once
+ * @param sampledNanos {@link System#nanoTime()} of the sample
+ */
+public record AudioEngineUsage(
+        float dspPercent,
+        float streamPercent,
+        float updatePercent,
+        long memoryBytes,
+        long peakMemoryBytes,
+        long sampledNanos) {}
@@ -0,0 +1,36 @@
+package core.telemetry;
+
+import jdk.jfr.Category;
+import jdk.jfr.DataAmount;
+import jdk.jfr.Event;
+import jdk.jfr.Label;
+import jdk.jfr.Name;
+import jdk.jfr.Percentage;
+import jdk.jfr.StackTrace;
+
+@Name("totalrecall.AudioEngineUsage")
+@Label("Audio Engine Usage")
+@Category({"Penn TotalRecall", "Performance"})
+@StackTrace(false)
+final class AudioEngineUsageEvent extends Event {
+
+    @Label("DSP CPU")
+    @Percentage
+    float dsp;
+
+    @Label("Stream CPU")
+    @Percentage
+    float stream;
+
+    @Label("Update CPU")
+    @Percentage
+    float update;
+
+    @Label("Memory")
+    @DataAmount
+    long memory;
+
+    @Label("Peak Memory")
+    @DataAmount
+    long peakMemory;
+}
@@ -0,0 +1,35 @@
+package core.telemetry;
+
+import jdk.jfr.Category;
+import jdk.jfr.Event;
+import jdk.jfr.Label;
+import jdk.jfr.Name;
+import jdk.jfr.StackTrace;
+
+@Name("totalrecall.CacheLookup")
+@Label("Segment Cache Lookup")
+@Category({"Penn TotalRecall", "Performance"})
+@StackTrace(false)
+public final class CacheLookupEvent extends Event {
+
+    @Label("Hit")
+    public boolean hit;
+
+    @Label("Start Time (s)")
+    public double startSeconds;
+
+    @Label("Pixels per Second")
+    public int pixelsPerSecond;
+
+    /** Count a waveform segment lookup and commit it if a recording wants it. */
+    public static void record(boolean hit, double startSeconds, int pixelsPerSecond) {
+        StageTimings.recordCacheLookup(hit);
+        CacheLookupEvent event = new CacheLookupEvent();
+        if (event.shouldCommit()) {
+            event.hit = hit;
+            event.startSeconds = startSeconds;
+            event.pixelsPerSecond = pixelsPerSecond;
+            event.commit();
+        }
+    }
+}
@@ -0,0 +1,22 @@
+package core.telemetry;
+
+import jdk.jfr.Description;
+import jdk.jfr.Label;
+import jdk.jfr.Name;
+
+@Name("totalrecall.Composite")
+@Label("Viewport Composite")
+@Description("Painting the viewport's tiles, reference line and playhead")
+public final class CompositeEvent extends StageEvent {
+
+    @Label("Width")
+    public int widthPx;
+
+    @Label("Height")
+    public int heightPx;
+
+    @Override
+    Stage stage() {
+        return Stage.COMPOSITE;
+    }
+}
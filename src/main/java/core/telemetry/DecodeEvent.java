@@ -0,0 +1,26 @@
+package core.telemetry;
+
+import jdk.jfr.Description;
+import jdk.jfr.Label;
+import jdk.jfr.Name;
+
+@Name("totalrecall.Decode")
+@Label("Audio Decode")
+@Description("Decoding a file, or a window of a streamed file, into samples")
+public final class DecodeEvent extends StageEvent {
+
+    @Label("File")
+    public String file;
+
+    @Label("Frames")
+    public long frames;
+
+    @Label("Streaming")
+    @Description("A window of a streamed file rather than the whole file")
+    public boolean streaming;
+
+    @Override
+    Stage stage() {
+        return Stage.DECODE;
+    }
+}
@@ -0,0 +1,22 @@
+package core.telemetry;
+
+import jdk.jfr.Description;
+import jdk.jfr.Label;
+import jdk.jfr.Name;
+
+@Name("totalrecall.Filter")
+@Label("Waveform Filter")
+@Description("Band-pass filtering one chunk of samples for the waveform")
+public final class FilterEvent extends StageEvent {
+
+    @Label("Samples")
+    public long samples;
+
+    @Label("Channels")
+    public int channels;
+
+    @Override
+    Stage stage() {
+        return Stage.FILTER;
+    }
+}
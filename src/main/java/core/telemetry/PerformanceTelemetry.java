@@ -0,0 +1,230 @@
+package core.telemetry;
+
+import com.google.errorprone.annotations.ThreadSafe;
+import core.env.AppConfig;
+import jakarta.inject.Inject;
+import jakarta.inject.Singleton;
+import java.util.EnumMap;
+import java.util.Locale;
+import java.util.Map;
+import java.util.Optional;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicLong;
+import lombok.NonNull;
+
+/**
+ * One place to read how the pipeline is performing: recent durations of each {@link Stage} (fed by
+ * the {@link StageEvent}s), segment cache hits and misses, delivered and dropped viewport frames,
+ * and the audio engine's own CPU and memory use as last sampled. Every stage also goes to JFR, so a
+ * recording ({@code -XX:StartFlightRecording}) captures the same events with full timing.
+ *
+ * <p>Backs the on-screen performance overlay, whose visibility it holds, and the performance dump.
+ */
+@ThreadSafe
+@Singleton
+public class PerformanceTelemetry {
+
+    static final String OVERLAY_KEY = "perf.overlay.enabled";
+
+    // Usage older than this is from an engine that has stopped sampling
+    private static final long USAGE_STALE_NANOS = TimeUnit.SECONDS.toNanos(5);
+
+    private final AtomicLong framesDelivered = new AtomicLong();
+    private final AtomicLong framesDropped = new AtomicLong();
+    private volatile AudioEngineUsage audioUsage;
+    private volatile boolean overlayVisible;
+
+    /**
+     * Stage statistics over the last {@link StageTimings#WINDOW_NANOS}.
+     *
+     * @param total Times the stage has run since start
+     * @param perSecond Recent runs per second
+     */
+    public record StageStats(
+            long total, double perSecond, double meanMillis, double p95Millis, double maxMillis) {}
+
+    /** Everything the telemetry knows at one moment. */
+    public record Snapshot(
+            @NonNull Map<Stage, StageStats> stages,
+            long cacheHits,
+            long cacheMisses,
+            long framesDelivered,
+            long framesDropped,
+            @NonNull Optional<AudioEngineUsage> audioUsage,
+            long heapUsedBytes,
+            long heapMaxBytes) {
+
+        public double cacheHitRate() {
+            long lookups = cacheHits + cacheMisses;
+            return lookups > 0 ? (double) cacheHits / lookups : 0;
+        }
+    }
+
+    @Inject
+    public PerformanceTelemetry(@NonNull AppConfig config) {
+        this.overlayVisible = config.getBooleanProperty(OVERLAY_KEY, false);
+    }
+
+    /** Telemetry with the overlay hidden. */
+    public PerformanceTelemetry() {
+        this.overlayVisible = false;
+    }
+
+    public boolean isOverlayVisible() {
+        return overlayVisible;
+    }
+
+    public void setOverlayVisible(boolean visible) {
+        this.overlayVisible = visible;
+    }
+
+    /** Count a viewport frame, and the refreshes dropped before it. */
+    public void recordFrame(int droppedBefore) {
+        framesDelivered.incrementAndGet();
+        if (droppedBefore > 0) {
+            framesDropped.addAndGet(droppedBefore);
+        }
+    }
+
+    /** Keep the audio engine's latest usage sample and commit it to any running recording. */
+    public void recordAudioUsage(@NonNull AudioEngineUsage usage) {
+        audioUsage = usage;
+        AudioEngineUsageEvent event = new AudioEngineUsageEvent();
+        if (event.shouldCommit()) {
+            // JFR percentages are fractions
+            event.dsp = usage.dspPercent() / 100;
+            event.stream = usage.streamPercent() / 100;
+            event.update = usage.updatePercent() / 100;
+            event.memory = usage.memoryBytes();
+            event.peakMemory = usage.peakMemoryBytes();
+            event.commit();
+        }
+    }
+
+    public Snapshot snapshot() {
+        Map<Stage, StageStats> stages = new EnumMap<>(Stage.class);
+        for (Stage stage : Stage.values()) {
+            StageTimings.Stats s = StageTimings.stats(stage);
+            stages.put(
+                    stage,
+                    new StageStats(
+                            s.total(),
+                            s.perSecond(),
+                            s.meanMillis(),
+                            s.p95Millis(),
+                            s.maxMillis()));
+        }
+        AudioEngineUsage usage = audioUsage;
+        boolean fresh =
+                usage != null && System.nanoTime() - usage.sampledNanos() < USAGE_STALE_NANOS;
+        Runtime runtime = Runtime.getRuntime();
+        return new Snapshot(
+                stages,
+                StageTimings.cacheHits(),
+                StageTimings.cacheMisses(),
+                framesDelivered.get(),
+                framesDropped.get(),
+                fresh ? Optional.of(usage) : Optional.empty(),
+                runtime.totalMemory() - runtime.freeMemory(),
+                runtime.maxMemory());
+    }
+
+    /** Short lines for the on-screen overlay. */
+    public static String[] overlayLines(@NonNull Snapshot s) {
+        StageStats composite = s.stages().get(Stage.COMPOSITE);
+        String[] lines = new String[Stage.values().length + 3];
+        int n = 0;
+        lines[n++] =
+                format(
+                        "%.0f fps  dropped %d of %d",
+                        composite.perSecond(),
+                        s.framesDropped(),
+                        s.framesDelivered() + s.framesDropped());
+        for (Stage stage : Stage.values()) {
+            StageStats t = s.stages().get(stage);
+            lines[n++] =
+                    format(
+                            "%-9s %6.2f ms  p95 %6.2f  max %6.2f  %5.1f/s",
+                            stage.label(),
+                            t.meanMillis(),
+                            t.p95Millis(),
+                            t.maxMillis(),
+                            t.perSecond());
+        }
+        lines[n++] =
+                format(
+                        "cache     %5.1f%% hit  (%d/%d)",
+                        100 * s.cacheHitRate(),
+                        s.cacheHits(),
+                        s.cacheHits() + s.cacheMisses());
+        lines[n] =
+                s.audioUsage()
+                        .map(
+                                u ->
+                                        format(
+                                                "fmod      dsp %.1f%%  stream %.1f%%  update %.1f%%"
+                                                        + "  %.1f MB",
+                                                u.dspPercent(),
+                                                u.streamPercent(),
+                                                u.updatePercent(),
+                                                u.memoryBytes() / 1e6))
+                        .orElse("fmod      not sampled");
+        return lines;
+    }
+
+    /** Full plain-text report, for the performance dump. */
+    public static String report(@NonNull Snapshot s) {
+        StringBuilder out = new StringBuilder();
+        out.append(
+                format(
+                        "Stage timings over the last %d s%n",
+                        TimeUnit.NANOSECONDS.toSeconds(StageTimings.WINDOW_NANOS)));
+        out.append(
+                format(
+                        "  %-10s %10s %8s %10s %10s %10s%n",
+                        "stage", "total", "per s", "mean ms", "p95 ms", "max ms"));
+        for (Stage stage : Stage.values()) {
+            StageStats t = s.stages().get(stage);
+            out.append(
+                    format(
+                            "  %-10s %10d %8.1f %10.3f %10.3f %10.3f%n",
+                            stage.label(),
+                            t.total(),
+                            t.perSecond(),
+                            t.meanMillis(),
+                            t.p95Millis(),
+                            t.maxMillis()));
+        }
+        out.append(
+                format(
+                        "Viewport frames: %d delivered, %d dropped%n",
+                        s.framesDelivered(), s.framesDropped()));
+        out.append(
+                format(
+                        "Segment cache: %d hits, %d misses (%.1f%% hit rate)%n",
+                        s.cacheHits(), s.cacheMisses(), 100 * s.cacheHitRate()));
+        out.append(
+                s.audioUsage()
+                        .map(
+                                u ->
+                                        format(
+                                                "FMOD CPU: dsp %.2f%%, stream %.2f%%, update"
+                                                        + " %.2f%%%nFMOD memory: %.2f MB (peak"
+                                                        + " %.2f MB)%n",
+                                                u.dspPercent(),
+                                                u.streamPercent(),
+                                                u.updatePercent(),
+                                                u.memoryBytes() / 1e6,
+                                                u.peakMemoryBytes() / 1e6))
+                        .orElse(format("FMOD: not sampled%n")));
+        out.append(
+                format(
+                        "Java heap: %.1f MB used of %.1f MB%n",
+                        s.heapUsedBytes() / 1e6, s.heapMaxBytes() / 1e6));
+        return out.toString();
+    }
+
+    private static String format(String pattern, Object... args) {
+        return String.format(Locale.ROOT, pattern, args);
+    }
+}
@@ -0,0 +1,26 @@
+package core.telemetry;
+
+import jdk.jfr.Label;
+import jdk.jfr.Name;
+
+@Name("totalrecall.SegmentRender")
+@Label("Segment Render")
+public final class SegmentRenderEvent extends StageEvent {
+
+    @Label("Start Time (s)")
+    public double startSeconds;
+
+    @Label("Pixels per Second")
+    public int pixelsPerSecond;
+
+    @Label("Height")
+    public int heightPx;
+
+    @Label("Spectrogram")
+    public boolean spectrogram;
+
+    @Override
+    Stage stage() {
+        return Stage.SEGMENT_RENDER;
+    }
+}
@@ -0,0 +1,24 @@
+package core.telemetry;
+
+/** Timed stages of the audio-to-screen pipeline. */
+public enum Stage {
+    /** Decoding audio into samples. */
+    DECODE("decode"),
+    /** Band-pass filtering samples for the waveform. */
+    FILTER("filter"),
+    /** Drawing one waveform or spectrogram segment. */
+    SEGMENT_RENDER("segment"),
+    /** Painting the viewport from its tiles and overlay. */
+    COMPOSITE("composite");
+
+    private final String label;
+
+    Stage(String label) {
+        this.label = label;
+    }
+
+    /** Short lower-case name for reports. */
+    public String label() {
+        return label;
+    }
+}
@@ -0,0 +1,43 @@
+package core.telemetry;
+
+import jdk.jfr.Category;
+import jdk.jfr.Event;
+import jdk.jfr.StackTrace;
+
+/**
+ * Base of the JFR events that time a {@link Stage}. Besides committing to any running recording,
+ * {@link #finish()} feeds the duration to the in-process timings behind {@link
+ * PerformanceTelemetry}, so the overlay and dump work without a recording.
+ *
+ * <pre>{@code
+ * var event = new DecodeEvent();
+ * event.start();
+ * ... // the work
+ * event.file = path.toString();
+ * event.finish();
+ * }</pre>
+ */
+@Category({"Penn TotalRecall", "Performance"})
+@StackTrace(false)
+public abstract class StageEvent extends Event {
+
+    // Transient fields are not recorded
+    private transient long startNanos;
+
+    abstract Stage stage();
+
+    /** Start timing the stage. */
+    public final void start() {
+        startNanos = System.nanoTime();
+        begin();
+    }
+
+    /** Stop timing, record the duration and commit the event if a recording wants it. */
+    public final void finish() {
+        end();
+        StageTimings.record(stage(), System.nanoTime() - startNanos);
+        if (shouldCommit()) {
+            commit();
+        }
+    }
+}
@@ -0,0 +1,126 @@
+package core.telemetry;
+
+import com.google.errorprone.annotations.ThreadSafe;
+import java.util.Arrays;
+import java.util.EnumMap;
+import java.util.Map;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicLong;
+import lombok.NonNull;
+
+/**
+ * Process-wide recent durations of each {@link Stage}, and segment cache lookup counts. Static,
+ * like JFR itself, so pipeline code deep in the waveform and audio packages can feed it without
+ * having it injected.
+ */
+@ThreadSafe
+final class StageTimings {
+
+    /** Span of recent activity the statistics describe. */
+    static final long WINDOW_NANOS = TimeUnit.SECONDS.toNanos(5);
+
+    // Most recent durations kept per stage; enough for a 5 s window at 60 frames per second
+    private static final int CAPACITY = 512;
+
+    private static final Map<Stage, Ring> RINGS = new EnumMap<>(Stage.class);
+
+    static {
+        for (Stage stage : Stage.values()) {
+            RINGS.put(stage, new Ring());
+        }
+    }
+
+    private static final AtomicLong cacheHits = new AtomicLong();
+    private static final AtomicLong cacheMisses = new AtomicLong();
+
+    /**
+     * Durations of one stage over the recent window.
+     *
+     * @param total Times the stage has run since start
+     * @param recent Times it ran within the window
+     * @param perSecond Recent runs per second
+     */
+    record Stats(
+            long total,
+            int recent,
+            double perSecond,
+            double meanMillis,
+            double p95Millis,
+            double maxMillis) {}
+
+    private StageTimings() {}
+
+    static void record(@NonNull Stage stage, long durationNanos) {
+        RINGS.get(stage).add(System.nanoTime(), durationNanos);
+    }
+
+    static void recordCacheLookup(boolean hit) {
+        (hit ? cacheHits : cacheMisses).incrementAndGet();
+    }
+
+    static Stats stats(@NonNull Stage stage) {
+        return RINGS.get(stage).stats(System.nanoTime());
+    }
+
+    static long cacheHits() {
+        return cacheHits.get();
+    }
+
+    static long cacheMisses() {
+        return cacheMisses.get();
+    }
+
+    /** Forget all durations and counts. */
+    static void reset() {
+        RINGS.values().forEach(Ring::clear);
+        cacheHits.set(0);
+        cacheMisses.set(0);
+    }
+
+    /** Fixed ring of (end time, duration) pairs. */
+    private static final class Ring {
+        private final long[] ends = new long[CAPACITY];
+        private final long[] durations = new long[CAPACITY];
+        private long total;
+
+        synchronized void add(long endNanos, long durationNanos) {
+            int slot = (int) (total++ % CAPACITY);
+            ends[slot] = endNanos;
+            durations[slot] = durationNanos;
+        }
+
+        synchronized void clear() {
+            total = 0;
+        }
+
+        synchronized Stats stats(long nowNanos) {
+            int kept = (int) Math.min(total, CAPACITY);
+            long[] recent = new long[kept];
+            int count = 0;
+            long oldest = nowNanos;
+            for (int i = 0; i < kept; i++) {
+                if (nowNanos - ends[i] <= WINDOW_NANOS) {
+                    recent[count++] = durations[i];
+                    oldest = Math.min(oldest, ends[i]);
+                }
+            }
+            if (count == 0) {
+                return new Stats(total, 0, 0, 0, 0, 0);
+            }
+            Arrays.sort(recent, 0, count);
+            long sum = 0;
+            for (int i = 0; i < count; i++) {
+                sum += recent[i];
+            }
+            // A full ring may cover less than the window
+            long span = count == CAPACITY ? Math.max(1, nowNanos - oldest) : WINDOW_NANOS;
+            return new Stats(
+                    total,
+                    count,
+                    count * 1e9 / span,
+                    sum / 1e6 / count,
+                    recent[Math.min(count - 1, (int) Math.ceil(0.95 * count) - 1)] / 1e6,
+                    recent[count - 1] / 1e6);
+        }
+    }
+}
@@ -0,0 +1,160 @@
+package core.util;
+
+import com.google.errorprone.annotations.ThreadSafe;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.function.ToLongFunction;
+import lombok.NonNull;
+
+/**
+ * A least-recently-used cache bounded by the total byte size of its values rather than by entry
+ * count.
+ *
+ * <p>Each value is weighed once when it is inserted. When an insertion pushes the total over the
+ * budget, least-recently-used entries are evicted until it fits again. The entry being inserted is
+ * never evicted by its own insertion, so a single value larger than the budget is still cached
+ * (alone) rather than silently dropped.
+ *
+ * <p>Hit, miss and eviction counters are kept for diagnostics, mirroring the waveform segment
+ * cache's statistics.
+ *
+ * @param <K> key type
+ * @param <V> value type
+ */
+@ThreadSafe
+public class ByteBoundedLruCache<K, V> {
+
+    private record Entry<V>(V value, long bytes) {}
+
+    private final long maxBytes;
+    private final ToLongFunction<? super V> weigher;
+    private final LinkedHashMap<K, Entry<V>> entries = new LinkedHashMap<>(16, 0.75f, true);
+    private long currentBytes = 0;
+
+    private final AtomicLong hits = new AtomicLong();
+    private final AtomicLong misses = new AtomicLong();
+    private final AtomicLong puts = new AtomicLong();
+    private final AtomicLong evictions = new AtomicLong();
+    private final AtomicLong evictedBytes = new AtomicLong();
+
+    /**
+     * Creates a cache.
+     *
+     * @param maxBytes Byte budget for all cached values, must be positive
+     * @param weigher Returns the size in bytes of a value
+     */
+    public ByteBoundedLruCache(long maxBytes, @NonNull ToLongFunction<? super V> weigher) {
+        if (maxBytes <= 0) {
+            throw new IllegalArgumentException("Byte budget must be positive: " + maxBytes);
+        }
+        this.maxBytes = maxBytes;
+        this.weigher = weigher;
+    }
+
+    /** Returns the cached value and marks it most recently used, or null if absent. */
+    public synchronized V get(@NonNull K key) {
+        Entry<V> entry = entries.get(key);
+        if (entry == null) {
+            misses.incrementAndGet();
+            return null;
+        }
+        hits.incrementAndGet();
+        return entry.value();
+    }
+
+    /** Inserts or replaces a value, evicting least-recently-used entries to stay in budget. */
+    public synchronized void put(@NonNull K key, @NonNull V value) {
+        long bytes = Math.max(0, weigher.applyAsLong(value));
+        Entry<V> previous = entries.put(key, new Entry<>(value, bytes));
+        if (previous != null) {
+            currentBytes -= previous.bytes();
+        }
+        currentBytes += bytes;
+        puts.incrementAndGet();
+
+        Iterator<Map.Entry<K, Entry<V>>> it = entries.entrySet().iterator();
+        while (currentBytes > maxBytes && it.hasNext()) {
+            Map.Entry<K, Entry<V>> eldest = it.next();
+            if (eldest.getKey().equals(key)) {
+                // The newest entry is last in access order; nothing older is left to evict
+                break;
+            }
+            it.remove();
+            currentBytes -= eldest.getValue().bytes();
+            evictions.incrementAndGet();
+            evictedBytes.addAndGet(eldest.getValue().bytes());
+        }
+    }
+
+    /** Removes a value, returning it or null if absent. */
+    public synchronized V remove(@NonNull K key) {
+        Entry<V> entry = entries.remove(key);
+        if (entry == null) {
+            return null;
+        }
+        currentBytes -= entry.bytes();
+        return entry.value();
+    }
+
+    /** Removes all values. Cleared entries are not counted as evictions. */
+    public synchronized void clear() {
+        entries.clear();
+        currentBytes = 0;
+    }
+
+    public synchronized int size() {
+        return entries.size();
+    }
+
+    /** Total bytes currently held, as reported by the weigher. */
+    public synchronized long weightedSize() {
+        return currentBytes;
+    }
+
+    public long getMaxBytes() {
+        return maxBytes;
+    }
+
+    public long getHits() {
+        return hits.get();
+    }
+
+    public long getMisses() {
+        return misses.get();
+    }
+
+    public double getHitRate() {
+        long requests = hits.get() + misses.get();
+        return requests > 0 ? (double) hits.get() / requests : 0.0;
+    }
+
+    public long getPuts() {
+        return puts.get();
+    }
+
+    public long getEvictions() {
+        return evictions.get();
+    }
+
+    public long getEvictedBytes() {
+        return evictedBytes.get();
+    }
+
+    @Override
+    public String toString() {
+        return String.format(
+                "ByteBoundedLruCache[entries=%d, bytes=%d/%d, hits=%d (%.1f%%), misses=%d,"
+                        + " puts=%d, evictions=%d, evictedBytes=%d]",
+                size(),
+                weightedSize(),
+                maxBytes,
+                hits.get(),
+                getHitRate() * 100,
+                misses.get(),
+                puts.get(),
+                evictions.get(),
+                evictedBytes.get());
+    }
+}
@@ -0,0 +1,47 @@
+package core.util.simd;
+
+import java.lang.foreign.MemorySegment;
+
+/** Sample loops with interchangeable scalar and vector implementations. */
+interface Kernels {
+
+    /**
+     * Converts little-endian interleaved PCM to normalized doubles.
+     *
+     * @param bitsPerSample 16, 24 or 32
+     * @param count Number of samples (not frames)
+     */
+    void pcmToDouble(
+            byte[] src, int byteOffset, double[] dst, int dstOffset, int bitsPerSample, int count);
+
+    /** Converts little-endian interleaved PCM to normalized native-order floats in a segment. */
+    void pcmToFloat(
+            byte[] src,
+            int byteOffset,
+            MemorySegment dst,
+            long dstIndex,
+            int bitsPerSample,
+            int count);
+
+    /**
+     * Folds {@code samples[from, to)} into {@code acc}, which holds the running minimum, maximum
+     * and sum of squares in that order.
+     */
+    void minMaxSumSquares(double[] samples, int from, int to, double[] acc);
+
+    /** Largest {@code min(values[i], values[i + 1])} for {@code i >= from}, or 0 if none. */
+    double maxOfAdjacentMin(double[] values, int from);
+
+    /**
+     * Flattens single-sample peaks and valleys: each interior {@code dst[i]} whose {@code src[i]}
+     * is above (below) both neighbours becomes the larger (smaller) neighbour. Other elements of
+     * {@code dst} are left alone.
+     */
+    void smoothPeaksAndValleys(double[] src, double[] dst);
+
+    /**
+     * Sets {@code dst[i]} to the largest magnitude of {@code src} over {@code [i - window, i +
+     * window)}, clipped to the array. {@code src} and {@code dst} must be distinct.
+     */
+    void slidingAbsMax(double[] src, int window, double[] dst);
+}
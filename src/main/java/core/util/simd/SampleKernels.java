@@ -0,0 +1,111 @@
+package core.util.simd;
+
+import java.lang.foreign.MemorySegment;
+import lombok.extern.slf4j.Slf4j;
+
+/**
+ * Hot sample loops for decoding and waveform DSP, vectorized with the incubating Vector API when it
+ * is available.
+ *
+ * <p>The vector kernels run when the JVM resolves {@code jdk.incubator.vector} (the build, tests
+ * and packaged launchers pass {@code --add-modules jdk.incubator.vector} unless built with {@code
+ * -PvectorApi=false}, which also drops the JVM's incubator warning) and the hardware has
+ * vectors of at least four floats. Otherwise, or with {@code -Dsimd.enabled=false}, the equivalent
+ * scalar loops run. Both give identical results apart from summation order in {@link
+ * #minMaxSumSquares}.
+ */
+@Slf4j
+public final class SampleKernels {
+
+    static final String ENABLED_PROPERTY = "simd.enabled";
+    private static final String VECTOR_MODULE = "jdk.incubator.vector";
+
+    private static final Kernels KERNELS = select();
+
+    /** Private constructor to prevent instantiation. */
+    private SampleKernels() {}
+
+    private static Kernels select() {
+        if (!Boolean.parseBoolean(System.getProperty(ENABLED_PROPERTY, "true"))) {
+            log.debug("Vector kernels disabled by {}", ENABLED_PROPERTY);
+            return new ScalarKernels();
+        }
+        if (ModuleLayer.boot().findModule(VECTOR_MODULE).isEmpty()) {
+            log.debug("{} not resolved, using scalar kernels", VECTOR_MODULE);
+            return new ScalarKernels();
+        }
+        try {
+            if (VectorKernels.isWorthwhile()) {
+                log.debug("Using Vector API sample kernels");
+                return new VectorKernels();
+            }
+        } catch (LinkageError e) {
+            log.debug("Vector API unavailable, using scalar kernels: {}", e.toString());
+        }
+        return new ScalarKernels();
+    }
+
+    /** Whether the vector kernels are in use. */
+    public static boolean isVectorized() {
+        return KERNELS instanceof VectorKernels;
+    }
+
+    /**
+     * Converts {@code count} little-endian PCM samples starting at {@code byteOffset} into
+     * normalized doubles in {@code dst} starting at {@code dstOffset}.
+     *
+     * @param bitsPerSample 16, 24 or 32
+     * @throws UnsupportedOperationException for other bit depths
+     */
+    public static void pcmToDouble(
+            byte[] src, int byteOffset, double[] dst, int dstOffset, int bitsPerSample, int count) {
+        KERNELS.pcmToDouble(src, byteOffset, dst, dstOffset, bitsPerSample, count);
+    }
+
+    /**
+     * Converts {@code count} little-endian PCM samples starting at {@code byteOffset} into
+     * normalized native-order floats in {@code dst} starting at float index {@code dstIndex}.
+     *
+     * @param bitsPerSample 16, 24 or 32
+     * @throws UnsupportedOperationException for other bit depths
+     */
+    public static void pcmToFloat(
+            byte[] src,
+            int byteOffset,
+            MemorySegment dst,
+            long dstIndex,
+            int bitsPerSample,
+            int count) {
+        KERNELS.pcmToFloat(src, byteOffset, dst, dstIndex, bitsPerSample, count);
+    }
+
+    /**
+     * Folds {@code samples[from, to)} into {@code acc}, which holds a running minimum, maximum and
+     * sum of squares in that order.
+     */
+    public static void minMaxSumSquares(double[] samples, int from, int to, double[] acc) {
+        KERNELS.minMaxSumSquares(samples, from, to, acc);
+    }
+
+    /** Largest {@code min(values[i], values[i + 1])} for {@code i >= from}, or 0 if none. */
+    public static double maxOfAdjacentMin(double[] values, int from) {
+        return KERNELS.maxOfAdjacentMin(values, from);
+    }
+
+    /**
+     * Flattens single-sample peaks and valleys of {@code src} into {@code dst}, which must start as
+     * a copy of {@code src}.
+     */
+    public static void smoothPeaksAndValleys(double[] src, double[] dst) {
+        KERNELS.smoothPeaksAndValleys(src, dst);
+    }
+
+    /**
+     * Sets each {@code dst[i]} to the largest magnitude in {@code src} over {@code [i - window, i +
+     * window)}, clipped to the array, or to 0 when {@code window <= 0}. {@code src} and {@code
+     * dst} must be distinct arrays.
+     */
+    public static void slidingAbsMax(double[] src, int window, double[] dst) {
+        KERNELS.slidingAbsMax(src, window, dst);
+    }
+}
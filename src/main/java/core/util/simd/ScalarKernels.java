@@ -0,0 +1,152 @@
+package core.util.simd;
+
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.util.ArrayDeque;
+import java.util.Deque;
+
+/** Plain loops; the reference behaviour and the fallback when vectors are unavailable. */
+final class ScalarKernels implements Kernels {
+
+    @Override
+    public void pcmToDouble(
+            byte[] src, int byteOffset, double[] dst, int dstOffset, int bitsPerSample, int count) {
+        if (bitsPerSample == 16) {
+            for (int i = 0; i < count; i++) {
+                dst[dstOffset + i] = pcm16(src, byteOffset + i * 2) / 32768.0;
+            }
+        } else if (bitsPerSample == 24) {
+            for (int i = 0; i < count; i++) {
+                dst[dstOffset + i] = pcm24(src, byteOffset + i * 3) / 8388608.0;
+            }
+        } else if (bitsPerSample == 32) {
+            for (int i = 0; i < count; i++) {
+                dst[dstOffset + i] = pcm32(src, byteOffset + i * 4) / 2147483648.0;
+            }
+        } else {
+            throw new UnsupportedOperationException("Unsupported bit depth: " + bitsPerSample);
+        }
+    }
+
+    @Override
+    public void pcmToFloat(
+            byte[] src,
+            int byteOffset,
+            MemorySegment dst,
+            long dstIndex,
+            int bitsPerSample,
+            int count) {
+        if (bitsPerSample == 16) {
+            for (int i = 0; i < count; i++) {
+                float value = (float) (pcm16(src, byteOffset + i * 2) / 32768.0);
+                dst.setAtIndex(ValueLayout.JAVA_FLOAT, dstIndex + i, value);
+            }
+        } else if (bitsPerSample == 24) {
+            for (int i = 0; i < count; i++) {
+                float value = (float) (pcm24(src, byteOffset + i * 3) / 8388608.0);
+                dst.setAtIndex(ValueLayout.JAVA_FLOAT, dstIndex + i, value);
+            }
+        } else if (bitsPerSample == 32) {
+            for (int i = 0; i < count; i++) {
+                float value = (float) (pcm32(src, byteOffset + i * 4) / 2147483648.0);
+                dst.setAtIndex(ValueLayout.JAVA_FLOAT, dstIndex + i, value);
+            }
+        } else {
+            throw new UnsupportedOperationException("Unsupported bit depth: " + bitsPerSample);
+        }
+    }
+
+    private static int pcm16(byte[] src, int i) {
+        return (short) ((src[i] & 0xFF) | (src[i + 1] << 8));
+    }
+
+    private static int pcm24(byte[] src, int i) {
+        int value = (src[i] & 0xFF) | ((src[i + 1] & 0xFF) << 8) | (src[i + 2] << 16);
+        if ((value & 0x800000) != 0) {
+            value |= 0xFF000000;
+        }
+        return value;
+    }
+
+    private static int pcm32(byte[] src, int i) {
+        return (src[i] & 0xFF)
+                | ((src[i + 1] & 0xFF) << 8)
+                | ((src[i + 2] & 0xFF) << 16)
+                | (src[i + 3] << 24);
+    }
+
+    @Override
+    public void minMaxSumSquares(double[] samples, int from, int to, double[] acc) {
+        double min = acc[0];
+        double max = acc[1];
+        double sumSquares = acc[2];
+        for (int i = from; i < to; i++) {
+            double s = samples[i];
+            min = Math.min(min, s);
+            max = Math.max(max, s);
+            sumSquares += s * s;
+        }
+        acc[0] = min;
+        acc[1] = max;
+        acc[2] = sumSquares;
+    }
+
+    @Override
+    public double maxOfAdjacentMin(double[] values, int from) {
+        double maxConsecutive = 0;
+        for (int i = from; i < values.length - 1; i++) {
+            maxConsecutive = Math.max(Math.min(values[i], values[i + 1]), maxConsecutive);
+        }
+        return maxConsecutive;
+    }
+
+    @Override
+    public void smoothPeaksAndValleys(double[] src, double[] dst) {
+        for (int i = 1; i < src.length - 1; i++) {
+            if (src[i] > src[i - 1] && src[i] > src[i + 1]) {
+                // Smooth peak
+                dst[i] = Math.max(src[i + 1], src[i - 1]);
+            } else if (src[i] < src[i - 1] && src[i] < src[i + 1]) {
+                // Smooth valley
+                dst[i] = Math.min(src[i + 1], src[i - 1]);
+            }
+        }
+    }
+
+    @Override
+    public void slidingAbsMax(double[] src, int window, double[] dst) {
+        int n = src.length;
+
+        // Sliding window maximum with monotonic deque for O(n) complexity
+        Deque<Integer> maxDeque = new ArrayDeque<>();
+
+        for (int i = 0; i < n; i++) {
+            int windowStart = Math.max(0, i - window);
+            int windowEnd = Math.min(n, i + window);
+
+            // Remove elements outside current window from front
+            while (!maxDeque.isEmpty() && maxDeque.peekFirst() < windowStart) {
+                maxDeque.removeFirst();
+            }
+
+            // Add elements to the window from the right
+            // For i=0, add entire window [windowStart, windowEnd)
+            // For i>0, only add new elements that entered the window
+            int addStart =
+                    (i == 0) ? windowStart : Math.max(windowStart, Math.min(n, (i - 1) + window));
+
+            for (int j = addStart; j < windowEnd; j++) {
+                double absValue = Math.abs(src[j]);
+
+                // Remove smaller elements from back to maintain monotonic decreasing order
+                while (!maxDeque.isEmpty() && Math.abs(src[maxDeque.peekLast()]) <= absValue) {
+                    maxDeque.removeLast();
+                }
+                maxDeque.addLast(j);
+            }
+
+            // Front of deque has the index of maximum element in current window
+            dst[i] = maxDeque.isEmpty() ? 0.0 : Math.abs(src[maxDeque.peekFirst()]);
+        }
+    }
+}
@@ -0,0 +1,289 @@
+package core.util.simd;
+
+import java.lang.foreign.MemorySegment;
+import java.nio.ByteOrder;
+import java.util.Arrays;
+import jdk.incubator.vector.DoubleVector;
+import jdk.incubator.vector.FloatVector;
+import jdk.incubator.vector.IntVector;
+import jdk.incubator.vector.ShortVector;
+import jdk.incubator.vector.VectorMask;
+import jdk.incubator.vector.VectorOperators;
+import jdk.incubator.vector.VectorShape;
+import jdk.incubator.vector.VectorSpecies;
+
+/**
+ * Vector API implementations at the platform's preferred vector width. Loop tails, and 24-bit PCM
+ * (whose 3-byte samples do not map onto lanes), use the scalar kernels.
+ *
+ * <p>Only load this class once {@code jdk.incubator.vector} is known to be resolved.
+ */
+final class VectorKernels implements Kernels {
+
+    private static final VectorSpecies<Double> DOUBLES = DoubleVector.SPECIES_PREFERRED;
+    private static final VectorSpecies<Float> FLOATS = FloatVector.SPECIES_PREFERRED;
+
+    // PCM lanes to load per step; at least 64 bits, so narrow hardware widens in several parts
+    private static final VectorSpecies<Short> SHORTS_TO_DOUBLES = loadSpecies(short.class, 16);
+    private static final VectorSpecies<Integer> INTS_TO_DOUBLES = loadSpecies(int.class, 32);
+    private static final VectorSpecies<Short> SHORTS_TO_FLOATS =
+            VectorSpecies.of(
+                    short.class, VectorShape.forBitSize(Math.max(64, FLOATS.length() * 16)));
+    private static final VectorSpecies<Integer> INTS_TO_FLOATS =
+            VectorSpecies.of(int.class, FLOATS.vectorShape());
+
+    private static final double PCM16_SCALE = 1.0 / 32768.0;
+    private static final double PCM32_SCALE = 1.0 / 2147483648.0;
+
+    private final ScalarKernels scalar = new ScalarKernels();
+
+    /** Whether vectors are wide enough here to beat the scalar loops. */
+    static boolean isWorthwhile() {
+        return DOUBLES.length() >= 2 && FLOATS.length() >= 4;
+    }
+
+    private static <E> VectorSpecies<E> loadSpecies(Class<E> type, int elementBits) {
+        return VectorSpecies.of(
+                type, VectorShape.forBitSize(Math.max(64, DOUBLES.length() * elementBits)));
+    }
+
+    @Override
+    public void pcmToDouble(
+            byte[] src, int byteOffset, double[] dst, int dstOffset, int bitsPerSample, int count) {
+        MemorySegment in = MemorySegment.ofArray(src);
+        int lanes = DOUBLES.length();
+        int done = 0;
+        if (bitsPerSample == 16) {
+            int step = SHORTS_TO_DOUBLES.length();
+            for (; done <= count - step; done += step) {
+                ShortVector pcm =
+                        ShortVector.fromMemorySegment(
+                                SHORTS_TO_DOUBLES,
+                                in,
+                                byteOffset + 2L * done,
+                                ByteOrder.LITTLE_ENDIAN);
+                for (int part = 0; part < step / lanes; part++) {
+                    ((DoubleVector) pcm.convertShape(VectorOperators.S2D, DOUBLES, part))
+                            .mul(PCM16_SCALE)
+                            .intoArray(dst, dstOffset + done + part * lanes);
+                }
+            }
+            scalar.pcmToDouble(
+                    src, byteOffset + 2 * done, dst, dstOffset + done, 16, count - done);
+        } else if (bitsPerSample == 32) {
+            int step = INTS_TO_DOUBLES.length();
+            for (; done <= count - step; done += step) {
+                IntVector pcm =
+                        IntVector.fromMemorySegment(
+                                INTS_TO_DOUBLES,
+                                in,
+                                byteOffset + 4L * done,
+                                ByteOrder.LITTLE_ENDIAN);
+                for (int part = 0; part < step / lanes; part++) {
+                    ((DoubleVector) pcm.convertShape(VectorOperators.I2D, DOUBLES, part))
+                            .mul(PCM32_SCALE)
+                            .intoArray(dst, dstOffset + done + part * lanes);
+                }
+            }
+            scalar.pcmToDouble(
+                    src, byteOffset + 4 * done, dst, dstOffset + done, 32, count - done);
+        } else {
+            scalar.pcmToDouble(src, byteOffset, dst, dstOffset, bitsPerSample, count);
+        }
+    }
+
+    @Override
+    public void pcmToFloat(
+            byte[] src,
+            int byteOffset,
+            MemorySegment dst,
+            long dstIndex,
+            int bitsPerSample,
+            int count) {
+        if (!dst.isNative()) {
+            // Vector stores into heap segments are limited to byte[] backing
+            scalar.pcmToFloat(src, byteOffset, dst, dstIndex, bitsPerSample, count);
+            return;
+        }
+        MemorySegment in = MemorySegment.ofArray(src);
+        ByteOrder order = ByteOrder.nativeOrder();
+        int lanes = FLOATS.length();
+        int done = 0;
+        if (bitsPerSample == 16) {
+            int step = SHORTS_TO_FLOATS.length();
+            for (; done <= count - step; done += step) {
+                ShortVector pcm =
+                        ShortVector.fromMemorySegment(
+                                SHORTS_TO_FLOATS,
+                                in,
+                                byteOffset + 2L * done,
+                                ByteOrder.LITTLE_ENDIAN);
+                for (int part = 0; part < step / lanes; part++) {
+                    long index = dstIndex + done + (long) part * lanes;
+                    ((FloatVector) pcm.convertShape(VectorOperators.S2F, FLOATS, part))
+                            .mul((float) PCM16_SCALE)
+                            .intoMemorySegment(dst, index * Float.BYTES, order);
+                }
+            }
+            scalar.pcmToFloat(
+                    src, byteOffset + 2 * done, dst, dstIndex + done, 16, count - done);
+        } else if (bitsPerSample == 32) {
+            // int -> float rounds once and the power-of-two scale is exact, as in the scalar path
+            for (; done <= count - lanes; done += lanes) {
+                IntVector pcm =
+                        IntVector.fromMemorySegment(
+                                INTS_TO_FLOATS,
+                                in,
+                                byteOffset + 4L * done,
+                                ByteOrder.LITTLE_ENDIAN);
+                ((FloatVector) pcm.convertShape(VectorOperators.I2F, FLOATS, 0))
+                        .mul((float) PCM32_SCALE)
+                        .intoMemorySegment(dst, (dstIndex + done) * Float.BYTES, order);
+            }
+            scalar.pcmToFloat(
+                    src, byteOffset + 4 * done, dst, dstIndex + done, 32, count - done);
+        } else {
+            scalar.pcmToFloat(src, byteOffset, dst, dstIndex, bitsPerSample, count);
+        }
+    }
+
+    @Override
+    public void minMaxSumSquares(double[] samples, int from, int to, double[] acc) {
+        int lanes = DOUBLES.length();
+        int i = from;
+        if (to - from >= lanes) {
+            DoubleVector min = DoubleVector.broadcast(DOUBLES, Double.POSITIVE_INFINITY);
+            DoubleVector max = DoubleVector.broadcast(DOUBLES, Double.NEGATIVE_INFINITY);
+            DoubleVector sumSquares = DoubleVector.zero(DOUBLES);
+            for (; i <= to - lanes; i += lanes) {
+                DoubleVector v = DoubleVector.fromArray(DOUBLES, samples, i);
+                min = min.min(v);
+                max = max.max(v);
+                sumSquares = v.fma(v, sumSquares);
+            }
+            acc[0] = Math.min(acc[0], min.reduceLanes(VectorOperators.MIN));
+            acc[1] = Math.max(acc[1], max.reduceLanes(VectorOperators.MAX));
+            acc[2] += sumSquares.reduceLanes(VectorOperators.ADD);
+        }
+        scalar.minMaxSumSquares(samples, i, to, acc);
+    }
+
+    @Override
+    public double maxOfAdjacentMin(double[] values, int from) {
+        int lanes = DOUBLES.length();
+        int i = from;
+        DoubleVector best = DoubleVector.zero(DOUBLES);
+        // Each step reads values[i, i + lanes]; stop while that is still in bounds
+        for (; i + lanes < values.length; i += lanes) {
+            DoubleVector here = DoubleVector.fromArray(DOUBLES, values, i);
+            DoubleVector next = DoubleVector.fromArray(DOUBLES, values, i + 1);
+            best = best.max(here.min(next));
+        }
+        double tail = scalar.maxOfAdjacentMin(values, i);
+        return Math.max(best.reduceLanes(VectorOperators.MAX), tail);
+    }
+
+    @Override
+    public void smoothPeaksAndValleys(double[] src, double[] dst) {
+        int lanes = DOUBLES.length();
+        int i = 1;
+        for (; i + lanes < src.length; i += lanes) {
+            DoubleVector prev = DoubleVector.fromArray(DOUBLES, src, i - 1);
+            DoubleVector cur = DoubleVector.fromArray(DOUBLES, src, i);
+            DoubleVector next = DoubleVector.fromArray(DOUBLES, src, i + 1);
+            VectorMask<Double> peak =
+                    cur.compare(VectorOperators.GT, prev)
+                            .and(cur.compare(VectorOperators.GT, next));
+            VectorMask<Double> valley =
+                    cur.compare(VectorOperators.LT, prev)
+                            .and(cur.compare(VectorOperators.LT, next));
+            DoubleVector.fromArray(DOUBLES, dst, i)
+                    .blend(prev.max(next), peak)
+                    .blend(prev.min(next), valley)
+                    .intoArray(dst, i);
+        }
+        // Finish the interior with the scalar rule, starting from the first unprocessed centre
+        for (; i < src.length - 1; i++) {
+            if (src[i] > src[i - 1] && src[i] > src[i + 1]) {
+                dst[i] = Math.max(src[i + 1], src[i - 1]);
+            } else if (src[i] < src[i - 1] && src[i] < src[i + 1]) {
+                dst[i] = Math.min(src[i + 1], src[i - 1]);
+            }
+        }
+    }
+
+    /**
+     * Builds, by repeated doubling, {@code spans[j]} = max magnitude over {@code [j, j + p)} for
+     * the largest power of two {@code p <= 2 * window}; each output is then the larger of two
+     * overlapping spans. That is {@code log2(window) + 2} branch-free passes instead of a deque.
+     */
+    @Override
+    public void slidingAbsMax(double[] src, int window, double[] dst) {
+        int n = src.length;
+        if (window <= 0) {
+            // Every window is empty, as in the deque version
+            Arrays.fill(dst, 0, n, 0.0);
+            return;
+        }
+        int lanes = DOUBLES.length();
+        double[] spans = new double[n];
+        double[] next = new double[n];
+
+        int i = 0;
+        for (; i <= n - lanes; i += lanes) {
+            DoubleVector.fromArray(DOUBLES, src, i).abs().intoArray(spans, i);
+        }
+        for (; i < n; i++) {
+            spans[i] = Math.abs(src[i]);
+        }
+
+        long span = 2L * window;
+        int p = 1;
+        while (2L * p <= span && p < n) {
+            // next[j] = max(spans[j], spans[j + p]); magnitudes past the end count as 0
+            int j = 0;
+            for (; j <= n - p - lanes; j += lanes) {
+                DoubleVector.fromArray(DOUBLES, spans, j)
+                        .max(DoubleVector.fromArray(DOUBLES, spans, j + p))
+                        .intoArray(next, j);
+            }
+            for (; j < n - p; j++) {
+                next[j] = Math.max(spans[j], spans[j + p]);
+            }
+            System.arraycopy(spans, Math.max(0, n - p), next, Math.max(0, n - p), Math.min(p, n));
+            double[] swap = spans;
+            spans = next;
+            next = swap;
+            p *= 2;
+        }
+
+        // Interior outputs, where [i - window, i + window) lies within the array
+        int k = window;
+        for (; k + lanes - 1 <= n - window; k += lanes) {
+            DoubleVector.fromArray(DOUBLES, spans, k - window)
+                    .max(DoubleVector.fromArray(DOUBLES, spans, k + window - p))
+                    .intoArray(dst, k);
+        }
+        for (int o = 0; o < n; o++) {
+            if (o >= window && o < k) {
+                continue;
+            }
+            dst[o] = windowMax(src, spans, p, Math.max(0, o - window), Math.min(n, o + window));
+        }
+    }
+
+    /** Max magnitude over {@code [start, end)} given spans of length {@code p} (clipped at n). */
+    private static double windowMax(double[] src, double[] spans, int p, int start, int end) {
+        if (end - start >= p) {
+            return Math.max(spans[start], spans[end - p]);
+        }
+        if (end == src.length) {
+            return spans[start];
+        }
+        double max = 0;
+        for (int j = start; j < end; j++) {
+            max = Math.max(max, Math.abs(src[j]));
+        }
+        return max;
+    }
+}
@@ -6,26 +6,37 @@ import core.viewport.smoothing.PhaseLockedLoopSmoother;
 import core.viewport.smoothing.PlayheadSmoother;
 import core.viewport.smoothing.SmoothingMetrics;
 import core.waveform.WaveformViewportSpec;
+import jakarta.inject.Inject;
+import java.util.concurrent.TimeUnit;
 import lombok.NonNull;
 import lombok.extern.slf4j.Slf4j;
 
 /**
  * Default, pure implementation of ViewportProjector. Frame-based math with deterministic
- * generation. Includes optional playhead smoothing for visual comfort during playback.
+ * generation. Includes optional playhead smoothing for visual comfort during playback, sampled at
+ * the display frame times stamped on the {@link FrameClock}.
  */
 @Slf4j
 public class DefaultViewportProjector implements ViewportProjector {
 
-    private static final int RENDER_FPS = 60; // Target render frame rate
+    private static final int RENDER_FPS = 60; // Nominal render frame rate, for sizing metrics
     private long generationCounter = 0;
+    private final FrameClock frameClock;
     private final MetricsAwarePlayheadSmoother smoother;
     private final SmoothingMetrics renderMetrics; // Separate metrics for render-rate sampling
-    private long lastUpdateTimeMs = System.currentTimeMillis();
+    private long lastUpdateNanos = System.nanoTime();
+    private FrameClock.Frame lastFrame; // Last scheduler frame recorded in renderMetrics
     private long lastRenderedFrame = 0; // Track last rendered position for metrics
     private long frameCounter = 0;
     private static final long REPORT_INTERVAL = 500; // Report metrics every 500 frames
 
     public DefaultViewportProjector() {
+        this(new FrameClock());
+    }
+
+    @Inject
+    public DefaultViewportProjector(@NonNull FrameClock frameClock) {
+        this.frameClock = frameClock;
         // Choose which smoother to use
         PlayheadSmoother baseSmoother = createSmoother();
         this.smoother = new MetricsAwarePlayheadSmoother(baseSmoother, 100);
@@ -60,31 +71,42 @@ public class DefaultViewportProjector implements ViewportProjector {
             smoother.reset(); // Reset smoother when not rendering
             renderMetrics.reset(); // Reset render metrics too
             lastRenderedFrame = 0; // Reset position tracking
+            lastFrame = null;
             return new Projection(mode, 0L, 0L, ++generationCounter, audio.errorMessage());
         }
 
-        // Calculate time delta for smoothing
-        long currentTimeMs = System.currentTimeMillis();
-        long deltaMs = currentTimeMs - lastUpdateTimeMs;
-        lastUpdateTimeMs = currentTimeMs;
+        // Calculate time delta for smoothing from the frame being prepared
+        long frameTimeNanos = frameClock.frameTimeNanos();
+        double deltaMs = (frameTimeNanos - lastUpdateNanos) / 1e6;
+        lastUpdateNanos = frameTimeNanos;
+        long currentTimeMs = TimeUnit.NANOSECONDS.toMillis(frameTimeNanos);
+
+        // Record frame delivery once per scheduled frame, not per projection
+        FrameClock.Frame frame = frameClock.currentFrame();
+        if (frame != null && frame != lastFrame) {
+            renderMetrics.addFrame(frame.startedNanos(), frame.droppedFrames());
+            lastFrame = frame;
+        }
 
         // Update smoother and get smoothed position
         PlayheadSmoother.SmoothingResult smoothingResult =
                 smoother.updateAndGetSmoothedPosition(
-                        audio.playheadFrame(), deltaMs, audio.state());
+                        audio.playheadFrame(), frameTimeNanos, audio.state());
 
         // Collect render-rate metrics (every frame at display FPS)
         // We measure smoothness by tracking how the rendered position changes frame-to-frame
         // NOT by comparing to audio position (which updates infrequently)
-        if (audio.state() == core.audio.session.AudioSessionStateMachine.State.PLAYING) {
+        if (audio.state() == core.audio.session.AudioSessionStateMachine.State.PLAYING
+                && deltaMs > 0) {
             // Use a synthetic "target" that represents ideal linear progression
             // This lets us measure the actual visual smoothness
             long expectedFrame =
-                    lastRenderedFrame + (long) (deltaMs * 44.1); // 44.1 frames/ms at 44100Hz
+                    lastRenderedFrame + Math.round(deltaMs * 44.1); // 44.1 frames/ms at 44100Hz
             renderMetrics.addSample(currentTimeMs, smoothingResult.smoothedFrame(), expectedFrame);
             lastRenderedFrame = smoothingResult.smoothedFrame();
         } else {
-            // When paused or stopped, update position without collecting metrics
+            // When paused or stopped (or the same frame is projected again), update position
+            // without collecting metrics
             lastRenderedFrame = smoothingResult.smoothedFrame();
         }
 
@@ -92,6 +114,7 @@ public class DefaultViewportProjector implements ViewportProjector {
         frameCounter++;
         if (frameCounter % REPORT_INTERVAL == 0) {
             SmoothingMetrics.SmoothnessScores scores = renderMetrics.calculateScores();
+            SmoothingMetrics.FrameTimingStats timing = renderMetrics.calculateFrameTiming();
             if (scores != null) {
                 // Get smoother name and abbreviate it
                 String fullName = smoother.getDelegate().getClass().getSimpleName();
@@ -108,7 +131,7 @@ public class DefaultViewportProjector implements ViewportProjector {
                 String header =
                         String.format(
                                 "%s Smoothing @ %dfps (frame %d)",
-                                smootherName, RENDER_FPS, frameCounter);
+                                smootherName, frameRate(frame), frameCounter);
 
                 // Calculate padding to center the header (50 chars total inside box)
                 int totalInnerWidth = 50;
@@ -137,6 +160,26 @@ public class DefaultViewportProjector implements ViewportProjector {
                         String.format("║ %-18s ║ %24.2f ms ║\n", "Max Lag", scores.maxLagMs()));
                 table.append(
                         String.format("║ %-18s ║ %25.1f %% ║\n", "Overshoot", scores.overshoot()));
+                if (timing != null) {
+                    table.append(
+                            String.format(
+                                    "║ %-18s ║ %24.2f ms ║\n",
+                                    "Frame Interval",
+                                    timing.meanIntervalMs()));
+                    table.append(
+                            String.format(
+                                    "║ %-18s ║ %24.2f ms ║\n", "Frame Jitter", timing.jitterMs()));
+                    table.append(
+                            String.format(
+                                    "║ %-18s ║ %24.2f ms ║\n",
+                                    "P99 Frame Interval",
+                                    timing.p99IntervalMs()));
+                    table.append(
+                            String.format(
+                                    "║ %-18s ║ %27d ║\n",
+                                    "Dropped Frames",
+                                    timing.droppedFrames()));
+                }
                 table.append("╚════════════════════╩═════════════════════════════╝");
                 log.info(table.toString());
             }
@@ -161,6 +204,13 @@ public class DefaultViewportProjector implements ViewportProjector {
                 PaintMode.RENDER, startFrame, endFrame, generation, audio.errorMessage());
     }
 
+    /** Frames per second the scheduler is delivering, or the nominal rate if unscheduled. */
+    private static long frameRate(FrameClock.Frame frame) {
+        return frame != null && frame.periodNanos() > 0
+                ? Math.round(1e9 / frame.periodNanos())
+                : RENDER_FPS;
+    }
+
     @Override
     public WaveformViewportSpec toWaveformViewport(
             @NonNull Projection p,
@@ -0,0 +1,44 @@
+package core.viewport;
+
+import com.google.errorprone.annotations.ThreadSafe;
+import jakarta.inject.Singleton;
+
+/**
+ * Timestamp of the display frame being prepared, stamped by the frame scheduler before it asks for
+ * a frame and read by the projector so the playhead smoothers sample at frame times rather than at
+ * whenever a paint happened to run.
+ *
+ * <p>Until the scheduler stamps a frame, {@link #frameTimeNanos()} falls back to the current time.
+ */
+@Singleton
+@ThreadSafe
+public final class FrameClock {
+
+    /**
+     * A stamped frame.
+     *
+     * @param timeNanos Nominal presentation time, on the display's refresh grid
+     * @param startedNanos When the frame actually started preparing
+     * @param periodNanos Interval between frames at the current rate
+     * @param droppedFrames Frames skipped since the previous one because it was still pending
+     */
+    public record Frame(long timeNanos, long startedNanos, long periodNanos, int droppedFrames) {}
+
+    private volatile Frame current;
+
+    /** Stamp the frame about to be prepared. */
+    public void beginFrame(long timeNanos, long periodNanos, int droppedFrames) {
+        current = new Frame(timeNanos, System.nanoTime(), periodNanos, droppedFrames);
+    }
+
+    /** The frame being prepared, or null before the scheduler has stamped one. */
+    public Frame currentFrame() {
+        return current;
+    }
+
+    /** Presentation time of the frame being prepared, on the {@link System#nanoTime()} scale. */
+    public long frameTimeNanos() {
+        Frame frame = current;
+        return frame != null ? frame.timeNanos() : System.nanoTime();
+    }
+}
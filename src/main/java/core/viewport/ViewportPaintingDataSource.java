@@ -1,6 +1,7 @@
 package core.viewport;
 
 import core.waveform.ScreenDimension;
+import core.waveform.WaveformTileSet;
 import java.awt.Image;
 import java.util.Optional;
 import java.util.concurrent.CompletableFuture;
@@ -9,9 +10,9 @@ import java.util.concurrent.CompletableFuture;
  * Data source for viewport painting operations (new, playhead-anchored API).
  *
  * <p>This interface provides a single, immutable, frame-based context for painting. The returned
- * image is pre-aligned so the absolute playhead frame maps to the horizontal center (50%) of the
- * viewport. The painter simply draws the image to the full viewport bounds and draws the playhead
- * at the center, without additional layout logic.
+ * tiles are pre-aligned so the absolute playhead frame maps to the horizontal center (50%) of the
+ * viewport. The painter simply draws the tiles at their positions and draws the playhead at the
+ * center, without additional layout logic.
  */
 public interface ViewportPaintingDataSource {
 
@@ -29,13 +30,30 @@ public interface ViewportPaintingDataSource {
      *
      * <p>The specId uniquely identifies this spec's content, incorporating the underlying segment
      * cache keys to ensure changes at any layer trigger repaints.
+     *
+     * <p>{@code tiles} completes with the waveform's segment images and their placement (null
+     * outside {@link PaintMode#RENDER} or if rendering failed). {@code preview} is an approximate
+     * image (e.g. rescaled from a neighbouring zoom level) the painter may show while {@code tiles}
+     * is still rendering.
      */
     record ViewportRenderSpec(
             PaintMode mode,
             Optional<String> errorMessage,
-            CompletableFuture<Image> image,
+            CompletableFuture<WaveformTileSet> tiles,
+            Optional<Image> preview,
             long generation,
-            String specId) {}
+            String specId) {
+
+        /** Creates a spec without a preview. */
+        public ViewportRenderSpec(
+                PaintMode mode,
+                Optional<String> errorMessage,
+                CompletableFuture<WaveformTileSet> tiles,
+                long generation,
+                String specId) {
+            this(mode, errorMessage, tiles, Optional.empty(), generation, specId);
+        }
+    }
 
     /** Build a render spec for the given viewport bounds. */
     ViewportRenderSpec getRenderSpec(ScreenDimension bounds);
@@ -10,11 +10,13 @@ import core.viewport.ViewportPaintingDataSource.PaintMode;
 import core.waveform.ScreenDimension;
 import core.waveform.Waveform;
 import core.waveform.WaveformManager;
+import core.waveform.WaveformTileSet;
 import jakarta.inject.Inject;
 import jakarta.inject.Singleton;
 import java.awt.Image;
 import java.util.Optional;
 import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.atomic.AtomicBoolean;
 import java.util.concurrent.atomic.AtomicReference;
 import lombok.NonNull;
 import lombok.extern.slf4j.Slf4j;
@@ -41,6 +43,9 @@ public class ViewportSessionManager implements ViewportPaintingDataSource {
     // We initialize it lazily when the sample rate is known to keep DEFAULT_PPS as the sole source.
     private final AtomicReference<Double> framesPerPixel = new AtomicReference<>(Double.NaN);
 
+    // Whether the viewport shows the spectrogram instead of the waveform
+    private final AtomicBoolean spectrogramVisible = new AtomicBoolean(false);
+
     @Inject
     public ViewportSessionManager(
             @NonNull EventDispatchBus eventBus,
@@ -53,16 +58,27 @@ public class ViewportSessionManager implements ViewportPaintingDataSource {
         eventBus.subscribe(this);
     }
 
+    /** Whether the viewport shows the file's spectrogram rather than its waveform. */
+    public boolean isSpectrogramVisible() {
+        return spectrogramVisible.get();
+    }
+
+    /** Switch the viewport between the spectrogram and the waveform; the next frame shows it. */
+    public void setSpectrogramVisible(boolean visible) {
+        spectrogramVisible.set(visible);
+    }
+
     // Command history removed; use debug logs for traceability.
-    /** Adjust zoom level based on user ZoomEvent (IN/OUT). */
+    /** Adjust zoom level based on user ZoomEvent (IN/OUT), one factor of 1.5 per step. */
     @Subscribe
     public void onZoom(@NonNull ZoomEvent event) {
         double cur = framesPerPixel.get();
-        double next = event.direction() == ZoomEvent.Direction.IN ? (cur / 1.5) : (cur * 1.5);
+        double factor = Math.pow(1.5, event.steps());
+        double next = event.direction() == ZoomEvent.Direction.IN ? (cur / factor) : (cur * factor);
         if (next < MIN_FRAMES_PER_PIXEL) next = MIN_FRAMES_PER_PIXEL;
         if (next > MAX_FRAMES_PER_PIXEL) next = MAX_FRAMES_PER_PIXEL;
         framesPerPixel.set(next);
-        log.debug("Zoom {} -> {} frames/pixel", event.direction(), next);
+        log.debug("Zoom {} x{} -> {} frames/pixel", event.direction(), event.steps(), next);
     }
 
     @Override
@@ -77,7 +93,7 @@ public class ViewportSessionManager implements ViewportPaintingDataSource {
             return new ViewportRenderSpec(
                     PaintMode.ERROR,
                     snap.errorMessage(),
-                    CompletableFuture.<Image>completedFuture(null),
+                    CompletableFuture.<WaveformTileSet>completedFuture(null),
                     0L,
                     specId);
         }
@@ -86,7 +102,7 @@ public class ViewportSessionManager implements ViewportPaintingDataSource {
             return new ViewportRenderSpec(
                     PaintMode.LOADING,
                     Optional.empty(),
-                    CompletableFuture.<Image>completedFuture(null),
+                    CompletableFuture.<WaveformTileSet>completedFuture(null),
                     0L,
                     specId);
         }
@@ -96,7 +112,7 @@ public class ViewportSessionManager implements ViewportPaintingDataSource {
             return new ViewportRenderSpec(
                     PaintMode.EMPTY,
                     Optional.empty(),
-                    CompletableFuture.<Image>completedFuture(null),
+                    CompletableFuture.<WaveformTileSet>completedFuture(null),
                     0L,
                     specId);
         }
@@ -109,7 +125,7 @@ public class ViewportSessionManager implements ViewportPaintingDataSource {
             return new ViewportRenderSpec(
                     PaintMode.LOADING,
                     Optional.empty(),
-                    CompletableFuture.<Image>completedFuture(null),
+                    CompletableFuture.<WaveformTileSet>completedFuture(null),
                     0L,
                     specId);
         }
@@ -123,7 +139,7 @@ public class ViewportSessionManager implements ViewportPaintingDataSource {
             return new ViewportRenderSpec(
                     PaintMode.LOADING,
                     Optional.empty(),
-                    CompletableFuture.<Image>completedFuture(null),
+                    CompletableFuture.<WaveformTileSet>completedFuture(null),
                     0L,
                     specId);
         }
@@ -150,13 +166,22 @@ public class ViewportSessionManager implements ViewportPaintingDataSource {
 
         var projection = projector.project(audioSnap, uiState);
         var wfCtx = projector.toWaveformViewport(projection, uiState, audioSnap, sampleRate);
-        var imageFuture = waveform.renderViewport(wfCtx);
+        boolean spectrogram = spectrogramVisible.get();
+        var tilesFuture =
+                spectrogram ? waveform.renderSpectrogramTiles(wfCtx) : waveform.renderTiles(wfCtx);
         long generation = projection.generation();
 
+        // While the exact tiles render, offer a rescaled image from a neighbouring cached zoom tier
+        // (waveform tiers only, so the spectrogram view just waits for its tiles)
+        Optional<Image> preview =
+                spectrogram || tilesFuture.isDone()
+                        ? Optional.empty()
+                        : waveform.previewViewport(wfCtx);
+
         // Use the WaveformViewportSpec's built-in specId which captures all rendering parameters
-        String specId = "render-" + wfCtx.specId();
+        String specId = (spectrogram ? "spectrogram-" : "render-") + wfCtx.specId();
 
         return new ViewportRenderSpec(
-                PaintMode.RENDER, Optional.empty(), imageFuture, generation, specId);
+                PaintMode.RENDER, Optional.empty(), tilesFuture, preview, generation, specId);
     }
 }
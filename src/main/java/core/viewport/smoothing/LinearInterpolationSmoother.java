@@ -16,26 +16,30 @@ public class LinearInterpolationSmoother implements PlayheadSmoother {
     private static class State {
         final long previousTarget; // Previous target frame from audio engine
         final long currentTarget; // Current target frame from audio engine
-        final long targetUpdateTime; // When we received the current target
+        final long targetUpdateNanos; // Frame time we received the current target at
         final double playbackRate; // Calculated playback rate (frames per ms)
 
-        State(long previousTarget, long currentTarget, long targetUpdateTime, double playbackRate) {
+        State(
+                long previousTarget,
+                long currentTarget,
+                long targetUpdateNanos,
+                double playbackRate) {
             this.previousTarget = previousTarget;
             this.currentTarget = currentTarget;
-            this.targetUpdateTime = targetUpdateTime;
+            this.targetUpdateNanos = targetUpdateNanos;
             this.playbackRate = playbackRate;
         }
     }
 
     private final AtomicReference<State> state =
             new AtomicReference<>(
-                    new State(0, 0, System.currentTimeMillis(), 44.1)); // 44.1 frames/ms = 44100 Hz
+                    new State(0, 0, System.nanoTime(), 44.1)); // 44.1 frames/ms = 44100 Hz
 
     @Override
     public SmoothingResult updateAndGetSmoothedPosition(
-            long targetFrame, long deltaMs, AudioSessionStateMachine.State audioState) {
+            long targetFrame, long frameTimeNanos, AudioSessionStateMachine.State audioState) {
 
-        long currentTime = System.currentTimeMillis();
+        long currentTime = frameTimeNanos;
         boolean isPlaying = audioState == AudioSessionStateMachine.State.PLAYING;
 
         // Not playing - snap to target
@@ -52,7 +56,7 @@ public class LinearInterpolationSmoother implements PlayheadSmoother {
                             if (targetFrame != current.currentTarget) {
                                 // Calculate actual playback rate from the last two updates
                                 long framesDelta = targetFrame - current.currentTarget;
-                                long timeDelta = currentTime - current.targetUpdateTime;
+                                double timeDelta = (currentTime - current.targetUpdateNanos) / 1e6;
 
                                 double newRate;
                                 if (timeDelta > 0 && framesDelta > 0) {
@@ -80,7 +84,7 @@ public class LinearInterpolationSmoother implements PlayheadSmoother {
                         });
 
         // Calculate expected position based on time elapsed
-        long timeSinceUpdate = currentTime - newState.targetUpdateTime;
+        double timeSinceUpdate = (currentTime - newState.targetUpdateNanos) / 1e6;
         long expectedAdvance = Math.round(timeSinceUpdate * newState.playbackRate);
 
         // Extrapolate from the last known target position
@@ -112,7 +116,7 @@ public class LinearInterpolationSmoother implements PlayheadSmoother {
 
     @Override
     public void reset() {
-        state.set(new State(0, 0, System.currentTimeMillis(), 44.1));
+        state.set(new State(0, 0, System.nanoTime(), 44.1));
         log.debug("Linear interpolation smoother reset");
     }
 }
@@ -1,6 +1,7 @@
 package core.viewport.smoothing;
 
 import core.audio.session.AudioSessionStateMachine;
+import java.util.concurrent.TimeUnit;
 import lombok.extern.slf4j.Slf4j;
 
 /**
@@ -28,14 +29,15 @@ public class MetricsAwarePlayheadSmoother implements PlayheadSmoother {
 
     @Override
     public SmoothingResult updateAndGetSmoothedPosition(
-            long targetFrame, long deltaMs, AudioSessionStateMachine.State state) {
+            long targetFrame, long frameTimeNanos, AudioSessionStateMachine.State state) {
 
         // Get result from underlying smoother
-        SmoothingResult result = delegate.updateAndGetSmoothedPosition(targetFrame, deltaMs, state);
+        SmoothingResult result =
+                delegate.updateAndGetSmoothedPosition(targetFrame, frameTimeNanos, state);
 
         // Collect metrics if enabled
         if (metricsEnabled && state == AudioSessionStateMachine.State.PLAYING) {
-            long timestamp = System.currentTimeMillis();
+            long timestamp = TimeUnit.NANOSECONDS.toMillis(frameTimeNanos);
             metrics.addSample(timestamp, result.smoothedFrame(), targetFrame);
 
             // Optionally log metrics periodically (every 100 samples)
@@ -12,7 +12,7 @@ public class NoSmoother implements PlayheadSmoother {
 
     @Override
     public SmoothingResult updateAndGetSmoothedPosition(
-            long targetFrame, long deltaMs, AudioSessionStateMachine.State audioState) {
+            long targetFrame, long frameTimeNanos, AudioSessionStateMachine.State audioState) {
 
         // Always return the exact target position with zero distance
         log.trace("No smoothing: target={}, distance=0", targetFrame);
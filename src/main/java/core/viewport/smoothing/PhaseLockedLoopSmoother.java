@@ -17,25 +17,25 @@ public class PhaseLockedLoopSmoother implements PlayheadSmoother {
         final double phase; // Current phase (position)
         final double frequency; // Locked frequency (frames per ms)
         final double phaseError; // Accumulated phase error
-        final long lastUpdateTime; // Last update timestamp
+        final long lastUpdateNanos; // Frame time of the last update
         final long lastTarget; // Last target from audio engine
 
         PLLState(
                 double phase,
                 double frequency,
                 double phaseError,
-                long lastUpdateTime,
+                long lastUpdateNanos,
                 long lastTarget) {
             this.phase = phase;
             this.frequency = frequency;
             this.phaseError = phaseError;
-            this.lastUpdateTime = lastUpdateTime;
+            this.lastUpdateNanos = lastUpdateNanos;
             this.lastTarget = lastTarget;
         }
     }
 
     private final AtomicReference<PLLState> state =
-            new AtomicReference<>(new PLLState(0, 44.1, 0, System.currentTimeMillis(), 0));
+            new AtomicReference<>(new PLLState(0, 44.1, 0, System.nanoTime(), 0));
 
     // PLL tuning parameters
     private static final double PHASE_GAIN = 0.1; // How aggressively to correct phase errors
@@ -44,9 +44,9 @@ public class PhaseLockedLoopSmoother implements PlayheadSmoother {
 
     @Override
     public SmoothingResult updateAndGetSmoothedPosition(
-            long targetFrame, long deltaMs, AudioSessionStateMachine.State audioState) {
+            long targetFrame, long frameTimeNanos, AudioSessionStateMachine.State audioState) {
 
-        long currentTime = System.currentTimeMillis();
+        long currentTime = frameTimeNanos;
         boolean isPlaying = audioState == AudioSessionStateMachine.State.PLAYING;
 
         // Not playing - reset PLL
@@ -58,9 +58,11 @@ public class PhaseLockedLoopSmoother implements PlayheadSmoother {
         PLLState newState =
                 state.updateAndGet(
                         current -> {
-                            // Calculate time delta
-                            long timeDelta = currentTime - current.lastUpdateTime;
-                            if (timeDelta <= 0) timeDelta = 16; // ~60fps fallback
+                            // Calculate time delta; the same frame asked again keeps its state
+                            double timeDelta = (currentTime - current.lastUpdateNanos) / 1e6;
+                            if (timeDelta <= 0) {
+                                return current;
+                            }
 
                             // Advance phase based on current frequency
                             double expectedPhase = current.phase + (current.frequency * timeDelta);
@@ -121,7 +123,7 @@ public class PhaseLockedLoopSmoother implements PlayheadSmoother {
 
     @Override
     public void reset() {
-        state.set(new PLLState(0, 44.1, 0, System.currentTimeMillis(), 0));
+        state.set(new PLLState(0, 44.1, 0, System.nanoTime(), 0));
         log.debug("PLL smoother reset");
     }
 }
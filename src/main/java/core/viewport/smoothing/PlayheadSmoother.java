@@ -21,12 +21,13 @@ public interface PlayheadSmoother {
      * Update smoother with current state and get smoothed position.
      *
      * @param targetFrame The actual/true playhead position from audio engine
-     * @param deltaMs Time since last update in milliseconds
+     * @param frameTimeNanos Presentation time of the frame being drawn, on the {@link
+     *     System#nanoTime()} scale; successive calls for the same frame pass the same time
      * @param state Current audio session state
      * @return The smoothed position and distance from target
      */
     SmoothingResult updateAndGetSmoothedPosition(
-            long targetFrame, long deltaMs, AudioSessionStateMachine.State state);
+            long targetFrame, long frameTimeNanos, AudioSessionStateMachine.State state);
 
     /** Reset smoother to initial state. Called when audio stops or changes. */
     void reset();
@@ -16,19 +16,19 @@ public class PredictiveExtrapolationSmoother implements PlayheadSmoother {
     private static class State {
         final long position; // Current smoothed position
         final long lastTargetFrame; // Last known target position
-        final long lastUpdateTimeMs; // Time of last update
+        final long lastUpdateNanos; // Frame time of last update
         final boolean wasPlaying; // Whether we were playing in the last update
 
-        State(long position, long lastTargetFrame, long lastUpdateTimeMs, boolean wasPlaying) {
+        State(long position, long lastTargetFrame, long lastUpdateNanos, boolean wasPlaying) {
             this.position = position;
             this.lastTargetFrame = lastTargetFrame;
-            this.lastUpdateTimeMs = lastUpdateTimeMs;
+            this.lastUpdateNanos = lastUpdateNanos;
             this.wasPlaying = wasPlaying;
         }
     }
 
     private final AtomicReference<State> state =
-            new AtomicReference<>(new State(0, 0, System.currentTimeMillis(), false));
+            new AtomicReference<>(new State(0, 0, System.nanoTime(), false));
 
     // Sample rate - should be injected or determined from audio context
     // Using 44100 as default for now (44.1kHz)
@@ -38,14 +38,14 @@ public class PredictiveExtrapolationSmoother implements PlayheadSmoother {
 
     @Override
     public SmoothingResult updateAndGetSmoothedPosition(
-            long targetFrame, long deltaMs, AudioSessionStateMachine.State audioState) {
+            long targetFrame, long frameTimeNanos, AudioSessionStateMachine.State audioState) {
 
-        long currentTimeMs = System.currentTimeMillis();
+        long currentTime = frameTimeNanos;
         boolean isPlaying = audioState == AudioSessionStateMachine.State.PLAYING;
 
         // Handle non-playing states - just snap to target
         if (!isPlaying) {
-            State newState = new State(targetFrame, targetFrame, currentTimeMs, false);
+            State newState = new State(targetFrame, targetFrame, currentTime, false);
             state.set(newState);
             return new SmoothingResult(targetFrame, 0);
         }
@@ -62,12 +62,12 @@ public class PredictiveExtrapolationSmoother implements PlayheadSmoother {
                                         "Resyncing to target: {} (was at {})",
                                         targetFrame,
                                         current.position);
-                                return new State(targetFrame, targetFrame, currentTimeMs, true);
+                                return new State(targetFrame, targetFrame, currentTime, true);
                             }
 
                             // Calculate expected advancement based on elapsed time
-                            long elapsedMs = currentTimeMs - current.lastUpdateTimeMs;
-                            double expectedAdvancement = (elapsedMs / 1000.0) * SAMPLE_RATE;
+                            double elapsedSeconds = (currentTime - current.lastUpdateNanos) / 1e9;
+                            double expectedAdvancement = elapsedSeconds * SAMPLE_RATE;
 
                             // Extrapolate position based on playback rate
                             long extrapolatedPosition =
@@ -79,13 +79,13 @@ public class PredictiveExtrapolationSmoother implements PlayheadSmoother {
                             // If drift is too large, resync
                             if (Math.abs(drift) > RESYNC_THRESHOLD) {
                                 log.debug("Large drift detected: {} frames, resyncing", drift);
-                                return new State(targetFrame, targetFrame, currentTimeMs, true);
+                                return new State(targetFrame, targetFrame, currentTime, true);
                             }
 
                             // Apply gentle correction for small drift (10% correction per frame)
                             long correctedPosition = extrapolatedPosition + Math.round(drift * 0.1);
 
-                            return new State(correctedPosition, targetFrame, currentTimeMs, true);
+                            return new State(correctedPosition, targetFrame, currentTime, true);
                         });
 
         long distance = targetFrame - newState.position;
@@ -102,7 +102,7 @@ public class PredictiveExtrapolationSmoother implements PlayheadSmoother {
 
     @Override
     public void reset() {
-        state.set(new State(0, 0, System.currentTimeMillis(), false));
+        state.set(new State(0, 0, System.nanoTime(), false));
         log.debug("Predictive smoother reset");
     }
 }
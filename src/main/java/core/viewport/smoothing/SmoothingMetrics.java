@@ -28,13 +28,26 @@ public class SmoothingMetrics {
             int sampleCount // Number of samples in calculation
             ) {}
 
+    /** Timing of recently delivered display frames */
+    public record FrameTimingStats(
+            double meanIntervalMs, // Average time between delivered frames
+            double jitterMs, // Standard deviation of the interval - lower is steadier
+            double p99IntervalMs, // 99th percentile interval
+            long droppedFrames, // Frames skipped because the previous one was still pending
+            int frameCount // Number of intervals in calculation
+            ) {}
+
     private final int maxSamples;
     private final Deque<PositionSample> samples;
+    private final Deque<Long> frameIntervals;
     private final Object lock = new Object();
+    private long lastFrameNanos = -1;
+    private long droppedFrames;
 
     public SmoothingMetrics(int maxSamples) {
         this.maxSamples = maxSamples;
         this.samples = new ArrayDeque<>(maxSamples);
+        this.frameIntervals = new ArrayDeque<>(maxSamples);
     }
 
     /**
@@ -53,6 +66,57 @@ public class SmoothingMetrics {
         }
     }
 
+    /**
+     * Record a delivered display frame for frame-time jitter.
+     *
+     * @param startedNanos When the frame actually started, on the {@link System#nanoTime()} scale
+     * @param dropped Frames skipped since the previous delivered frame
+     */
+    public void addFrame(long startedNanos, int dropped) {
+        synchronized (lock) {
+            if (lastFrameNanos >= 0 && startedNanos > lastFrameNanos) {
+                frameIntervals.addLast(startedNanos - lastFrameNanos);
+                while (frameIntervals.size() > maxSamples) {
+                    frameIntervals.removeFirst();
+                }
+            }
+            lastFrameNanos = startedNanos;
+            droppedFrames += dropped;
+        }
+    }
+
+    /**
+     * Calculate frame timing from recent frames. Requires at least 10 intervals.
+     *
+     * @return Frame timing or null if insufficient data
+     */
+    public FrameTimingStats calculateFrameTiming() {
+        synchronized (lock) {
+            if (frameIntervals.size() < 10) {
+                return null;
+            }
+            double[] intervalsMs =
+                    frameIntervals.stream().mapToDouble(nanos -> nanos / 1e6).toArray();
+            double mean = Arrays.stream(intervalsMs).average().orElse(0);
+            double variance = 0;
+            for (double interval : intervalsMs) {
+                variance += (interval - mean) * (interval - mean);
+            }
+            variance /= intervalsMs.length;
+
+            Arrays.sort(intervalsMs);
+            int p99Index = (int) Math.ceil(0.99 * intervalsMs.length) - 1;
+            p99Index = Math.max(0, Math.min(intervalsMs.length - 1, p99Index));
+
+            return new FrameTimingStats(
+                    mean,
+                    Math.sqrt(variance),
+                    intervalsMs[p99Index],
+                    droppedFrames,
+                    intervalsMs.length);
+        }
+    }
+
     /**
      * Calculate smoothness scores from recent samples. Requires at least 10 samples for meaningful
      * results.
@@ -270,6 +334,9 @@ public class SmoothingMetrics {
     public void reset() {
         synchronized (lock) {
             samples.clear();
+            frameIntervals.clear();
+            lastFrameNanos = -1;
+            droppedFrames = 0;
         }
     }
 }
@@ -13,8 +13,10 @@ public class Module extends AbstractModule {
 
         // Waveform components
         bind(WaveformSegmentCache.class);
+        bind(PeakPyramidStore.class).in(Singleton.class);
 
         // Waveform management
         bind(WaveformManager.class).in(Singleton.class);
+        bind(WaveformPreloader.class).in(Singleton.class);
     }
 }
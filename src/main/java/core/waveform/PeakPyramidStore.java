@@ -0,0 +1,399 @@
+package core.waveform;
+
+import core.audio.AudioMetadata;
+import core.env.AppConfig;
+import core.env.Platform;
+import core.env.UserHomeProvider;
+import core.waveform.signal.PeakPyramid;
+import jakarta.inject.Inject;
+import jakarta.inject.Singleton;
+import java.io.IOException;
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.nio.channels.FileChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.DirectoryStream;
+import java.nio.file.FileSystemException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardCopyOption;
+import java.nio.file.StandardOpenOption;
+import java.nio.file.attribute.BasicFileAttributes;
+import java.nio.file.attribute.FileTime;
+import java.security.MessageDigest;
+import java.security.NoSuchAlgorithmException;
+import java.util.ArrayList;
+import java.util.Comparator;
+import java.util.HexFormat;
+import java.util.List;
+import java.util.Objects;
+import java.util.Optional;
+import lombok.NonNull;
+import lombok.extern.slf4j.Slf4j;
+
+/**
+ * Persists peak pyramids as sidecar files in the user cache directory so reopened recordings render
+ * without decoding.
+ *
+ * <p>Sidecars are named by a hash of the audio file's absolute path, size, modification time and
+ * the processing parameters, so any change to the file or the pipeline simply misses. The format
+ * is a small native-order header (the file's {@link AudioMetadata} and global peak, then one entry
+ * per level) followed by each level's packed float data at 8-byte aligned offsets; loading
+ * memory-maps the file and hands the mapped slices to {@link PeakPyramid} directly, so only the
+ * pages a render touches are ever read, and a stored file's format is known without opening it.
+ *
+ * <p>The directory is kept under {@value #MAX_MB_KEY} megabytes: after each write the least
+ * recently used sidecars are deleted until the rest fit. Loading a sidecar stamps its modification
+ * time, so eviction order follows use even where the file system does not track access times.
+ *
+ * <p>Failures are never fatal: an unreadable or stale sidecar is treated as a miss and a failed
+ * write is logged and ignored. On Windows a sidecar that is still mapped can be neither replaced
+ * nor deleted; since sidecars are named by their content's key, a write onto a mapped one keeps the
+ * existing file, and eviction skips it until it is unmapped.
+ */
+@Singleton
+@Slf4j
+public class PeakPyramidStore {
+
+    static final String ENABLED_KEY = "waveform.sidecar.enabled";
+    static final String DIRECTORY_KEY = "waveform.sidecar.dir";
+    static final String MAX_MB_KEY = "waveform.sidecar.max_mb";
+    private static final int DEFAULT_MAX_MB = 1024;
+
+    static final String SUFFIX = ".wfpk";
+    private static final int MAGIC = 0x54525746; // "TRWF"
+    private static final int FORMAT_VERSION = 2;
+    private static final int BYTE_ORDER_MARK = 0x01020304;
+    private static final long FIXED_HEADER_BYTES = 56;
+    private static final long LEVEL_HEADER_BYTES = 8;
+
+    /** A stored pyramid and the metadata of the file it was built from. */
+    public record Sidecar(@NonNull PeakPyramid pyramid, @NonNull AudioMetadata metadata) {}
+
+    private final Path directory;
+    private final boolean enabled;
+    private final long maxBytes;
+
+    @Inject
+    public PeakPyramidStore(
+            @NonNull AppConfig config,
+            @NonNull Platform platform,
+            @NonNull UserHomeProvider userHomeProvider) {
+        this(
+                resolveDirectory(config.getProperty(DIRECTORY_KEY, ""), platform, userHomeProvider),
+                config.getBooleanProperty(ENABLED_KEY, true),
+                config.getIntProperty(MAX_MB_KEY, DEFAULT_MAX_MB) * 1024L * 1024L);
+    }
+
+    PeakPyramidStore(@NonNull Path directory, boolean enabled) {
+        this(directory, enabled, 0);
+    }
+
+    /**
+     * @param maxBytes Total size the sidecars may take up, or 0 for no limit
+     */
+    PeakPyramidStore(@NonNull Path directory, boolean enabled, long maxBytes) {
+        this.directory = directory;
+        this.enabled = enabled;
+        this.maxBytes = maxBytes;
+    }
+
+    /**
+     * Memory-maps the stored pyramid for an audio file, if one exists for its current size,
+     * modification time and the given processing parameters.
+     */
+    public Optional<PeakPyramid> load(@NonNull Path audioFile, @NonNull String parameters) {
+        return loadSidecar(audioFile, parameters).map(Sidecar::pyramid);
+    }
+
+    /** Like {@link #load}, with the metadata stored alongside the pyramid. */
+    public Optional<Sidecar> loadSidecar(@NonNull Path audioFile, @NonNull String parameters) {
+        if (!enabled) {
+            return Optional.empty();
+        }
+        try {
+            Path sidecar = sidecarFor(audioFile, parameters);
+            if (!Files.isRegularFile(sidecar)) {
+                return Optional.empty();
+            }
+            markUsed(sidecar);
+            MemorySegment mapped;
+            try (FileChannel channel = FileChannel.open(sidecar, StandardOpenOption.READ)) {
+                mapped =
+                        channel.map(
+                                FileChannel.MapMode.READ_ONLY, 0, channel.size(), Arena.ofAuto());
+            }
+            Optional<Sidecar> decoded = decode(mapped);
+            if (decoded.isEmpty()) {
+                log.debug("Ignoring invalid waveform sidecar {}", sidecar);
+            } else {
+                log.debug("Mapped waveform sidecar {} for {}", sidecar, audioFile);
+            }
+            return decoded;
+        } catch (IOException | RuntimeException e) {
+            log.debug("Failed to load waveform sidecar for {}: {}", audioFile, e.getMessage());
+            return Optional.empty();
+        }
+    }
+
+    /**
+     * Writes a pyramid and the file's metadata for an audio file, replacing any previous sidecar
+     * atomically, then evicts the least recently used sidecars beyond the size limit.
+     */
+    public void save(
+            @NonNull Path audioFile,
+            @NonNull String parameters,
+            @NonNull PeakPyramid pyramid,
+            @NonNull AudioMetadata metadata) {
+        if (!enabled) {
+            return;
+        }
+        Path temp = null;
+        try {
+            Files.createDirectories(directory);
+            Path sidecar = sidecarFor(audioFile, parameters);
+            temp = Files.createTempFile(directory, "pyramid", ".tmp");
+            write(temp, pyramid, metadata);
+            try {
+                Files.move(
+                        temp,
+                        sidecar,
+                        StandardCopyOption.REPLACE_EXISTING,
+                        StandardCopyOption.ATOMIC_MOVE);
+                log.debug("Wrote waveform sidecar {} for {}", sidecar, audioFile);
+            } catch (FileSystemException e) {
+                // Windows refuses to replace a mapped file; one with this name holds the same data
+                if (!Files.isRegularFile(sidecar)) {
+                    throw e;
+                }
+                Files.deleteIfExists(temp);
+                markUsed(sidecar);
+                log.debug("Kept waveform sidecar {} in use: {}", sidecar, e.getMessage());
+            }
+            temp = null;
+            evictBeyond(maxBytes, sidecar);
+        } catch (IOException | RuntimeException e) {
+            log.warn("Failed to write waveform sidecar for {}: {}", audioFile, e.getMessage());
+            if (temp != null) {
+                try {
+                    Files.deleteIfExists(temp);
+                } catch (IOException ignored) {
+                    // Best effort
+                }
+            }
+        }
+    }
+
+    /**
+     * Deletes the least recently used sidecars until the rest take up at most {@code limit} bytes,
+     * never deleting {@code keep}. Sidecars that cannot be deleted, such as ones still mapped on
+     * Windows, are skipped.
+     */
+    private void evictBeyond(long limit, @NonNull Path keep) {
+        if (limit <= 0) {
+            return;
+        }
+        record Entry(Path path, long bytes, long usedMillis) {}
+        List<Entry> entries = new ArrayList<>();
+        long total = 0;
+        try (DirectoryStream<Path> sidecars = Files.newDirectoryStream(directory, "*" + SUFFIX)) {
+            for (Path path : sidecars) {
+                try {
+                    BasicFileAttributes attributes =
+                            Files.readAttributes(path, BasicFileAttributes.class);
+                    entries.add(
+                            new Entry(
+                                    path,
+                                    attributes.size(),
+                                    attributes.lastModifiedTime().toMillis()));
+                    total += attributes.size();
+                } catch (IOException e) {
+                    // Deleted concurrently
+                }
+            }
+        } catch (IOException e) {
+            log.debug("Could not list waveform sidecars in {}: {}", directory, e.getMessage());
+            return;
+        }
+        if (total <= limit) {
+            return;
+        }
+        entries.sort(Comparator.comparingLong(Entry::usedMillis));
+        for (Entry entry : entries) {
+            if (total <= limit) {
+                break;
+            }
+            if (entry.path().equals(keep)) {
+                continue;
+            }
+            try {
+                Files.deleteIfExists(entry.path());
+                total -= entry.bytes();
+                log.debug("Evicted waveform sidecar {}", entry.path());
+            } catch (IOException e) {
+                log.debug("Could not evict waveform sidecar {}: {}", entry.path(), e.getMessage());
+            }
+        }
+    }
+
+    /** Records a use of a sidecar for eviction order. */
+    private static void markUsed(@NonNull Path sidecar) {
+        try {
+            Files.setLastModifiedTime(sidecar, FileTime.fromMillis(System.currentTimeMillis()));
+        } catch (IOException e) {
+            // Eviction order is only a heuristic
+        }
+    }
+
+    Path sidecarFor(@NonNull Path audioFile, @NonNull String parameters) throws IOException {
+        Path absolute = audioFile.toAbsolutePath().normalize();
+        String key =
+                absolute
+                        + "|"
+                        + Files.size(absolute)
+                        + "|"
+                        + Files.getLastModifiedTime(absolute).toMillis()
+                        + "|"
+                        + parameters
+                        + "|v"
+                        + FORMAT_VERSION;
+        return directory.resolve(sha256(key) + SUFFIX);
+    }
+
+    private static void write(
+            @NonNull Path target, @NonNull PeakPyramid pyramid, @NonNull AudioMetadata metadata)
+            throws IOException {
+        int levelCount = pyramid.levelCount();
+        byte[] format =
+                Objects.requireNonNullElse(metadata.format(), "").getBytes(StandardCharsets.UTF_8);
+        long formatOffset = FIXED_HEADER_BYTES + levelCount * LEVEL_HEADER_BYTES;
+        long dataOffset = align8(formatOffset + format.length);
+        long totalBytes = dataOffset;
+        for (int i = 0; i < levelCount; i++) {
+            totalBytes += align8(pyramid.level(i).data().byteSize());
+        }
+
+        try (FileChannel channel =
+                        FileChannel.open(
+                                target, StandardOpenOption.READ, StandardOpenOption.WRITE);
+                Arena arena = Arena.ofConfined()) {
+            MemorySegment out = channel.map(FileChannel.MapMode.READ_WRITE, 0, totalBytes, arena);
+            out.set(ValueLayout.JAVA_INT, 0, MAGIC);
+            out.set(ValueLayout.JAVA_INT, 4, FORMAT_VERSION);
+            out.set(ValueLayout.JAVA_INT, 8, BYTE_ORDER_MARK);
+            out.set(ValueLayout.JAVA_INT, 12, pyramid.sampleRate());
+            out.set(ValueLayout.JAVA_LONG, 16, pyramid.frameCount());
+            out.set(ValueLayout.JAVA_INT, 24, levelCount);
+            out.set(ValueLayout.JAVA_INT, 28, metadata.channelCount());
+            out.set(ValueLayout.JAVA_INT, 32, metadata.bitsPerSample());
+            out.set(ValueLayout.JAVA_INT, 36, format.length);
+            out.set(ValueLayout.JAVA_DOUBLE, 40, pyramid.peak());
+            out.set(ValueLayout.JAVA_DOUBLE, 48, metadata.durationSeconds());
+            MemorySegment.copy(format, 0, out, ValueLayout.JAVA_BYTE, formatOffset, format.length);
+
+            long offset = dataOffset;
+            for (int i = 0; i < levelCount; i++) {
+                PeakPyramid.Level level = pyramid.level(i);
+                long header = FIXED_HEADER_BYTES + i * LEVEL_HEADER_BYTES;
+                out.set(ValueLayout.JAVA_INT, header, level.binFrames());
+                out.set(ValueLayout.JAVA_INT, header + 4, level.binCount());
+                MemorySegment.copy(level.data(), 0, out, offset, level.data().byteSize());
+                offset += align8(level.data().byteSize());
+            }
+            out.force();
+        }
+    }
+
+    private static Optional<Sidecar> decode(@NonNull MemorySegment in) {
+        if (in.byteSize() < FIXED_HEADER_BYTES
+                || in.get(ValueLayout.JAVA_INT, 0) != MAGIC
+                || in.get(ValueLayout.JAVA_INT, 4) != FORMAT_VERSION
+                || in.get(ValueLayout.JAVA_INT, 8) != BYTE_ORDER_MARK) {
+            return Optional.empty();
+        }
+        int sampleRate = in.get(ValueLayout.JAVA_INT, 12);
+        long frameCount = in.get(ValueLayout.JAVA_LONG, 16);
+        int levelCount = in.get(ValueLayout.JAVA_INT, 24);
+        int channelCount = in.get(ValueLayout.JAVA_INT, 28);
+        int bitsPerSample = in.get(ValueLayout.JAVA_INT, 32);
+        int formatBytes = in.get(ValueLayout.JAVA_INT, 36);
+        double peak = in.get(ValueLayout.JAVA_DOUBLE, 40);
+        double durationSeconds = in.get(ValueLayout.JAVA_DOUBLE, 48);
+        long formatOffset = FIXED_HEADER_BYTES + (long) levelCount * LEVEL_HEADER_BYTES;
+        long dataOffset = align8(formatOffset + formatBytes);
+        if (levelCount <= 0 || formatBytes < 0 || dataOffset > in.byteSize()) {
+            return Optional.empty();
+        }
+        String format =
+                new String(
+                        in.asSlice(formatOffset, formatBytes).toArray(ValueLayout.JAVA_BYTE),
+                        StandardCharsets.UTF_8);
+
+        PeakPyramid.Level[] levels = new PeakPyramid.Level[levelCount];
+        long offset = dataOffset;
+        for (int i = 0; i < levelCount; i++) {
+            long header = FIXED_HEADER_BYTES + i * LEVEL_HEADER_BYTES;
+            int binFrames = in.get(ValueLayout.JAVA_INT, header);
+            int binCount = in.get(ValueLayout.JAVA_INT, header + 4);
+            long bytes = 3L * binCount * Float.BYTES;
+            if (binFrames <= 0 || binCount < 0 || offset + bytes > in.byteSize()) {
+                return Optional.empty();
+            }
+            levels[i] = new PeakPyramid.Level(binFrames, binCount, in.asSlice(offset, bytes));
+            offset += align8(bytes);
+        }
+        var metadata =
+                new AudioMetadata(
+                        sampleRate,
+                        channelCount,
+                        bitsPerSample,
+                        format,
+                        frameCount,
+                        durationSeconds);
+        return Optional.of(
+                new Sidecar(new PeakPyramid(sampleRate, frameCount, levels, peak), metadata));
+    }
+
+    private static long align8(long value) {
+        return (value + 7) & ~7L;
+    }
+
+    private static String sha256(@NonNull String value) {
+        try {
+            MessageDigest digest = MessageDigest.getInstance("SHA-256");
+            return HexFormat.of().formatHex(digest.digest(value.getBytes(StandardCharsets.UTF_8)));
+        } catch (NoSuchAlgorithmException e) {
+            throw new IllegalStateException("SHA-256 unavailable", e);
+        }
+    }
+
+    /** Resolves the sidecar directory, defaulting to the platform's per-user cache location. */
+    private static Path resolveDirectory(
+            @NonNull String configured,
+            @NonNull Platform platform,
+            @NonNull UserHomeProvider userHomeProvider) {
+        if (!configured.isBlank()) {
+            return Path.of(configured);
+        }
+        String home = userHomeProvider.getUserHomeDir();
+        Path cacheRoot =
+                switch (platform.detect()) {
+                    case MACOS -> Path.of(home, "Library", "Caches", "Penn TotalRecall");
+                    case WINDOWS -> {
+                        String localAppData = System.getenv("LOCALAPPDATA");
+                        Path base = localAppData != null ? Path.of(localAppData) : Path.of(home);
+                        yield base.resolve("Penn TotalRecall").resolve("Cache");
+                    }
+                    case LINUX -> {
+                        String xdgCache = System.getenv("XDG_CACHE_HOME");
+                        Path base =
+                                xdgCache != null && !xdgCache.isBlank()
+                                        ? Path.of(xdgCache)
+                                        : Path.of(home, ".cache");
+                        yield base.resolve("penn-totalrecall");
+                    }
+                };
+        return cacheRoot.resolve("waveforms");
+    }
+}
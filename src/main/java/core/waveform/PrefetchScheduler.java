@@ -0,0 +1,257 @@
+package core.waveform;
+
+import com.google.errorprone.annotations.ThreadSafe;
+import java.awt.Image;
+import java.util.HashMap;
+import java.util.Iterator;
+import java.util.Map;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.Executor;
+import java.util.concurrent.RejectedExecutionException;
+import java.util.concurrent.atomic.AtomicReference;
+import java.util.function.Function;
+import java.util.function.LongSupplier;
+import lombok.NonNull;
+import lombok.extern.slf4j.Slf4j;
+
+/**
+ * Decides which off-screen segments to render ahead of the viewport.
+ *
+ * <p>The scheduler watches successive viewports to estimate how fast, and in which direction, the
+ * view is moving through the audio. It samples viewports rather than playback snapshots because
+ * the viewport is all a waveform is given: {@code ViewportSessionManager} places each one around
+ * the session snapshot's playhead, so viewport deltas are the playhead's deltas, sampled as often
+ * as the view repaints, and a zoom shows up in the same sample. While idle it
+ * keeps {@link WaveformSegmentCache#PREFETCH_COUNT} segments warm on both sides. While moving it
+ * covers {@link #LOOKAHEAD_SECONDS} of travel in the direction of motion, up to {@link
+ * #MAX_PREFETCH} segments, and only {@link #TRAILING_PREFETCH} behind.
+ *
+ * <p>Requests go through {@link WaveformSegmentCache#getOrRender}, so a segment already cached or
+ * in flight is never rendered twice. Prefetches this scheduler started that fall outside the new
+ * window (after a seek, a zoom or a change of direction) are cancelled before they reach the
+ * render pool and dropped from the cache.
+ *
+ * <p>Renderers call {@link #scheduleOn} from the paint path, which only records the motion sample
+ * and hands the requests, each taking the cache's write lock, to the render pool.
+ */
+@ThreadSafe
+@Slf4j
+class PrefetchScheduler {
+
+    static final int MAX_PREFETCH = WaveformSegmentCache.PREFETCH_COUNT * 2;
+    static final int TRAILING_PREFETCH = 2; // Segments kept behind the direction of motion
+    static final double LOOKAHEAD_SECONDS = 2.0; // Wall-clock travel the window should cover
+
+    private static final double IDLE_VELOCITY = 0.05; // Audio seconds per second
+    private static final double VELOCITY_SMOOTHING = 0.3; // Weight of the newest sample
+    private static final double MAX_SAMPLE_GAP_SECONDS = 0.5; // Older motion no longer predicts
+
+    /** Segments to prefetch after and before the visible range. */
+    record Window(int forward, int backward) {}
+
+    /** A viewport waiting to be scheduled, and when it was seen. */
+    private record Pending(@NonNull WaveformViewportSpec viewport, long nanos) {}
+
+    private final WaveformSegmentCache cache;
+    private final Function<WaveformSegmentCache.SegmentKey, CompletableFuture<Image>> renderer;
+    private final LongSupplier nanoClock;
+    private final AtomicReference<Pending> pending = new AtomicReference<>();
+
+    // Guarded by this
+    private final Map<WaveformSegmentCache.SegmentKey, CompletableFuture<Image>> outstanding =
+            new HashMap<>();
+    private WaveformViewportSpec lastViewport;
+    private long lastNanos;
+    private double velocity; // Audio seconds per wall-clock second, negative when moving back
+
+    PrefetchScheduler(
+            @NonNull WaveformSegmentCache cache,
+            @NonNull Function<WaveformSegmentCache.SegmentKey, CompletableFuture<Image>> renderer) {
+        this(cache, renderer, System::nanoTime);
+    }
+
+    PrefetchScheduler(
+            @NonNull WaveformSegmentCache cache,
+            @NonNull Function<WaveformSegmentCache.SegmentKey, CompletableFuture<Image>> renderer,
+            @NonNull LongSupplier nanoClock) {
+        this.cache = cache;
+        this.renderer = renderer;
+        this.nanoClock = nanoClock;
+    }
+
+    /**
+     * Runs {@link #schedule} for a viewport on {@code executor} rather than the calling thread. The
+     * motion sample is timed now; a viewport arriving while another is still queued replaces it.
+     */
+    void scheduleOn(@NonNull WaveformViewportSpec viewport, @NonNull Executor executor) {
+        if (pending.getAndSet(new Pending(viewport, nanoClock.getAsLong())) != null) {
+            return;
+        }
+        try {
+            executor.execute(
+                    () -> {
+                        Pending next = pending.getAndSet(null);
+                        if (next != null) {
+                            schedule(next.viewport(), next.nanos());
+                        }
+                    });
+        } catch (RejectedExecutionException e) {
+            // The pool is shutting down with its waveform
+            pending.set(null);
+        }
+    }
+
+    /** Updates the motion estimate for a new viewport and queues the segments around it. */
+    void schedule(@NonNull WaveformViewportSpec viewport) {
+        schedule(viewport, nanoClock.getAsLong());
+    }
+
+    private synchronized void schedule(@NonNull WaveformViewportSpec viewport, long now) {
+        Window window = observe(viewport, now);
+
+        int pps = viewport.pixelsPerSecond();
+        int height = viewport.viewportHeightPx();
+        long startIndex = firstVisibleIndex(viewport);
+        long endIndex = lastVisibleIndex(viewport);
+        long firstWanted = Math.max(0, startIndex - window.backward());
+        long lastWanted = endIndex + window.forward();
+
+        cancelOutside(firstWanted, lastWanted, pps, height);
+
+        // Nearest first, leading side first, so the segments needed soonest render first
+        boolean backwardLeads = window.backward() > window.forward();
+        int steps = Math.max(window.forward(), window.backward());
+        for (int i = 1; i <= steps; i++) {
+            if (backwardLeads) {
+                request(startIndex - i, i <= window.backward(), viewport);
+                request(endIndex + i, i <= window.forward(), viewport);
+            } else {
+                request(endIndex + i, i <= window.forward(), viewport);
+                request(startIndex - i, i <= window.backward(), viewport);
+            }
+        }
+        log.trace(
+                "Prefetch window [{}-{}] around [{}-{}] at {}s/s",
+                firstWanted,
+                lastWanted,
+                startIndex,
+                endIndex,
+                String.format("%.2f", velocity));
+    }
+
+    /** Folds a viewport into the motion estimate and returns the prefetch window to use. */
+    Window observe(@NonNull WaveformViewportSpec viewport) {
+        return observe(viewport, nanoClock.getAsLong());
+    }
+
+    private synchronized Window observe(@NonNull WaveformViewportSpec viewport, long now) {
+        if (lastViewport != null) {
+            double elapsed = (now - lastNanos) / 1e9;
+            double span = viewport.endTimeSeconds() - viewport.startTimeSeconds();
+            double moved = viewport.startTimeSeconds() - lastViewport.startTimeSeconds();
+            boolean jumped =
+                    Math.abs(moved) > span
+                            || viewport.pixelsPerSecond() != lastViewport.pixelsPerSecond()
+                            || viewport.viewportHeightPx() != lastViewport.viewportHeightPx();
+            if (jumped || elapsed > MAX_SAMPLE_GAP_SECONDS) {
+                // A seek or zoom says nothing about where the view goes next
+                velocity = 0;
+            } else if (elapsed > 0) {
+                velocity += VELOCITY_SMOOTHING * (moved / elapsed - velocity);
+            }
+        }
+        lastViewport = viewport;
+        lastNanos = now;
+        return windowFor(velocity, viewport.pixelsPerSecond());
+    }
+
+    /** Sizes the window for a velocity in audio seconds per second. */
+    static Window windowFor(double velocity, int pixelsPerSecond) {
+        int symmetric = WaveformSegmentCache.PREFETCH_COUNT;
+        double speed = Math.abs(velocity);
+        if (speed < IDLE_VELOCITY) {
+            return new Window(symmetric, symmetric);
+        }
+        double travelPx = speed * LOOKAHEAD_SECONDS * pixelsPerSecond;
+        int lead = (int) Math.ceil(travelPx / WaveformSegmentCache.SEGMENT_WIDTH_PX);
+        int leading = Math.clamp(lead, symmetric, MAX_PREFETCH);
+        return velocity > 0
+                ? new Window(leading, TRAILING_PREFETCH)
+                : new Window(TRAILING_PREFETCH, leading);
+    }
+
+    private void request(long index, boolean wanted, @NonNull WaveformViewportSpec viewport) {
+        if (!wanted || index < 0) {
+            return;
+        }
+        var key =
+                new WaveformSegmentCache.SegmentKey(
+                        index, viewport.pixelsPerSecond(), viewport.viewportHeightPx());
+        if (key.startTime() >= viewport.audioDurationSeconds()) {
+            return;
+        }
+        cache.getOrRender(
+                key,
+                k -> {
+                    CompletableFuture<Image> future = renderer.apply(k);
+                    if (!future.isDone()) {
+                        outstanding.put(k, future);
+                    }
+                    return future;
+                },
+                false);
+    }
+
+    /** Cancels unfinished prefetches this scheduler started outside the wanted range. */
+    private void cancelOutside(long firstWanted, long lastWanted, int pps, int height) {
+        int cancelled = 0;
+        Iterator<Map.Entry<WaveformSegmentCache.SegmentKey, CompletableFuture<Image>>> it =
+                outstanding.entrySet().iterator();
+        while (it.hasNext()) {
+            var entry = it.next();
+            WaveformSegmentCache.SegmentKey key = entry.getKey();
+            CompletableFuture<Image> future = entry.getValue();
+            if (future.isDone()) {
+                it.remove();
+                continue;
+            }
+            boolean wanted =
+                    key.pixelsPerSecond() == pps
+                            && key.height() == height
+                            && key.segmentIndex() >= firstWanted
+                            && key.segmentIndex() <= lastWanted;
+            if (!wanted) {
+                // Queued renders complete as cancelled without ever running
+                future.cancel(false);
+                cache.remove(key, future);
+                it.remove();
+                cancelled++;
+            }
+        }
+        if (cancelled > 0) {
+            log.debug("Cancelled {} stale prefetches", cancelled);
+        }
+    }
+
+    /** Number of prefetches started here that have not finished yet. */
+    synchronized int outstandingCount() {
+        outstanding.values().removeIf(CompletableFuture::isDone);
+        return outstanding.size();
+    }
+
+    static long firstVisibleIndex(@NonNull WaveformViewportSpec viewport) {
+        return (long)
+                Math.floor(
+                        viewport.startTimeSeconds()
+                                * viewport.pixelsPerSecond()
+                                / WaveformSegmentCache.SEGMENT_WIDTH_PX);
+    }
+
+    static long lastVisibleIndex(@NonNull WaveformViewportSpec viewport) {
+        return (long)
+                Math.ceil(
+                        viewport.endTimeSeconds()
+                                * viewport.pixelsPerSecond()
+                                / WaveformSegmentCache.SEGMENT_WIDTH_PX);
+    }
+}
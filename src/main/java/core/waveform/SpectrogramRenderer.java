@@ -0,0 +1,266 @@
+package core.waveform;
+
+import core.audio.AudioData;
+import core.audio.AudioMetadata;
+import core.audio.SampleReader;
+import core.telemetry.SegmentRenderEvent;
+import core.waveform.signal.ShortTimeFft;
+import java.awt.Image;
+import java.awt.image.BufferedImage;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CancellationException;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
+import java.util.concurrent.ExecutorService;
+import lombok.NonNull;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+
+/**
+ * Spectrogram tiles for the same viewports as {@link WaveformRenderer}: short-time FFT magnitude
+ * images in {@link WaveformSegmentCache#SEGMENT_WIDTH_PX} segments, keyed, cached, evicted and
+ * prefetched exactly as the waveform's segments are, so only the visible range and its prefetch
+ * window are ever analysed and cost does not grow with file length.
+ *
+ * <p>Each segment takes one Hann-windowed FFT per pixel column, centred on the column, over audio
+ * mixed to mono. Where the columns' windows overlap the segment reads its span (plus half a window
+ * either side) once; at coarser zooms each column reads just its own window, so a segment never
+ * reads more than {@link WaveformSegmentCache#SEGMENT_WIDTH_PX} windows. Rows cover 0 Hz at the
+ * bottom to {@link #MAX_FREQUENCY_HZ} (or Nyquist) at the top, each showing the loudest bin it
+ * spans, shaded from white at {@link #DYNAMIC_RANGE_DB} below full scale to black at full scale.
+ * Segments render in parallel on the waveform's render pool; each render thread keeps its own FFT
+ * and sample buffers.
+ */
+class SpectrogramRenderer {
+    private static final Logger logger = LoggerFactory.getLogger(SpectrogramRenderer.class);
+
+    private static final int SEGMENT_WIDTH_PX = WaveformSegmentCache.SEGMENT_WIDTH_PX;
+
+    // Narrowband analysis: long enough to resolve voice harmonics, which separate speakers
+    static final double WINDOW_SECONDS = 0.025;
+    static final double MAX_FREQUENCY_HZ = 8000;
+    static final double DYNAMIC_RANGE_DB = 70;
+
+    private final Path audioFile;
+    private final WaveformSegmentCache cache;
+    private final ExecutorService renderPool;
+    private final SampleReader sampleReader;
+    private final PrefetchScheduler prefetchScheduler;
+    private final int sampleRate;
+    private final long totalFrames;
+    private final double audioDurationSeconds;
+    private final int windowFrames;
+    private final ThreadLocal<Workspace> workspaces;
+
+    /** Per-thread FFT and buffers, reused from segment to segment. */
+    private static final class Workspace {
+        final ShortTimeFft fft;
+        final double[] spectrum;
+        double[] mono = new double[0];
+
+        Workspace(int windowFrames) {
+            fft = new ShortTimeFft(windowFrames);
+            spectrum = new double[fft.binCount()];
+        }
+
+        double[] mono(int length) {
+            if (mono.length < length) {
+                mono = new double[length];
+            }
+            return mono;
+        }
+    }
+
+    SpectrogramRenderer(
+            @NonNull String audioFilePath,
+            @NonNull WaveformSegmentCache cache,
+            @NonNull ExecutorService renderPool,
+            @NonNull SampleReader sampleReader,
+            @NonNull AudioMetadata metadata) {
+        this.audioFile = Path.of(audioFilePath);
+        this.cache = cache;
+        this.renderPool = renderPool;
+        this.sampleReader = sampleReader;
+        this.prefetchScheduler = new PrefetchScheduler(cache, this::renderSegment);
+        this.sampleRate = metadata.sampleRate();
+        this.totalFrames = metadata.frameCount();
+        this.audioDurationSeconds = metadata.durationSeconds();
+        this.windowFrames = Math.max(2, (int) Math.round(WINDOW_SECONDS * sampleRate));
+        this.workspaces = ThreadLocal.withInitial(() -> new Workspace(windowFrames));
+    }
+
+    /**
+     * Fill the spectrogram cache for the viewport and queue its prefetch window. Completes with the
+     * visible tiles and their placement, or null if rendering failed or was cancelled.
+     */
+    CompletableFuture<WaveformTileSet> renderTiles(@NonNull WaveformViewportSpec viewport) {
+        cache.updateViewport(viewport);
+
+        List<CompletableFuture<Image>> segmentFutures = new ArrayList<>();
+        for (var key : WaveformRenderer.calculateVisibleSegments(viewport)) {
+            // Hit and miss stats describe the waveform's segments; don't count these lookups
+            segmentFutures.add(cache.getOrRender(key, this::renderSegment, false));
+        }
+        prefetchScheduler.scheduleOn(viewport, renderPool);
+
+        return CompletableFuture.allOf(segmentFutures.toArray(CompletableFuture[]::new))
+                .thenApply(
+                        _ ->
+                                WaveformRenderer.tileSet(
+                                        segmentFutures.stream().map(f -> f.getNow(null)).toList(),
+                                        viewport))
+                .exceptionally(
+                        e -> {
+                            if (e.getCause() instanceof CancellationException) {
+                                logger.debug(
+                                        "Spectrogram render cancelled for viewport at {}s",
+                                        viewport.startTimeSeconds());
+                            } else {
+                                logger.warn("Error rendering spectrogram viewport: ", e);
+                            }
+                            return null;
+                        });
+    }
+
+    /** Clear all cached tiles, cancelling unfinished renders. */
+    void clear() {
+        cache.clear();
+    }
+
+    /** Render one segment on the render pool; segments wholly before time 0 are empty. */
+    private CompletableFuture<Image> renderSegment(@NonNull WaveformSegmentCache.SegmentKey key) {
+        if (key.endTime() <= 0 || key.startTime() >= audioDurationSeconds) {
+            return CompletableFuture.completedFuture(null);
+        }
+        return CompletableFuture.supplyAsync(
+                () -> {
+                    var event = new SegmentRenderEvent();
+                    event.start();
+                    BufferedImage image = drawSegment(key);
+                    event.startSeconds = key.startTime();
+                    event.pixelsPerSecond = key.pixelsPerSecond();
+                    event.heightPx = key.height();
+                    event.spectrogram = true;
+                    event.finish();
+                    return image;
+                },
+                renderPool);
+    }
+
+    private BufferedImage drawSegment(@NonNull WaveformSegmentCache.SegmentKey key) {
+        checkCancelled();
+        double framesPerPixel = (double) sampleRate / key.pixelsPerSecond();
+        double segmentStartFrame = key.startTime() * sampleRate;
+
+        // The audio under every column's window: half a window either side of the segment
+        long firstFrame = (long) Math.floor(segmentStartFrame) - windowFrames / 2;
+        long lastFrame =
+                (long) Math.ceil(segmentStartFrame + SEGMENT_WIDTH_PX * framesPerPixel)
+                        + windowFrames / 2;
+        long readStart = Math.clamp(firstFrame, 0, totalFrames);
+        long readEnd = Math.clamp(lastFrame, readStart, totalFrames);
+
+        // Sparse columns read only their own windows; dense ones share one read of the span
+        Workspace ws = workspaces.get();
+        boolean columnReads = readEnd - readStart > (long) SEGMENT_WIDTH_PX * windowFrames;
+        int length = columnReads ? windowFrames : Math.toIntExact(readEnd - readStart);
+        double[] mono = ws.mono(length);
+        int read = columnReads ? 0 : readMono(readStart, length, mono);
+        checkCancelled();
+
+        // Row y (from the top) spans the bins between lowBins[y] and highBins[y]
+        int height = key.height();
+        double topHz = Math.min(MAX_FREQUENCY_HZ, sampleRate / 2.0);
+        double binHz = (double) sampleRate / ws.fft.fftSize();
+        int[] lowBins = new int[height];
+        int[] highBins = new int[height];
+        for (int y = 0; y < height; y++) {
+            double lowHz = topHz * (height - y - 1) / height;
+            double highHz = topHz * (height - y) / height;
+            lowBins[y] = (int) Math.floor(lowHz / binHz);
+            highBins[y] =
+                    Math.min(
+                            ws.spectrum.length - 1,
+                            Math.max(lowBins[y], (int) Math.ceil(highHz / binHz) - 1));
+        }
+
+        BufferedImage image =
+                new BufferedImage(SEGMENT_WIDTH_PX, height, BufferedImage.TYPE_INT_ARGB);
+        int[] column = new int[height];
+
+        for (int x = 0; x < SEGMENT_WIDTH_PX; x++) {
+            double centreFrame = segmentStartFrame + (x + 0.5) * framesPerPixel;
+            if (centreFrame < 0 || centreFrame >= totalFrames) {
+                continue; // Before time 0 or after the end: leave transparent
+            }
+            if ((x & 31) == 0) {
+                checkCancelled();
+            }
+            // Frames beyond what was read count as silence
+            long windowStart = Math.round(centreFrame) - windowFrames / 2;
+            int start;
+            if (columnReads) {
+                long columnStart = Math.clamp(windowStart, 0, totalFrames);
+                long columnEnd = Math.clamp(windowStart + windowFrames, columnStart, totalFrames);
+                read = readMono(columnStart, (int) (columnEnd - columnStart), mono);
+                start = (int) (windowStart - columnStart);
+            } else {
+                start = (int) (windowStart - readStart);
+            }
+            ws.fft.spectrum(mono, read, start, ws.spectrum);
+
+            for (int y = 0; y < height; y++) {
+                double level = ShortTimeFft.FLOOR_DB;
+                for (int bin = lowBins[y]; bin <= highBins[y]; bin++) {
+                    level = Math.max(level, ws.spectrum[bin]);
+                }
+                column[y] = shade(level);
+            }
+            image.setRGB(x, 0, 1, height, column, 0, 1);
+        }
+        return image;
+    }
+
+    /** Read {@code length} frames from {@code startFrame} mixed to mono; returns frames read. */
+    private int readMono(long startFrame, int length, @NonNull double[] mono) {
+        if (length == 0) {
+            return 0;
+        }
+        AudioData data;
+        try {
+            data = sampleReader.readSamples(audioFile, startFrame, length).join();
+        } catch (CompletionException e) {
+            logger.warn(
+                    "Failed to read audio for spectrogram at frame {}: {}",
+                    startFrame,
+                    e.getMessage());
+            return 0;
+        }
+        int frames = (int) Math.min(length, data.frameCount());
+        int channels = data.channelCount();
+        var view = data.view();
+        for (int i = 0; i < frames; i++) {
+            double sum = 0;
+            for (int c = 0; c < channels; c++) {
+                sum += view.get(i * channels + c);
+            }
+            mono[i] = sum / channels;
+        }
+        return frames;
+    }
+
+    /** Opaque grey for a level: white at the bottom of the range, black at full scale. */
+    static int shade(double levelDb) {
+        double intensity = Math.clamp((levelDb + DYNAMIC_RANGE_DB) / DYNAMIC_RANGE_DB, 0, 1);
+        int grey = (int) Math.round(255 * (1 - intensity));
+        return 0xFF000000 | grey << 16 | grey << 8 | grey;
+    }
+
+    private static void checkCancelled() {
+        if (Thread.currentThread().isInterrupted()) {
+            throw new CancellationException("Render cancelled");
+        }
+    }
+}
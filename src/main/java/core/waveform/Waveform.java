@@ -4,10 +4,16 @@ import core.audio.AudioEngine;
 import core.audio.AudioHandle;
 import core.audio.AudioMetadata;
 import core.audio.SampleReader;
+import core.waveform.signal.PeakPyramid;
 import java.awt.Image;
+import java.util.HashSet;
+import java.util.Optional;
+import java.util.Set;
 import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.Executor;
 import java.util.concurrent.ExecutorService;
 import java.util.concurrent.Executors;
+import java.util.concurrent.RejectedExecutionException;
 import java.util.concurrent.ThreadFactory;
 import java.util.concurrent.TimeUnit;
 import lombok.NonNull;
@@ -16,21 +22,118 @@ import lombok.extern.slf4j.Slf4j;
 /**
  * Viewport-aware waveform renderer with segment caching. Thread-safe implementation that manages
  * parallel rendering.
+ *
+ * <p>A spectrogram of the same file is available through {@link #renderSpectrogramTiles}, which the
+ * viewport uses in place of {@link #renderTiles} while the spectrogram view is on; its renderer and
+ * cache are created on first use and share the waveform's render pool.
  */
 @Slf4j
 public class Waveform {
 
+    /**
+     * Runs tasks on a preloader's pool until {@link #adopt}, then on the waveform's render pool.
+     */
+    private static final class HandOffExecutor implements Executor {
+        private final Executor preparePool;
+        private final Executor renderPool;
+
+        // Guarded by this; threads running one of our tasks on the prepare pool
+        private final Set<Thread> running = new HashSet<>();
+        private volatile boolean adopted = false;
+
+        HandOffExecutor(@NonNull Executor preparePool, @NonNull Executor renderPool) {
+            this.preparePool = preparePool;
+            this.renderPool = renderPool;
+        }
+
+        @Override
+        public void execute(@NonNull Runnable task) {
+            if (adopted) {
+                renderPool.execute(task);
+                return;
+            }
+            preparePool.execute(() -> runOnPreparePool(task));
+        }
+
+        private void runOnPreparePool(@NonNull Runnable task) {
+            if (adopted) {
+                try {
+                    renderPool.execute(task);
+                    return;
+                } catch (RejectedExecutionException e) {
+                    // Shut down since; run it here so its future still completes
+                }
+            }
+            Thread thread = Thread.currentThread();
+            int priority = thread.getPriority();
+            synchronized (this) {
+                running.add(thread);
+                if (adopted) {
+                    thread.setPriority(Thread.NORM_PRIORITY);
+                }
+            }
+            try {
+                task.run();
+            } finally {
+                synchronized (this) {
+                    running.remove(thread);
+                    thread.setPriority(priority);
+                }
+            }
+        }
+
+        synchronized void adopt() {
+            adopted = true;
+            running.forEach(thread -> thread.setPriority(Thread.NORM_PRIORITY));
+        }
+    }
+
     private final WaveformRenderer renderer;
     private final WaveformSegmentCache cache;
     private final ExecutorService renderPool;
     private final SampleReader sampleReader;
+    private final String audioFilePath;
+    private final AudioMetadata metadata;
+
+    // Runs the first pass and prepareViewport renders; the render pool unless a preloader gave one
+    private final Executor preparePool;
+    private final Optional<HandOffExecutor> handOff;
+
+    private volatile WaveformViewportSpec lastViewport;
+    private volatile SpectrogramRenderer spectrogram;
 
     public Waveform(
             @NonNull String audioFilePath,
             @NonNull AudioEngine audioEngine,
             @NonNull AudioHandle audioHandle,
             @NonNull SampleReader sampleReader,
-            @NonNull WaveformSegmentCache cache) {
+            @NonNull WaveformSegmentCache cache,
+            @NonNull PeakPyramidStore pyramidStore,
+            @NonNull Optional<PeakPyramid> storedPyramid) {
+        this(
+                audioFilePath,
+                audioEngine.getMetadata(audioHandle),
+                sampleReader,
+                cache,
+                pyramidStore,
+                storedPyramid,
+                Optional.empty());
+    }
+
+    /**
+     * Create a waveform from metadata alone, with no loaded audio; {@link WaveformPreloader} uses
+     * this to prepare files before they are opened. When a prepare pool is given, the first pass
+     * over the file runs on it, as do renders requested through {@link #prepareViewport}, until
+     * {@link #adopt}; everything else renders on the waveform's own pool.
+     */
+    Waveform(
+            @NonNull String audioFilePath,
+            @NonNull AudioMetadata metadata,
+            @NonNull SampleReader sampleReader,
+            @NonNull WaveformSegmentCache cache,
+            @NonNull PeakPyramidStore pyramidStore,
+            @NonNull Optional<PeakPyramid> storedPyramid,
+            @NonNull Optional<Executor> preparePool) {
 
         // Create thread pool for rendering (leave 1 core for UI)
         int threads = Math.max(1, Runtime.getRuntime().availableProcessors() - 1);
@@ -49,28 +152,50 @@ public class Waveform {
                             }
                         });
 
-        // Get sample rate from audio metadata
-        AudioMetadata metadata = audioEngine.getMetadata(audioHandle);
-
         // Initialize with default viewport (will be updated on first render)
-        WaveformViewportSpec defaultViewport =
-                new WaveformViewportSpec(0.0, 10.0, 1000, 200, 100, metadata.durationSeconds());
-
         this.cache = cache;
-        this.cache.initialize(defaultViewport);
+        this.cache.initialize(defaultViewport(metadata.durationSeconds()));
         int sampleRate = metadata.sampleRate();
 
         this.sampleReader = sampleReader;
+        this.audioFilePath = audioFilePath;
+        this.metadata = metadata;
+        this.handOff = preparePool.map(pool -> new HandOffExecutor(pool, renderPool));
+        this.preparePool = handOff.isPresent() ? handOff.get() : renderPool;
 
         this.renderer =
                 new WaveformRenderer(
-                        audioFilePath, cache, renderPool, sampleReader, sampleRate, metadata);
+                        audioFilePath,
+                        cache,
+                        renderPool,
+                        this.preparePool,
+                        sampleReader,
+                        sampleRate,
+                        metadata,
+                        pyramidStore,
+                        storedPyramid);
+    }
+
+    /**
+     * Run the rest of a preloaded waveform's preparation as its own work: tasks still waiting on
+     * the prepare pool move to the render pool as they come up, and one already running there
+     * (such as the first pass) carries on at normal priority. Does nothing for a waveform created
+     * without a prepare pool.
+     */
+    void adopt() {
+        handOff.ifPresent(HandOffExecutor::adopt);
+    }
+
+    /** Viewport assumed before the first render. */
+    static WaveformViewportSpec defaultViewport(double audioDurationSeconds) {
+        return new WaveformViewportSpec(0.0, 10.0, 1000, 200, 100, audioDurationSeconds);
     }
 
     public CompletableFuture<Image> renderViewport(@NonNull WaveformViewportSpec viewport) {
         if (renderer == null) {
             return CompletableFuture.completedFuture(null);
         }
+        lastViewport = viewport;
         try {
             return renderer.renderViewport(viewport);
         } catch (Exception e) {
@@ -79,6 +204,84 @@ public class Waveform {
         }
     }
 
+    /**
+     * Render the viewport's visible segments into the cache on the prepare pool, once the first
+     * pass completes, so a later {@link #renderViewport} of the same view is served at once. Does
+     * not block; completes exceptionally if rendering fails or the waveform is shut down.
+     */
+    CompletableFuture<Void> prepareViewport(@NonNull WaveformViewportSpec viewport) {
+        lastViewport = viewport;
+        return renderer.prepareTiles(viewport, preparePool);
+    }
+
+    /**
+     * Render the viewport's segments without compositing them, for callers that draw the tiles
+     * themselves. Completes with null if rendering fails.
+     */
+    public CompletableFuture<WaveformTileSet> renderTiles(@NonNull WaveformViewportSpec viewport) {
+        if (renderer == null) {
+            return CompletableFuture.completedFuture(null);
+        }
+        lastViewport = viewport;
+        try {
+            return renderer.renderTiles(viewport);
+        } catch (Exception e) {
+            // Log error but don't rethrow
+            return CompletableFuture.completedFuture(null);
+        }
+    }
+
+    /**
+     * Render the viewport's spectrogram tiles, laid out as {@link #renderTiles} lays out the
+     * waveform's. Completes with null if rendering fails.
+     */
+    public CompletableFuture<WaveformTileSet> renderSpectrogramTiles(
+            @NonNull WaveformViewportSpec viewport) {
+        lastViewport = viewport;
+        try {
+            return spectrogram().renderTiles(viewport);
+        } catch (Exception e) {
+            log.debug("Failed to render spectrogram: {}", e.getMessage());
+            return CompletableFuture.completedFuture(null);
+        }
+    }
+
+    private SpectrogramRenderer spectrogram() {
+        SpectrogramRenderer current = spectrogram;
+        if (current == null) {
+            synchronized (this) {
+                current = spectrogram;
+                if (current == null) {
+                    var tiles = new WaveformSegmentCache(cache.getStats());
+                    tiles.initialize(defaultViewport(metadata.durationSeconds()));
+                    current =
+                            new SpectrogramRenderer(
+                                    audioFilePath, tiles, renderPool, sampleReader, metadata);
+                    spectrogram = current;
+                }
+            }
+        }
+        return current;
+    }
+
+    /**
+     * Get a rescaled stand-in for the viewport, built from a neighbouring cached zoom level or
+     * height, to show while {@link #renderViewport} is still rendering.
+     */
+    public Optional<Image> previewViewport(@NonNull WaveformViewportSpec viewport) {
+        try {
+            return Optional.ofNullable(renderer.renderPreview(viewport));
+        } catch (Exception e) {
+            log.debug("Failed to build waveform preview: {}", e.getMessage());
+            return Optional.empty();
+        }
+    }
+
+    /** The viewport most recently rendered, if any. */
+    Optional<WaveformViewportSpec> getLastViewport() {
+        return Optional.ofNullable(lastViewport);
+    }
+
     /** Shutdown the renderer and release resources. */
     public void shutdown() {
         // Log final cache stats before shutdown
@@ -90,6 +293,10 @@ public class Waveform {
 
         // Cancel all pending renders
         cache.clear();
+        SpectrogramRenderer activeSpectrogram = spectrogram;
+        if (activeSpectrogram != null) {
+            activeSpectrogram.clear();
+        }
 
         // Shutdown thread pool
         renderPool.shutdown();
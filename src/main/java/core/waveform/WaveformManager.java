@@ -9,8 +9,11 @@ import core.audio.session.AudioSessionStateMachine;
 import core.dispatch.EventDispatchBus;
 import core.dispatch.Subscribe;
 import core.events.AppStateChangedEvent;
+import core.waveform.signal.PeakPyramid;
+import core.waveform.signal.WaveformProcessor;
 import jakarta.inject.Inject;
 import jakarta.inject.Singleton;
+import java.nio.file.Path;
 import java.util.Optional;
 import lombok.NonNull;
 import lombok.extern.slf4j.Slf4j;
@@ -27,6 +30,8 @@ public class WaveformManager {
     private final Provider<AudioEngine> audioEngineProvider;
     private final Provider<SampleReader> sampleReaderProvider;
     private final Provider<WaveformSegmentCache> cacheProvider;
+    private final PeakPyramidStore pyramidStore;
+    private final WaveformPreloader preloader;
 
     private Optional<Waveform> currentWaveform = Optional.empty();
     private Optional<AudioEngine> audioEngine = Optional.empty();
@@ -37,11 +42,15 @@ public class WaveformManager {
             @NonNull Provider<AudioEngine> audioEngineProvider,
             @NonNull Provider<SampleReader> sampleReaderProvider,
             @NonNull Provider<WaveformSegmentCache> cacheProvider,
+            @NonNull PeakPyramidStore pyramidStore,
+            @NonNull WaveformPreloader preloader,
             @NonNull EventDispatchBus eventBus) {
         this.sessionSource = sessionSource;
         this.audioEngineProvider = audioEngineProvider;
         this.sampleReaderProvider = sampleReaderProvider;
         this.cacheProvider = cacheProvider;
+        this.pyramidStore = pyramidStore;
+        this.preloader = preloader;
         eventBus.subscribe(this);
     }
 
@@ -86,14 +95,16 @@ public class WaveformManager {
                 audioEngine = Optional.of(audioEngineProvider.get());
             }
 
-            // Create new waveform for the audio file with a new sample reader
+            // Adopt the waveform prepared while the previous file was open, if there is one
             Waveform waveform =
-                    new Waveform(
-                            audioPath.get(),
-                            audioEngine.get(),
-                            audioHandle.get(),
-                            sampleReaderProvider.get(),
-                            cacheProvider.get());
+                    preloader
+                            .take(Path.of(audioPath.get()))
+                            .orElseGet(
+                                    () ->
+                                            createWaveform(
+                                                    audioPath.get(),
+                                                    audioEngine.get(),
+                                                    audioHandle.get()));
 
             // Clean up old waveform if present
             currentWaveform.ifPresent(Waveform::shutdown);
@@ -106,6 +117,26 @@ public class WaveformManager {
         }
     }
 
+    private Waveform createWaveform(
+            @NonNull String audioPath,
+            @NonNull AudioEngine engine,
+            @NonNull AudioHandle audioHandle) {
+        // Map the stored peak pyramid if this file was processed before, so display needs no
+        // decoding
+        Optional<PeakPyramid> storedPyramid =
+                pyramidStore.load(Path.of(audioPath), WaveformProcessor.PYRAMID_PARAMETERS);
+
+        // Create new waveform for the audio file with a new sample reader
+        return new Waveform(
+                audioPath,
+                engine,
+                audioHandle,
+                sampleReaderProvider.get(),
+                cacheProvider.get(),
+                pyramidStore,
+                storedPyramid);
+    }
+
     private void clearWaveform() {
         currentWaveform = Optional.empty();
     }
@@ -0,0 +1,296 @@
+package core.waveform;
+
+import com.google.inject.Provider;
+import core.audio.AudioMetadata;
+import core.audio.AudioMetadataProbe;
+import core.audio.SampleReader;
+import core.dispatch.EventDispatchBus;
+import core.dispatch.Subscribe;
+import core.env.AppConfig;
+import core.events.UpcomingAudioFilesEvent;
+import core.waveform.signal.WaveformProcessor;
+import jakarta.inject.Inject;
+import jakarta.inject.Singleton;
+import java.io.File;
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Optional;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import lombok.NonNull;
+import lombok.extern.slf4j.Slf4j;
+
+/**
+ * Prepares waveforms for the files the user is likely to open next, so the switch after Done shows
+ * the next file at once.
+ *
+ * <p>For each upcoming file a background thread probes its header, opens it through a fresh {@link
+ * SampleReader} (with the memory reader this starts decoding the file into the store playback also
+ * opens from), maps or builds its peak pyramid, and renders the first screen at the current zoom
+ * and canvas size into the waveform's own segment cache. {@link WaveformManager} adopts the
+ * prepared waveform when that file finishes loading, and whatever preparation is left then moves
+ * to the waveform's own render pool; preparations for files that stop being upcoming are shut
+ * down.
+ *
+ * <p>At most {@value #MAX_FILES_KEY} files are prepared, one at a time, and only while their
+ * decoded audio fits in {@value #BUDGET_KEY} megabytes together. The size is estimated from the
+ * metadata stored in the file's sidecar, or from a header probe when it has none, so a file over
+ * the budget is never decoded.
+ */
+@Singleton
+@Slf4j
+public class WaveformPreloader {
+
+    static final String ENABLED_KEY = "waveform.preload.enabled";
+    static final String MAX_FILES_KEY = "waveform.preload.max_files";
+    static final String BUDGET_KEY = "waveform.preload.max_mb";
+
+    private static final int DEFAULT_MAX_FILES = 1;
+    private static final int DEFAULT_BUDGET_MB = 256;
+
+    /** One file being or already prepared. */
+    private static final class Preload {
+        final CompletableFuture<Waveform> waveform = new CompletableFuture<>();
+
+        // Completes once the first screen is rendered, or the preparation fails or is dropped
+        final CompletableFuture<Void> prepared = new CompletableFuture<>();
+
+        // Decoded size counted against the budget; 0 until the header is probed
+        volatile long sizeBytes;
+    }
+
+    private final Provider<SampleReader> sampleReaderProvider;
+    private final AudioMetadataProbe probe;
+    private final Provider<WaveformSegmentCache> cacheProvider;
+    private final Provider<WaveformManager> managerProvider;
+    private final PeakPyramidStore pyramidStore;
+    private final boolean enabled;
+    private final int maxFiles;
+    private final long budgetBytes;
+    private final ExecutorService executor;
+
+    // Guarded by this; in upcoming order
+    private final Map<Path, Preload> preloads = new LinkedHashMap<>();
+
+    @Inject
+    public WaveformPreloader(
+            @NonNull Provider<SampleReader> sampleReaderProvider,
+            @NonNull AudioMetadataProbe probe,
+            @NonNull Provider<WaveformSegmentCache> cacheProvider,
+            @NonNull Provider<WaveformManager> managerProvider,
+            @NonNull PeakPyramidStore pyramidStore,
+            @NonNull AppConfig config,
+            @NonNull EventDispatchBus eventBus) {
+        this.sampleReaderProvider = sampleReaderProvider;
+        this.probe = probe;
+        this.cacheProvider = cacheProvider;
+        this.managerProvider = managerProvider;
+        this.pyramidStore = pyramidStore;
+        this.enabled = config.getBooleanProperty(ENABLED_KEY, true);
+        this.maxFiles = Math.max(0, config.getIntProperty(MAX_FILES_KEY, DEFAULT_MAX_FILES));
+        this.budgetBytes = config.getIntProperty(BUDGET_KEY, DEFAULT_BUDGET_MB) * 1024L * 1024L;
+
+        // One low-priority thread, so preparing never competes with the open file's rendering;
+        // the file's decode, pyramid pass and first screen all run at its priority until adopted
+        this.executor =
+                Executors.newSingleThreadExecutor(
+                        r -> {
+                            Thread t = new Thread(r, "WaveformPreloader");
+                            t.setDaemon(true);
+                            t.setPriority(Thread.MIN_PRIORITY);
+                            return t;
+                        });
+        eventBus.subscribe(this);
+    }
+
+    @Subscribe
+    public void onUpcomingFiles(@NonNull UpcomingAudioFilesEvent event) {
+        if (!enabled) {
+            return;
+        }
+        List<Path> upcoming =
+                event.files().stream()
+                        .map(File::toPath)
+                        .map(WaveformPreloader::keyFor)
+                        .distinct()
+                        .limit(maxFiles)
+                        .toList();
+
+        synchronized (this) {
+            Iterator<Map.Entry<Path, Preload>> it = preloads.entrySet().iterator();
+            while (it.hasNext()) {
+                Map.Entry<Path, Preload> entry = it.next();
+                if (!upcoming.contains(entry.getKey())) {
+                    discard(entry.getValue());
+                    it.remove();
+                }
+            }
+            for (Path file : upcoming) {
+                if (!preloads.containsKey(file)) {
+                    Preload preload = new Preload();
+                    preloads.put(file, preload);
+                    executor.execute(() -> prepare(file, preload));
+                }
+            }
+        }
+    }
+
+    /**
+     * Hand over the prepared waveform for a file. Empty if the file was not upcoming or is not
+     * ready yet, in which case any unfinished preparation is dropped.
+     */
+    public Optional<Waveform> take(@NonNull Path audioFile) {
+        Preload preload;
+        synchronized (this) {
+            preload = preloads.remove(keyFor(audioFile));
+        }
+        if (preload == null) {
+            return Optional.empty();
+        }
+        if (preload.waveform.isDone() && !preload.waveform.isCompletedExceptionally()) {
+            Waveform waveform = preload.waveform.join();
+            waveform.adopt();
+            return Optional.of(waveform);
+        }
+        discard(preload);
+        return Optional.empty();
+    }
+
+    /** Drop every preparation. */
+    public synchronized void clear() {
+        preloads.values().forEach(WaveformPreloader::discard);
+        preloads.clear();
+    }
+
+    /** Completes once every preparation still upcoming has finished. */
+    CompletableFuture<Void> idle() {
+        CompletableFuture<?>[] pending;
+        synchronized (this) {
+            pending =
+                    preloads.values().stream()
+                            .map(p -> p.prepared)
+                            .toArray(CompletableFuture[]::new);
+        }
+        return CompletableFuture.allOf(pending);
+    }
+
+    private void prepare(@NonNull Path file, @NonNull Preload preload) {
+        if (preload.waveform.isDone()) {
+            preload.prepared.complete(null);
+            return; // Discarded before it started
+        }
+
+        SampleReader reader = null;
+        Waveform waveform;
+        double durationSeconds;
+        try {
+            // Decoded floats are rarely smaller than the file, so skip hopeless cases unread
+            if (Files.size(file) > budgetBytes) {
+                throw new IOException("file exceeds the preload budget");
+            }
+            // Size the decode before opening the file, which starts decoding it: from the
+            // sidecar when the file has one, otherwise from a probe of its header
+            Optional<PeakPyramidStore.Sidecar> sidecar =
+                    pyramidStore.loadSidecar(file, WaveformProcessor.PYRAMID_PARAMETERS);
+            AudioMetadata header =
+                    sidecar.isPresent() ? sidecar.get().metadata() : probe.probe(file).join();
+            long sizeBytes = header.frameCount() * header.channelCount() * Float.BYTES;
+            if (!reserve(preload, sizeBytes)) {
+                throw new IOException("decoded audio exceeds the preload budget");
+            }
+            reader = sampleReaderProvider.get();
+            AudioMetadata metadata = reader.getMetadata(file).join();
+            waveform =
+                    new Waveform(
+                            file.toString(),
+                            metadata,
+                            reader,
+                            cacheProvider.get(),
+                            pyramidStore,
+                            sidecar.map(PeakPyramidStore.Sidecar::pyramid),
+                            Optional.of(executor));
+            durationSeconds = metadata.durationSeconds();
+        } catch (Exception e) {
+            log.debug("Not preloading {}: {}", file.getFileName(), e.getMessage());
+            closeQuietly(reader);
+            preload.waveform.completeExceptionally(e);
+            preload.prepared.complete(null);
+            return;
+        }
+
+        if (!preload.waveform.complete(waveform)) {
+            waveform.shutdown(); // Discarded while preparing
+            preload.prepared.complete(null);
+            return;
+        }
+
+        // The pyramid pass and then the first screen run as later tasks on this same thread, so
+        // the whole preparation stays at low priority; the screen then stays in the cache
+        waveform.prepareViewport(initialViewport(durationSeconds))
+                .whenComplete(
+                        (_, e) -> {
+                            if (e == null) {
+                                log.debug("Preloaded waveform for {}", file.getFileName());
+                            }
+                            preload.prepared.complete(null);
+                        });
+    }
+
+    private synchronized boolean reserve(@NonNull Preload preload, long sizeBytes) {
+        long reserved = preloads.values().stream().mapToLong(p -> p.sizeBytes).sum();
+        if (reserved + sizeBytes > budgetBytes) {
+            return false;
+        }
+        preload.sizeBytes = sizeBytes;
+        return true;
+    }
+
+    /** The view a newly opened file starts with: the current zoom and size, centred on 0. */
+    private WaveformViewportSpec initialViewport(double durationSeconds) {
+        return managerProvider
+                .get()
+                .getCurrentWaveform()
+                .flatMap(Waveform::getLastViewport)
+                .map(
+                        v -> {
+                            double widthSeconds =
+                                    v.viewportWidthPx() / (double) v.pixelsPerSecond();
+                            return new WaveformViewportSpec(
+                                    -widthSeconds / 2,
+                                    widthSeconds / 2,
+                                    v.viewportWidthPx(),
+                                    v.viewportHeightPx(),
+                                    v.pixelsPerSecond(),
+                                    durationSeconds);
+                        })
+                .orElseGet(() -> Waveform.defaultViewport(durationSeconds));
+    }
+
+    private static void discard(@NonNull Preload preload) {
+        // A preparation still running shuts its waveform down itself once it sees the cancel
+        if (!preload.waveform.cancel(false)) {
+            preload.waveform.thenAccept(Waveform::shutdown);
+        }
+    }
+
+    private static void closeQuietly(SampleReader reader) {
+        if (reader == null) {
+            return;
+        }
+        try {
+            reader.close();
+        } catch (IOException e) {
+            log.debug("Error closing preload sample reader", e);
+        }
+    }
+
+    private static Path keyFor(@NonNull Path audioFile) {
+        return audioFile.toAbsolutePath().normalize();
+    }
+}
@@ -2,6 +2,8 @@ package core.waveform;
 
 import core.audio.AudioMetadata;
 import core.audio.SampleReader;
+import core.telemetry.SegmentRenderEvent;
+import core.waveform.signal.PeakPyramid;
 import core.waveform.signal.PixelScaler;
 import core.waveform.signal.WaveformProcessor;
 import java.awt.Color;
@@ -9,10 +11,14 @@ import java.awt.Graphics2D;
 import java.awt.Image;
 import java.awt.RenderingHints;
 import java.awt.image.BufferedImage;
+import java.io.IOException;
+import java.nio.file.Path;
 import java.text.DecimalFormat;
 import java.util.ArrayList;
 import java.util.List;
+import java.util.Optional;
 import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.Executor;
 import java.util.concurrent.ExecutorService;
 import lombok.NonNull;
 import org.slf4j.Logger;
@@ -26,7 +32,10 @@ class WaveformRenderer {
     private static final Logger logger = LoggerFactory.getLogger(WaveformRenderer.class);
 
     private static final int SEGMENT_WIDTH_PX = WaveformSegmentCache.SEGMENT_WIDTH_PX;
-    private static final int PREFETCH_COUNT = WaveformSegmentCache.PREFETCH_COUNT;
+
+    // Longest segment drawn from its own frames while the pyramid builds; coarser zooms show the
+    // partial pyramid preview until it completes
+    private static final double PROVISIONAL_MAX_SECONDS = 30;
 
     // Waveform rendering constants (from original WaveformRenderer)
     private static final Color WAVEFORM_BACKGROUND = Color.WHITE;
@@ -35,8 +44,11 @@ class WaveformRenderer {
     private static final Color WAVEFORM_SCALE_TEXT = Color.BLACK;
     private static final Color FIRST_CHANNEL_WAVEFORM = Color.BLACK;
     private static final DecimalFormat SEC_FORMAT = new DecimalFormat("0.00s");
+    // Segment lines are all axis-aligned at whole pixels, where geometry antialiasing changes
+    // nothing but still costs a coverage pass per line; only the scale labels need smoothing
     private static final RenderingHints RENDERING_HINTS =
-            new RenderingHints(RenderingHints.KEY_ANTIALIASING, RenderingHints.VALUE_ANTIALIAS_ON);
+            new RenderingHints(
+                    RenderingHints.KEY_ANTIALIASING, RenderingHints.VALUE_ANTIALIAS_OFF);
 
     static {
         RENDERING_HINTS.put(RenderingHints.KEY_RENDERING, RenderingHints.VALUE_RENDER_QUALITY);
@@ -48,10 +60,26 @@ class WaveformRenderer {
 
     private final WaveformSegmentCache cache;
     private final ExecutorService renderPool;
+    private final PrefetchScheduler prefetchScheduler;
     private final String audioFilePath;
     private final WaveformProcessor processor;
     private final WaveformPeakDetector peakDetector;
+    private final PixelScaler pixelScaler = new PixelScaler();
     private final double audioDurationSeconds;
+    private final int sampleRate;
+
+    // Built (or mapped from a sidecar) once per file; segment renders chain off its completion,
+    // except short visible ones drawn provisionally while it builds
+    private final CompletableFuture<PeakPyramid> pyramid;
+
+    // The frames the first pass has filtered so far while the pyramid builds, for previews; null
+    // otherwise
+    private volatile PeakPyramid partialPyramid;
+    private volatile PartialPreview partialPreview;
+
+    /** Last preview drawn from a partial pyramid, reused until the viewport or pyramid changes. */
+    private record PartialPreview(
+            @NonNull String specId, @NonNull PeakPyramid source, @NonNull Image image) {}
 
     enum Priority {
         VISIBLE(1),
@@ -84,110 +112,174 @@ class WaveformRenderer {
             @NonNull ExecutorService renderPool,
             @NonNull SampleReader sampleReader,
             int sampleRate,
-            @NonNull AudioMetadata metadata) {
+            @NonNull AudioMetadata metadata,
+            @NonNull PeakPyramidStore pyramidStore,
+            @NonNull Optional<PeakPyramid> storedPyramid) {
+        this(
+                audioFilePath,
+                cache,
+                renderPool,
+                renderPool,
+                sampleReader,
+                sampleRate,
+                metadata,
+                pyramidStore,
+                storedPyramid);
+    }
+
+    /**
+     * Create a renderer whose first pass over the file runs on {@code buildPool} rather than the
+     * render pool, so a waveform prepared in the background builds its pyramid at that pool's
+     * priority.
+     */
+    WaveformRenderer(
+            @NonNull String audioFilePath,
+            @NonNull WaveformSegmentCache cache,
+            @NonNull ExecutorService renderPool,
+            @NonNull Executor buildPool,
+            @NonNull SampleReader sampleReader,
+            int sampleRate,
+            @NonNull AudioMetadata metadata,
+            @NonNull PeakPyramidStore pyramidStore,
+            @NonNull Optional<PeakPyramid> storedPyramid) {
         this.audioFilePath = audioFilePath;
         this.cache = cache;
         this.renderPool = renderPool;
-        this.processor = new WaveformProcessor(sampleReader, sampleRate, new PixelScaler());
-        this.peakDetector = new WaveformPeakDetector(audioFilePath, processor, metadata);
+        this.prefetchScheduler = new PrefetchScheduler(cache, this::renderSegment);
+        this.processor = new WaveformProcessor(sampleReader, sampleRate, pixelScaler);
+        this.peakDetector = new WaveformPeakDetector();
         this.audioDurationSeconds = metadata.durationSeconds();
+        this.sampleRate = sampleRate;
+
+        // Use the stored peak pyramid when there is one; otherwise build it in one pass (so zooming
+        // no longer re-runs the DSP per segment) and store it for the next time the file is opened
+        CompletableFuture<PeakPyramid> source;
+        if (storedPyramid.isPresent()) {
+            source = CompletableFuture.completedFuture(storedPyramid.get());
+        } else {
+            source =
+                    CompletableFuture.supplyAsync(
+                            () -> {
+                                try {
+                                    PeakPyramid built =
+                                            processor.buildPeakPyramid(
+                                                    audioFilePath,
+                                                    metadata,
+                                                    partial -> partialPyramid = partial);
+                                    pyramidStore.save(
+                                            Path.of(audioFilePath),
+                                            WaveformProcessor.PYRAMID_PARAMETERS,
+                                            built,
+                                            metadata);
+                                    return built;
+                                } catch (Exception e) {
+                                    // Render silence rather than failing every segment
+                                    logger.warn(
+                                            "Failed to build peak pyramid: {}", e.getMessage());
+                                    int channels = Math.max(1, metadata.channelCount());
+                                    return new PeakPyramid.Builder(sampleRate, channels, 0)
+                                            .build();
+                                }
+                            },
+                            buildPool);
+        }
 
-        // Initialize the peak detector asynchronously to pre-calculate common resolutions
-        CompletableFuture.runAsync(
-                () -> {
-                    try {
-                        peakDetector.initialize();
-                    } catch (Exception e) {
-                        logger.error("Failed to initialize peak detector: {}", e.getMessage());
-                    }
-                },
-                renderPool);
+        // The global peak comes from the same pass, so scaling needs no extra decoding. Taking it
+        // before the future is published guarantees every segment render sees it.
+        this.pyramid =
+                source.thenApply(
+                        built -> {
+                            peakDetector.update(built);
+                            partialPyramid = null;
+                            partialPreview = null;
+                            return built;
+                        });
     }
 
-    /** Fill cache for viewport with priority-based rendering. */
+    /** The file's peak pyramid, complete once the first pass (or sidecar load) finishes. */
+    CompletableFuture<PeakPyramid> peakPyramid() {
+        return pyramid;
+    }
+
+    /** Fill cache for viewport with priority-based rendering, and composite the result. */
     CompletableFuture<Image> renderViewport(@NonNull WaveformViewportSpec viewport) {
+        return renderTiles(viewport).thenApply(tiles -> tiles == null ? null : tiles.toImage());
+    }
+
+    /**
+     * Fill cache for viewport with priority-based rendering. Completes with the visible segments
+     * and their placement, or null if rendering failed or was cancelled.
+     */
+    CompletableFuture<WaveformTileSet> renderTiles(@NonNull WaveformViewportSpec viewport) {
         // Update cache for new viewport
         cache.updateViewport(viewport);
 
         // Calculate visible segments
         List<WaveformSegmentCache.SegmentKey> visibleSegments = calculateVisibleSegments(viewport);
 
-        // Get or render each segment
+        // Get or render each segment; concurrent requests for a segment share one render
         List<CompletableFuture<Image>> segmentFutures = new ArrayList<>();
         for (var key : visibleSegments) {
-            CompletableFuture<Image> future = cache.get(key);
-            if (future == null) {
-                future = renderSegment(key);
-                cache.put(key, future);
-            }
-            segmentFutures.add(future);
+            segmentFutures.add(cache.getOrRender(key, this::renderSegment, true));
         }
 
-        // Start prefetch tasks asynchronously
-        CompletableFuture.runAsync(
-                () -> {
-                    addPrefetchTasks(viewport);
-                },
-                renderPool);
-
-        // Composite segments when all ready
-        CompletableFuture<Image> compositeFuture =
-                CompletableFuture.allOf(segmentFutures.toArray(CompletableFuture[]::new))
-                        .thenApply(
-                                _ -> {
-                                    List<Image> segments =
-                                            segmentFutures.stream()
-                                                    .map(f -> f.getNow(null))
-                                                    .toList();
-                                    Image compositeImage = compositeSegments(segments, viewport);
-                                    logger.trace(
-                                            "Successfully rendered viewport [{}s - {}s] with {}"
-                                                    + " segments",
-                                            String.format("%.2f", viewport.startTimeSeconds()),
-                                            String.format("%.2f", viewport.endTimeSeconds()),
-                                            segments.size());
-                                    return compositeImage;
-                                })
-                        .exceptionally(
-                                e -> {
-                                    // Check if this is a cancellation
-                                    Throwable cause = e.getCause();
-                                    if (cause
-                                            instanceof java.util.concurrent.CancellationException) {
-                                        // Don't log cancellations - they're expected during
-                                        // navigation
-                                        logger.debug(
-                                                "Waveform render cancelled for viewport at {}s",
-                                                viewport.startTimeSeconds());
-                                    } else {
-                                        // Log other errors
-                                        logger.warn("Error rendering waveform viewport: ", e);
-                                    }
-                                    return null;
-                                });
-
-        return compositeFuture;
+        // Queue off-screen segments in the direction the view is moving, off the paint path
+        prefetchScheduler.scheduleOn(viewport, renderPool);
+
+        // Place segments when all ready
+        return CompletableFuture.allOf(segmentFutures.toArray(CompletableFuture[]::new))
+                .thenApply(
+                        _ -> {
+                            List<Image> segments =
+                                    segmentFutures.stream().map(f -> f.getNow(null)).toList();
+                            WaveformTileSet tiles = tileSet(segments, viewport);
+                            logger.trace(
+                                    "Successfully rendered viewport [{}s - {}s] with {} segments",
+                                    String.format("%.2f", viewport.startTimeSeconds()),
+                                    String.format("%.2f", viewport.endTimeSeconds()),
+                                    segments.size());
+                            return tiles;
+                        })
+                .exceptionally(
+                        e -> {
+                            // Check if this is a cancellation
+                            Throwable cause = e.getCause();
+                            if (cause instanceof java.util.concurrent.CancellationException) {
+                                // Don't log cancellations - they're expected during navigation
+                                logger.debug(
+                                        "Waveform render cancelled for viewport at {}s",
+                                        viewport.startTimeSeconds());
+                            } else {
+                                // Log other errors
+                                logger.warn("Error rendering waveform viewport: ", e);
+                            }
+                            return null;
+                        });
+    }
+
+    /**
+     * Render the viewport's visible segments into the cache once the pyramid is complete, drawing
+     * them on {@code executor} instead of the render pool and scheduling no prefetches.
+     */
+    CompletableFuture<Void> prepareTiles(
+            @NonNull WaveformViewportSpec viewport, @NonNull Executor executor) {
+        cache.updateViewport(viewport);
+        List<CompletableFuture<Image>> segmentFutures = new ArrayList<>();
+        for (var key : calculateVisibleSegments(viewport)) {
+            segmentFutures.add(cache.getOrRender(key, k -> renderSegment(k, executor), true));
+        }
+        return CompletableFuture.allOf(segmentFutures.toArray(CompletableFuture[]::new));
     }
 
     /** Calculate which segments are needed for the viewport. */
-    private List<WaveformSegmentCache.SegmentKey> calculateVisibleSegments(
+    static List<WaveformSegmentCache.SegmentKey> calculateVisibleSegments(
             @NonNull WaveformViewportSpec viewport) {
         List<WaveformSegmentCache.SegmentKey> segments = new ArrayList<>();
 
         // Calculate segment indices based on viewport time range
         // Each segment represents SEGMENT_WIDTH_PX pixels worth of audio
-        long startIndex =
-                (long)
-                        Math.floor(
-                                viewport.startTimeSeconds()
-                                        * viewport.pixelsPerSecond()
-                                        / SEGMENT_WIDTH_PX);
-        long endIndex =
-                (long)
-                        Math.ceil(
-                                viewport.endTimeSeconds()
-                                        * viewport.pixelsPerSecond()
-                                        / SEGMENT_WIDTH_PX);
+        long startIndex = PrefetchScheduler.firstVisibleIndex(viewport);
+        long endIndex = PrefetchScheduler.lastVisibleIndex(viewport);
 
         logger.trace(
                 "calculateVisibleSegments: viewport=[{}-{}s] @ {}px/s, HEIGHT={},"
@@ -216,68 +308,13 @@ class WaveformRenderer {
         return segments;
     }
 
-    /** Add symmetric prefetch tasks (no scroll direction). */
-    private void addPrefetchTasks(@NonNull WaveformViewportSpec viewport) {
-        // Check for interruption before starting prefetch
-        if (Thread.currentThread().isInterrupted()) {
-            return; // Skip prefetch if interrupted
-        }
-
-        // Calculate the last visible segment index
-        long endIndex =
-                (long)
-                        Math.ceil(
-                                viewport.endTimeSeconds()
-                                        * viewport.pixelsPerSecond()
-                                        / SEGMENT_WIDTH_PX);
-        long startIndex =
-                (long)
-                        Math.floor(
-                                viewport.startTimeSeconds()
-                                        * viewport.pixelsPerSecond()
-                                        / SEGMENT_WIDTH_PX);
-
-        logger.trace(
-                "Prefetching for viewport {}s-{}s, segments {}-{}, will prefetch up to segment {}",
-                viewport.startTimeSeconds(),
-                viewport.endTimeSeconds(),
-                startIndex,
-                endIndex,
-                endIndex + PREFETCH_COUNT);
-
-        // Prefetch forward (segments after the viewport)
-        for (int i = 1; i <= PREFETCH_COUNT; i++) {
-            long prefetchIndex = endIndex + i;
-            var key =
-                    new WaveformSegmentCache.SegmentKey(
-                            prefetchIndex, viewport.pixelsPerSecond(), viewport.viewportHeightPx());
-            // Use no-stats version for prefetch checks
-            if (cache.get(key, false) == null) {
-                CompletableFuture<Image> future = renderSegment(key);
-                cache.put(key, future);
-            }
-        }
-
-        // Prefetch backward (segments before the viewport)
-        for (int i = 1; i <= PREFETCH_COUNT; i++) {
-            long prefetchIndex = startIndex - i;
-            // Don't prefetch segments before the start of the audio
-            if (prefetchIndex < 0) {
-                continue;
-            }
-            var key =
-                    new WaveformSegmentCache.SegmentKey(
-                            prefetchIndex, viewport.pixelsPerSecond(), viewport.viewportHeightPx());
-            // Use no-stats version for prefetch checks
-            if (cache.get(key, false) == null) {
-                CompletableFuture<Image> future = renderSegment(key);
-                cache.put(key, future);
-            }
-        }
+    /** Render single 200px segment. */
+    CompletableFuture<Image> renderSegment(@NonNull WaveformSegmentCache.SegmentKey key) {
+        return renderSegment(key, renderPool);
     }
 
-    /** Render single 200px segment. */
-    private CompletableFuture<Image> renderSegment(@NonNull WaveformSegmentCache.SegmentKey key) {
+    private CompletableFuture<Image> renderSegment(
+            @NonNull WaveformSegmentCache.SegmentKey key, @NonNull Executor executor) {
 
         // For segments that start before 0, we'll render partial content
         // Calculate the segment duration
@@ -288,289 +325,387 @@ class WaveformRenderer {
             return CompletableFuture.completedFuture(null);
         }
 
-        return CompletableFuture.supplyAsync(
-                () -> {
-                    // Check for cancellation at start
-                    if (Thread.currentThread().isInterrupted()) {
-                        throw new java.util.concurrent.CancellationException("Render cancelled");
-                    }
-
-                    logger.trace(
-                            "renderSegment: Creating image for segment {} with HEIGHT={}",
-                            key.segmentIndex(),
-                            key.height());
+        // The first pass over a file reads it end to end; rather than hold every visible segment
+        // until it finishes, draw segments short enough to read on their own straight away
+        if (!pyramid.isDone() && segmentDuration <= PROVISIONAL_MAX_SECONDS) {
+            return renderProvisional(key, executor);
+        }
+
+        return pyramid.thenApplyAsync(
+                peaks -> {
+                    var event = new SegmentRenderEvent();
+                    event.start();
+                    // Use global peak for consistent scaling across all segments
                     BufferedImage image =
-                            new BufferedImage(
-                                    SEGMENT_WIDTH_PX, key.height(), BufferedImage.TYPE_INT_ARGB);
-
-                    // Handle segments that start before 0
-                    int chunkIndex = 0;
-                    double segmentOffsetInChunk = 0;
-
-                    if (key.startTime() >= 0) {
-                        chunkIndex =
-                                (int)
-                                        (key.startTime()
-                                                / WaveformProcessor
-                                                        .STANDARD_CHUNK_DURATION_SECONDS);
-                        double chunkStartTime =
-                                chunkIndex * WaveformProcessor.STANDARD_CHUNK_DURATION_SECONDS;
-                        segmentOffsetInChunk = key.startTime() - chunkStartTime;
-                    } else {
-                        // Segment starts before 0, we'll use chunk 0 but offset differently
-                        chunkIndex = 0;
-                        segmentOffsetInChunk = key.startTime(); // Will be negative
-                    }
-
-                    // Check for cancellation before expensive operation
-                    if (Thread.currentThread().isInterrupted()) {
-                        throw new java.util.concurrent.CancellationException("Render cancelled");
-                    }
-
-                    // Process the full 10-second chunk (matching original implementation)
-                    double[] tempChunkData;
-                    try {
-                        int chunkWidthPixels =
-                                (int)
-                                        (WaveformProcessor.STANDARD_CHUNK_DURATION_SECONDS
-                                                * key.pixelsPerSecond());
-                        tempChunkData =
-                                processor.processAudioForDisplay(
-                                        audioFilePath, chunkIndex, chunkWidthPixels);
-                    } catch (Exception e) {
-                        logger.warn(
-                                "Failed to process audio for segment at {}s: {}",
-                                key.startTime(),
-                                e.getMessage());
-                        tempChunkData = new double[0];
-                    }
-                    final double[] fullChunkData = tempChunkData;
-
-                    // Extract the 200px segment we need from the full chunk
-                    double[] valsToDraw = new double[SEGMENT_WIDTH_PX];
-                    int segmentStartPixel = (int) (segmentOffsetInChunk * key.pixelsPerSecond());
-
-                    // Calculate how many pixels contain actual audio data
-                    // We need to check both: data availability and audio duration
-                    int audioDataPixelCount = 0;
-
-                    // Calculate where the audio ends in pixels for this segment
-                    double segmentStartTime = key.startTime();
-                    double pixelsPerSecond = key.pixelsPerSecond();
-
-                    for (int i = 0; i < SEGMENT_WIDTH_PX; i++) {
-                        // Calculate the time for this pixel
-                        double pixelTime = segmentStartTime + (i / (double) pixelsPerSecond);
-
-                        // Check if this pixel is within the audio duration
-                        if (pixelTime >= audioDurationSeconds) {
-                            break; // We've reached the end of audio
-                        }
-
-                        int dataIndex = segmentStartPixel + i;
-                        if (dataIndex >= 0 && dataIndex < fullChunkData.length) {
-                            valsToDraw[i] = fullChunkData[dataIndex];
-                            audioDataPixelCount = i + 1; // Track the last pixel with data
-                        } else if (pixelTime >= 0) {
-                            // We're in valid time range but no data - still count as audio region
-                            // This handles edge cases at chunk boundaries
-                            audioDataPixelCount = i + 1;
-                        }
-                        // else leave as 0 (silence for out-of-bounds regions before time 0)
-                    }
-
-                    Graphics2D g = image.createGraphics();
-                    try {
-                        // Enable antialiasing
-                        g.setRenderingHints(RENDERING_HINTS);
-
-                        int centerY = key.height() / 2;
-
-                        // Only fill background where there's audio data
-                        if (audioDataPixelCount > 0) {
-                            g.setColor(WAVEFORM_BACKGROUND);
-                            g.fillRect(0, 0, audioDataPixelCount, key.height());
-                        }
-                        // The rest remains transparent (ARGB with alpha = 0)
-
-                        // Draw reference line only where there's audio data
-                        if (audioDataPixelCount > 0) {
-                            g.setColor(WAVEFORM_REFERENCE_LINE);
-                            g.drawLine(0, centerY, audioDataPixelCount, centerY);
-                        }
-
-                        // Draw time scale (vertical lines and labels) only where there's audio
-                        if (audioDataPixelCount > 0) {
-                            drawTimeScale(
-                                    g,
-                                    audioDataPixelCount, // Only draw scale up to where audio data
-                                    // ends
-                                    key.height(),
-                                    key.startTime(),
-                                    key.pixelsPerSecond());
-                        }
-
-                        // Draw waveform using exact same logic as original
-                        g.setColor(FIRST_CHANNEL_WAVEFORM);
-
-                        // Use global peak for consistent scaling across all segments
-                        double peak = peakDetector.getPeak(key.pixelsPerSecond());
-
-                        double yScale;
-                        if (peak <= 0) {
-                            yScale = 0;
-                        } else {
-                            yScale = (((double) key.height() / 2) - 1) / peak;
-                            if (Double.isInfinite(yScale) || Double.isNaN(yScale)) {
-                                yScale = 0;
+                            drawSegment(
+                                    segmentPeaks(peaks, key),
+                                    key,
+                                    peakDetector.getPeak(key.pixelsPerSecond()),
+                                    audioDurationSeconds);
+                    event.startSeconds = key.startTime();
+                    event.pixelsPerSecond = key.pixelsPerSecond();
+                    event.heightPx = key.height();
+                    event.finish();
+                    return image;
+                },
+                executor);
+    }
+
+    /**
+     * Render a segment from a bounded read of its own frames while the pyramid is still building.
+     * The global peak is not known yet, so the segment is scaled to the loudest frame processed so
+     * far (or its own loudest pixel, if louder), and is dropped from the cache once the pyramid
+     * completes so the next frame redraws it at the final scale.
+     */
+    private CompletableFuture<Image> renderProvisional(
+            @NonNull WaveformSegmentCache.SegmentKey key, @NonNull Executor executor) {
+        CompletableFuture<Image> future =
+                CompletableFuture.supplyAsync(
+                        () -> {
+                            var event = new SegmentRenderEvent();
+                            event.start();
+                            double[] envelope = provisionalPeaks(key);
+                            double peak = 0;
+                            for (double value : envelope) {
+                                peak = Math.max(peak, value);
                             }
-                        }
-
-                        logger.trace(
-                                "Segment {} render scaling: height={}, centerY={}, peak={},"
-                                        + " yScale={}",
-                                key.segmentIndex(),
-                                key.height(),
-                                centerY,
-                                peak,
-                                yScale);
-
-                        // Draw waveform only where there's audio data
-                        for (int i = 0; i < audioDataPixelCount; i++) {
-                            // Check for interruption periodically (every 10 pixels for performance)
-                            if (i % 10 == 0 && Thread.currentThread().isInterrupted()) {
-                                g.dispose();
-                                throw new java.util.concurrent.CancellationException(
-                                        "Render cancelled during draw");
+                            PeakPyramid partial = partialPyramid;
+                            if (partial != null) {
+                                peak = Math.max(peak, partial.peak());
                             }
+                            BufferedImage image =
+                                    drawSegment(
+                                            envelope,
+                                            key,
+                                            WaveformPeakDetector.scalingPeak(peak),
+                                            audioDurationSeconds);
+                            event.startSeconds = key.startTime();
+                            event.pixelsPerSecond = key.pixelsPerSecond();
+                            event.heightPx = key.height();
+                            event.finish();
+                            return image;
+                        },
+                        executor);
+        // Runs on the pool, so it waits for getOrRender to finish caching the future it removes
+        pyramid.runAfterBothAsync(future, () -> cache.remove(key, future), renderPool);
+        return future;
+    }
 
-                            double scaledSample = valsToDraw[i] * yScale;
-                            int topY = (int) (centerY - scaledSample);
-                            int bottomY = (int) (centerY + scaledSample);
-
-                            g.drawLine(i, centerY, i, topY);
-                            g.drawLine(i, centerY, i, bottomY);
-                        }
+    /** Peak per pixel for a segment read from its own frames, or silence if the read fails. */
+    private double[] provisionalPeaks(@NonNull WaveformSegmentCache.SegmentKey key) {
+        try {
+            return processor.segmentEnvelope(
+                    audioFilePath,
+                    key.startTime() * sampleRate,
+                    (double) sampleRate / key.pixelsPerSecond(),
+                    SEGMENT_WIDTH_PX);
+        } catch (IOException e) {
+            logger.warn(
+                    "Failed to read segment {} samples: {}", key.segmentIndex(), e.getMessage());
+            return new double[SEGMENT_WIDTH_PX];
+        }
+    }
 
-                    } finally {
-                        g.dispose();
-                    }
+    /**
+     * Peak per pixel for a segment. Zooms finer than the pyramid's base bins read the segment's
+     * own frames, so every pixel stays exact; coarser zooms read the pyramid.
+     */
+    private double[] segmentPeaks(
+            @NonNull PeakPyramid peaks, @NonNull WaveformSegmentCache.SegmentKey key) {
+        double framesPerPixel = (double) sampleRate / key.pixelsPerSecond();
+        if (framesPerPixel < PeakPyramid.BASE_BIN_FRAMES) {
+            try {
+                return processor.segmentEnvelope(
+                        audioFilePath,
+                        key.startTime() * sampleRate,
+                        framesPerPixel,
+                        SEGMENT_WIDTH_PX);
+            } catch (IOException e) {
+                // Reads may fail transiently during file switches; the pyramid is close enough
+                logger.warn(
+                        "Failed to read segment {} samples: {}",
+                        key.segmentIndex(),
+                        e.getMessage());
+            }
+        }
+        return pyramidPeaks(peaks, key);
+    }
 
-                    logger.trace(
-                            "Successfully rendered segment at {}s ({}x{} px)",
-                            key.startTime(),
-                            SEGMENT_WIDTH_PX,
-                            key.height());
-                    return image;
-                },
-                renderPool);
+    /** Peak per pixel for a segment from the coarsest pyramid level that resolves its pixels. */
+    private double[] pyramidPeaks(
+            @NonNull PeakPyramid peaks, @NonNull WaveformSegmentCache.SegmentKey key) {
+        double framesPerPixel = (double) sampleRate / key.pixelsPerSecond();
+        return peaks.envelope(key.startTime() * sampleRate, framesPerPixel, SEGMENT_WIDTH_PX);
     }
 
-    /** Composite segments into single viewport image. */
-    private Image compositeSegments(
-            @NonNull List<Image> segments, @NonNull WaveformViewportSpec viewport) {
-        // Check for interruption before compositing
+    /**
+     * Draw one segment from its per-pixel peaks.
+     *
+     * @param envelope Peak magnitude of each of the segment's pixels
+     * @param peak Peak magnitude that spans half the segment height
+     * @param endSeconds Time after which the segment is left transparent
+     */
+    private BufferedImage drawSegment(
+            @NonNull double[] envelope,
+            @NonNull WaveformSegmentCache.SegmentKey key,
+            double peak,
+            double endSeconds) {
+        // Check for cancellation at start
         if (Thread.currentThread().isInterrupted()) {
-            throw new java.util.concurrent.CancellationException("Composite cancelled");
-        }
-
-        if (segments.isEmpty()) {
-            return new BufferedImage(1, 1, BufferedImage.TYPE_INT_ARGB);
+            throw new java.util.concurrent.CancellationException("Render cancelled");
         }
 
         logger.trace(
-                "Creating composite image: width={}, HEIGHT={}",
-                viewport.viewportWidthPx(),
-                viewport.viewportHeightPx());
-        BufferedImage composite =
-                new BufferedImage(
-                        viewport.viewportWidthPx(),
-                        viewport.viewportHeightPx(),
-                        BufferedImage.TYPE_INT_ARGB);
+                "renderSegment: Creating image for segment {} with HEIGHT={}",
+                key.segmentIndex(),
+                key.height());
+        BufferedImage image =
+                new BufferedImage(SEGMENT_WIDTH_PX, key.height(), BufferedImage.TYPE_INT_ARGB);
+
+        double[] pixelPeaks = pixelScaler.smoothPixels(envelope);
+
+        // Copy the pixels that fall before endSeconds; pixels before time 0 are already silent in
+        // the envelope
+        double[] valsToDraw = new double[SEGMENT_WIDTH_PX];
+        int audioDataPixelCount = 0;
+        double segmentStartTime = key.startTime();
+        double pixelsPerSecond = key.pixelsPerSecond();
+
+        for (int i = 0; i < SEGMENT_WIDTH_PX; i++) {
+            double pixelTime = segmentStartTime + (i / (double) pixelsPerSecond);
+            if (pixelTime >= endSeconds) {
+                break; // We've reached the end of audio
+            }
+            valsToDraw[i] = pixelPeaks[i];
+            audioDataPixelCount = i + 1;
+        }
 
-        Graphics2D g = composite.createGraphics();
+        Graphics2D g = image.createGraphics();
         try {
-            // Fill background
-            g.setColor(new Color(242, 242, 242));
-            g.fillRect(0, 0, viewport.viewportWidthPx(), viewport.viewportHeightPx());
+            g.setRenderingHints(RENDERING_HINTS);
 
-            // Calculate the offset for the first segment
-            // The first segment's index tells us its start time
-            long firstSegmentIndex =
-                    (long)
-                            Math.floor(
-                                    viewport.startTimeSeconds()
-                                            * viewport.pixelsPerSecond()
-                                            / SEGMENT_WIDTH_PX);
-
-            // Calculate where in pixels the first segment should start
-            // This will be negative if the viewport starts partway through the segment
-            double firstSegmentStartTime =
-                    (firstSegmentIndex * SEGMENT_WIDTH_PX) / (double) viewport.pixelsPerSecond();
-            double offsetSeconds = firstSegmentStartTime - viewport.startTimeSeconds();
-            int offsetPixels = (int) Math.round(offsetSeconds * viewport.pixelsPerSecond());
+            int centerY = key.height() / 2;
+
+            // Only fill background where there's audio data
+            if (audioDataPixelCount > 0) {
+                g.setColor(WAVEFORM_BACKGROUND);
+                g.fillRect(0, 0, audioDataPixelCount, key.height());
+            }
+            // The rest remains transparent (ARGB with alpha = 0)
+
+            // Draw reference line only where there's audio data
+            if (audioDataPixelCount > 0) {
+                g.setColor(WAVEFORM_REFERENCE_LINE);
+                g.drawLine(0, centerY, audioDataPixelCount, centerY);
+            }
+
+            // Draw time scale (vertical lines and labels) only where there's audio
+            if (audioDataPixelCount > 0) {
+                drawTimeScale(
+                        g,
+                        audioDataPixelCount, // Only draw scale up to where audio data
+                        // ends
+                        key.height(),
+                        key.startTime(),
+                        key.pixelsPerSecond());
+            }
+
+            // Draw waveform using exact same logic as original
+            g.setColor(FIRST_CHANNEL_WAVEFORM);
+
+            double yScale;
+            if (peak <= 0) {
+                yScale = 0;
+            } else {
+                yScale = (((double) key.height() / 2) - 1) / peak;
+                if (Double.isInfinite(yScale) || Double.isNaN(yScale)) {
+                    yScale = 0;
+                }
+            }
 
             logger.trace(
-                    "Compositing: viewport=[{}-{}s], viewportHEIGHT={}, firstSegIdx={},"
-                            + " segStartTime={}, offsetSec={}, offsetPx={}, segmentCount={}",
-                    viewport.startTimeSeconds(),
-                    viewport.endTimeSeconds(),
-                    viewport.viewportHeightPx(),
-                    firstSegmentIndex,
-                    firstSegmentStartTime,
-                    offsetSeconds,
-                    offsetPixels,
-                    segments.size());
-
-            // Draw each segment at its position
-            int x = offsetPixels;
-            for (Image segment : segments) {
-                // Check for interruption during compositing
-                if (Thread.currentThread().isInterrupted()) {
+                    "Segment {} render scaling: height={}, centerY={}, peak={},"
+                            + " yScale={}",
+                    key.segmentIndex(),
+                    key.height(),
+                    centerY,
+                    peak,
+                    yScale);
+
+            // Draw waveform only where there's audio data
+            for (int i = 0; i < audioDataPixelCount; i++) {
+                // Check for interruption periodically (every 10 pixels for performance)
+                if (i % 10 == 0 && Thread.currentThread().isInterrupted()) {
+                    g.dispose();
                     throw new java.util.concurrent.CancellationException(
-                            "Composite cancelled during draw");
+                            "Render cancelled during draw");
                 }
 
-                if (segment != null) {
-                    // Center the segment vertically if there's a height mismatch
-                    int segmentHeight = segment.getHeight(null);
-                    int y = (viewport.viewportHeightPx() - segmentHeight) / 2;
-                    if (y != 0) {
-                        logger.warn(
-                                "HEIGHT MISMATCH: viewport height={}, segment height={}, y"
-                                        + " offset={}",
-                                viewport.viewportHeightPx(),
-                                segmentHeight,
-                                y);
-                    }
-                    g.drawImage(segment, x, y, null);
-                }
-                // Always advance position, even for null segments (pre-audio silence)
-                x += SEGMENT_WIDTH_PX;
+                double scaledSample = valsToDraw[i] * yScale;
+                int topY = (int) (centerY - scaledSample);
+                int bottomY = (int) (centerY + scaledSample);
 
-                // Stop if we've filled the viewport
-                if (x >= viewport.viewportWidthPx()) {
-                    break;
-                }
+                g.drawLine(i, centerY, i, topY);
+                g.drawLine(i, centerY, i, bottomY);
             }
 
-            // Handle partial last segment
-            if (x < viewport.viewportWidthPx() && !segments.isEmpty()) {
-                // Last segment might extend beyond viewport
-                Image lastSegment = segments.get(segments.size() - 1);
-                if (lastSegment != null) {
-                    int segmentHeight = lastSegment.getHeight(null);
-                    int y = (viewport.viewportHeightPx() - segmentHeight) / 2;
-                    int remainingWidth = viewport.viewportWidthPx() - x + SEGMENT_WIDTH_PX;
-                    g.setClip(x - SEGMENT_WIDTH_PX, 0, remainingWidth, viewport.viewportHeightPx());
-                    g.drawImage(lastSegment, x - SEGMENT_WIDTH_PX, y, null);
+        } finally {
+            g.dispose();
+        }
+
+        logger.trace(
+                "Successfully rendered segment at {}s ({}x{} px)",
+                key.startTime(),
+                SEGMENT_WIDTH_PX,
+                key.height());
+        return image;
+    }
+
+    /**
+     * Compose a stand-in viewport image from the nearest cached zoom/height tier, scaled to this
+     * viewport, to show while the exact segments render. With no other tier cached, falls back to
+     * the part of the file the first pass has processed so far; returns null if there is neither.
+     */
+    Image renderPreview(@NonNull WaveformViewportSpec viewport) {
+        var target =
+                new WaveformSegmentCache.Tier(
+                        viewport.pixelsPerSecond(), viewport.viewportHeightPx());
+        var tier = cache.nearestCompletedTier(target).orElse(null);
+        if (tier == null) {
+            return renderPartialPreview(viewport);
+        }
+
+        int tierPps = tier.pixelsPerSecond();
+        double scaleX = (double) viewport.pixelsPerSecond() / tierPps;
+        int scaledWidth = (int) Math.ceil(SEGMENT_WIDTH_PX * scaleX);
+        long firstIndex =
+                (long) Math.floor(viewport.startTimeSeconds() * tierPps / SEGMENT_WIDTH_PX);
+        long lastIndex = (long) Math.ceil(viewport.endTimeSeconds() * tierPps / SEGMENT_WIDTH_PX);
+
+        BufferedImage preview =
+                new BufferedImage(
+                        viewport.viewportWidthPx(),
+                        viewport.viewportHeightPx(),
+                        BufferedImage.TYPE_INT_ARGB);
+        Graphics2D g = preview.createGraphics();
+        boolean drewAny = false;
+        try {
+            g.setColor(WaveformTileSet.BACKGROUND);
+            g.fillRect(0, 0, viewport.viewportWidthPx(), viewport.viewportHeightPx());
+            g.setRenderingHint(
+                    RenderingHints.KEY_INTERPOLATION, RenderingHints.VALUE_INTERPOLATION_BILINEAR);
+
+            for (long index = Math.max(0, firstIndex); index <= lastIndex; index++) {
+                Image segment =
+                        cache.getCompleted(
+                                new WaveformSegmentCache.SegmentKey(
+                                        index, tierPps, tier.height()));
+                if (segment == null) {
+                    continue;
                 }
+                double segmentStartTime = index * SEGMENT_WIDTH_PX / (double) tierPps;
+                int x =
+                        (int)
+                                Math.round(
+                                        (segmentStartTime - viewport.startTimeSeconds())
+                                                * viewport.pixelsPerSecond());
+                g.drawImage(segment, x, 0, scaledWidth, viewport.viewportHeightPx(), null);
+                drewAny = true;
             }
         } finally {
             g.dispose();
         }
 
-        return composite;
+        logger.trace(
+                "Preview for viewport at {}px/s from tier {}px/s x {}px: {}",
+                viewport.pixelsPerSecond(),
+                tierPps,
+                tier.height(),
+                drewAny ? "drawn" : "no segments");
+        return drewAny ? preview : null;
+    }
+
+    /**
+     * Draw the viewport from the frames the first pass has filtered so far while it builds the
+     * pyramid, so the waveform fills in from the left as the pass advances. Time not yet processed
+     * stays transparent. Returns null once the pyramid is complete or before the first progress
+     * snapshot. With the in-memory sample reader the pass reads each chunk as soon as it is
+     * decoded, so this also tracks the decode.
+     */
+    private Image renderPartialPreview(@NonNull WaveformViewportSpec viewport) {
+        PeakPyramid partial = partialPyramid;
+        if (partial == null || partial.frameCount() == 0) {
+            return null;
+        }
+        PartialPreview last = partialPreview;
+        if (last != null && last.source() == partial && last.specId().equals(viewport.specId())) {
+            return last.image();
+        }
+
+        // Scale to the loudest frame so far; the final render rescales to the global peak
+        double peak = WaveformPeakDetector.scalingPeak(partial);
+        double processedSeconds =
+                Math.min(audioDurationSeconds, partial.frameCount() / (double) sampleRate);
+        List<Image> segments = new ArrayList<>();
+        for (var key : calculateVisibleSegments(viewport)) {
+            boolean drawable = key.startTime() + key.duration() > 0;
+            segments.add(
+                    drawable
+                            ? drawSegment(pyramidPeaks(partial, key), key, peak, processedSeconds)
+                            : null);
+        }
+        Image image = tileSet(segments, viewport).toImage();
+        partialPreview = new PartialPreview(viewport.specId(), partial, image);
+        logger.trace(
+                "Partial preview for viewport at {}s with {}s processed",
+                viewport.startTimeSeconds(),
+                processedSeconds);
+        return image;
+    }
+
+    /** Place segments in the viewport; segment {@code i} follows segment {@code i - 1}. */
+    static WaveformTileSet tileSet(
+            @NonNull List<Image> segments, @NonNull WaveformViewportSpec viewport) {
+        // Check for interruption before placing
+        if (Thread.currentThread().isInterrupted()) {
+            throw new java.util.concurrent.CancellationException("Composite cancelled");
+        }
+
+        // Calculate the offset for the first segment
+        // The first segment's index tells us its start time
+        long firstSegmentIndex =
+                (long)
+                        Math.floor(
+                                viewport.startTimeSeconds()
+                                        * viewport.pixelsPerSecond()
+                                        / SEGMENT_WIDTH_PX);
+
+        // Calculate where in pixels the first segment should start
+        // This will be negative if the viewport starts partway through the segment
+        double firstSegmentStartTime =
+                (firstSegmentIndex * SEGMENT_WIDTH_PX) / (double) viewport.pixelsPerSecond();
+        double offsetSeconds = firstSegmentStartTime - viewport.startTimeSeconds();
+        int offsetPixels = (int) Math.round(offsetSeconds * viewport.pixelsPerSecond());
+
+        logger.trace(
+                "Placing tiles: viewport=[{}-{}s], viewportHEIGHT={}, firstSegIdx={},"
+                        + " segStartTime={}, offsetSec={}, offsetPx={}, segmentCount={}",
+                viewport.startTimeSeconds(),
+                viewport.endTimeSeconds(),
+                viewport.viewportHeightPx(),
+                firstSegmentIndex,
+                firstSegmentStartTime,
+                offsetSeconds,
+                offsetPixels,
+                segments.size());
+
+        return new WaveformTileSet(
+                viewport.viewportWidthPx(),
+                viewport.viewportHeightPx(),
+                viewport.pixelsPerSecond(),
+                firstSegmentIndex,
+                offsetPixels,
+                segments);
     }
 
     /** Draw time scale lines and labels - matches original WaveformRenderer */
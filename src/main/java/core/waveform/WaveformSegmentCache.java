@@ -2,16 +2,39 @@ package core.waveform;
 
 import com.google.errorprone.annotations.ThreadSafe;
 import com.google.inject.Inject;
+import core.telemetry.CacheLookupEvent;
 import java.awt.Image;
+import java.util.ArrayList;
+import java.util.Comparator;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.Optional;
+import java.util.Set;
+import java.util.concurrent.CancellationException;
 import java.util.concurrent.CompletableFuture;
-import java.util.concurrent.locks.ReadWriteLock;
-import java.util.concurrent.locks.ReentrantReadWriteLock;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.TimeoutException;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.locks.ReentrantLock;
+import java.util.function.Function;
 import lombok.NonNull;
 import lombok.extern.slf4j.Slf4j;
 
 /**
- * Circular cache for 200px-wide waveform segments. Optimized for timeline scrolling with
+ * Bounded cache for 200px-wide waveform segments. Optimized for timeline scrolling with
  * fixed-width segment compositing.
+ *
+ * <p>Lookups are lock-free hash reads. Writers serialize on a single lock so that capacity and
+ * eviction stay consistent. When full, the entry whose time span is farthest from the current
+ * viewport centre is evicted (least recently used among equals), so visible segments survive while
+ * stale far prefetches go first. The entry being inserted is never evicted by its own insertion.
+ *
+ * <p>Segments are grouped into tiers by zoom and height. Changing either keeps a few neighbouring
+ * tiers (the 1.5x zoom steps) instead of clearing, so the renderer can show a rescaled preview from
+ * the nearest tier while the exact one renders. Capacity applies per tier.
  */
 @ThreadSafe
 @Slf4j
@@ -19,17 +42,50 @@ public class WaveformSegmentCache {
 
     static final int SEGMENT_WIDTH_PX = 200;
     static final int PREFETCH_COUNT = 10; // Segments to prefetch in each direction
+    static final int MAX_TIERS = 3; // Current zoom/height plus its nearest neighbours
 
-    private final ReadWriteLock lock = new ReentrantReadWriteLock();
-    private CacheEntry[] entries;
-    private int size;
-    private int head = 0;
-    private WaveformViewportSpec currentViewport;
+    private final ReentrantLock writeLock = new ReentrantLock();
+    private final Map<SegmentKey, CacheEntry> entries = new ConcurrentHashMap<>();
+    private final AtomicLong accessClock = new AtomicLong();
+    private volatile boolean initialized = false;
+    private volatile int size;
+    private volatile WaveformViewportSpec currentViewport;
     private final CacheStats stats;
 
-    record CacheEntry(@NonNull SegmentKey key, @NonNull CompletableFuture<Image> future) {}
+    static final class CacheEntry {
+        private final SegmentKey key;
+        private final CompletableFuture<Image> future;
+        private volatile long lastAccess;
+
+        CacheEntry(@NonNull SegmentKey key, @NonNull CompletableFuture<Image> future, long tick) {
+            this.key = key;
+            this.future = future;
+            this.lastAccess = tick;
+        }
+
+        SegmentKey key() {
+            return key;
+        }
+
+        CompletableFuture<Image> future() {
+            return future;
+        }
+    }
+
+    /** Zoom level and height shared by a set of segments. */
+    record Tier(int pixelsPerSecond, int height) {
+        /** Distance between tiers: zoom ratio first, then height ratio. */
+        double distanceTo(@NonNull Tier other) {
+            return Math.abs(Math.log((double) pixelsPerSecond / other.pixelsPerSecond)) * 1000
+                    + Math.abs(Math.log((double) height / other.height));
+        }
+    }
 
     record SegmentKey(long segmentIndex, int pixelsPerSecond, int height) {
+        Tier tier() {
+            return new Tier(pixelsPerSecond, height);
+        }
+
         double duration() {
             return (double) SEGMENT_WIDTH_PX / pixelsPerSecond;
         }
@@ -68,9 +124,14 @@ public class WaveformSegmentCache {
                 (int) Math.ceil((double) viewport.viewportWidthPx() / SEGMENT_WIDTH_PX);
         int prefetchSegments = PREFETCH_COUNT * 2; // Prefetch in both directions
 
-        this.size = calculateCacheSize(viewport.viewportWidthPx());
-        this.entries = new CacheEntry[size];
-        this.currentViewport = viewport;
+        writeLock.lock();
+        try {
+            this.size = calculateCacheSize(viewport.viewportWidthPx());
+            this.currentViewport = viewport;
+            this.initialized = true;
+        } finally {
+            writeLock.unlock();
+        }
 
         log.debug(
                 "Initialized cache with size {} (visible: {}, prefetch: {}, buffer: {})",
@@ -87,112 +148,186 @@ public class WaveformSegmentCache {
 
     /** Get cached segment or null if not found, optionally recording stats. */
     CompletableFuture<Image> get(@NonNull SegmentKey key, boolean recordStats) {
-        lock.readLock().lock();
-        try {
-            if (recordStats) {
-                stats.recordRequest();
-            }
-            if (entries == null) {
-                if (recordStats) {
-                    stats.recordMiss();
-                    log.warn(
-                            "Cache not initialized, returning null for segment {} ({}s at {}pps)",
-                            key.segmentIndex(),
-                            key.startTime(),
-                            key.pixelsPerSecond());
-                }
-                return null;
-            }
-            for (CacheEntry entry : entries) {
-                if (entry != null && entry.key().equals(key)) {
-                    if (recordStats) {
-                        stats.recordHit();
-                        log.trace(
-                                "Cache HIT for segment {} ({}s at {}pps)",
-                                key.segmentIndex(),
-                                key.startTime(),
-                                key.pixelsPerSecond());
-                    }
-                    return entry.future();
-                }
-            }
+        if (recordStats) {
+            stats.recordRequest();
+        }
+        if (!initialized) {
             if (recordStats) {
                 stats.recordMiss();
                 log.warn(
-                        "Cache MISS for segment {} ({}s at {}pps)",
+                        "Cache not initialized, returning null for segment {} ({}s at {}pps)",
                         key.segmentIndex(),
                         key.startTime(),
                         key.pixelsPerSecond());
             }
             return null;
-        } finally {
-            lock.readLock().unlock();
         }
+        CacheEntry entry = entries.get(key);
+        if (entry != null) {
+            entry.lastAccess = accessClock.incrementAndGet();
+            if (recordStats) {
+                stats.recordHit();
+                CacheLookupEvent.record(true, key.startTime(), key.pixelsPerSecond());
+                log.trace(
+                        "Cache HIT for segment {} ({}s at {}pps)",
+                        key.segmentIndex(),
+                        key.startTime(),
+                        key.pixelsPerSecond());
+            }
+            return entry.future();
+        }
+        if (recordStats) {
+            stats.recordMiss();
+            CacheLookupEvent.record(false, key.startTime(), key.pixelsPerSecond());
+            log.warn(
+                    "Cache MISS for segment {} ({}s at {}pps)",
+                    key.segmentIndex(),
+                    key.startTime(),
+                    key.pixelsPerSecond());
+        }
+        return null;
     }
 
-    /** Add segment to cache, overwriting oldest entry if full. */
+    /** Add segment to cache, evicting the segment farthest from the viewport if full. */
     void put(@NonNull SegmentKey key, @NonNull CompletableFuture<Image> future) {
-        lock.writeLock().lock();
+        writeLock.lock();
         try {
-            if (entries == null) {
+            if (!initialized) {
                 log.warn("Cache not initialized, cannot put segment {}", key.segmentIndex());
                 return;
             }
-            // Check if key already exists
-            for (int i = 0; i < entries.length; i++) {
-                if (entries[i] != null && entries[i].key().equals(key)) {
-                    entries[i] = new CacheEntry(key, future);
-                    stats.recordUpdate();
-                    return;
-                }
+            CacheEntry entry = new CacheEntry(key, future, accessClock.incrementAndGet());
+            if (entries.put(key, entry) != null) {
+                stats.recordUpdate();
+                return;
             }
+            log.trace("Put segment {} (cache size: {})", key.segmentIndex(), size);
+            stats.recordPut();
+            evictToCapacity(key.tier(), key);
+        } finally {
+            writeLock.unlock();
+        }
+    }
 
-            // Add new entry at head position
-            if (entries[head] != null) {
-                log.trace(
-                        "Evicting segment {} to make room for segment {}",
-                        entries[head].key().segmentIndex(),
-                        key.segmentIndex());
-                stats.recordEviction();
+    /**
+     * Returns the cached segment, or renders and caches it. The miss is re-checked under the write
+     * lock, so concurrent callers asking for the same segment share a single render.
+     */
+    CompletableFuture<Image> getOrRender(
+            @NonNull SegmentKey key,
+            @NonNull Function<SegmentKey, CompletableFuture<Image>> render,
+            boolean recordStats) {
+        CompletableFuture<Image> cached = get(key, recordStats);
+        if (cached != null) {
+            return cached;
+        }
+        writeLock.lock();
+        try {
+            if (!initialized) {
+                log.warn("Cache not initialized, not caching segment {}", key.segmentIndex());
+                return render.apply(key);
             }
-            entries[head] = new CacheEntry(key, future);
-            log.trace(
-                    "Put segment {} at position {} (cache size: {})",
-                    key.segmentIndex(),
-                    head,
-                    size);
-            head = (head + 1 >= size) ? 0 : head + 1;
+            CacheEntry existing = entries.get(key);
+            if (existing != null) {
+                existing.lastAccess = accessClock.incrementAndGet();
+                return existing.future();
+            }
+            CompletableFuture<Image> future = render.apply(key);
+            entries.put(key, new CacheEntry(key, future, accessClock.incrementAndGet()));
+            log.trace("Put segment {} (cache size: {})", key.segmentIndex(), size);
             stats.recordPut();
+            evictToCapacity(key.tier(), key);
+            return future;
         } finally {
-            lock.writeLock().unlock();
+            writeLock.unlock();
         }
     }
 
+    /** Removes a segment only while it is still mapped to {@code future}. */
+    boolean remove(@NonNull SegmentKey key, @NonNull CompletableFuture<Image> future) {
+        writeLock.lock();
+        try {
+            CacheEntry entry = entries.get(key);
+            if (entry == null || entry.future() != future) {
+                return false;
+            }
+            entries.remove(key);
+            return true;
+        } finally {
+            writeLock.unlock();
+        }
+    }
+
+    /** Evicts far-from-viewport entries of a tier until within capacity, sparing {@code keep}. */
+    private void evictToCapacity(@NonNull Tier tier, SegmentKey keep) {
+        // Called with writeLock held
+        while (countInTier(tier) > size) {
+            CacheEntry victim = null;
+            double victimDistance = -1;
+            for (CacheEntry candidate : entries.values()) {
+                if (candidate.key().equals(keep) || !candidate.key().tier().equals(tier)) {
+                    continue;
+                }
+                double distance = distanceFromViewport(candidate.key());
+                if (distance > victimDistance
+                        || (distance == victimDistance
+                                && candidate.lastAccess < victim.lastAccess)) {
+                    victim = candidate;
+                    victimDistance = distance;
+                }
+            }
+            if (victim == null) {
+                return;
+            }
+            entries.remove(victim.key());
+            log.trace(
+                    "Evicting segment {} ({}s from viewport centre)",
+                    victim.key().segmentIndex(),
+                    victimDistance);
+            stats.recordEviction();
+        }
+    }
+
+    private int countInTier(@NonNull Tier tier) {
+        int count = 0;
+        for (SegmentKey key : entries.keySet()) {
+            if (key.tier().equals(tier)) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    /** Seconds between a segment's centre and the current viewport's centre. */
+    private double distanceFromViewport(SegmentKey key) {
+        WaveformViewportSpec viewport = currentViewport;
+        double viewportCentre = (viewport.startTimeSeconds() + viewport.endTimeSeconds()) / 2;
+        double segmentCentre = (key.startTime() + key.endTime()) / 2;
+        return Math.abs(segmentCentre - viewportCentre);
+    }
+
     /** Clear all cached segments. */
     void clear() {
-        lock.writeLock().lock();
+        writeLock.lock();
         try {
             int cleared = 0;
-            for (int i = 0; i < entries.length; i++) {
-                if (entries[i] != null) {
-                    entries[i].future().cancel(true);
-                    entries[i] = null;
-                    cleared++;
-                }
+            for (CacheEntry entry : entries.values()) {
+                entry.future().cancel(true);
+                cleared++;
             }
-            head = 0;
+            entries.clear();
             stats.recordClear(cleared);
         } finally {
-            lock.writeLock().unlock();
+            writeLock.unlock();
         }
     }
 
     /**
-     * Update cache for new viewport context. Clears cache if pixelsPerSecond or height changed,
-     * resizes if width changed.
+     * Update cache for new viewport context. A zoom or height change retains the nearest tiers
+     * (cancelling their unfinished renders) rather than clearing; a width change resizes.
      */
     void updateViewport(@NonNull WaveformViewportSpec newViewport) {
-        lock.writeLock().lock();
+        writeLock.lock();
         try {
             if (currentViewport == null) {
                 // First time initialization
@@ -202,50 +337,107 @@ public class WaveformSegmentCache {
             if (currentViewport.pixelsPerSecond() != newViewport.pixelsPerSecond()
                     || currentViewport.viewportHeightPx() != newViewport.viewportHeightPx()) {
                 log.debug(
-                        "Clearing cache due to viewport change: pps {} -> {}, height {} -> {}",
+                        "Switching cache tier due to viewport change: pps {} -> {},"
+                                + " height {} -> {}",
                         currentViewport.pixelsPerSecond(),
                         newViewport.pixelsPerSecond(),
                         currentViewport.viewportHeightPx(),
                         newViewport.viewportHeightPx());
-                clear();
                 initialize(newViewport);
+                retainNearestTiers(tierOf(newViewport));
                 return;
-            } else if (currentViewport.viewportWidthPx() != newViewport.viewportWidthPx()) {
-                log.debug(
-                        "Resizing cache due to viewport width change: {} -> {}",
-                        currentViewport.viewportWidthPx(),
-                        newViewport.viewportWidthPx());
-                resize(newViewport.viewportWidthPx());
             }
             currentViewport = newViewport;
+            if (calculateCacheSize(newViewport.viewportWidthPx()) != size) {
+                log.debug("Resizing cache due to viewport width change");
+                resize(newViewport.viewportWidthPx());
+            }
         } finally {
-            lock.writeLock().unlock();
+            writeLock.unlock();
         }
     }
 
-    /** Resize cache array to accommodate new viewport width. Preserves existing valid segments. */
+    /** Resize capacity to accommodate new viewport width. Preserves the nearest segments. */
     private void resize(int newViewportWidthPx) {
-        // Called from updateViewport() which already holds write lock
-        int newSize = calculateCacheSize(newViewportWidthPx);
+        // Called from updateViewport() which already holds writeLock
+        int oldSize = size;
+        size = calculateCacheSize(newViewportWidthPx);
+        for (Tier tier : tiers()) {
+            evictToCapacity(tier, null);
+        }
+        stats.recordResize(oldSize, size);
+    }
+
+    /**
+     * Keeps {@code current} and the nearest other tiers up to {@link #MAX_TIERS}. Other tiers keep
+     * only finished segments, since their renders are no longer wanted.
+     */
+    private void retainNearestTiers(@NonNull Tier current) {
+        // Called with writeLock held
+        List<Tier> others = new ArrayList<>(tiers());
+        others.remove(current);
+        others.sort(Comparator.comparingDouble(t -> t.distanceTo(current)));
+        Set<Tier> kept = new HashSet<>(others.subList(0, Math.min(others.size(), MAX_TIERS - 1)));
+
+        int dropped = 0;
+        for (var it = entries.values().iterator(); it.hasNext(); ) {
+            CacheEntry entry = it.next();
+            Tier tier = entry.key().tier();
+            if (tier.equals(current)) {
+                continue;
+            }
+            if (!kept.contains(tier) || !entry.future().isDone()) {
+                entry.future().cancel(true);
+                it.remove();
+                dropped++;
+            }
+        }
+        if (dropped > 0) {
+            stats.recordClear(dropped);
+        }
+    }
 
-        if (newSize == size) {
-            return; // No resize needed
+    private Set<Tier> tiers() {
+        Set<Tier> tiers = new HashSet<>();
+        for (SegmentKey key : entries.keySet()) {
+            tiers.add(key.tier());
         }
+        return tiers;
+    }
 
-        CacheEntry[] newEntries = new CacheEntry[newSize];
+    private static Tier tierOf(@NonNull WaveformViewportSpec viewport) {
+        return new Tier(viewport.pixelsPerSecond(), viewport.viewportHeightPx());
+    }
 
-        // Copy existing valid entries
-        int copied = 0;
-        for (CacheEntry entry : entries) {
-            if (entry != null && copied < newSize) {
-                newEntries[copied++] = entry;
+    /**
+     * Finds the tier nearest to {@code target}, other than {@code target} itself, that has at least
+     * one finished segment.
+     */
+    Optional<Tier> nearestCompletedTier(@NonNull Tier target) {
+        Tier best = null;
+        for (CacheEntry entry : entries.values()) {
+            Tier tier = entry.key().tier();
+            if (tier.equals(target) || !isCompleted(entry.future())) {
+                continue;
+            }
+            if (best == null || tier.distanceTo(target) < best.distanceTo(target)) {
+                best = tier;
             }
         }
+        return Optional.ofNullable(best);
+    }
 
-        entries = newEntries;
-        size = newSize;
-        head = copied % newSize;
-        stats.recordResize(size, newSize);
+    /** Returns the segment's image if it finished successfully, else null. Records no stats. */
+    Image getCompleted(@NonNull SegmentKey key) {
+        CacheEntry entry = entries.get(key);
+        if (entry == null || !isCompleted(entry.future())) {
+            return null;
+        }
+        return entry.future().getNow(null);
+    }
+
+    private static boolean isCompleted(@NonNull CompletableFuture<Image> future) {
+        return future.isDone() && !future.isCompletedExceptionally();
     }
 
     /** Get cache statistics. */
@@ -253,39 +445,46 @@ public class WaveformSegmentCache {
         return stats;
     }
 
-    /** Get the current cache size. */
+    /** Get the current cache capacity. */
     public int getSize() {
-        lock.readLock().lock();
-        try {
-            return size;
-        } finally {
-            lock.readLock().unlock();
-        }
+        return size;
     }
 
     /** Check if any cache entries have incomplete futures. */
     public boolean hasPendingLoads() {
-        lock.readLock().lock();
-        try {
-            if (entries == null) {
-                return false; // Cache not initialized yet
-            }
-            for (CacheEntry entry : entries) {
-                if (entry != null && !entry.future().isDone()) {
-                    return true;
-                }
+        for (CacheEntry entry : entries.values()) {
+            if (!entry.future().isDone()) {
+                return true;
             }
-            return false;
-        } finally {
-            lock.readLock().unlock();
         }
+        return false;
     }
 
-    /** Wait for all pending cache loads to complete. */
+    /**
+     * Wait for all pending cache loads to complete, including loads added while waiting. Returns
+     * when none are pending or the timeout elapses; failed or cancelled loads count as complete.
+     */
     public void waitForPendingLoads(long timeoutMs) throws InterruptedException {
-        long deadline = System.currentTimeMillis() + timeoutMs;
-        while (hasPendingLoads() && System.currentTimeMillis() < deadline) {
-            Thread.sleep(50);
+        long deadline = System.nanoTime() + TimeUnit.MILLISECONDS.toNanos(timeoutMs);
+        while (true) {
+            List<CompletableFuture<Image>> pending = new ArrayList<>();
+            for (CacheEntry entry : entries.values()) {
+                if (!entry.future().isDone()) {
+                    pending.add(entry.future());
+                }
+            }
+            long remaining = deadline - System.nanoTime();
+            if (pending.isEmpty() || remaining <= 0) {
+                return;
+            }
+            try {
+                CompletableFuture.allOf(pending.toArray(CompletableFuture[]::new))
+                        .get(remaining, TimeUnit.NANOSECONDS);
+            } catch (TimeoutException e) {
+                return;
+            } catch (ExecutionException | CancellationException e) {
+                // A failed load is still finished; re-check the rest
+            }
         }
     }
 }
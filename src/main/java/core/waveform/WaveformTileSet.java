@@ -0,0 +1,105 @@
+package core.waveform;
+
+import java.awt.Color;
+import java.awt.Graphics2D;
+import java.awt.Image;
+import java.awt.image.BufferedImage;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+import java.util.OptionalInt;
+import lombok.NonNull;
+
+/**
+ * The cached segment images that make up one viewport, with where each one goes, so the caller can
+ * draw them straight to the screen instead of through a viewport-sized composite.
+ *
+ * <p>Tile {@code i} is {@link #TILE_WIDTH_PX} wide and its left edge is at {@link #tileX(int)}; the
+ * first is usually partly off the left edge. A null tile lies before time 0 and shows only the
+ * background. Tiles are the cache's own segment images, so the same image object recurs from
+ * viewport to viewport while its segment stays cached, and can serve as its identity.
+ *
+ * @param widthPx Viewport width
+ * @param heightPx Viewport height
+ * @param pixelsPerSecond Zoom the tiles were drawn at
+ * @param firstIndex Segment index of the first tile
+ * @param offsetPx Left edge of the first tile relative to the viewport, at most 0
+ * @param tiles Segment images in time order, null where there is no audio
+ */
+public record WaveformTileSet(
+        int widthPx,
+        int heightPx,
+        int pixelsPerSecond,
+        long firstIndex,
+        int offsetPx,
+        @NonNull List<Image> tiles) {
+
+    public static final int TILE_WIDTH_PX = WaveformSegmentCache.SEGMENT_WIDTH_PX;
+
+    /** Colour behind and around the tiles. */
+    public static final Color BACKGROUND = new Color(242, 242, 242);
+
+    public WaveformTileSet {
+        tiles = Collections.unmodifiableList(new ArrayList<>(tiles));
+    }
+
+    /** Left edge of tile {@code index}, relative to the viewport. */
+    public int tileX(int index) {
+        return offsetPx + index * TILE_WIDTH_PX;
+    }
+
+    /** The tile for a segment index, or null if that segment is not part of the set. */
+    public Image tileAt(long segmentIndex) {
+        long i = segmentIndex - firstIndex;
+        return i >= 0 && i < tiles.size() ? tiles.get((int) i) : null;
+    }
+
+    /**
+     * How far the content moved from {@code previous} to this set, in pixels (positive to the
+     * right), if both show the same zoom and height; empty otherwise.
+     */
+    public OptionalInt shiftFrom(@NonNull WaveformTileSet previous) {
+        if (previous.pixelsPerSecond != pixelsPerSecond || previous.heightPx != heightPx) {
+            return OptionalInt.empty();
+        }
+        long shift =
+                offsetPx - previous.offsetPx - (firstIndex - previous.firstIndex) * TILE_WIDTH_PX;
+        return Math.abs(shift) < Integer.MAX_VALUE
+                ? OptionalInt.of((int) shift)
+                : OptionalInt.empty();
+    }
+
+    /** Top edge of a tile, centring it if its height differs from the viewport's. */
+    public int tileY(@NonNull Image tile) {
+        return (heightPx - tile.getHeight(null)) / 2;
+    }
+
+    /** Draw the background and every tile from the tile images themselves. */
+    public void paint(@NonNull Graphics2D g, int x, int y) {
+        g.setColor(BACKGROUND);
+        g.fillRect(x, y, widthPx, heightPx);
+        for (int i = 0; i < tiles.size() && tileX(i) < widthPx; i++) {
+            Image tile = tiles.get(i);
+            if (tile != null) {
+                g.drawImage(tile, x + tileX(i), y + tileY(tile), null);
+            }
+        }
+    }
+
+    /** Composite the tiles into one viewport-sized image. */
+    public BufferedImage toImage() {
+        if (tiles.isEmpty()) {
+            return new BufferedImage(1, 1, BufferedImage.TYPE_INT_ARGB);
+        }
+        BufferedImage composite =
+                new BufferedImage(widthPx, heightPx, BufferedImage.TYPE_INT_ARGB);
+        Graphics2D g = composite.createGraphics();
+        try {
+            g.setClip(0, 0, widthPx, heightPx);
+            paint(g, 0, 0);
+        } finally {
+            g.dispose();
+        }
+        return composite;
+    }
+}
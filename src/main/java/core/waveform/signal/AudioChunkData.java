@@ -4,6 +4,7 @@ package core.waveform.signal;
 record AudioChunkData(
         double[] amplitudeValues,
         double sampleRate,
+        int channelCount,
         double peakAmplitude,
         int frameCount,
         int overlapFrames) {}
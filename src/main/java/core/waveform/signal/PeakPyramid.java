@@ -0,0 +1,301 @@
+package core.waveform.signal;
+
+import com.google.errorprone.annotations.ThreadSafe;
+import core.util.simd.SampleKernels;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import lombok.NonNull;
+
+/**
+ * Multi-resolution min/max/RMS envelopes of a whole audio file.
+ *
+ * <p>Level 0 summarizes {@link #BASE_BIN_FRAMES} frames per bin; each further level halves the bin
+ * count by merging neighbouring pairs, so level {@code n} covers {@code BASE_BIN_FRAMES << n}
+ * frames per bin. Rendering at any zoom reads the coarsest level whose bins are no wider than a
+ * pixel, which keeps per-pixel work bounded regardless of zoom. Zooms finer than one base bin per
+ * pixel are not served from the pyramid; renderers read those few frames from samples instead
+ * (see {@link WaveformProcessor#segmentEnvelope}).
+ *
+ * <p>Each level's bins live in one {@link MemorySegment} (all minimums, then all maximums, then all
+ * RMS values, as native-order floats), so a pyramid can equally be backed by heap arrays or by a
+ * memory-mapped sidecar file. Instances are immutable once built and may be shared between render
+ * threads.
+ */
+@ThreadSafe
+public final class PeakPyramid {
+
+    /**
+     * Frames summarized by one bin at level 0. Each bin costs 12 bytes, so an hour at 44.1 kHz
+     * takes about 7.4 MB at level 0 and 15 MB for the whole pyramid.
+     */
+    public static final int BASE_BIN_FRAMES = 256;
+
+    /**
+     * One resolution of the pyramid.
+     *
+     * @param binFrames Frames covered by each bin
+     * @param binCount Number of bins
+     * @param data {@code 3 * binCount} native-order floats: minimums, maximums, then RMS values
+     */
+    public record Level(int binFrames, int binCount, MemorySegment data) {
+        public Level {
+            if (data.byteSize() != 3L * binCount * Float.BYTES) {
+                throw new IllegalArgumentException(
+                        "Level data is " + data.byteSize() + " bytes for " + binCount + " bins");
+            }
+        }
+
+        /** Minimum sample value of a bin. */
+        public float min(int bin) {
+            return data.getAtIndex(ValueLayout.JAVA_FLOAT, bin);
+        }
+
+        /** Maximum sample value of a bin. */
+        public float max(int bin) {
+            return data.getAtIndex(ValueLayout.JAVA_FLOAT, (long) binCount + bin);
+        }
+
+        /** Root mean square of a bin. */
+        public float rms(int bin) {
+            return data.getAtIndex(ValueLayout.JAVA_FLOAT, 2L * binCount + bin);
+        }
+
+        static Level ofArrays(int binFrames, float[] min, float[] max, float[] rms, int count) {
+            float[] packed = new float[3 * count];
+            System.arraycopy(min, 0, packed, 0, count);
+            System.arraycopy(max, 0, packed, count, count);
+            System.arraycopy(rms, 0, packed, 2 * count, count);
+            return new Level(binFrames, count, MemorySegment.ofArray(packed));
+        }
+    }
+
+    private final int sampleRate;
+    private final long frameCount;
+    private final Level[] levels;
+    private final double peak;
+
+    public PeakPyramid(int sampleRate, long frameCount, @NonNull Level[] levels) {
+        this(sampleRate, frameCount, levels, topPeak(levels));
+    }
+
+    /**
+     * A pyramid whose global peak is already known, e.g. one read back from a sidecar that stored
+     * it.
+     */
+    public PeakPyramid(int sampleRate, long frameCount, @NonNull Level[] levels, double peak) {
+        if (levels.length == 0) {
+            throw new IllegalArgumentException("Pyramid needs at least one level");
+        }
+        this.sampleRate = sampleRate;
+        this.frameCount = frameCount;
+        this.levels = levels.clone();
+        this.peak = peak;
+    }
+
+    public int sampleRate() {
+        return sampleRate;
+    }
+
+    public long frameCount() {
+        return frameCount;
+    }
+
+    public int levelCount() {
+        return levels.length;
+    }
+
+    public Level level(int index) {
+        return levels[index];
+    }
+
+    /** Returns the largest sample magnitude in the file. */
+    public double peak() {
+        return peak;
+    }
+
+    // The top level summarizes the whole file in one bin, so this is exact and O(1)
+    private static double topPeak(@NonNull Level[] levels) {
+        if (levels.length == 0) {
+            return 0;
+        }
+        Level top = levels[levels.length - 1];
+        double peak = 0;
+        for (int b = 0; b < top.binCount(); b++) {
+            peak = Math.max(peak, Math.max(top.max(b), -top.min(b)));
+        }
+        return peak;
+    }
+
+    /** Returns the coarsest level whose bins are no wider than {@code framesPerPixel}. */
+    public int levelFor(double framesPerPixel) {
+        int index = 0;
+        while (index + 1 < levels.length && levels[index + 1].binFrames() <= framesPerPixel) {
+            index++;
+        }
+        return index;
+    }
+
+    /**
+     * Computes the absolute peak per pixel for a run of pixels.
+     *
+     * @param startFrame Frame position of the left edge of the first pixel, may be negative
+     * @param framesPerPixel Frames covered by each pixel, must be positive
+     * @param pixelCount Number of pixels to compute
+     * @return Peak magnitude per pixel; pixels outside the file are 0
+     */
+    public double[] envelope(double startFrame, double framesPerPixel, int pixelCount) {
+        if (framesPerPixel <= 0) {
+            throw new IllegalArgumentException("Frames per pixel must be > 0: " + framesPerPixel);
+        }
+        Level level = levels[levelFor(framesPerPixel)];
+        int binFrames = level.binFrames();
+        int binCount = level.binCount();
+
+        double[] pixels = new double[pixelCount];
+        for (int i = 0; i < pixelCount; i++) {
+            double from = startFrame + i * framesPerPixel;
+            double to = from + framesPerPixel;
+            if (to <= 0 || from >= frameCount) {
+                continue;
+            }
+            int firstBin = (int) Math.max(0, Math.floor(from / binFrames));
+            int endBin =
+                    (int) Math.min(binCount, Math.max(firstBin + 1, Math.ceil(to / binFrames)));
+            double peak = 0;
+            for (int b = firstBin; b < endBin; b++) {
+                peak = Math.max(peak, Math.max(level.max(b), -level.min(b)));
+            }
+            pixels[i] = peak;
+        }
+        return pixels;
+    }
+
+    /**
+     * Accumulates interleaved samples, in file order, into level 0 and derives the coarser levels
+     * in {@link #build()}. Not thread-safe.
+     */
+    public static final class Builder {
+        private final int sampleRate;
+        private final int channelCount;
+        private final int samplesPerBin;
+
+        private float[] min;
+        private float[] max;
+        private float[] rms;
+        private int bins = 0;
+        private long samplesSeen = 0;
+
+        // Running minimum, maximum and sum of squares of the bin being filled
+        private final double[] bin = new double[3];
+        private int binSamples = 0;
+
+        /**
+         * @param sampleRate Sample rate in Hz
+         * @param channelCount Channels per interleaved frame
+         * @param expectedFrames Expected total frames, used to presize storage
+         */
+        public Builder(int sampleRate, int channelCount, long expectedFrames) {
+            if (channelCount <= 0) {
+                throw new IllegalArgumentException("Channel count must be > 0: " + channelCount);
+            }
+            this.sampleRate = sampleRate;
+            this.channelCount = channelCount;
+            this.samplesPerBin = BASE_BIN_FRAMES * channelCount;
+            long expectedBins = (expectedFrames + BASE_BIN_FRAMES - 1) / BASE_BIN_FRAMES;
+            int capacity = (int) Math.max(1, Math.min(expectedBins, Integer.MAX_VALUE - 8));
+            this.min = new float[capacity];
+            this.max = new float[capacity];
+            this.rms = new float[capacity];
+            resetBin();
+        }
+
+        /** Appends {@code count} interleaved samples starting at {@code offset}. */
+        public Builder accept(@NonNull double[] samples, int offset, int count) {
+            int end = offset + count;
+            for (int i = offset; i < end; ) {
+                int take = Math.min(samplesPerBin - binSamples, end - i);
+                SampleKernels.minMaxSumSquares(samples, i, i + take, bin);
+                binSamples += take;
+                i += take;
+                if (binSamples == samplesPerBin) {
+                    flushBin();
+                }
+            }
+            samplesSeen += count;
+            return this;
+        }
+
+        private void resetBin() {
+            bin[0] = Double.POSITIVE_INFINITY;
+            bin[1] = Double.NEGATIVE_INFINITY;
+            bin[2] = 0;
+            binSamples = 0;
+        }
+
+        public PeakPyramid build() {
+            if (binSamples > 0) {
+                flushBin();
+            }
+            return pyramidOf(samplesSeen / channelCount);
+        }
+
+        /**
+         * Builds a pyramid of the whole bins accepted so far, leaving the builder free to accept
+         * more. Copies every completed bin, so callers building progressively should space
+         * snapshots out.
+         */
+        public PeakPyramid snapshot() {
+            return pyramidOf((long) bins * BASE_BIN_FRAMES);
+        }
+
+        private PeakPyramid pyramidOf(long frameCount) {
+            Level base = Level.ofArrays(BASE_BIN_FRAMES, min, max, rms, bins);
+
+            List<Level> levels = new ArrayList<>();
+            levels.add(base);
+            Level current = base;
+            while (current.binCount() > 1) {
+                current = downsample(current);
+                levels.add(current);
+            }
+            return new PeakPyramid(sampleRate, frameCount, levels.toArray(Level[]::new));
+        }
+
+        private void flushBin() {
+            if (bins == max.length) {
+                int capacity = max.length * 2;
+                min = Arrays.copyOf(min, capacity);
+                max = Arrays.copyOf(max, capacity);
+                rms = Arrays.copyOf(rms, capacity);
+            }
+            min[bins] = (float) bin[0];
+            max[bins] = (float) bin[1];
+            rms[bins] = (float) Math.sqrt(bin[2] / binSamples);
+            bins++;
+
+            resetBin();
+        }
+
+        /** Merges neighbouring bin pairs; a trailing odd bin is carried up unchanged. */
+        private static Level downsample(Level fine) {
+            int fineCount = fine.binCount();
+            int count = (fineCount + 1) / 2;
+            float[] min = new float[count];
+            float[] max = new float[count];
+            float[] rms = new float[count];
+            for (int i = 0; i < count; i++) {
+                int a = 2 * i;
+                int b = Math.min(a + 1, fineCount - 1);
+                min[i] = Math.min(fine.min(a), fine.min(b));
+                max[i] = Math.max(fine.max(a), fine.max(b));
+                float ra = fine.rms(a);
+                float rb = fine.rms(b);
+                rms[i] = (float) Math.sqrt((ra * ra + rb * rb) / 2.0);
+            }
+            return Level.ofArrays(fine.binFrames() * 2, min, max, rms, count);
+        }
+    }
+}
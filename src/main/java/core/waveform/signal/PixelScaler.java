@@ -1,5 +1,7 @@
 package core.waveform.signal;
 
+import core.util.simd.SampleKernels;
+
 /** Converts audio samples to pixel resolution and applies smoothing. */
 public final class PixelScaler {
 
@@ -52,17 +54,7 @@ public final class PixelScaler {
         System.arraycopy(pixelValues, 0, originalValues, 0, pixelValues.length);
 
         // Smooth peaks and valleys in single pass
-        for (int i = 1; i < originalValues.length - 1; i++) {
-            if (originalValues[i] > originalValues[i - 1]
-                    && originalValues[i] > originalValues[i + 1]) {
-                // Smooth peak
-                pixelValues[i] = Math.max(originalValues[i + 1], originalValues[i - 1]);
-            } else if (originalValues[i] < originalValues[i - 1]
-                    && originalValues[i] < originalValues[i + 1]) {
-                // Smooth valley
-                pixelValues[i] = Math.min(originalValues[i + 1], originalValues[i - 1]);
-            }
-        }
+        SampleKernels.smoothPeaksAndValleys(originalValues, pixelValues);
 
         // log.debug("Applied pixel smoothing to {} pixels", pixelValues.length);
         return pixelValues;
@@ -74,12 +66,7 @@ public final class PixelScaler {
             return 0;
         }
 
-        double maxConsecutive = 0;
-        for (int i = skipInitialPixels; i < pixelValues.length - 1; i++) {
-            double consecutiveVals = Math.min(pixelValues[i], pixelValues[i + 1]);
-            maxConsecutive = Math.max(consecutiveVals, maxConsecutive);
-        }
-
+        double maxConsecutive = SampleKernels.maxOfAdjacentMin(pixelValues, skipInitialPixels);
         return maxConsecutive;
     }
 }
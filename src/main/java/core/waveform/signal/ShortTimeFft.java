@@ -0,0 +1,127 @@
+package core.waveform.signal;
+
+import java.util.Arrays;
+import lombok.NonNull;
+
+/**
+ * Windowed power spectrum of short frames of mono audio, for spectrogram columns.
+ *
+ * <p>Each frame is {@link #windowFrames()} samples under a Hann window, zero-padded to a
+ * power-of-two FFT of {@link #fftSize()} points and transformed in place with an iterative radix-2
+ * FFT. The window, twiddle factors, bit-reversal order and work buffers are built once, so a
+ * transform allocates nothing. Levels are in dB relative to a full-scale sine.
+ *
+ * <p>Not thread-safe: use one instance per thread.
+ */
+public final class ShortTimeFft {
+
+    /** Level reported for silence, in place of negative infinity. */
+    public static final double FLOOR_DB = -200;
+
+    private final int windowFrames;
+    private final int fftSize;
+    private final double[] window;
+    private final double[] cos;
+    private final double[] sin;
+    private final int[] reversed;
+    private final double[] re;
+    private final double[] im;
+
+    // Spectrum magnitude of a full-scale sine under this window
+    private final double fullScale;
+
+    /**
+     * Prepare transforms of frames of {@code windowFrames} samples.
+     *
+     * @param windowFrames Samples per frame, at least 2
+     */
+    public ShortTimeFft(int windowFrames) {
+        if (windowFrames < 2) {
+            throw new IllegalArgumentException("Window must be at least 2 frames: " + windowFrames);
+        }
+        this.windowFrames = windowFrames;
+        this.fftSize = Integer.highestOneBit(windowFrames - 1) << 1;
+
+        window = new double[windowFrames];
+        double windowSum = 0;
+        for (int i = 0; i < windowFrames; i++) {
+            window[i] = 0.5 - 0.5 * Math.cos(2 * Math.PI * i / (windowFrames - 1));
+            windowSum += window[i];
+        }
+        fullScale = windowSum / 2;
+
+        cos = new double[fftSize / 2];
+        sin = new double[fftSize / 2];
+        for (int i = 0; i < fftSize / 2; i++) {
+            cos[i] = Math.cos(-2 * Math.PI * i / fftSize);
+            sin[i] = Math.sin(-2 * Math.PI * i / fftSize);
+        }
+
+        int bits = Integer.numberOfTrailingZeros(fftSize);
+        reversed = new int[fftSize];
+        for (int i = 0; i < fftSize; i++) {
+            reversed[i] = Integer.reverse(i) >>> (Integer.SIZE - bits);
+        }
+        re = new double[fftSize];
+        im = new double[fftSize];
+    }
+
+    public int windowFrames() {
+        return windowFrames;
+    }
+
+    public int fftSize() {
+        return fftSize;
+    }
+
+    /** Bins from DC to Nyquist, which {@link #spectrum} fills. */
+    public int binCount() {
+        return fftSize / 2 + 1;
+    }
+
+    /**
+     * Level of each bin for the frame starting at {@code start} of the first {@code count} of
+     * {@code samples}. Samples outside that range count as silence, so frames may overhang either
+     * end.
+     *
+     * @param out Receives {@link #binCount()} levels in dB
+     */
+    public void spectrum(@NonNull double[] samples, int count, int start, @NonNull double[] out) {
+        Arrays.fill(re, 0);
+        Arrays.fill(im, 0);
+        int from = Math.max(0, -start);
+        int to = Math.min(windowFrames, Math.min(count, samples.length) - start);
+        for (int i = from; i < to; i++) {
+            re[reversed[i]] = samples[start + i] * window[i];
+        }
+        transform();
+
+        double fullScalePower = fullScale * fullScale;
+        for (int bin = 0; bin < binCount(); bin++) {
+            double power = re[bin] * re[bin] + im[bin] * im[bin];
+            out[bin] = power > 0 ? 10 * Math.log10(power / fullScalePower) : FLOOR_DB;
+        }
+    }
+
+    /** In-place radix-2 FFT of {@code re, im}, whose input is already in bit-reversed order. */
+    private void transform() {
+        for (int size = 2; size <= fftSize; size <<= 1) {
+            int half = size / 2;
+            int step = fftSize / size;
+            for (int start = 0; start < fftSize; start += size) {
+                for (int k = 0; k < half; k++) {
+                    int even = start + k;
+                    int odd = even + half;
+                    double wr = cos[k * step];
+                    double wi = sin[k * step];
+                    double tr = wr * re[odd] - wi * im[odd];
+                    double ti = wr * im[odd] + wi * re[odd];
+                    re[odd] = re[even] - tr;
+                    im[odd] = im[even] - ti;
+                    re[even] += tr;
+                    im[even] += ti;
+                }
+            }
+        }
+    }
+}
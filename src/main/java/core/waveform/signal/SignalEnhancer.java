@@ -1,7 +1,6 @@
 package core.waveform.signal;
 
-import java.util.ArrayDeque;
-import java.util.Deque;
+import core.util.simd.SampleKernels;
 
 /** Signal processing operations for audio enhancement. */
 final class SignalEnhancer {
@@ -16,41 +15,8 @@ final class SignalEnhancer {
         double[] originalSamples = new double[samples.length];
         System.arraycopy(samples, 0, originalSamples, 0, originalSamples.length);
 
-        // Use sliding window maximum with monotonic deque for O(n) complexity
-        Deque<Integer> maxDeque = new ArrayDeque<>();
-
-        for (int i = 0; i < samples.length; i++) {
-            int windowStart = Math.max(0, i - windowSize);
-            int windowEnd = Math.min(samples.length, i + windowSize);
-
-            // Remove elements outside current window from front
-            while (!maxDeque.isEmpty() && maxDeque.peekFirst() < windowStart) {
-                maxDeque.removeFirst();
-            }
-
-            // Add elements to the window from the right
-            // For i=0, add entire window [windowStart, windowEnd)
-            // For i>0, only add new elements that entered the window
-            int addStart =
-                    (i == 0)
-                            ? windowStart
-                            : Math.max(windowStart, Math.min(samples.length, (i - 1) + windowSize));
-            int addEnd = windowEnd;
-
-            for (int j = addStart; j < addEnd; j++) {
-                double absValue = Math.abs(originalSamples[j]);
-
-                // Remove smaller elements from back to maintain monotonic decreasing order
-                while (!maxDeque.isEmpty()
-                        && Math.abs(originalSamples[maxDeque.peekLast()]) <= absValue) {
-                    maxDeque.removeLast();
-                }
-                maxDeque.addLast(j);
-            }
-
-            // Front of deque has the index of maximum element in current window
-            samples[i] = maxDeque.isEmpty() ? 0.0 : Math.abs(originalSamples[maxDeque.peekFirst()]);
-        }
+        // Sliding window maximum of magnitudes, vectorized where supported
+        SampleKernels.slidingAbsMax(originalSamples, windowSize, samples);
 
         // logger.debug(
         //         "Applied envelope smoothing (window={}) to {} samples", windowSize,
@@ -0,0 +1,119 @@
+package core.waveform.signal;
+
+import java.util.Arrays;
+import lombok.NonNull;
+
+/**
+ * Fourth-order Butterworth band-pass as a cascade of biquads (two high-pass, two low-pass) that
+ * keeps its state between calls.
+ *
+ * <p>Feeding consecutive blocks of a stream gives the same output as filtering the whole stream at
+ * once, so chunked readers need no overlap for the filter to settle. Output goes into a
+ * caller-provided buffer (which may be the input) and no call allocates. Each channel of the
+ * interleaved input is filtered independently. Not thread-safe; use one instance per stream.
+ */
+final class StreamingBandPassFilter {
+
+    // Pole-pair Q factors of a 4th-order Butterworth response
+    private static final double[] BUTTERWORTH_Q = {
+        1 / (2 * Math.cos(Math.PI / 8)), 1 / (2 * Math.cos(3 * Math.PI / 8))
+    };
+    private static final double DENORMAL_FLOOR = 1e-30;
+
+    private final int channelCount;
+    private final int sectionCount;
+
+    // Normalized coefficients per section: b0, b1, b2, a1, a2
+    private final double[] coefficients;
+
+    // Transposed direct form II state per section and channel: z1, z2
+    private final double[] state;
+
+    /**
+     * @param range Pass band as fractions of the sample rate
+     * @param channelCount Channels per interleaved frame
+     */
+    StreamingBandPassFilter(@NonNull FrequencyRange range, int channelCount) {
+        if (channelCount <= 0) {
+            throw new IllegalArgumentException("Channel count must be > 0: " + channelCount);
+        }
+        this.channelCount = channelCount;
+        this.sectionCount = 2 * BUTTERWORTH_Q.length;
+        this.coefficients = new double[sectionCount * 5];
+        this.state = new double[sectionCount * channelCount * 2];
+        int section = 0;
+        for (double q : BUTTERWORTH_Q) {
+            design(section++, range.minFrequency(), q, true);
+        }
+        for (double q : BUTTERWORTH_Q) {
+            design(section++, range.maxFrequency(), q, false);
+        }
+    }
+
+    /** RBJ cookbook high- or low-pass section at a normalized frequency. */
+    private void design(int section, double frequency, double q, boolean highPass) {
+        double w0 = 2 * Math.PI * frequency;
+        double cos = Math.cos(w0);
+        double alpha = Math.sin(w0) / (2 * q);
+        double a0 = 1 + alpha;
+        double b1 = highPass ? -(1 + cos) : 1 - cos;
+        double b0 = Math.abs(b1) / 2;
+        int c = section * 5;
+        coefficients[c] = b0 / a0;
+        coefficients[c + 1] = b1 / a0;
+        coefficients[c + 2] = b0 / a0;
+        coefficients[c + 3] = -2 * cos / a0;
+        coefficients[c + 4] = (1 - alpha) / a0;
+    }
+
+    int channelCount() {
+        return channelCount;
+    }
+
+    /**
+     * Filters {@code sampleCount} interleaved samples, continuing from the previous call.
+     *
+     * @param src Input samples, starting on a frame boundary
+     * @param dst Output buffer; may be {@code src} with the same offset to filter in place
+     * @param sampleCount Number of samples, a whole number of frames
+     */
+    void process(double[] src, int srcOffset, double[] dst, int dstOffset, int sampleCount) {
+        if (sampleCount % channelCount != 0) {
+            throw new IllegalArgumentException(
+                    sampleCount + " samples is not a whole number of " + channelCount + " frames");
+        }
+        double[] in = src;
+        int inOffset = srcOffset;
+        for (int section = 0; section < sectionCount; section++) {
+            int c = section * 5;
+            double b0 = coefficients[c];
+            double b1 = coefficients[c + 1];
+            double b2 = coefficients[c + 2];
+            double a1 = coefficients[c + 3];
+            double a2 = coefficients[c + 4];
+            for (int channel = 0; channel < channelCount; channel++) {
+                int s = (section * channelCount + channel) * 2;
+                double z1 = state[s];
+                double z2 = state[s + 1];
+                for (int i = channel; i < sampleCount; i += channelCount) {
+                    double x = in[inOffset + i];
+                    double y = b0 * x + z1;
+                    z1 = b1 * x - a1 * y + z2;
+                    z2 = b2 * x - a2 * y;
+                    dst[dstOffset + i] = y;
+                }
+                // Decaying state in silence would otherwise turn subnormal and slow every sample
+                state[s] = Math.abs(z1) < DENORMAL_FLOOR ? 0 : z1;
+                state[s + 1] = Math.abs(z2) < DENORMAL_FLOOR ? 0 : z2;
+            }
+            // Later sections run in place on the output
+            in = dst;
+            inOffset = dstOffset;
+        }
+    }
+
+    /** Forgets all history, as before the first sample of a stream. */
+    void reset() {
+        Arrays.fill(state, 0);
+    }
+}
@@ -1,12 +1,15 @@
 package core.waveform.signal;
 
 import core.audio.AudioData;
+import core.audio.AudioMetadata;
 import core.audio.SampleReader;
+import core.telemetry.FilterEvent;
+import core.util.simd.SampleKernels;
 import java.io.IOException;
 import java.nio.file.Path;
 import java.nio.file.Paths;
-import java.util.concurrent.ConcurrentHashMap;
-import marytts.signalproc.filter.BandPassFilter;
+import java.util.concurrent.TimeUnit;
+import java.util.function.Consumer;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
@@ -20,48 +23,236 @@ public final class WaveformProcessor {
     // Signal processing constants
     private static final double MIN_FREQUENCY = 0.001; // 0.1% of Nyquist frequency
     private static final double MAX_FREQUENCY = 0.45; // 45% of Nyquist frequency
-    private static final double PRE_DATA_OVERLAP_SECONDS = 0.25; // Overlap for chunk boundaries
+    private static final FrequencyRange PASS_BAND =
+            new FrequencyRange(MIN_FREQUENCY, MAX_FREQUENCY);
+
+    // Samples either side of each sample that envelope smoothing takes the maximum magnitude over
+    private static final int ENVELOPE_WINDOW = 20;
+
+    // Audio read ahead of a chunk that does not continue the previous one, so the filter settles
+    private static final double FILTER_WARMUP_SECONDS = 0.05;
+
+    // Progress snapshots copy the pyramid so far; keep them at least this far apart, and no more
+    // than 1 / PROGRESS_COST_RATIO of the pass
+    private static final long PROGRESS_INTERVAL_NANOS = TimeUnit.MILLISECONDS.toNanos(250);
+    private static final long PROGRESS_COST_RATIO = 8;
+
+    /**
+     * Processing parameters that shape {@link #buildPeakPyramid} output. Persisted pyramids are
+     * keyed by this string, so any change to the pipeline must change it.
+     */
+    public static final String PYRAMID_PARAMETERS =
+            "bandpass=butterworth4:"
+                    + MIN_FREQUENCY
+                    + "-"
+                    + MAX_FREQUENCY
+                    + ";bin="
+                    + PeakPyramid.BASE_BIN_FRAMES;
 
     private final SampleReader sampleReader;
     private final int sampleRate;
     private final SignalEnhancer signalEnhancer = new SignalEnhancer();
     private final PixelScaler pixelScaler;
-    private final ConcurrentHashMap<FrequencyRange, BandPassFilter> filterCache;
+
+    /** The buffers a processAudioForDisplay chunk is filtered and smoothed in. */
+    private record ChunkBuffers(double[] filtered, double[] smoothed) {}
+
+    // Filter state carried from one processAudioForDisplay chunk to the next, and the buffers
+    // its chunks are processed in, guarded by streamLock. A call claims them under the lock and
+    // hands them back once done, so reads, filtering and scaling all happen outside it.
+    private final Object streamLock = new Object();
+    private String streamPath;
+    private int streamNextChunk;
+    private StreamingBandPassFilter streamFilter;
+    private ChunkBuffers streamBuffers;
 
     public WaveformProcessor(SampleReader sampleReader, int sampleRate, PixelScaler pixelScaler) {
         this.sampleReader = sampleReader;
         this.sampleRate = sampleRate;
         this.pixelScaler = pixelScaler;
-        this.filterCache = new ConcurrentHashMap<>();
     }
 
-    /** Processes audio and scales for display in one call. */
+    /**
+     * Processes audio and scales for display in one call. A chunk that directly follows the
+     * previous call's chunk of the same file continues its filter state and reads no overlap;
+     * any other chunk first reads a short warm-up for the filter to settle.
+     */
     public double[] processAudioForDisplay(
             String audioFilePath, int chunkIndex, int targetPixelWidth) {
+        // Claim the carried filter and buffers, so a concurrent call warms up and uses its own
+        StreamingBandPassFilter filter = null;
+        ChunkBuffers buffers;
+        synchronized (streamLock) {
+            if (streamFilter != null
+                    && audioFilePath.equals(streamPath)
+                    && chunkIndex == streamNextChunk) {
+                filter = streamFilter;
+            }
+            buffers = streamBuffers;
+            streamFilter = null;
+            streamPath = null;
+            streamBuffers = null;
+        }
 
+        RawChunk rawAudio;
         try {
-            AudioChunkData rawAudio =
+            rawAudio =
                     loadChunk(
                             audioFilePath,
                             chunkIndex,
                             STANDARD_CHUNK_DURATION_SECONDS,
-                            PRE_DATA_OVERLAP_SECONDS);
-
-            FrequencyRange frequencyFilter = new FrequencyRange(MIN_FREQUENCY, MAX_FREQUENCY);
-            AudioChunkData processedAudio = processSignal(rawAudio, frequencyFilter);
-
-            return scaleToDisplay(processedAudio, targetPixelWidth);
-
+                            filter != null ? 0 : FILTER_WARMUP_SECONDS);
         } catch (IOException e) {
             // During file switches or rapid state changes, FMOD may transiently fail reads.
             // Avoid a noisy stack trace; log a concise warning and render an empty strip.
             logger.warn("Failed to read audio chunk {} using FMOD: {}", chunkIndex, e.getMessage());
             return new double[targetPixelWidth];
         }
+
+        int channelCount = rawAudio.audio().channelCount();
+        if (filter == null || filter.channelCount() != channelCount) {
+            filter = new StreamingBandPassFilter(PASS_BAND, channelCount);
+        }
+        int sampleCount = rawAudio.audio().view().length();
+        if (buffers == null || buffers.filtered().length != sampleCount) {
+            // Pixel scaling reads the whole array, so the buffers match the chunk exactly
+            buffers = new ChunkBuffers(new double[sampleCount], new double[sampleCount]);
+        }
+        double[] display =
+                scaleToDisplay(processSignal(rawAudio, filter, buffers), targetPixelWidth);
+
+        // Of concurrent calls, the last to finish leaves its state for the next chunk
+        synchronized (streamLock) {
+            streamFilter = filter;
+            streamPath = audioFilePath;
+            streamNextChunk = chunkIndex + 1;
+            streamBuffers = buffers;
+        }
+        return display;
     }
 
+    /**
+     * Builds the peak pyramid for a whole file in one streaming pass over band-passed samples.
+     * The filter carries its state from chunk to chunk, so each frame is read exactly once, and
+     * every chunk is filtered in place in one reused buffer.
+     */
+    public PeakPyramid buildPeakPyramid(String audioFilePath, AudioMetadata metadata)
+            throws IOException {
+        return buildPeakPyramid(audioFilePath, metadata, _ -> {});
+    }
+
+    /**
+     * Builds the peak pyramid as {@link #buildPeakPyramid(String, AudioMetadata)} does, handing
+     * {@code progress} a pyramid of the frames processed so far every few hundred milliseconds so
+     * callers can draw the file as the pass advances. Progress runs on the building thread.
+     *
+     * <p>Each chunk is read as soon as the sample reader has it, so with the in-memory reader the
+     * pass, and its progress, follow the decode as it advances through the file.
+     */
+    public PeakPyramid buildPeakPyramid(
+            String audioFilePath, AudioMetadata metadata, Consumer<PeakPyramid> progress)
+            throws IOException {
+        int channelCount = Math.max(1, metadata.channelCount());
+        StreamingBandPassFilter filter = new StreamingBandPassFilter(PASS_BAND, channelCount);
+        PeakPyramid.Builder builder =
+                new PeakPyramid.Builder(sampleRate, channelCount, metadata.frameCount());
+
+        long chunkFrames = (long) (STANDARD_CHUNK_DURATION_SECONDS * sampleRate);
+        double[] buffer = new double[0];
+        long nextProgress = System.nanoTime() + PROGRESS_INTERVAL_NANOS;
+        for (long startFrame = 0; startFrame < metadata.frameCount(); startFrame += chunkFrames) {
+            if (Thread.currentThread().isInterrupted()) {
+                throw new IOException("Peak pyramid build interrupted");
+            }
+            AudioData audioData = read(audioFilePath, startFrame, chunkFrames);
+            int sampleCount = audioData.view().length();
+            if (audioData.frameCount() <= 0 || sampleCount == 0) {
+                break;
+            }
+            if (buffer.length < sampleCount) {
+                buffer = new double[sampleCount];
+            }
+            audioData.view().copyTo(0, buffer, 0, sampleCount);
+            filter(filter, buffer, buffer, sampleCount);
+            builder.accept(buffer, 0, sampleCount);
+
+            long now = System.nanoTime();
+            if (now >= nextProgress && startFrame + chunkFrames < metadata.frameCount()) {
+                progress.accept(builder.snapshot());
+                long done = System.nanoTime();
+                long cost = done - now;
+                nextProgress = done + Math.max(PROGRESS_INTERVAL_NANOS, PROGRESS_COST_RATIO * cost);
+            }
+        }
+
+        PeakPyramid pyramid = builder.build();
+        logger.debug(
+                "Built peak pyramid for {}: {} frames, {} levels",
+                audioFilePath,
+                pyramid.frameCount(),
+                pyramid.levelCount());
+        return pyramid;
+    }
+
+    /**
+     * Computes the absolute peak per pixel straight from band-passed samples, for zooms finer than
+     * {@link PeakPyramid#BASE_BIN_FRAMES} frames per pixel where the pyramid cannot resolve single
+     * pixels. Reads only the frames the pixels cover plus a short filter warm-up, and smooths the
+     * envelope over {@value #ENVELOPE_WINDOW} samples as the chunked pipeline does.
+     *
+     * <p>The pyramid skips that smoothing: at a base bin or more per pixel, the per-pixel maximum
+     * already spans many windows, and smoothing would only widen each pixel by a few samples.
+     *
+     * @param startFrame Frame position of the left edge of the first pixel, may be negative
+     * @param framesPerPixel Frames covered by each pixel, must be positive
+     * @param pixelCount Number of pixels to compute
+     * @return Peak magnitude per pixel; pixels outside the file are 0
+     */
+    public double[] segmentEnvelope(
+            String audioFilePath, double startFrame, double framesPerPixel, int pixelCount)
+            throws IOException {
+        if (framesPerPixel <= 0) {
+            throw new IllegalArgumentException("Frames per pixel must be > 0: " + framesPerPixel);
+        }
+        double[] pixels = new double[pixelCount];
+        long from = (long) Math.max(0, Math.floor(startFrame));
+        long to = (long) Math.ceil(startFrame + framesPerPixel * pixelCount);
+        if (to <= from) {
+            return pixels;
+        }
+        long warmup = Math.min(from, (long) (FILTER_WARMUP_SECONDS * sampleRate));
+        long readStart = from - warmup;
+
+        AudioData audio = read(audioFilePath, readStart, to - readStart);
+        int channels = audio.channelCount();
+        int sampleCount = audio.view().length();
+        if (audio.frameCount() <= warmup || sampleCount == 0) {
+            return pixels;
+        }
+        double[] samples = new double[sampleCount];
+        audio.view().copyTo(0, samples, 0, sampleCount);
+        filter(new StreamingBandPassFilter(PASS_BAND, channels), samples, samples, sampleCount);
+        signalEnhancer.envelopeSmooth(samples, ENVELOPE_WINDOW);
+
+        long frames = audio.frameCount();
+        for (int i = 0; i < pixelCount; i++) {
+            double pixelFrom = startFrame + i * framesPerPixel;
+            long first = Math.max(warmup, (long) Math.floor(pixelFrom) - readStart);
+            long end = Math.min(frames, (long) Math.ceil(pixelFrom + framesPerPixel) - readStart);
+            double peak = 0;
+            for (long s = first * channels; s < end * channels; s++) {
+                peak = Math.max(peak, samples[(int) s]);
+            }
+            pixels[i] = peak;
+        }
+        return pixels;
+    }
+
+    /** Raw samples read for one chunk, led by {@code overlapFrames} of filter warm-up. */
+    private record RawChunk(AudioData audio, int overlapFrames) {}
+
     /** Loads raw audio chunk from file using SampleReader. */
-    private AudioChunkData loadChunk(
+    private RawChunk loadChunk(
             String audioFilePath,
             int chunkIndex,
             double chunkDurationSeconds,
@@ -84,57 +275,68 @@ public final class WaveformProcessor {
                 actualOverlapFrames = (int) overlapFrames;
             }
 
-            // Read samples asynchronously but wait for result
-            Path audioPath = Paths.get(audioFilePath);
-            AudioData audioData = sampleReader.readSamples(audioPath, startFrame, frameCount).get();
+            AudioData audioData = read(audioFilePath, startFrame, frameCount);
 
             // If the read returned no frames (e.g., beyond EOF), disable overlap to avoid
             // invalid skip counts during pixel scaling.
             int safeOverlapFrames = (audioData.frameCount() <= 0) ? 0 : actualOverlapFrames;
 
-            return new AudioChunkData(
-                    audioData.samples(),
-                    audioData.sampleRate(),
-                    0.0, // Peak calculated after processing
-                    (int) audioData.frameCount(),
-                    safeOverlapFrames);
-        } catch (Exception e) {
+            return new RawChunk(audioData, safeOverlapFrames);
+        } catch (RuntimeException e) {
             throw new IOException("Failed to read audio chunk: " + e.getMessage(), e);
         }
     }
 
-    /** Applies signal processing to raw audio data. */
-    private AudioChunkData processSignal(AudioChunkData rawAudio, FrequencyRange frequencyFilter) {
-        // BandPassFilter.apply() returns a new array, so no defensive copy needed
-        double[] samples = rawAudio.amplitudeValues();
-
-        if (samples.length > 0) {
-            BandPassFilter filter;
-            if (filterCache != null) {
-                filter =
-                        filterCache.computeIfAbsent(
-                                frequencyFilter,
-                                range ->
-                                        new BandPassFilter(
-                                                range.minFrequency(), range.maxFrequency()));
-            } else {
-                filter =
-                        new BandPassFilter(
-                                frequencyFilter.minFrequency(), frequencyFilter.maxFrequency());
-            }
-            samples = filter.apply(samples); // This returns new array
+    /** Reads samples, waiting for the asynchronous result. */
+    private AudioData read(String audioFilePath, long startFrame, long frameCount)
+            throws IOException {
+        try {
+            Path audioPath = Paths.get(audioFilePath);
+            return sampleReader.readSamples(audioPath, startFrame, frameCount).get();
+        } catch (InterruptedException e) {
+            Thread.currentThread().interrupt();
+            throw new IOException("Interrupted reading audio chunk", e);
+        } catch (Exception e) {
+            throw new IOException("Failed to read audio chunk: " + e.getMessage(), e);
         }
+    }
 
-        signalEnhancer.envelopeSmooth(samples, 20);
+    /**
+     * Applies signal processing to raw audio data, continuing the given filter's state. Works in
+     * the given buffers, which must be the chunk's length and are not shared while in use.
+     */
+    private AudioChunkData processSignal(
+            RawChunk rawAudio, StreamingBandPassFilter filter, ChunkBuffers buffers) {
+        // Copy out of the reader's storage, then filter in place
+        AudioData audio = rawAudio.audio();
+        int sampleCount = audio.view().length();
+        double[] filtered = buffers.filtered();
+        audio.view().copyTo(0, filtered, 0, sampleCount);
+        filter(filter, filtered, filtered, sampleCount);
+
+        // The envelope smoothing of SignalEnhancer, without its per-call copy
+        SampleKernels.slidingAbsMax(filtered, ENVELOPE_WINDOW, buffers.smoothed());
 
         return new AudioChunkData(
-                samples,
-                rawAudio.sampleRate(),
+                buffers.smoothed(),
+                audio.sampleRate(),
+                audio.channelCount(),
                 0.0, // Peak calculated later by WaveformBuffer if needed
-                rawAudio.frameCount(),
+                (int) audio.frameCount(),
                 rawAudio.overlapFrames());
     }
 
+    /** Filters the first {@code count} samples of {@code in} into {@code out}, timing it. */
+    private static void filter(
+            StreamingBandPassFilter filter, double[] in, double[] out, int count) {
+        var event = new FilterEvent();
+        event.start();
+        filter.process(in, 0, out, 0, count);
+        event.samples = count;
+        event.channels = filter.channelCount();
+        event.finish();
+    }
+
     /** Scales processed audio data to display pixel resolution. */
     private double[] scaleToDisplay(AudioChunkData processedAudio, int targetPixelWidth) {
         double[] displayAmplitudes =
@@ -44,9 +44,9 @@ public class FileDropListener implements FileDrop.Listener {
     /**
      * Handles drag and drop of audio files or a wordpool document.
      *
-     * <p>For each directory dropped, adds the directory's normal files to the file batch. Adds each
-     * file dropped to the batch. Finally, adds the whole batch to the <code>AudioFileDisplay</code>
-     * . using {@link AudioFileDisplay#addFilesIfSupported(File[])}.
+     * <p>Each directory dropped is scanned in the background using {@link
+     * AudioFileDisplay#addFolder(File)}. Each file dropped is added to the <code>AudioFileDisplay
+     * </code> using {@link AudioFileDisplay#addFilesIfSupported(File[])}.
      *
      * <p>Files are added in a batch, instead of one at a time, to the <code>AudioFileDisplay</code>
      * in keeping with that classes policies on sorting optimization.
@@ -107,7 +107,7 @@ public class FileDropListener implements FileDrop.Listener {
                             somethingAccepted = true;
                         }
                     } else if (f.isDirectory()) {
-                        if (audioFileDisplay.addFilesIfSupported(f.listFiles())) {
+                        if (audioFileDisplay.addFolder(f)) {
                             somethingAccepted = true;
                         }
                     }
@@ -26,4 +26,9 @@ public class SwingEventDispatcher implements EventDispatcher {
             SwingUtilities.invokeLater(task);
         }
     }
+
+    @Override
+    public void dispatchLater(Runnable task) {
+        SwingUtilities.invokeLater(task);
+    }
 }
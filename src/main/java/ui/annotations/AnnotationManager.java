@@ -1,6 +1,7 @@
 package ui.annotations;
 
 import core.annotations.Annotation;
+import core.annotations.AnnotationFileParser;
 import core.audio.session.AudioSessionDataSource;
 import core.dispatch.EventDispatchBus;
 import core.dispatch.Subscribe;
@@ -13,6 +14,7 @@ import core.util.OsPath;
 import jakarta.inject.Inject;
 import jakarta.inject.Singleton;
 import java.io.File;
+import java.io.IOException;
 import lombok.NonNull;
 import lombok.extern.slf4j.Slf4j;
 import ui.audiofiles.AudioFile;
@@ -26,16 +28,19 @@ public class AnnotationManager {
     private final EventDispatchBus eventBus;
     private final AudioSessionDataSource sessionSource;
     private final AnnotationDisplay annotationDisplay;
+    private final AnnotationFileParser annotationFileParser;
     private AudioFile currentAudioFile;
 
     @Inject
     public AnnotationManager(
             @NonNull EventDispatchBus eventBus,
             @NonNull AudioSessionDataSource sessionSource,
-            @NonNull AnnotationDisplay annotationDisplay) {
+            @NonNull AnnotationDisplay annotationDisplay,
+            @NonNull AnnotationFileParser annotationFileParser) {
         this.eventBus = eventBus;
         this.sessionSource = sessionSource;
         this.annotationDisplay = annotationDisplay;
+        this.annotationFileParser = annotationFileParser;
         eventBus.subscribe(this);
     }
 
@@ -52,6 +57,12 @@ public class AnnotationManager {
         } else if (event.isAudioClosed()) {
             currentAudioFile = null;
             log.debug("Cleared audio file reference");
+            // Fold journalled edits into the closed file's JSON
+            try {
+                annotationFileParser.closeAll();
+            } catch (IOException e) {
+                log.error("Error compacting annotation files: {}", e.getMessage());
+            }
         }
     }
 
@@ -85,6 +96,17 @@ public class AnnotationManager {
                                 DialogEvent.Type.ERROR));
                 return;
             } else {
+                // The completed file must be whole JSON, with no journal left behind
+                try {
+                    annotationFileParser.close(tmpFile);
+                } catch (IOException e) {
+                    log.error("Error compacting annotation file: {}", e.getMessage());
+                    eventBus.publish(
+                            new DialogEvent(
+                                    "Could not save annotations: " + e.getMessage(),
+                                    DialogEvent.Type.ERROR));
+                    return;
+                }
                 if (!tmpFile.renameTo(oFile)) {
                     eventBus.publish(new DialogEvent("Operation failed.", DialogEvent.Type.ERROR));
                     return;
@@ -1,10 +1,12 @@
 package ui.audiofiles;
 
+import core.audio.AudioMetadata;
 import core.env.Constants;
 import core.util.OsPath;
 import java.io.File;
 import java.nio.file.Path;
 import java.nio.file.Paths;
+import java.util.Optional;
 import java.util.concurrent.ConcurrentHashMap;
 import java.util.concurrent.atomic.AtomicBoolean;
 import javax.swing.event.ChangeEvent;
@@ -33,6 +35,7 @@ public class AudioFile implements Comparable<AudioFile> {
     private final Path path;
     private final ConcurrentHashMap<ChangeListener, Boolean> listeners;
     private final AtomicBoolean done;
+    private volatile AudioMetadata metadata;
 
     /**
      * Creates a new <code>AudioFile</code> from the given path.
@@ -53,6 +56,24 @@ public class AudioFile implements Comparable<AudioFile> {
         updateDoneStatus();
     }
 
+    /**
+     * Creates a new <code>AudioFile</code> whose completion status comes from a listing of its
+     * directory, made by the caller, rather than from probing the file system for each sister
+     * annotation file.
+     *
+     * @param path The path of the file to be created
+     * @param annFileExists Whether the listing contains the final annotation file
+     * @param tmpFileExists Whether the listing contains the temporary annotation file
+     * @throws AudioFilePathException If both annotation files are listed
+     */
+    AudioFile(@NonNull Path path, boolean annFileExists, boolean tmpFileExists)
+            throws AudioFilePathException {
+        this.path = path.toAbsolutePath();
+        this.listeners = new ConcurrentHashMap<>();
+        this.done = new AtomicBoolean(false);
+        updateDoneStatus(annFileExists, tmpFileExists);
+    }
+
     /**
      * Creates a new <code>AudioFile</code> from the given File.
      *
@@ -180,20 +201,29 @@ public class AudioFile implements Comparable<AudioFile> {
      * @throws AudioFilePathException If both the temporary and final annotation files are present
      */
     public void updateDoneStatus() throws AudioFilePathException {
-        var savedStatus = done.get();
-        var basePath = OsPath.basename(getAbsolutePath());
-        var annPath = Paths.get(basePath + "." + Constants.completedAnnotationFileExtension);
-        var tmpPath = Paths.get(basePath + "." + Constants.temporaryAnnotationFileExtension);
+        updateDoneStatus(
+                annotationPath(path, Constants.completedAnnotationFileExtension).toFile().exists(),
+                annotationPath(path, Constants.temporaryAnnotationFileExtension).toFile().exists());
+    }
 
-        var annFileExists = annPath.toFile().exists();
-        var tmpFileExists = tmpPath.toFile().exists();
+    /**
+     * Sets the <code>done</code> field from the given presence of this file's annotation files, as
+     * found in a listing of its directory. Informs listeners if the completion status changes.
+     *
+     * @param annFileExists Whether the final annotation file is present
+     * @param tmpFileExists Whether the temporary annotation file is present
+     * @throws AudioFilePathException If both the temporary and final annotation files are present
+     */
+    void updateDoneStatus(boolean annFileExists, boolean tmpFileExists)
+            throws AudioFilePathException {
+        var savedStatus = done.get();
 
         if (annFileExists && tmpFileExists) {
             throw new AudioFilePathException(
                     "Both exist, so I don't know if I'm completed or not:\n"
-                            + annPath
+                            + annotationPath(path, Constants.completedAnnotationFileExtension)
                             + "\n"
-                            + tmpPath);
+                            + annotationPath(path, Constants.temporaryAnnotationFileExtension));
         }
 
         var updatedStatus = annFileExists || (!tmpFileExists && savedStatus);
@@ -206,6 +236,35 @@ public class AudioFile implements Comparable<AudioFile> {
         }
     }
 
+    /**
+     * Finds the path of an audio file's sister annotation file with the given extension.
+     *
+     * @param audioFile The audio file
+     * @param extension The annotation file extension, without the dot
+     * @return The annotation file's path, in the same directory as the audio file
+     */
+    static Path annotationPath(@NonNull Path audioFile, @NonNull String extension) {
+        return Paths.get(OsPath.basename(audioFile.toString()) + "." + extension);
+    }
+
+    /**
+     * Gets the format and length probed from the file's header, once the probe has finished.
+     *
+     * @return The metadata, or empty if it has not been probed (or could not be)
+     */
+    public Optional<AudioMetadata> getMetadata() {
+        return Optional.ofNullable(metadata);
+    }
+
+    /**
+     * Records the format and length probed from the file's header.
+     *
+     * @param metadata The probed metadata
+     */
+    void setMetadata(@NonNull AudioMetadata metadata) {
+        this.metadata = metadata;
+    }
+
     /**
      * Adds a <code>ChangeListener</code> to be notified of updates in this <code>AudioFile</code>'s
      * completion status.
@@ -5,6 +5,7 @@ import core.dispatch.Subscribe;
 import core.env.Constants;
 import core.env.PreferenceKeys;
 import core.events.AudioFilesSelectedEvent;
+import core.events.AudioFolderSelectedEvent;
 import core.preferences.PreferencesManager;
 import jakarta.inject.Inject;
 import jakarta.inject.Singleton;
@@ -43,6 +44,7 @@ public class AudioFileDisplay extends JScrollPane implements AudioFileDisplayInt
     private final DialogService dialogService;
     private final AudioFileList list;
     private final EventDispatchBus eventBus;
+    private final AudioFolderScanner folderScanner;
 
     /**
      * Creates a new instance of the component, initializing internal components, key bindings,
@@ -53,11 +55,13 @@ public class AudioFileDisplay extends JScrollPane implements AudioFileDisplayInt
             @NonNull AudioFileList audioFileList,
             @NonNull PreferencesManager preferencesManager,
             @NonNull EventDispatchBus eventBus,
-            @NonNull DialogService dialogService) {
+            @NonNull DialogService dialogService,
+            @NonNull AudioFolderScanner folderScanner) {
         this.preferencesManager = preferencesManager;
         this.dialogService = dialogService;
         this.list = audioFileList;
         this.eventBus = eventBus;
+        this.folderScanner = folderScanner;
         getViewport().setView(list);
 
         setPreferredSize(PREFERRED_SIZE);
@@ -130,6 +134,22 @@ public class AudioFileDisplay extends JScrollPane implements AudioFileDisplayInt
         return false;
     }
 
+    /**
+     * Adds the supported audio files in a folder to the <code>AudioFileList</code>, listing the
+     * folder in the background with {@link AudioFolderScanner} and watching it afterwards.
+     *
+     * @param folder Candidate folder
+     * @return <code>true</code> if <code>folder</code> is a directory, so a scan was started
+     */
+    @Override
+    public boolean addFolder(@NonNull File folder) {
+        if (!folder.isDirectory()) {
+            return false;
+        }
+        folderScanner.scan(folder.toPath());
+        return true;
+    }
+
     /**
      * Switches to the provided <code>File</code>, but only after asking the user for confirmation
      * if the current user's preferences demand such a warning.
@@ -182,7 +202,7 @@ public class AudioFileDisplay extends JScrollPane implements AudioFileDisplayInt
      * @return <code>true</code> iff the the <code>name</code> parameter ends with a supported
      *     extension
      */
-    private static boolean extensionSupported(@NonNull String name) {
+    static boolean extensionSupported(@NonNull String name) {
         var lowerName = name.toLowerCase(Locale.ROOT);
         return Constants.audioFormatsLowerCase.stream().anyMatch(lowerName::endsWith);
     }
@@ -191,4 +211,9 @@ public class AudioFileDisplay extends JScrollPane implements AudioFileDisplayInt
     public void handleAudioFilesSelected(@NonNull AudioFilesSelectedEvent event) {
         addFilesIfSupported(event.files());
     }
+
+    @Subscribe
+    public void handleAudioFolderSelected(@NonNull AudioFolderSelectedEvent event) {
+        addFolder(event.folder());
+    }
 }
@@ -13,6 +13,14 @@ public interface AudioFileDisplayInterface {
      */
     boolean addFilesIfSupported(@NonNull File[] files);
 
+    /**
+     * Adds the supported audio files in a folder to the AudioFileList, in the background.
+     *
+     * @param folder Candidate folder
+     * @return true if the folder is a directory, so a scan was started
+     */
+    boolean addFolder(@NonNull File folder);
+
     /**
      * Switches to the provided AudioFile after asking for user confirmation if needed.
      *
@@ -5,6 +5,7 @@ import core.dispatch.EventDispatchBus;
 import core.dispatch.Subscribe;
 import core.events.AppStateChangedEvent;
 import core.events.AudioFileListEvent;
+import core.events.UpcomingAudioFilesEvent;
 import jakarta.inject.Inject;
 import jakarta.inject.Singleton;
 import java.awt.event.ActionEvent;
@@ -15,6 +16,8 @@ import java.awt.event.KeyEvent;
 import java.awt.event.MouseAdapter;
 import java.awt.event.MouseEvent;
 import java.io.File;
+import java.util.ArrayList;
+import java.util.List;
 import javax.swing.AbstractAction;
 import javax.swing.JComponent;
 import javax.swing.JList;
@@ -29,6 +32,7 @@ public class AudioFileList extends JList<AudioFile> implements FocusListener {
 
     private final AudioFileListModel model;
     private final AudioFileListCellRenderer render;
+    private final EventDispatchBus eventBus;
     private AudioFile currentAudioFile = null;
 
     /**
@@ -40,6 +44,7 @@ public class AudioFileList extends JList<AudioFile> implements FocusListener {
             @NonNull AudioFileListMouseAdapter mouseAdapter,
             @NonNull Provider<AudioFileDisplayInterface> audioFileDisplayProvider,
             @NonNull EventDispatchBus eventBus) {
+        this.eventBus = eventBus;
         model = new AudioFileListModel();
         setModel(model);
 
@@ -213,6 +218,7 @@ public class AudioFileList extends JList<AudioFile> implements FocusListener {
                     setSelectedIndex(i);
                     ensureIndexIsVisible(i);
                     repaint(); // Force renderer to update
+                    publishUpcomingFiles(i);
                     break;
                 }
             }
@@ -223,6 +229,21 @@ public class AudioFileList extends JList<AudioFile> implements FocusListener {
         }
     }
 
+    /**
+     * Announces the files likely to be opened after the one at {@code currentIndex}: the
+     * incomplete files below it, in list order, which is where Done leads.
+     */
+    private void publishUpcomingFiles(int currentIndex) {
+        List<File> upcoming = new ArrayList<>();
+        for (int i = currentIndex + 1; i < model.getSize(); i++) {
+            AudioFile audioFile = model.getElementAt(i);
+            if (!audioFile.isDone()) {
+                upcoming.add(audioFile.toFile());
+            }
+        }
+        eventBus.publish(new UpcomingAudioFilesEvent(upcoming));
+    }
+
     /** Gets the currently loaded audio file for rendering purposes. */
     public AudioFile getCurrentAudioFile() {
         return currentAudioFile;
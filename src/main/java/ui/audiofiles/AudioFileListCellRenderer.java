@@ -1,5 +1,6 @@
 package ui.audiofiles;
 
+import core.audio.AudioMetadata;
 import java.awt.Component;
 import java.awt.Font;
 import java.awt.font.TextAttribute;
@@ -15,6 +16,7 @@ import lombok.NonNull;
  * AudioFiles</code> that are done are displayed using a disabled <code>JComponent</code> with the
  * program's strike-through <code>Font</code>. <code>AudioFiles</code> that are incomplete are
  * displayed using an enabled <code>JComponent</code> with the program's bold <code>Font</code>.
+ * Once a file's header has been probed, its length and format are shown as the cell's tooltip.
  */
 public class AudioFileListCellRenderer extends DefaultListCellRenderer {
 
@@ -41,6 +43,8 @@ public class AudioFileListCellRenderer extends DefaultListCellRenderer {
         super.getListCellRendererComponent(list, value, index, isSelected, cellHasFocus);
 
         if (value instanceof AudioFile audioFile) {
+            setToolTipText(
+                    audioFile.getMetadata().map(AudioFileListCellRenderer::describe).orElse(null));
             if (audioFile.isDone()) {
                 setEnabled(false);
                 setFont(strikethrough);
@@ -59,4 +63,10 @@ public class AudioFileListCellRenderer extends DefaultListCellRenderer {
         }
         return this;
     }
+
+    /** Length and format, e.g. "12:03, 16000 Hz, 16 bit, Mono". */
+    private static String describe(@NonNull AudioMetadata metadata) {
+        long seconds = Math.round(metadata.durationSeconds());
+        return "%d:%02d, %s".formatted(seconds / 60, seconds % 60, metadata.format());
+    }
 }
@@ -61,6 +61,39 @@ public class AudioFileListModel implements ListModel<AudioFile>, ChangeListener
         listeners.forEach(ldl -> ldl.contentsChanged(e));
     }
 
+    /**
+     * Removes the element, if it is in the list.
+     *
+     * @param file The element to be removed
+     * @see #removeElementAt(int)
+     */
+    public void removeElement(@NonNull AudioFile file) {
+        int index = collection.indexOf(file);
+        if (index >= 0) {
+            removeElementAt(index);
+        }
+    }
+
+    /**
+     * Finds the element with the same path as <code>file</code>.
+     *
+     * @param file An <code>AudioFile</code> equal to the element sought
+     * @return The element in the list, or <code>null</code> if there is none
+     */
+    AudioFile findElement(@NonNull AudioFile file) {
+        int index = collection.indexOf(file);
+        return index >= 0 ? collection.get(index) : null;
+    }
+
+    /**
+     * Requests a repaint after the details of some elements have changed without their order
+     * changing, e.g. when probed metadata arrives.
+     */
+    void elementsChanged() {
+        var e = new ListDataEvent(this, ListDataEvent.CONTENTS_CHANGED, 0, collection.size());
+        listeners.forEach(ldl -> ldl.contentsChanged(e));
+    }
+
     /**
      * Adds files to the list, skipping <code>AudioFiles</code> already in the list.
      *
@@ -0,0 +1,377 @@
+package ui.audiofiles;
+
+import static java.nio.file.StandardWatchEventKinds.ENTRY_CREATE;
+import static java.nio.file.StandardWatchEventKinds.ENTRY_DELETE;
+import static java.nio.file.StandardWatchEventKinds.OVERFLOW;
+
+import core.audio.AudioMetadata;
+import core.audio.AudioMetadataProbe;
+import core.env.Constants;
+import core.util.OsPath;
+import jakarta.inject.Inject;
+import jakarta.inject.Singleton;
+import java.io.IOException;
+import java.nio.file.ClosedWatchServiceException;
+import java.nio.file.FileSystems;
+import java.nio.file.FileVisitResult;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.SimpleFileVisitor;
+import java.nio.file.WatchEvent;
+import java.nio.file.WatchKey;
+import java.nio.file.WatchService;
+import java.nio.file.attribute.BasicFileAttributes;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.ConcurrentLinkedQueue;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.atomic.AtomicBoolean;
+import javax.swing.SwingUtilities;
+import lombok.NonNull;
+import org.slf4j.Logger;
+import org.slf4j.LoggerFactory;
+import ui.DialogService;
+import ui.audiofiles.AudioFile.AudioFilePathException;
+
+/**
+ * Fills the {@link AudioFileList} from folders off the EDT, and keeps it current as the folders
+ * change.
+ *
+ * <p>A folder is listed once, with its entries' attributes; each <code>AudioFile</code>'s
+ * completion status is then taken from that listing instead of probing for its annotation files,
+ * which on a network share costs two round trips per recording. The files go into the model in
+ * batches of {@link #BATCH_SIZE}, and their headers are then probed in parallel by the {@link
+ * AudioMetadataProbe}, with results that arrive together repainted together.
+ *
+ * <p>Scanned folders are watched with a {@link WatchService}, so files and annotation files that
+ * appear or disappear later update the list without a re-scan. Some network file systems do not
+ * report changes to watchers; opening such a folder again re-scans it.
+ *
+ * <p>Listings and watch events are handled on one scanner thread, which alone touches the folder
+ * state; the model is only touched on the EDT.
+ */
+@Singleton
+public class AudioFolderScanner {
+    private static final Logger logger = LoggerFactory.getLogger(AudioFolderScanner.class);
+
+    /** Files added to the model per EDT task. */
+    static final int BATCH_SIZE = 100;
+
+    private final AudioFileList list;
+    private final AudioMetadataProbe probe;
+    private final DialogService dialogService;
+    private final ExecutorService scanner;
+
+    // Confined to the scanner thread
+    private final Map<Path, Folder> folders = new HashMap<>();
+    private final Map<WatchKey, Folder> watchedFolders = new HashMap<>();
+    private WatchService watchService;
+
+    // Probe results waiting for the EDT, and whether a task to apply them is queued
+    private final ConcurrentLinkedQueue<Probed> probed = new ConcurrentLinkedQueue<>();
+    private final AtomicBoolean flushQueued = new AtomicBoolean();
+
+    /** A scanned folder: the names listed in it, and its audio files by basename. */
+    private static final class Folder {
+        final Path dir;
+        final Set<String> names = new HashSet<>();
+        final Map<String, AudioFile> audioFiles = new HashMap<>();
+
+        Folder(@NonNull Path dir) {
+            this.dir = dir;
+        }
+    }
+
+    private record Probed(@NonNull AudioFile file, @NonNull AudioMetadata metadata) {}
+
+    /** Which of a file's annotation files a folder lists. */
+    private record Status(boolean annFileExists, boolean tmpFileExists) {}
+
+    @Inject
+    public AudioFolderScanner(
+            @NonNull AudioFileList list,
+            @NonNull AudioMetadataProbe probe,
+            @NonNull DialogService dialogService) {
+        this.list = list;
+        this.probe = probe;
+        this.dialogService = dialogService;
+        this.scanner =
+                Executors.newSingleThreadExecutor(
+                        r -> {
+                            Thread t = new Thread(r, "AudioFolderScanner");
+                            t.setDaemon(true);
+                            return t;
+                        });
+    }
+
+    /**
+     * Lists the folder and adds its supported audio files to the list, then watches it. Returns
+     * immediately; files appear as the listing completes.
+     *
+     * @param dir The folder to scan
+     */
+    public void scan(@NonNull Path dir) {
+        Path folder = dir.toAbsolutePath().normalize();
+        scanner.execute(() -> list(folder));
+    }
+
+    private void list(@NonNull Path dir) {
+        var folder = new Folder(dir);
+        List<Path> audioPaths = new ArrayList<>();
+        try {
+            // Depth 1: the entries' attributes come with the listing where the OS provides them
+            Files.walkFileTree(
+                    dir,
+                    Set.of(),
+                    1,
+                    new SimpleFileVisitor<>() {
+                        @Override
+                        public FileVisitResult visitFile(Path file, BasicFileAttributes attrs) {
+                            if (attrs.isRegularFile()) {
+                                String name = file.getFileName().toString();
+                                folder.names.add(name);
+                                if (AudioFileDisplay.extensionSupported(name)) {
+                                    audioPaths.add(file);
+                                }
+                            }
+                            return FileVisitResult.CONTINUE;
+                        }
+
+                        @Override
+                        public FileVisitResult visitFileFailed(Path file, IOException e) {
+                            logger.debug("Skipping unreadable entry {}", file, e);
+                            return FileVisitResult.CONTINUE;
+                        }
+                    });
+        } catch (IOException e) {
+            logger.error("Failed to list audio folder {}", dir, e);
+            showError("Could not read folder " + dir + ":\n" + e.getMessage());
+            return;
+        }
+
+        List<AudioFile> files = new ArrayList<>(audioPaths.size());
+        for (Path path : audioPaths) {
+            var file = resolve(folder, path, true);
+            if (file != null) {
+                files.add(file);
+            }
+        }
+        folders.put(dir, folder);
+        watch(folder);
+        logger.info("Listed {} audio files in {}", files.size(), dir);
+
+        for (int from = 0; from < files.size(); from += BATCH_SIZE) {
+            var batch = List.copyOf(files.subList(from, Math.min(files.size(), from + BATCH_SIZE)));
+            SwingUtilities.invokeLater(() -> list.getModel().addElements(batch));
+        }
+        files.forEach(this::probe);
+    }
+
+    /**
+     * Creates the <code>AudioFile</code> for a listed path and records it in its folder.
+     *
+     * @param reportConflict Whether to show the user an error if both annotation files are listed
+     * @return The file, or <code>null</code> if its completion status is ambiguous
+     */
+    private AudioFile resolve(@NonNull Folder folder, @NonNull Path path, boolean reportConflict) {
+        try {
+            var file =
+                    new AudioFile(
+                            path,
+                            folder.names.contains(annotationName(path, true)),
+                            folder.names.contains(annotationName(path, false)));
+            folder.audioFiles.put(basename(path), file);
+            return file;
+        } catch (AudioFilePathException e) {
+            logger.error("Error updating audio file done status", e);
+            if (reportConflict) {
+                showError(e.getMessage());
+            }
+            return null;
+        }
+    }
+
+    private void probe(@NonNull AudioFile file) {
+        probe.probe(file.getPath())
+                .whenComplete(
+                        (metadata, e) -> {
+                            if (e != null) {
+                                logger.debug("Could not probe {}: {}", file, e.getMessage());
+                                return;
+                            }
+                            probed.add(new Probed(file, metadata));
+                            if (flushQueued.compareAndSet(false, true)) {
+                                SwingUtilities.invokeLater(this::applyProbed);
+                            }
+                        });
+    }
+
+    /** On the EDT: attach the probe results that have arrived, with a single repaint. */
+    private void applyProbed() {
+        flushQueued.set(false);
+        var model = list.getModel();
+        boolean changed = false;
+        for (Probed result; (result = probed.poll()) != null; ) {
+            // The model keeps the first AudioFile it was given for a path
+            var element = model.findElement(result.file());
+            if (element != null) {
+                element.setMetadata(result.metadata());
+                changed = true;
+            }
+        }
+        if (changed) {
+            model.elementsChanged();
+        }
+    }
+
+    private void watch(@NonNull Folder folder) {
+        try {
+            if (watchService == null) {
+                watchService = FileSystems.getDefault().newWatchService();
+                var watcher = new Thread(this::pollWatchService, "AudioFolderWatcher");
+                watcher.setDaemon(true);
+                watcher.start();
+            }
+            var key = folder.dir.register(watchService, ENTRY_CREATE, ENTRY_DELETE);
+            watchedFolders.put(key, folder);
+        } catch (IOException | UnsupportedOperationException e) {
+            logger.warn("Cannot watch {}; changes will show when it is opened again", folder.dir);
+        }
+    }
+
+    /** On the watcher thread: hand each batch of events to the scanner thread. */
+    private void pollWatchService() {
+        try {
+            while (true) {
+                WatchKey key = watchService.take();
+                List<WatchEvent<?>> events = key.pollEvents();
+                boolean valid = key.reset();
+                scanner.execute(() -> handleEvents(key, events, valid));
+            }
+        } catch (InterruptedException | ClosedWatchServiceException e) {
+            logger.debug("Audio folder watcher stopped");
+        }
+    }
+
+    private void handleEvents(
+            @NonNull WatchKey key, @NonNull List<WatchEvent<?>> events, boolean valid) {
+        var folder = watchedFolders.get(key);
+        if (folder == null || folders.get(folder.dir) != folder) {
+            return; // Re-scanned since, under a new key
+        }
+        if (!valid) {
+            watchedFolders.remove(key);
+            folders.remove(folder.dir);
+            return; // Deleted or unmounted
+        }
+
+        Set<String> touched = new HashSet<>();
+        for (var event : events) {
+            if (event.kind() == OVERFLOW) {
+                logger.info("Missed changes in {}; re-scanning", folder.dir);
+                list(folder.dir);
+                return;
+            }
+            String name = ((Path) event.context()).getFileName().toString();
+            if (event.kind() == ENTRY_CREATE) {
+                folder.names.add(name);
+            } else {
+                folder.names.remove(name);
+            }
+            touched.add(name);
+        }
+
+        // Apply the net effect, since a rename shows up as a delete and a create
+        List<AudioFile> added = new ArrayList<>();
+        List<AudioFile> removed = new ArrayList<>();
+        Set<AudioFile> restatus = new HashSet<>();
+        for (String name : touched) {
+            Path path = folder.dir.resolve(name);
+            String base = basename(path);
+            var known = folder.audioFiles.get(base);
+            if (AudioFileDisplay.extensionSupported(name)) {
+                if (known == null && folder.names.contains(name) && Files.isRegularFile(path)) {
+                    var file = resolve(folder, path, false);
+                    if (file != null) {
+                        added.add(file);
+                    }
+                } else if (known != null && !folder.names.contains(name)) {
+                    folder.audioFiles.remove(base);
+                    removed.add(known);
+                }
+            } else if (known != null && isAnnotationFile(name)) {
+                restatus.add(known);
+            }
+        }
+
+        Map<AudioFile, Status> statuses = new HashMap<>();
+        for (var file : restatus) {
+            statuses.put(
+                    file,
+                    new Status(
+                            folder.names.contains(annotationName(file.getPath(), true)),
+                            folder.names.contains(annotationName(file.getPath(), false))));
+        }
+        if (!added.isEmpty() || !removed.isEmpty() || !statuses.isEmpty()) {
+            SwingUtilities.invokeLater(() -> applyChanges(added, removed, statuses));
+        }
+        added.forEach(this::probe);
+    }
+
+    /** On the EDT: apply a folder's changes to the model. */
+    private void applyChanges(
+            @NonNull List<AudioFile> added,
+            @NonNull List<AudioFile> removed,
+            @NonNull Map<AudioFile, Status> statuses) {
+        var model = list.getModel();
+        for (var file : removed) {
+            // Leave the open file alone; it stays until the user switches away
+            if (!file.equals(list.getCurrentAudioFile())) {
+                model.removeElement(file);
+            }
+        }
+        if (!added.isEmpty()) {
+            model.addElements(added);
+        }
+        statuses.forEach(
+                (file, status) -> {
+                    var element = model.findElement(file);
+                    if (element == null) {
+                        return;
+                    }
+                    try {
+                        element.updateDoneStatus(status.annFileExists(), status.tmpFileExists());
+                    } catch (AudioFilePathException e) {
+                        // Usually a rename between .tmp and .ann seen halfway; the next event
+                        // settles it
+                        logger.debug("Ambiguous completion status for {}", element);
+                    }
+                });
+    }
+
+    private static boolean isAnnotationFile(@NonNull String name) {
+        return name.endsWith("." + Constants.completedAnnotationFileExtension)
+                || name.endsWith("." + Constants.temporaryAnnotationFileExtension);
+    }
+
+    private static String annotationName(@NonNull Path audioFile, boolean completed) {
+        var extension =
+                completed
+                        ? Constants.completedAnnotationFileExtension
+                        : Constants.temporaryAnnotationFileExtension;
+        return AudioFile.annotationPath(audioFile, extension).getFileName().toString();
+    }
+
+    private static String basename(@NonNull Path file) {
+        return OsPath.basename(file.getFileName().toString());
+    }
+
+    private void showError(@NonNull String message) {
+        SwingUtilities.invokeLater(() -> dialogService.showError(message));
+    }
+}
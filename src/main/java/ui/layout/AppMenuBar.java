@@ -5,6 +5,7 @@ import core.actions.impl.AboutAction;
 // import actions.AnnotateRegularAction;
 import core.actions.impl.CheckUpdatesAction;
 import core.actions.impl.DoneAction;
+import core.actions.impl.DumpPerformanceAction;
 import core.actions.impl.EditShortcutsAction;
 import core.actions.impl.ExitAction;
 import core.actions.impl.Last200PlusMoveAction;
@@ -16,6 +17,8 @@ import core.actions.impl.ReplayLast200MillisAction;
 // import actions.ReturnToLastPositionAction;
 import core.actions.impl.SeekToStartAction;
 import core.actions.impl.TipsMessageAction;
+import core.actions.impl.ToggleSpectrogramAction;
+import core.actions.impl.TogglePerformanceOverlayAction;
 import core.actions.impl.VisitTutorialSiteAction;
 import jakarta.inject.Inject;
 import jakarta.inject.Singleton;
@@ -73,6 +76,9 @@ public class AppMenuBar extends JMenuBar {
             Last200PlusMoveAction last200PlusMoveAction,
             core.actions.impl.ZoomInAction zoomInAction,
             core.actions.impl.ZoomOutAction zoomOutAction,
+            ToggleSpectrogramAction toggleSpectrogramAction,
+            TogglePerformanceOverlayAction togglePerformanceOverlayAction,
+            DumpPerformanceAction dumpPerformanceAction,
             core.actions.impl.OpenAudioFileAction openAudioFileAction,
             core.actions.impl.OpenAudioFolderAction openAudioFolderAction,
             core.actions.impl.SeekForwardSmallAction seekForwardSmallAction,
@@ -191,6 +197,10 @@ public class AppMenuBar extends JMenuBar {
                 new JMenuItem(swingActions.get(core.actions.impl.ZoomOutAction.class));
         jmView.add(jmiZoomIn);
         jmView.add(jmiZoomOut);
+        jmView.add(new JMenuItem(swingActions.get(ToggleSpectrogramAction.class)));
+        jmView.addSeparator();
+        jmView.add(new JMenuItem(swingActions.get(TogglePerformanceOverlayAction.class)));
+        jmView.add(new JMenuItem(swingActions.get(DumpPerformanceAction.class)));
         add(jmView);
     }
 
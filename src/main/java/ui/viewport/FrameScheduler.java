@@ -0,0 +1,231 @@
+package ui.viewport;
+
+import core.viewport.FrameClock;
+import java.awt.Component;
+import java.awt.DisplayMode;
+import java.awt.GraphicsConfiguration;
+import java.awt.GraphicsEnvironment;
+import java.util.concurrent.Executors;
+import java.util.concurrent.ScheduledExecutorService;
+import java.util.concurrent.ScheduledFuture;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.function.Consumer;
+import java.util.function.Supplier;
+import javax.swing.SwingUtilities;
+import lombok.NonNull;
+import lombok.extern.slf4j.Slf4j;
+
+/**
+ * The viewport's single source of frames, ticking at the display's refresh rate.
+ *
+ * <p>A ticker thread wakes on the refresh grid and hands one frame at a time to the EDT, stamping
+ * the {@link FrameClock} with the frame's grid time so the playhead smoothers see evenly spaced
+ * timestamps regardless of when the EDT gets to the frame. A frame counts as pending until the
+ * paint it requested has run; ticks that find a frame still pending are dropped, not queued, and
+ * reported with the next frame. Repaint requests from any source between ticks collapse into the
+ * next frame.
+ *
+ * <p>If frames keep taking more than most of their period, or keep being dropped, the scheduler
+ * falls back to every second (third, fourth) refresh, and steps back up once frames are cheap
+ * again. With no known refresh rate it uses {@link ViewportPainter#FPS}.
+ */
+@Slf4j
+final class FrameScheduler {
+
+    private static final int FALLBACK_REFRESH_HZ = ViewportPainter.FPS;
+
+    // Slowest rate as a fraction of the refresh rate
+    private static final int MAX_DIVISOR = 4;
+
+    // Frames per rate decision
+    private static final int ADAPT_WINDOW = 30;
+
+    // Share of the period a frame may take before the rate drops
+    private static final double FRAME_BUDGET = 0.75;
+
+    private final FrameClock clock;
+    private final Supplier<Component> component;
+    private final Consumer<Boolean> onFrame;
+    private final ScheduledExecutorService ticker;
+
+    private final AtomicBoolean pending = new AtomicBoolean();
+    private final AtomicInteger dropped = new AtomicInteger();
+    private final AtomicLong lastSlot = new AtomicLong(Long.MIN_VALUE);
+    private volatile boolean requested;
+
+    // Guarded by this
+    private ScheduledFuture<?> task;
+    private long originNanos;
+    private volatile long refreshPeriodNanos;
+    private volatile int divisor = 1;
+
+    // Rate adaptation, EDT only
+    private long windowWorkNanos;
+    private int windowFrames;
+    private int windowDropped;
+
+    /**
+     * Create a stopped scheduler.
+     *
+     * @param clock Clock to stamp each frame on
+     * @param component Component whose screen sets the refresh rate, or null if not on screen
+     * @param onFrame Runs on the EDT once per frame, told whether a repaint was requested
+     */
+    FrameScheduler(
+            @NonNull FrameClock clock,
+            @NonNull Supplier<Component> component,
+            @NonNull Consumer<Boolean> onFrame) {
+        this.clock = clock;
+        this.component = component;
+        this.onFrame = onFrame;
+        this.ticker =
+                Executors.newSingleThreadScheduledExecutor(
+                        r -> {
+                            Thread t = new Thread(r, "ViewportFrameScheduler");
+                            t.setDaemon(true);
+                            t.setPriority(Thread.MAX_PRIORITY);
+                            return t;
+                        });
+    }
+
+    /** Start ticking. */
+    synchronized void start() {
+        if (task != null) {
+            return;
+        }
+        refreshPeriodNanos = TimeUnit.SECONDS.toNanos(1) / refreshRate();
+        divisor = 1;
+        originNanos = System.nanoTime();
+        lastSlot.set(Long.MIN_VALUE);
+        schedule();
+        log.debug("Frame scheduler started at {} Hz", Math.round(1e9 / refreshPeriodNanos));
+    }
+
+    /** Stop ticking; a frame already handed to the EDT still runs. */
+    synchronized void stop() {
+        if (task != null) {
+            task.cancel(false);
+            task = null;
+        }
+    }
+
+    synchronized boolean isRunning() {
+        return task != null;
+    }
+
+    /** Ask for a repaint on the next frame. Requests before that frame collapse into one. */
+    void requestFrame() {
+        requested = true;
+    }
+
+    /** Current interval between frames. */
+    long periodNanos() {
+        return refreshPeriodNanos * divisor;
+    }
+
+    private void schedule() {
+        long period = periodNanos();
+        task = ticker.scheduleAtFixedRate(this::tick, period, period, TimeUnit.NANOSECONDS);
+    }
+
+    /** Ticker thread: hand the frame for this refresh to the EDT, unless one is still pending. */
+    private void tick() {
+        long origin;
+        long refresh;
+        synchronized (this) {
+            origin = originNanos;
+            refresh = refreshPeriodNanos;
+        }
+        long slot = (System.nanoTime() - origin) / refresh;
+        if (slot <= lastSlot.getAndSet(slot)) {
+            return; // Already delivered this refresh (rate was just changed)
+        }
+        if (!pending.compareAndSet(false, true)) {
+            dropped.incrementAndGet();
+            return;
+        }
+        long frameTimeNanos = origin + slot * refresh;
+        SwingUtilities.invokeLater(() -> runFrame(frameTimeNanos));
+    }
+
+    /** EDT: prepare a frame, and mark it finished once the paint it requested has run. */
+    private void runFrame(long frameTimeNanos) {
+        long started = System.nanoTime();
+        int skipped = dropped.getAndSet(0);
+        long period = periodNanos();
+        clock.beginFrame(frameTimeNanos, period, skipped);
+
+        boolean force = requested;
+        requested = false;
+        try {
+            onFrame.accept(force);
+        } finally {
+            // Queued behind the repaint, so this runs once the frame is on screen
+            SwingUtilities.invokeLater(
+                    () -> {
+                        pending.set(false);
+                        adapt(System.nanoTime() - started, skipped, period);
+                    });
+        }
+    }
+
+    /** Drop to a lower rate when frames overrun, and step back up once they are cheap again. */
+    private void adapt(long workNanos, int skipped, long period) {
+        windowWorkNanos += workNanos;
+        windowDropped += skipped;
+        if (++windowFrames < ADAPT_WINDOW) {
+            return;
+        }
+        double meanWork = windowWorkNanos / (double) windowFrames;
+        boolean overrun = meanWork > FRAME_BUDGET * period || windowDropped > ADAPT_WINDOW / 4;
+        windowWorkNanos = 0;
+        windowFrames = 0;
+        windowDropped = 0;
+
+        synchronized (this) {
+            if (task == null) {
+                return;
+            }
+            int next = divisor;
+            if (overrun && divisor < MAX_DIVISOR) {
+                next = divisor + 1;
+            } else if (!overrun && divisor > 1) {
+                // Step up only with room to spare at the faster rate
+                long faster = refreshPeriodNanos * (divisor - 1);
+                next = meanWork < FRAME_BUDGET * faster / 2 ? divisor - 1 : divisor;
+            }
+            long refresh = TimeUnit.SECONDS.toNanos(1) / refreshRate();
+            if (next == divisor && refresh == refreshPeriodNanos) {
+                return;
+            }
+            task.cancel(false);
+            refreshPeriodNanos = refresh;
+            divisor = next;
+            schedule();
+            log.debug(
+                    "Frame rate now {} Hz (mean frame {} ms)",
+                    Math.round(1e9 / periodNanos()),
+                    String.format("%.2f", meanWork / 1e6));
+        }
+    }
+
+    /** Refresh rate of the component's screen, or the fallback if unknown. */
+    private int refreshRate() {
+        if (GraphicsEnvironment.isHeadless()) {
+            return FALLBACK_REFRESH_HZ;
+        }
+        Component c = component.get();
+        GraphicsConfiguration gc = c != null ? c.getGraphicsConfiguration() : null;
+        DisplayMode mode =
+                gc != null
+                        ? gc.getDevice().getDisplayMode()
+                        : GraphicsEnvironment.getLocalGraphicsEnvironment()
+                                .getDefaultScreenDevice()
+                                .getDisplayMode();
+        int hz = mode != null ? mode.getRefreshRate() : DisplayMode.REFRESH_RATE_UNKNOWN;
+        return hz > 0 ? hz : FALLBACK_REFRESH_HZ;
+    }
+}
@@ -1,46 +1,97 @@
 package ui.viewport;
 
+import core.telemetry.CompositeEvent;
+import core.telemetry.PerformanceTelemetry;
+import core.viewport.FrameClock;
 import core.viewport.ViewportPaintingDataSource;
 import core.viewport.ViewportPaintingDataSource.ViewportRenderSpec;
 import core.waveform.ScreenDimension;
+import core.waveform.WaveformTileSet;
 import core.waveform.WaveformViewport;
 import jakarta.inject.Inject;
 import java.awt.Color;
+import java.awt.Component;
+import java.awt.Font;
+import java.awt.FontMetrics;
 import java.awt.Graphics2D;
 import java.awt.Image;
 import java.awt.RenderingHints;
 import java.util.concurrent.TimeUnit;
 import javax.swing.SwingUtilities;
-import javax.swing.Timer;
 import lombok.NonNull;
 import lombok.extern.slf4j.Slf4j;
 
 /**
- * Paints waveform display components with configurable refresh rate. Handles rendering of waveform
+ * Paints waveform display components at the display's refresh rate. Handles rendering of waveform
  * image, playback cursor, and status messages.
+ *
+ * <p>Frames come from a {@link FrameScheduler}, which also takes repaint requests (such as a
+ * finished tile render) so they are served by the next frame instead of painting on their own.
+ *
+ * <p>Painting is split into a static layer (the waveform tiles with their time scale, kept in a
+ * {@link WaveformLayer} and scrolled in place during playback) and an overlay (reference line and
+ * playhead) drawn over it each paint. Each frame builds the next render spec and repaints only
+ * when the frame it describes differs from the one on screen, so a paused or idle viewport costs no
+ * painting at all; the spec is handed to the paint it triggers rather than built twice.
+ *
+ * <p>Each paint is timed as a {@link CompositeEvent}. When {@link PerformanceTelemetry} has its
+ * overlay switched on, the painter draws the telemetry's figures over the top-left corner and
+ * repaints at least every {@link #OVERLAY_REFRESH_NANOS} to keep them current.
  */
 @Slf4j
 public final class ViewportPainter {
 
+    /** Frame rate when the display's refresh rate is unknown. */
     public static final int FPS = 60;
+
     private static final int RENDER_TIMEOUT_MS = 750;
-    private final Timer repaintTimer;
+
+    private static final long OVERLAY_REFRESH_NANOS = TimeUnit.MILLISECONDS.toNanos(500);
+    private static final Font OVERLAY_FONT = new Font(Font.MONOSPACED, Font.PLAIN, 11);
+    private static final Color OVERLAY_BACKGROUND = new Color(0, 0, 0, 170);
+
+    private final FrameClock frameClock;
+    private final PerformanceTelemetry telemetry;
+    private final FrameScheduler frameScheduler;
+    private final WaveformLayer waveformLayer = new WaveformLayer(new WaveformTileRing());
     private volatile WaveformViewport viewport;
     private volatile ViewportPaintingDataSource dataSource;
     private volatile String lastSpecId = null;
     private volatile long lastGeneration = -1;
 
+    // What the screen shows, and the spec a frame built for the repaint it requested (EDT only)
+    private Frame painted;
+    private ViewportRenderSpec pendingSpec;
+    private ScreenDimension pendingBounds;
+
+    // Overlay text and when it was gathered, or null while the overlay is off (EDT only)
+    private String[] overlayLines;
+    private long overlayGatheredNanos;
+
+    /** The visible outcome of painting a spec, for deciding whether a frame needs a repaint. */
+    private record Frame(
+            String specId, @NonNull ScreenDimension bounds, boolean ready, boolean preview) {
+        static Frame of(@NonNull ViewportRenderSpec ctx, @NonNull ScreenDimension bounds) {
+            return new Frame(
+                    ctx.specId(), bounds, ctx.tiles().isDone(), ctx.preview().isPresent());
+        }
+    }
+
     /** Create a painter with dependency injection. */
     @Inject
-    public ViewportPainter() {
+    public ViewportPainter(
+            @NonNull FrameClock frameClock, @NonNull PerformanceTelemetry telemetry) {
         this.viewport = null;
         this.dataSource = null;
-        this.repaintTimer =
-                new Timer(
-                        1000 / FPS,
-                        _ -> {
+        this.frameClock = frameClock;
+        this.telemetry = telemetry;
+        this.frameScheduler =
+                new FrameScheduler(
+                        frameClock,
+                        () -> viewport instanceof Component c ? c : null,
+                        force -> {
                             if (viewport != null && viewport.isVisible()) {
-                                viewport.repaint();
+                                onFrame(force);
                             }
                         });
     }
@@ -55,19 +106,47 @@ public final class ViewportPainter {
         this.dataSource = dataSource;
     }
 
-    /** Start the repaint timer. */
+    /** Start delivering frames. */
     public void start() {
-        repaintTimer.start();
+        frameScheduler.start();
     }
 
-    /** Stop the repaint timer. */
+    /** Stop delivering frames. */
     public void stop() {
-        repaintTimer.stop();
+        frameScheduler.stop();
     }
 
-    /** Check if timer is running. */
+    /** Check if frames are being delivered. */
     public boolean isRunning() {
-        return repaintTimer.isRunning();
+        return frameScheduler.isRunning();
+    }
+
+    /** Ask for a repaint on the next frame, or right away if frames are not being delivered. */
+    public void requestFrame() {
+        if (frameScheduler.isRunning()) {
+            frameScheduler.requestFrame();
+        } else if (viewport != null) {
+            viewport.repaint();
+        }
+    }
+
+    /** Frame: repaint if requested, or if the next frame would differ from the one on screen. */
+    private void onFrame(boolean force) {
+        FrameClock.Frame frame = frameClock.currentFrame();
+        telemetry.recordFrame(frame != null ? frame.droppedFrames() : 0);
+        force |= overlayDue();
+        if (dataSource == null) {
+            viewport.repaint();
+            return;
+        }
+        ScreenDimension bounds = viewport.getViewportBounds();
+        ViewportRenderSpec ctx = dataSource.getRenderSpec(bounds);
+        if (!force && Frame.of(ctx, bounds).equals(painted)) {
+            return;
+        }
+        pendingSpec = ctx;
+        pendingBounds = bounds;
+        viewport.repaint();
     }
 
     /** Suggest a paint during the viewport's paint cycle. */
@@ -84,7 +163,64 @@ public final class ViewportPainter {
             return;
         }
 
+        var event = new CompositeEvent();
+        event.start();
         paint(g);
+        ScreenDimension bounds = viewport.getViewportBounds();
+        event.widthPx = bounds.width();
+        event.heightPx = bounds.height();
+        event.finish();
+
+        if (telemetry.isOverlayVisible()) {
+            paintPerformanceOverlay(g, bounds);
+        } else {
+            overlayLines = null;
+        }
+    }
+
+    /** Whether the overlay was switched on or off, or its figures are due for a refresh. */
+    private boolean overlayDue() {
+        boolean visible = telemetry.isOverlayVisible();
+        if (visible != (overlayLines != null)) {
+            return true;
+        }
+        return visible && System.nanoTime() - overlayGatheredNanos >= OVERLAY_REFRESH_NANOS;
+    }
+
+    /** Paint the telemetry figures in a translucent box at the top left. */
+    private void paintPerformanceOverlay(@NonNull Graphics2D g, @NonNull ScreenDimension bounds) {
+        long now = System.nanoTime();
+        if (overlayLines == null || now - overlayGatheredNanos >= OVERLAY_REFRESH_NANOS) {
+            String[] figures = PerformanceTelemetry.overlayLines(telemetry.snapshot());
+            FrameClock.Frame frame = frameClock.currentFrame();
+            String rate =
+                    frame != null && frame.periodNanos() > 0
+                            ? String.format("refresh   %.0f Hz", 1e9 / frame.periodNanos())
+                            : "refresh   not scheduled";
+            overlayLines = new String[figures.length + 1];
+            overlayLines[0] = rate;
+            System.arraycopy(figures, 0, overlayLines, 1, figures.length);
+            overlayGatheredNanos = now;
+        }
+
+        g.setPaintMode();
+        g.setFont(OVERLAY_FONT);
+        FontMetrics metrics = g.getFontMetrics();
+        int width = 0;
+        for (String line : overlayLines) {
+            width = Math.max(width, metrics.stringWidth(line));
+        }
+        int padding = 4;
+        int lineHeight = metrics.getHeight();
+        int x = bounds.x() + padding;
+        int y = bounds.y() + padding;
+        g.setColor(OVERLAY_BACKGROUND);
+        g.fillRect(x, y, width + 2 * padding, overlayLines.length * lineHeight + 2 * padding);
+        g.setColor(Color.WHITE);
+        int baseline = y + padding + metrics.getAscent();
+        for (int i = 0; i < overlayLines.length; i++) {
+            g.drawString(overlayLines[i], x + padding, baseline + i * lineHeight);
+        }
     }
 
     /** Main paint orchestration: query data source, render, and draw. */
@@ -93,25 +229,25 @@ public final class ViewportPainter {
             return;
         }
         ScreenDimension bounds = viewport.getViewportBounds();
-        ViewportRenderSpec ctx = dataSource.getRenderSpec(bounds);
+        ViewportRenderSpec ctx =
+                pendingSpec != null && bounds.equals(pendingBounds)
+                        ? pendingSpec
+                        : dataSource.getRenderSpec(bounds);
+        pendingSpec = null;
+        pendingBounds = null;
+        painted = Frame.of(ctx, bounds);
 
         // Skip repaint if spec hasn't changed (for RENDER mode only)
         if (ctx.mode() == ViewportPaintingDataSource.PaintMode.RENDER) {
             String currentSpecId = ctx.specId();
             if (currentSpecId != null && currentSpecId.equals(lastSpecId)) {
                 // Check if the future is complete - if so, we can still paint
-                if (ctx.image().isDone()) {
+                if (ctx.tiles().isDone()) {
                     try {
-                        Image image = ctx.image().getNow(null);
-                        if (image != null) {
+                        WaveformTileSet tiles = ctx.tiles().getNow(null);
+                        if (tiles != null) {
                             log.trace("Avoiding repaint - spec unchanged: {}", currentSpecId);
-                            paintWaveform(
-                                    g,
-                                    bounds.x(),
-                                    bounds.y(),
-                                    bounds.width(),
-                                    bounds.height(),
-                                    image);
+                            paintTiles(g, bounds, tiles);
                             paintReferenceLine(g, bounds);
                             paintPlayhead(g, bounds);
                         }
@@ -122,6 +258,7 @@ public final class ViewportPainter {
                     log.trace(
                             "Avoiding repaint - spec unchanged and image still rendering: {}",
                             currentSpecId);
+                    paintPreview(g, bounds, ctx);
                 }
                 return; // Skip redundant repaint
             }
@@ -152,18 +289,12 @@ public final class ViewportPainter {
                     lastGeneration = currentGeneration;
                 }
 
-                var future = ctx.image();
+                var future = ctx.tiles();
                 if (future.isDone()) {
                     try {
-                        Image image = future.getNow(null);
-                        if (image != null) {
-                            paintWaveform(
-                                    g,
-                                    bounds.x(),
-                                    bounds.y(),
-                                    bounds.width(),
-                                    bounds.height(),
-                                    image);
+                        WaveformTileSet tiles = future.getNow(null);
+                        if (tiles != null) {
+                            paintTiles(g, bounds, tiles);
                             // Only draw reference line and playhead when waveform is ready
                             paintReferenceLine(g, bounds);
                             paintPlayhead(g, bounds);
@@ -171,6 +302,8 @@ public final class ViewportPainter {
                     } catch (Exception e) {
                     }
                 } else {
+                    paintPreview(g, bounds, ctx);
+
                     // Non-blocking: schedule a repaint when rendering completes (with timeout)
                     // completeOnTimeout will cancel the original future if it times out
                     var repaintFuture = future.orTimeout(RENDER_TIMEOUT_MS, TimeUnit.MILLISECONDS);
@@ -183,7 +316,7 @@ public final class ViewportPainter {
                                                 // to fix waveform disappearing during playback
                                                 // TODO: Re-enable with smarter logic that allows
                                                 // slightly stale renders during continuous playback
-                                                viewport.repaint();
+                                                requestFrame();
                                                 if (ex != null) {
                                                     // Check if it's a timeout or cancellation
                                                     if (ex
@@ -213,6 +346,34 @@ public final class ViewportPainter {
         }
     }
 
+    /** Paint the spec's stand-in image, if it has one, while the exact image renders. */
+    private void paintPreview(
+            @NonNull Graphics2D g,
+            @NonNull ScreenDimension bounds,
+            @NonNull ViewportRenderSpec ctx) {
+        ctx.preview()
+                .ifPresent(
+                        preview -> {
+                            paintWaveform(
+                                    g,
+                                    bounds.x(),
+                                    bounds.y(),
+                                    bounds.width(),
+                                    bounds.height(),
+                                    preview);
+                            paintReferenceLine(g, bounds);
+                            paintPlayhead(g, bounds);
+                        });
+    }
+
+    /** Paint the waveform's static layer at the bounds' origin. */
+    public void paintTiles(
+            @NonNull Graphics2D g,
+            @NonNull ScreenDimension bounds,
+            @NonNull WaveformTileSet tiles) {
+        waveformLayer.paint(g, bounds.x(), bounds.y(), tiles);
+    }
+
     /** Paint the waveform image within the given bounds. */
     public void paintWaveform(
             @NonNull Graphics2D g,
@@ -0,0 +1,122 @@
+package ui.viewport;
+
+import core.waveform.WaveformTileSet;
+import java.awt.Graphics2D;
+import java.awt.GraphicsConfiguration;
+import java.awt.Transparency;
+import java.awt.image.VolatileImage;
+import java.util.OptionalInt;
+import lombok.NonNull;
+
+/**
+ * The viewport's static layer: the waveform tiles (with their time scale) composited into one
+ * accelerated surface the size of the viewport, kept between frames.
+ *
+ * <p>An unchanged tile set is blitted as is. When the tiles only scrolled (same zoom and height,
+ * the same images where old and new overlap), the layer is shifted in place with {@code copyArea}
+ * and only the newly exposed strip is drawn, so a playback frame touches a strip as wide as the
+ * scroll step. Anything else redraws the layer from the {@link WaveformTileRing}.
+ *
+ * <p>Used on the EDT only.
+ */
+final class WaveformLayer {
+
+    // Attempts to draw through the surface before a frame falls back to the tiles
+    private static final int MAX_ATTEMPTS = 2;
+
+    private final WaveformTileRing tileRing;
+    private VolatileImage surface;
+    private WaveformTileSet drawn;
+
+    WaveformLayer(@NonNull WaveformTileRing tileRing) {
+        this.tileRing = tileRing;
+    }
+
+    /** Bring the layer up to date with {@code tiles} and draw it at {@code x, y}. */
+    void paint(@NonNull Graphics2D g, int x, int y, @NonNull WaveformTileSet tiles) {
+        GraphicsConfiguration gc = g.getDeviceConfiguration();
+        if (gc == null || tiles.widthPx() <= 0 || tiles.heightPx() <= 0) {
+            tileRing.paint(g, x, y, tiles);
+            return;
+        }
+
+        for (int attempt = 0; attempt < MAX_ATTEMPTS; attempt++) {
+            boolean sized =
+                    surface != null
+                            && surface.getWidth() == tiles.widthPx()
+                            && surface.getHeight() == tiles.heightPx();
+            int status = sized ? surface.validate(gc) : VolatileImage.IMAGE_INCOMPATIBLE;
+            if (status == VolatileImage.IMAGE_INCOMPATIBLE) {
+                invalidate();
+                surface =
+                        gc.createCompatibleVolatileImage(
+                                tiles.widthPx(), tiles.heightPx(), Transparency.OPAQUE);
+                surface.validate(gc);
+            } else if (status == VolatileImage.IMAGE_RESTORED) {
+                drawn = null;
+            }
+
+            update(tiles);
+            g.drawImage(surface, x, y, null);
+            if (!surface.contentsLost()) {
+                return;
+            }
+            drawn = null;
+        }
+        // The surface keeps getting lost; draw this frame without it
+        tileRing.paint(g, x, y, tiles);
+    }
+
+    /** Forget the layer's contents and release its surface. */
+    void invalidate() {
+        if (surface != null) {
+            surface.flush();
+            surface = null;
+        }
+        drawn = null;
+    }
+
+    private void update(@NonNull WaveformTileSet tiles) {
+        if (tiles.equals(drawn)) {
+            return;
+        }
+        Graphics2D g = surface.createGraphics();
+        try {
+            OptionalInt shift = drawn == null ? OptionalInt.empty() : shiftable(drawn, tiles);
+            int dx = shift.orElse(0);
+            if (shift.isPresent() && Math.abs(dx) < tiles.widthPx()) {
+                // Move what is still in view, then draw only the strip that scrolled in
+                g.copyArea(0, 0, tiles.widthPx(), tiles.heightPx(), dx, 0);
+                int stripX = dx > 0 ? 0 : tiles.widthPx() + dx;
+                g.clipRect(stripX, 0, Math.abs(dx), tiles.heightPx());
+            }
+            tileRing.paint(g, 0, 0, tiles);
+        } finally {
+            g.dispose();
+        }
+        drawn = tiles;
+    }
+
+    /**
+     * The shift from {@code previous} to {@code next} if the layer can be scrolled rather than
+     * redrawn: same zoom and height, and every segment in both sets is the same image in both.
+     */
+    private static OptionalInt shiftable(
+            @NonNull WaveformTileSet previous, @NonNull WaveformTileSet next) {
+        OptionalInt shift = next.shiftFrom(previous);
+        if (shift.isEmpty() || previous.widthPx() != next.widthPx()) {
+            return OptionalInt.empty();
+        }
+        long first = Math.max(previous.firstIndex(), next.firstIndex());
+        long last =
+                Math.min(
+                        previous.firstIndex() + previous.tiles().size(),
+                        next.firstIndex() + next.tiles().size());
+        for (long index = first; index < last; index++) {
+            if (previous.tileAt(index) != next.tileAt(index)) {
+                return OptionalInt.empty();
+            }
+        }
+        return shift;
+    }
+}
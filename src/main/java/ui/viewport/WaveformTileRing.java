@@ -0,0 +1,151 @@
+package ui.viewport;
+
+import core.waveform.WaveformTileSet;
+import java.awt.AlphaComposite;
+import java.awt.Graphics2D;
+import java.awt.GraphicsConfiguration;
+import java.awt.Image;
+import java.awt.Transparency;
+import java.awt.image.VolatileImage;
+import java.util.ArrayDeque;
+import java.util.Deque;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.Map;
+import lombok.NonNull;
+
+/**
+ * Screen-side copies of waveform tiles in accelerated {@link VolatileImage} surfaces, so each
+ * frame blits the visible tiles from video memory instead of compositing a viewport image.
+ *
+ * <p>Tiles are keyed by their segment image, which the segment cache keeps while the segment is
+ * cached. While the viewport scrolls only newly exposed tiles are uploaded; the ring holds the
+ * visible tiles plus a couple either side, and surfaces of evicted tiles are reused for new ones.
+ * Lost surfaces (display change, GPU reset) are re-uploaded from their tile on the next paint.
+ *
+ * <p>Used on the EDT only.
+ */
+final class WaveformTileRing {
+
+    // Kept beyond the visible tiles, so a tile scrolled just off screen survives a step back
+    private static final int SPARE_TILES = 2;
+
+    // Upload or blit attempts before falling back to the tile image itself
+    private static final int MAX_ATTEMPTS = 2;
+
+    private final Map<Image, VolatileImage> surfaces = new LinkedHashMap<>(16, 0.75f, true);
+    private final Deque<VolatileImage> free = new ArrayDeque<>();
+    private GraphicsConfiguration configuration;
+    private int tileHeight = -1;
+
+    /** Uploads since creation, i.e. tiles that were not already on the screen side. */
+    private long uploads;
+
+    /** Draw the tiles' background and every tile with its left edge at {@code x}. */
+    void paint(@NonNull Graphics2D g, int x, int y, @NonNull WaveformTileSet tiles) {
+        GraphicsConfiguration gc = g.getDeviceConfiguration();
+        if (gc == null) {
+            tiles.paint(g, x, y);
+            return;
+        }
+        if (gc != configuration) {
+            // Surfaces belong to one device; start over on another screen
+            flush();
+            configuration = gc;
+        }
+
+        g.setColor(WaveformTileSet.BACKGROUND);
+        g.fillRect(x, y, tiles.widthPx(), tiles.heightPx());
+        int capacity = tiles.tiles().size() + SPARE_TILES;
+        for (int i = 0; i < tiles.tiles().size() && tiles.tileX(i) < tiles.widthPx(); i++) {
+            Image tile = tiles.tiles().get(i);
+            if (tile != null) {
+                blit(g, tile, x + tiles.tileX(i), y + tiles.tileY(tile));
+            }
+        }
+        trimTo(capacity);
+    }
+
+    /** Release every surface. */
+    void flush() {
+        surfaces.values().forEach(VolatileImage::flush);
+        surfaces.clear();
+        free.forEach(VolatileImage::flush);
+        free.clear();
+        tileHeight = -1;
+    }
+
+    /** Number of tiles copied to a surface so far. */
+    long uploads() {
+        return uploads;
+    }
+
+    private void blit(@NonNull Graphics2D g, @NonNull Image tile, int x, int y) {
+        int width = tile.getWidth(null);
+        int height = tile.getHeight(null);
+        if (height != tileHeight) {
+            // Height changed: every surface has the wrong size
+            flush();
+            tileHeight = height;
+        }
+
+        VolatileImage surface = surfaces.get(tile);
+        boolean fresh = surface == null;
+        if (fresh) {
+            surface = free.isEmpty() ? create(width, height) : free.pop();
+            surfaces.put(tile, surface);
+        }
+
+        for (int attempt = 0; attempt < MAX_ATTEMPTS; attempt++) {
+            int status = surface.validate(configuration);
+            if (status == VolatileImage.IMAGE_INCOMPATIBLE) {
+                surface.flush();
+                surface = create(width, height);
+                surfaces.put(tile, surface);
+                fresh = true;
+            }
+            if (fresh || status != VolatileImage.IMAGE_OK) {
+                upload(tile, surface);
+                fresh = false;
+            }
+            g.drawImage(surface, x, y, null);
+            if (!surface.contentsLost()) {
+                return;
+            }
+            fresh = true;
+        }
+        // The surface keeps getting lost; draw from the tile this frame
+        g.drawImage(tile, x, y, null);
+    }
+
+    private VolatileImage create(int width, int height) {
+        return configuration.createCompatibleVolatileImage(
+                width, height, Transparency.TRANSLUCENT);
+    }
+
+    private void upload(@NonNull Image tile, @NonNull VolatileImage surface) {
+        Graphics2D g = surface.createGraphics();
+        try {
+            // Replace, not blend: the tile's transparent tail must stay transparent
+            g.setComposite(AlphaComposite.Src);
+            g.drawImage(tile, 0, 0, null);
+        } finally {
+            g.dispose();
+        }
+        uploads++;
+    }
+
+    /** Evict the least recently drawn tiles beyond {@code capacity}, keeping their surfaces. */
+    private void trimTo(int capacity) {
+        Iterator<VolatileImage> it = surfaces.values().iterator();
+        while (surfaces.size() > capacity && it.hasNext()) {
+            VolatileImage surface = it.next();
+            it.remove();
+            if (free.size() < SPARE_TILES) {
+                free.push(surface);
+            } else {
+                surface.flush();
+            }
+        }
+    }
+}
@@ -1,7 +1,9 @@
 package ui.wordpool;
 
-import core.util.IndexedUniqueList;
 import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Comparator;
+import java.util.HashMap;
 import java.util.HashSet;
 import java.util.List;
 import java.util.Locale;
@@ -11,150 +13,137 @@ import javax.swing.event.ListDataListener;
 import org.slf4j.Logger;
 import org.slf4j.LoggerFactory;
 
-/** Custom list model for the <code>WordpoolList</code>. */
+/**
+ * Custom list model for the <code>WordpoolList</code>.
+ *
+ * <p>Words are held in a hash map by text, and in two arrays sorted by text: the lst words and the
+ * rest. The words on display are those starting with the current filter prefix (the contents of
+ * the <code>WordpoolTextField</code>), lst words first, so they are one contiguous range of each
+ * array, found by binary search. Typing in the field therefore costs two searches instead of a
+ * scan of the pool, and the list view only asks for the rows it paints.
+ */
 // This class assumes that the ListDataListener (often javax.swing.plaf.basic.BasicListUI$Handler by
 // default),
 // will repaint the WordpoolList after ListDataEvents>.
 public class WordpoolListModel implements ListModel<WordpoolWord> {
     private static final Logger logger = LoggerFactory.getLogger(WordpoolListModel.class);
 
-    private final IndexedUniqueList<WordpoolWord> collection;
+    private static final Comparator<WordpoolWord> BY_TEXT =
+            Comparator.comparing(WordpoolWord::getText);
+    private static final WordpoolWord[] NO_WORDS = new WordpoolWord[0];
 
+    private final HashMap<String, WordpoolWord> words;
     private final HashSet<ListDataListener> listeners;
-    private final HashSet<WordpoolWord> hiddenWords;
+
+    // Every word sorted by text, and the same words split by lst status
+    private WordpoolWord[] byText = NO_WORDS;
+    private WordpoolWord[] lstWords = NO_WORDS;
+    private WordpoolWord[] otherWords = NO_WORDS;
+
+    // Words shown: lstWords[lstFrom, lstTo) then otherWords[otherFrom, otherTo)
+    private String prefix = "";
+    private int lstFrom;
+    private int lstTo;
+    private int otherFrom;
+    private int otherTo;
 
     public WordpoolListModel() {
         super();
-        collection = new IndexedUniqueList<WordpoolWord>();
-        hiddenWords = new HashSet<WordpoolWord>();
+        words = new HashMap<String, WordpoolWord>();
         listeners = new HashSet<ListDataListener>();
     }
 
     @Override
     public WordpoolWord getElementAt(int index) {
-        if (index < 0 || index >= collection.size()) {
+        if (index < 0 || index >= getSize()) {
             throw new IllegalArgumentException("index not in wordpool list: " + index);
         }
-        return collection.get(index);
+        int lstCount = lstTo - lstFrom;
+        return index < lstCount
+                ? lstWords[lstFrom + index]
+                : otherWords[otherFrom + index - lstCount];
     }
 
     @Override
     public int getSize() {
-        return collection.size();
+        return (lstTo - lstFrom) + (otherTo - otherFrom);
     }
 
+    /**
+     * Adds words to the pool, skipping any whose text is already present. Words not matching the
+     * current filter prefix are added hidden.
+     *
+     * @param words The words to add
+     */
     public void addElements(Iterable<WordpoolWord> words) {
         // Clear text will be handled by caller when needed
+        List<WordpoolWord> added = new ArrayList<WordpoolWord>();
         for (WordpoolWord w : words) {
             if (w.getNum() < 0) {
                 logger.warn("adding wordpool words with negative line numbers is not allowed");
                 continue;
             }
-            if (!collection.contains(w) && !hiddenWords.contains(w)) {
-                collection.add(w);
+            if (this.words.putIfAbsent(w.getText(), w) == null) {
+                added.add(w);
             }
         }
-        collection.sort();
-
-        ListDataEvent e =
-                new ListDataEvent(this, ListDataEvent.CONTENTS_CHANGED, 0, collection.size());
-        for (ListDataListener ldl : listeners) {
-            ldl.contentsChanged(e);
+        if (!added.isEmpty()) {
+            added.sort(BY_TEXT);
+            byText = merge(byText, added);
+            partition();
         }
+        fireContentsChanged();
     }
 
     protected void removeAllWords() {
-        hiddenWords.clear();
-        collection.clear();
-        ListDataEvent e =
-                new ListDataEvent(this, ListDataEvent.CONTENTS_CHANGED, 0, collection.size());
-        for (ListDataListener ldl : listeners) {
-            ldl.contentsChanged(e);
-        }
+        words.clear();
+        byText = NO_WORDS;
+        partition();
+        fireContentsChanged();
     }
 
     protected void distinguishAsLst(List<WordpoolWord> lstWords) {
-        for (WordpoolWord w : hiddenWords) {
-            for (WordpoolWord lst : lstWords) {
-                if (lst.equals(w)) {
-                    w.setLst(true);
-                }
+        for (WordpoolWord lst : lstWords) {
+            WordpoolWord w = words.get(lst.getText());
+            if (w != null) {
+                w.setLst(true);
             }
         }
-        for (WordpoolWord w : collection) {
-            for (WordpoolWord lst : lstWords) {
-                if (lst.equals(w)) {
-                    w.setLst(true);
-                }
-            }
-        }
-        ListDataEvent e =
-                new ListDataEvent(this, ListDataEvent.CONTENTS_CHANGED, 0, collection.size());
-        collection.sort();
-        for (ListDataListener ldl : listeners) {
-            ldl.contentsChanged(e);
-        }
+        partition();
+        fireContentsChanged();
     }
 
     protected void undistinguishAllWords() {
-        for (WordpoolWord w : hiddenWords) {
-            w.setLst(false);
-        }
-        for (WordpoolWord w : collection) {
+        for (WordpoolWord w : byText) {
             w.setLst(false);
         }
-        collection.sort();
-        ListDataEvent e =
-                new ListDataEvent(this, ListDataEvent.CONTENTS_CHANGED, 0, collection.size());
-        for (ListDataListener ldl : listeners) {
-            ldl.contentsChanged(e);
-        }
+        partition();
+        fireContentsChanged();
     }
 
+    /**
+     * Narrows the display to the words starting with <code>prefix</code>, which the field's text
+     * has grown to.
+     *
+     * @param prefix The text field's contents
+     */
     protected void hideWordsStartingWith(String prefix) {
-        ArrayList<WordpoolWord> toRemove = new ArrayList<WordpoolWord>();
-        for (int i = 0; i < collection.size(); i++) {
-            WordpoolWord w = collection.get(i);
-            if (!w.getText().toUpperCase(Locale.ROOT).startsWith(prefix.toUpperCase(Locale.ROOT))) {
-                toRemove.add(w);
-                hiddenWords.add(w);
-            }
-        }
-        collection.removeAll(toRemove);
-
-        ListDataEvent e =
-                new ListDataEvent(this, ListDataEvent.CONTENTS_CHANGED, 0, collection.size());
-        for (ListDataListener ldl : listeners) {
-            ldl.contentsChanged(e);
-        }
+        filter(prefix);
     }
 
+    /**
+     * Widens the display to the words starting with <code>prefix</code>, which the field's text
+     * has shrunk to.
+     *
+     * @param prefix The text field's contents
+     */
     protected void restoreWordsStartingWith(String prefix) {
-        for (Object o : hiddenWords.toArray()) {
-            WordpoolWord w = (WordpoolWord) o;
-            if (w.getText().toUpperCase(Locale.ROOT).startsWith(prefix.toUpperCase(Locale.ROOT))) {
-                collection.add(w);
-                hiddenWords.remove(w);
-            }
-        }
-
-        collection.sort();
-
-        ListDataEvent e =
-                new ListDataEvent(this, ListDataEvent.CONTENTS_CHANGED, 0, collection.size());
-        for (ListDataListener ldl : listeners) {
-            ldl.contentsChanged(e);
-        }
+        filter(prefix);
     }
 
     protected WordpoolWord findMatchingWordpoolWord(String str) {
-        for (int i = 0; i < collection.size(); i++) {
-            WordpoolWord w = collection.get(i);
-            if (w.getText().equals(str)) {
-                return w;
-            }
-        }
-        return null;
+        WordpoolWord w = words.get(str);
+        return w != null && w.getText().startsWith(prefix) ? w : null;
     }
 
     /** {@inheritDoc} */
@@ -168,4 +157,97 @@ public class WordpoolListModel implements ListModel<WordpoolWord> {
     public void removeListDataListener(ListDataListener l) {
         listeners.remove(l);
     }
+
+    private void filter(String prefix) {
+        String upper = prefix.toUpperCase(Locale.ROOT);
+        if (upper.equals(this.prefix)) {
+            return;
+        }
+        this.prefix = upper;
+        updateRanges();
+        fireContentsChanged();
+    }
+
+    /** Splits <code>byText</code> by lst status, keeping each part in text order. */
+    private void partition() {
+        int lstCount = 0;
+        for (WordpoolWord w : byText) {
+            if (w.isLst()) {
+                lstCount++;
+            }
+        }
+        lstWords = new WordpoolWord[lstCount];
+        otherWords = new WordpoolWord[byText.length - lstCount];
+        int l = 0;
+        int o = 0;
+        for (WordpoolWord w : byText) {
+            if (w.isLst()) {
+                lstWords[l++] = w;
+            } else {
+                otherWords[o++] = w;
+            }
+        }
+        updateRanges();
+    }
+
+    private void updateRanges() {
+        lstFrom = firstAtLeast(lstWords, prefix);
+        lstTo = endOfPrefix(lstWords, lstFrom, prefix);
+        otherFrom = firstAtLeast(otherWords, prefix);
+        otherTo = endOfPrefix(otherWords, otherFrom, prefix);
+    }
+
+    /** First index whose text sorts at or after <code>text</code>. */
+    private static int firstAtLeast(WordpoolWord[] sorted, String text) {
+        int low = 0;
+        int high = sorted.length;
+        while (low < high) {
+            int mid = (low + high) >>> 1;
+            if (sorted[mid].getText().compareTo(text) < 0) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    /**
+     * End of the run of words starting with <code>prefix</code> that begins at <code>from</code>;
+     * words sharing a prefix are adjacent in text order.
+     */
+    private static int endOfPrefix(WordpoolWord[] sorted, int from, String prefix) {
+        int low = from;
+        int high = sorted.length;
+        while (low < high) {
+            int mid = (low + high) >>> 1;
+            if (sorted[mid].getText().startsWith(prefix)) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    private static WordpoolWord[] merge(WordpoolWord[] sorted, List<WordpoolWord> added) {
+        WordpoolWord[] result = Arrays.copyOf(sorted, sorted.length + added.size());
+        int i = sorted.length - 1;
+        int j = added.size() - 1;
+        for (int k = result.length - 1; j >= 0; k--) {
+            if (i >= 0 && BY_TEXT.compare(sorted[i], added.get(j)) > 0) {
+                result[k] = sorted[i--];
+            } else {
+                result[k] = added.get(j--);
+            }
+        }
+        return result;
+    }
+
+    private void fireContentsChanged() {
+        ListDataEvent e = new ListDataEvent(this, ListDataEvent.CONTENTS_CHANGED, 0, getSize());
+        for (ListDataListener ldl : listeners) {
+            ldl.contentsChanged(e);
+        }
+    }
 }
@@ -0,0 +1,184 @@
+package app.headless;
+
+import static org.junit.jupiter.api.Assertions.*;
+import static org.mockito.ArgumentMatchers.anyBoolean;
+import static org.mockito.ArgumentMatchers.anyString;
+import static org.mockito.ArgumentMatchers.eq;
+import static org.mockito.Mockito.mock;
+import static org.mockito.Mockito.when;
+
+import core.audio.AudioData;
+import core.audio.AudioMetadata;
+import core.audio.SampleReader;
+import core.audio.fmod.FmodStreamingSampleReader;
+import core.env.AppConfig;
+import core.env.Platform;
+import core.env.UserHomeProvider;
+import core.waveform.PeakPyramidStore;
+import core.waveform.signal.WaveformProcessor;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.List;
+import java.util.Set;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.atomic.AtomicLong;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+@DisplayName("BatchPrecompute")
+class BatchPrecomputeTest {
+
+    private static final int SAMPLE_RATE = 8000;
+    private static final double DURATION_SECONDS = 30;
+    private static final long FRAMES = (long) (DURATION_SECONDS * SAMPLE_RATE);
+
+    @TempDir Path tempDir;
+
+    private PeakPyramidStore store;
+    private final AtomicLong framesRead = new AtomicLong();
+    private final AtomicInteger readersOpen = new AtomicInteger();
+    private final AtomicInteger readersCreated = new AtomicInteger();
+    private final Set<Path> decoding = ConcurrentHashMap.newKeySet();
+    private final AtomicInteger maxDecoding = new AtomicInteger();
+
+    /** Mono tone whose amplitude is the file name's digit over ten, e.g. 0.3 for "3.wav". */
+    private final class ToneReader implements SampleReader {
+        ToneReader() {
+            readersCreated.incrementAndGet();
+            readersOpen.incrementAndGet();
+        }
+
+        @Override
+        public CompletableFuture<AudioData> readSamples(
+                Path audioFile, long startFrame, long frameCount) {
+            decoding.add(audioFile);
+            maxDecoding.accumulateAndGet(decoding.size(), Math::max);
+            long frames = Math.max(0, Math.min(frameCount, FRAMES - startFrame));
+            framesRead.addAndGet(frames);
+            double amplitude = amplitudeOf(audioFile);
+            double[] samples = new double[(int) frames];
+            for (int i = 0; i < frames; i++) {
+                double t = (startFrame + i) / (double) SAMPLE_RATE;
+                samples[i] = amplitude * Math.sin(2 * Math.PI * 440 * t);
+            }
+            return CompletableFuture.completedFuture(
+                    new AudioData(samples, SAMPLE_RATE, 1, startFrame, frames));
+        }
+
+        @Override
+        public CompletableFuture<AudioMetadata> getMetadata(Path audioFile) {
+            return CompletableFuture.completedFuture(
+                    new AudioMetadata(SAMPLE_RATE, 1, 16, "wav", FRAMES, DURATION_SECONDS));
+        }
+
+        @Override
+        public void release(Path audioFile) {
+            decoding.remove(audioFile);
+        }
+
+        @Override
+        public void close() {
+            readersOpen.decrementAndGet();
+        }
+    }
+
+    private static double amplitudeOf(Path audioFile) {
+        String name = audioFile.getFileName().toString();
+        return (name.charAt(0) - '0') / 10.0;
+    }
+
+    @BeforeEach
+    void setUp() {
+        AppConfig config = mock(AppConfig.class);
+        when(config.getProperty(eq("waveform.sidecar.dir"), anyString()))
+                .thenReturn(tempDir.resolve("sidecars").toString());
+        when(config.getBooleanProperty(anyString(), anyBoolean())).thenReturn(true);
+        store = new PeakPyramidStore(config, new Platform(), new UserHomeProvider());
+    }
+
+    private Path folderOf(int files) throws Exception {
+        Path folder = Files.createDirectories(tempDir.resolve("session"));
+        for (int i = 1; i <= files; i++) {
+            Files.write(folder.resolve(i + ".wav"), new byte[i * 100]);
+        }
+        Files.writeString(folder.resolve("notes.txt"), "not audio");
+        return folder;
+    }
+
+    @Test
+    @DisplayName("should decode each file once and store its pyramid, peak and metadata")
+    void shouldDecodeEachFileOnce() throws Exception {
+        Path folder = folderOf(4);
+        var batch = new BatchPrecompute(store, ToneReader::new, 2, 1L << 30);
+
+        BatchPrecompute.Report report = batch.run(List.of(folder));
+
+        assertEquals(4, report.files().size());
+        assertEquals(4, report.count(BatchPrecompute.Status.DECODED));
+        assertEquals(4 * FRAMES, framesRead.get());
+        for (BatchPrecompute.FileResult file : report.files()) {
+            assertEquals(FRAMES, file.metadata().frameCount());
+            double amplitude = amplitudeOf(file.path());
+            assertEquals(amplitude, file.peak(), 0.2 * amplitude, file.path().toString());
+            var sidecar =
+                    store.loadSidecar(file.path(), WaveformProcessor.PYRAMID_PARAMETERS)
+                            .orElseThrow();
+            assertEquals(file.metadata(), sidecar.metadata());
+            assertEquals(file.peak(), sidecar.pyramid().peak());
+        }
+        assertEquals(4 * DURATION_SECONDS, report.decodedSeconds(), 1e-9);
+        assertTrue(report.realtimeFactor() > 0);
+
+        // A second run finds every sidecar and decodes nothing
+        framesRead.set(0);
+        BatchPrecompute.Report again = batch.run(List.of(folder));
+        assertEquals(4, again.count(BatchPrecompute.Status.CACHED));
+        assertEquals(0, framesRead.get());
+        assertEquals(report.files().get(2).peak(), again.files().get(2).peak(), 1e-6);
+        assertEquals(report.files().get(2).metadata(), again.files().get(2).metadata());
+
+        Path tsv = tempDir.resolve("report.tsv");
+        again.write(tsv);
+        assertEquals(5, Files.readAllLines(tsv).size());
+    }
+
+    @Test
+    @DisplayName("should give each worker its own reader and close them all")
+    void shouldOwnOneReaderPerWorker() throws Exception {
+        Path folder = folderOf(8);
+
+        new BatchPrecompute(store, ToneReader::new, 3, 1L << 30).run(List.of(folder));
+
+        assertTrue(readersCreated.get() >= 1 && readersCreated.get() <= 3);
+        assertEquals(0, readersOpen.get());
+    }
+
+    @Test
+    @DisplayName("should open no more readers than FMOD has systems to spare")
+    void shouldLimitWorkersToFmodSystems() throws Exception {
+        Path folder = folderOf(9);
+
+        BatchPrecompute.Report report =
+                new BatchPrecompute(store, ToneReader::new, 32, 1L << 30).run(List.of(folder));
+
+        assertEquals(FmodStreamingSampleReader.MAX_OPEN_READERS, report.workers());
+        assertTrue(readersCreated.get() <= FmodStreamingSampleReader.MAX_OPEN_READERS);
+        assertEquals(0, readersOpen.get());
+    }
+
+    @Test
+    @DisplayName("should decode one file at a time when each fills the memory cap")
+    void shouldHonourMemoryCap() throws Exception {
+        Path folder = folderOf(6);
+
+        BatchPrecompute.Report report =
+                new BatchPrecompute(store, ToneReader::new, 4, 1).run(List.of(folder));
+
+        assertEquals(6, report.count(BatchPrecompute.Status.DECODED));
+        assertEquals(1, maxDecoding.get());
+    }
+}
@@ -0,0 +1,120 @@
+package core.annotations;
+
+import static org.junit.jupiter.api.Assertions.*;
+import static org.mockito.Mockito.mock;
+
+import com.fasterxml.jackson.databind.ObjectMapper;
+import core.env.ProgramVersion;
+import java.io.File;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.StandardOpenOption;
+import java.util.List;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+@DisplayName("AnnotationFileParser")
+class AnnotationFileParserTest {
+
+    @TempDir Path tempDir;
+
+    private File file;
+    private Path journal;
+    private AnnotationFileParser parser;
+
+    @BeforeEach
+    void setUp() throws Exception {
+        file = tempDir.resolve("session.tmp").toFile();
+        journal = AnnotationJournal.pathFor(file.toPath());
+        parser = new AnnotationFileParser(mock(ProgramVersion.class));
+        Files.createFile(file.toPath());
+        parser.prependHeader(file, "tester");
+    }
+
+    @Test
+    @DisplayName("should journal edits without rewriting the file, and fold them in on close")
+    void shouldJournalThenCompact() throws Exception {
+        String header = Files.readString(file.toPath());
+
+        parser.appendAnnotation(new Annotation(300, 3, "CAT"), file);
+        parser.appendAnnotation(new Annotation(100, 1, "DOG"), file);
+        parser.appendAnnotation(new Annotation(100, 1, "DOG"), file); // Duplicate, ignored
+        parser.appendAnnotation(new Annotation(200, 2, "EMU"), file);
+        assertTrue(parser.removeAnnotation(new Annotation(200, 2, "EMU"), file));
+        assertFalse(parser.removeAnnotation(new Annotation(200, 2, "EMU"), file));
+        parser.addField(file, "condition", "b");
+
+        assertEquals(header, Files.readString(file.toPath()));
+        assertEquals(5, Files.readAllLines(journal).size());
+        var expected = List.of(new Annotation(100, 1, "DOG"), new Annotation(300, 3, "CAT"));
+        assertEquals(expected, parser.parse(file));
+
+        parser.close(file);
+
+        assertFalse(Files.exists(journal));
+        var reopened = new AnnotationFileParser(mock(ProgramVersion.class));
+        assertEquals(expected, reopened.parse(file));
+        assertTrue(reopened.headerExists(file));
+        assertTrue(Files.readString(file.toPath()).contains("\"condition\" : \"b\""));
+    }
+
+    @Test
+    @DisplayName("should replay a journal left by a crash, dropping a torn last record")
+    void shouldReplayAfterCrash() throws Exception {
+        parser.appendAnnotation(new Annotation(100, 1, "DOG"), file);
+        parser.appendAnnotation(new Annotation(200, 2, "EMU"), file);
+        // The process dies mid-append: no compaction, and half a record on disk
+        Files.writeString(
+                journal, "{\"op\":\"add\",\"annotation\":{\"ti", StandardOpenOption.APPEND);
+
+        var recovered = new AnnotationFileParser(mock(ProgramVersion.class));
+        assertEquals(
+                List.of(new Annotation(100, 1, "DOG"), new Annotation(200, 2, "EMU")),
+                recovered.parse(file));
+
+        // Later records are written after the intact ones, not after the torn one
+        recovered.appendAnnotation(new Annotation(300, 3, "CAT"), file);
+        var again = new AnnotationFileParser(mock(ProgramVersion.class));
+        assertEquals(3, again.parse(file).size());
+        String lines = Files.readString(journal, StandardCharsets.UTF_8);
+        assertEquals(3, lines.lines().count());
+    }
+
+    @Test
+    @DisplayName("should compact once the journal passes its size threshold")
+    void shouldCompactPastThreshold() throws Exception {
+        String text = "x".repeat(1000);
+        int edits = (int) (AnnotationFileParser.COMPACT_THRESHOLD_BYTES / text.length()) + 1;
+        for (int i = 0; i < edits; i++) {
+            parser.appendAnnotation(new Annotation(i, i, text), file);
+        }
+
+        assertTrue(
+                !Files.exists(journal)
+                        || Files.size(journal) < AnnotationFileParser.COMPACT_THRESHOLD_BYTES);
+        assertTrue(Files.size(file.toPath()) > AnnotationFileParser.COMPACT_THRESHOLD_BYTES / 2);
+        var fromDisk = new AnnotationFileParser(mock(ProgramVersion.class));
+        assertEquals(edits, fromDisk.parse(file).size());
+    }
+
+    @Test
+    @DisplayName("should show journalled edits to the repository, which a full save folds in")
+    void shouldReplayJournalInRepository() throws Exception {
+        parser.appendAnnotation(new Annotation(100, 1, "DOG"), file);
+        parser.appendAnnotation(new Annotation(200, 2, "EMU"), file);
+        parser.removeAnnotation(new Annotation(100, 1, "DOG"), file);
+
+        var repository = new AnnotationRepository(new ObjectMapper(), mock(ProgramVersion.class));
+        var loaded = repository.load(file.toPath());
+        assertEquals(
+                List.of(new Annotation(200, 2, "EMU")),
+                loaded.stream().map(AnnotationEntry::annotation).toList());
+
+        repository.save(List.of(), file.toPath());
+        assertFalse(Files.exists(journal));
+        assertEquals(List.of(), repository.load(file.toPath()));
+    }
+}
@@ -0,0 +1,71 @@
+package core.annotations;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.util.List;
+import java.util.Optional;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+@DisplayName("AnnotationTimeIndex")
+class AnnotationTimeIndexTest {
+
+    private AnnotationTimeIndex index;
+
+    @BeforeEach
+    void setUp() {
+        index = new AnnotationTimeIndex();
+    }
+
+    private static AnnotationEntry entry(double time, String text) {
+        return AnnotationEntry.create(
+                new Annotation(time, 0, text), AnnotationType.REGULAR, Optional.empty());
+    }
+
+    @Test
+    @DisplayName("should answer next, previous and range queries")
+    void answersQueries() {
+        var b = entry(2000, "B");
+        var a = entry(1000, "A");
+        var c = entry(3000, "C");
+        index.reset(List.of(b, a));
+        index.add(c);
+
+        assertEquals(a, index.firstAfter(0).orElseThrow());
+        assertEquals(b, index.firstAfter(1000).orElseThrow());
+        assertTrue(index.firstAfter(3000).isEmpty());
+        assertEquals(b, index.lastBefore(3000).orElseThrow());
+        assertTrue(index.lastBefore(1000).isEmpty());
+        assertEquals(List.of(a, b), index.between(1000, 2000));
+        assertEquals(List.of(), index.between(1001, 1999));
+        assertTrue(index.anyWithin(2040, 50));
+        assertFalse(index.anyWithin(2050, 50));
+
+        var moved = b.withTime(3500);
+        index.update(b, moved);
+        index.remove(a);
+        assertEquals(List.of(c, moved), index.between(0, 10_000));
+
+        index.reset(List.of());
+        assertEquals(0, index.size());
+    }
+
+    @Test
+    @DisplayName("should ignore edits applied twice")
+    void editsAreIdempotent() {
+        var a = entry(1000, "A");
+        var b = entry(1000, "B");
+        index.add(a);
+        index.add(b);
+        index.add(a);
+        assertEquals(List.of(a, b), index.between(1000, 1000));
+
+        var renamed = a.withText("A2");
+        index.update(a, renamed);
+        index.update(a, renamed);
+        index.remove(b);
+        index.remove(b);
+        assertEquals(List.of(renamed), index.between(0, 2000));
+    }
+}
@@ -0,0 +1,92 @@
+package core.audio;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+@DisplayName("SampleView")
+class SampleViewTest {
+
+    @Test
+    @DisplayName("should return the wrapped array without copying")
+    void shouldReturnWrappedArray() {
+        double[] samples = {0.1, -0.2, 0.3};
+        SampleView view = SampleView.of(samples);
+
+        assertSame(samples, view.toArray());
+        assertEquals(3, view.length());
+        assertFalse(view.isFloatStorage());
+    }
+
+    @Test
+    @DisplayName("should slice without copying the backing samples")
+    void shouldSliceDoubles() {
+        double[] samples = {0.0, 0.1, 0.2, 0.3, 0.4};
+        SampleView slice = SampleView.of(samples).slice(1, 3);
+
+        assertEquals(3, slice.length());
+        assertArrayEquals(new double[] {0.1, 0.2, 0.3}, slice.toArray());
+
+        samples[2] = 0.9;
+        assertEquals(0.9, slice.get(1));
+    }
+
+    @Test
+    @DisplayName("should read float storage as doubles")
+    void shouldReadFloats() {
+        MemorySegment floats = Arena.ofAuto().allocate(ValueLayout.JAVA_FLOAT, 4);
+        for (int i = 0; i < 4; i++) {
+            floats.setAtIndex(ValueLayout.JAVA_FLOAT, i, i * 0.25f);
+        }
+        SampleView view = SampleView.ofFloats(floats);
+
+        assertTrue(view.isFloatStorage());
+        assertEquals(4, view.length());
+        assertArrayEquals(new double[] {0.25, 0.5}, view.slice(1, 2).toArray());
+
+        double[] dst = new double[5];
+        view.copyTo(2, dst, 3, 2);
+        assertArrayEquals(new double[] {0, 0, 0, 0.5, 0.75}, dst);
+    }
+
+    @Test
+    @DisplayName("should reject segments that are not whole samples")
+    void shouldRejectPartialSamples() {
+        MemorySegment odd = Arena.ofAuto().allocate(6);
+        assertThrows(IllegalArgumentException.class, () -> SampleView.ofFloats(odd));
+        assertThrows(IllegalArgumentException.class, () -> SampleView.ofDoubles(odd));
+    }
+
+    @Test
+    @DisplayName("should back AudioData and materialize samples on demand")
+    void shouldBackAudioData() {
+        double[] samples = {0.5, -0.5};
+        AudioData data = new AudioData(samples, 44100, 1, 0, 2);
+
+        assertEquals(2, data.view().length());
+        assertSame(samples, data.samples());
+    }
+
+    @Test
+    @DisplayName("should compare by storage and range, not by sample values")
+    void shouldCompareByStorage() {
+        double[] samples = {0.1, 0.2, 0.3, 0.4};
+        SampleView view = SampleView.of(samples);
+
+        assertEquals(view, SampleView.of(samples));
+        assertEquals(view.slice(1, 2), SampleView.of(samples).slice(1, 2));
+        assertEquals(view.slice(1, 2).hashCode(), SampleView.of(samples).slice(1, 2).hashCode());
+        assertNotEquals(view.slice(1, 2), view.slice(2, 2));
+        assertNotEquals(view, SampleView.of(samples.clone()));
+
+        assertEquals(
+                new AudioData(samples, 44100, 2, 0, 2), new AudioData(samples, 44100, 2, 0, 2));
+        assertNotEquals(
+                new AudioData(samples, 44100, 2, 0, 2),
+                new AudioData(samples.clone(), 44100, 2, 0, 2));
+    }
+}
@@ -10,6 +10,7 @@ import core.audio.PlaybackState;
 import core.audio.exceptions.AudioLoadException;
 import core.audio.exceptions.AudioPlaybackException;
 import core.env.Platform;
+import core.telemetry.PerformanceTelemetry;
 import java.util.ArrayList;
 import java.util.Collections;
 import java.util.List;
@@ -77,7 +78,8 @@ class FmodAudioEngineTest {
                         playbackManager,
                         listenerManager,
                         stateManager,
-                        lifecycleManager);
+                        lifecycleManager,
+                        new PerformanceTelemetry());
     }
 
     @AfterEach
@@ -5,9 +5,12 @@ import static org.junit.jupiter.api.Assertions.*;
 import core.audio.AudioHandle;
 import core.audio.AudioMetadata;
 import core.audio.exceptions.AudioLoadException;
+import core.audio.fmod.panama.FmodCore;
 import core.env.Platform;
 import java.io.File;
+import java.lang.foreign.Arena;
 import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
 import java.nio.file.Files;
 import java.nio.file.Path;
 import java.util.Optional;
@@ -393,6 +396,122 @@ class FmodAudioLoadingManagerTest {
         assertNull(error.get(), "Thread threw exception");
     }
 
+    // ========== Non-blocking Open Tests ==========
+
+    @Test
+    @Timeout(5)
+    void testNonBlockingOpenLoadsAndReportsErrors() throws Exception {
+        loadingManager.releaseAll();
+        loadingManager = new FmodAudioLoadingManager(
+                        system, stateManager, lifecycleManager, true, Optional.empty());
+
+        AudioHandle handle = loadingManager.loadAudio(SAMPLE_WAV);
+        assertTrue(loadingManager.isCurrent(handle));
+        AudioMetadata meta = loadingManager.getCurrentMetadata().orElseThrow();
+        assertEquals(44100, meta.sampleRate());
+        assertTrue(meta.frameCount() > 0);
+
+        // A failed asynchronous open surfaces as a load error and keeps the current audio
+        Path fakeWav = tempDir.resolve("nonblocking-bad.wav");
+        Files.writeString(fakeWav, "Invalid audio data");
+        assertThrows(AudioLoadException.class, () -> loadingManager.loadAudio(fakeWav.toString()));
+        assertTrue(loadingManager.isCurrent(handle));
+    }
+
+    @Test
+    void testOpenDoesNotChangeCurrentUntilCommit() throws Exception {
+        AudioHandle first = loadingManager.loadAudio(SAMPLE_WAV);
+
+        FmodAudioLoadingManager.PendingSound pending = loadingManager.open(SWEEP_WAV);
+        assertTrue(pending.sound().isPresent());
+        assertTrue(loadingManager.isCurrent(first));
+
+        AudioHandle second = loadingManager.commit(pending);
+        assertFalse(loadingManager.isCurrent(first));
+        assertTrue(loadingManager.isCurrent(second));
+
+        // Opening the current file reuses it
+        assertTrue(loadingManager.open(SWEEP_WAV).sound().isEmpty());
+        assertSame(second, loadingManager.commit(loadingManager.open(SWEEP_WAV)));
+    }
+
+    // ========== Shared Decode Tests ==========
+
+    @Test
+    void testSharedDecodePlaysFromStorePcm() throws Exception {
+        loadingManager.releaseAll();
+        FmodDecodedAudioStore store = new FmodDecodedAudioStore(system, 64L * 1024 * 1024);
+        loadingManager =
+                new FmodAudioLoadingManager(
+                        system, stateManager, lifecycleManager, false, Optional.of(store));
+
+        AudioHandle handle = loadingManager.loadAudio(SAMPLE_WAV);
+        assertTrue(loadingManager.isCurrent(handle));
+
+        // Metadata describes the file, not the raw float sound FMOD plays
+        AudioMetadata meta = loadingManager.getCurrentMetadata().orElseThrow();
+        assertEquals("WAV", meta.format());
+        assertEquals(44100, meta.sampleRate());
+        assertEquals(16, meta.bitsPerSample());
+
+        // The waveform side gets the very PCM playback uses, with no second decode
+        FmodDecodedAudioStore.DecodedAudio decoded = store.acquire(Path.of(SAMPLE_WAV));
+        assertSame(decoded, store.acquire(Path.of(SAMPLE_WAV)));
+        assertEquals(meta, decoded.metadata());
+
+        try (var arena = Arena.ofConfined()) {
+            var lengthRef = arena.allocate(ValueLayout.JAVA_INT);
+            int result =
+                    FmodCore.FMOD_Sound_GetLength(
+                            loadingManager.getCurrentSound().orElseThrow(),
+                            lengthRef,
+                            FmodConstants.FMOD_TIMEUNIT_PCM);
+            assertEquals(FmodConstants.FMOD_OK, result);
+            assertEquals(meta.frameCount(), lengthRef.get(ValueLayout.JAVA_INT, 0));
+        }
+    }
+
+    @Test
+    void testSharedDecodeWithoutBlockingMatchesBlockingDecode() throws Exception {
+        FmodDecodedAudioStore blocking = new FmodDecodedAudioStore(system, 64L * 1024 * 1024);
+        FmodDecodedAudioStore nonBlocking =
+                new FmodDecodedAudioStore(system, 64L * 1024 * 1024, true);
+
+        FmodDecodedAudioStore.DecodedAudio expected = blocking.acquire(Path.of(SAMPLE_WAV));
+        FmodDecodedAudioStore.DecodedAudio actual = nonBlocking.acquire(Path.of(SAMPLE_WAV));
+        expected.progress().done().get(5, TimeUnit.SECONDS);
+        actual.progress().done().get(5, TimeUnit.SECONDS);
+
+        assertEquals(expected.metadata(), actual.metadata());
+        assertEquals(-1, expected.samples().mismatch(actual.samples()));
+        assertThrows(
+                AudioLoadException.class,
+                () -> nonBlocking.acquire(Path.of("src/test/resources/audio/missing.wav")));
+    }
+
+    @Test
+    void testSharedDecodeIsProgressive() throws Exception {
+        FmodDecodedAudioStore store = new FmodDecodedAudioStore(system, 64L * 1024 * 1024);
+        FmodDecodedAudioStore.DecodedAudio decoded = store.acquire(Path.of(SAMPLE_WAV));
+        long frames = decoded.metadata().frameCount();
+
+        // The header alone sizes the buffer; waits for any frame complete in order
+        assertEquals(frames * decoded.metadata().channelCount() * Float.BYTES, decoded.sizeBytes());
+        decoded.progress().whenDecoded(1).get(5, TimeUnit.SECONDS);
+        assertTrue(decoded.progress().framesDecoded() >= 1);
+        decoded.progress().whenDecoded(frames).get(5, TimeUnit.SECONDS);
+        decoded.progress().done().get(5, TimeUnit.SECONDS);
+        assertEquals(frames, decoded.progress().framesDecoded());
+
+        // Past the end completes with the decode rather than never
+        assertTrue(decoded.progress().whenDecoded(frames + 1).isDone());
+
+        // Closing stops the store: nothing new decodes, decoded frames stay readable
+        store.close();
+        assertThrows(AudioLoadException.class, () -> store.acquire(Path.of(SWEEP_WAV)));
+        assertEquals(frames, decoded.progress().framesDecoded());
+    }
+
     // ========== Format and State Validation Tests ==========
 
     @Test
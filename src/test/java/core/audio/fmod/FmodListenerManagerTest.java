@@ -622,6 +622,119 @@ class FmodListenerManagerTest {
         playbackManager.stop();
     }
 
+    // ========== Position Snapshot Tests ==========
+
+    @Test
+    @DisplayName("Should serve positions from the snapshot while polling, and pause them exactly")
+    @Timeout(5)
+    void testPositionSnapshot() throws Exception {
+        AudioHandle audioHandle = loadingManager.loadAudio(SAMPLE_WAV);
+        MemorySegment sound =
+                loadingManager
+                        .getCurrentSound()
+                        .orElseThrow(() -> new IllegalStateException("No sound loaded"));
+        FmodPlaybackHandle playbackHandle = playbackManager.play(sound, audioHandle);
+
+        // Not monitored: callers must fall back to querying the channel
+        assertEquals(-1L, listenerManager.getPosition(playbackHandle));
+
+        listenerManager.addListener(new TestListener("Snapshot"));
+        listenerManager.startMonitoring(playbackHandle, getAudioFrameCount(sound));
+        Thread.sleep(200);
+        long playing = listenerManager.getPosition(playbackHandle);
+        assertTrue(playing > 0, "Snapshot position should advance during playback");
+
+        playbackManager.pause();
+        listenerManager.onPausedChanged(playbackHandle, true);
+        long paused = listenerManager.getPosition(playbackHandle);
+        Thread.sleep(150);
+        assertEquals(paused, listenerManager.getPosition(playbackHandle));
+
+        listenerManager.onSeek(playbackHandle, 10_000);
+        assertEquals(10_000, listenerManager.getPosition(playbackHandle));
+
+        listenerManager.stopMonitoring();
+        assertEquals(-1L, listenerManager.getPosition(playbackHandle));
+        playbackManager.stop();
+    }
+
+    @Test
+    @DisplayName("Should extrapolate snapshots between polls without passing the limit")
+    void testSnapshotExtrapolation() throws Exception {
+        AudioHandle audioHandle = loadingManager.loadAudio(SAMPLE_WAV);
+        FmodListenerManager.PositionSnapshot sampled =
+                new FmodListenerManager.PositionSnapshot(
+                        new FmodPlaybackHandle(audioHandle, MemorySegment.NULL, 0, 2_000),
+                        0,
+                        0,
+                        1_000,
+                        1_000,
+                        0,
+                        false,
+                        1_000,
+                        2_000);
+        long second = TimeUnit.SECONDS.toNanos(1);
+
+        assertEquals(1_500, sampled.positionAt(second / 2, second));
+        // Bounded by the extrapolation window, then by the limit frame
+        assertEquals(1_100, sampled.positionAt(second, second / 10));
+        assertEquals(2_000, sampled.positionAt(5 * second, 5 * second));
+        assertEquals(
+                1_000, sampled.withPosition(1_000, 0, true, second).positionAt(second, second));
+    }
+
+    @Test
+    @DisplayName("Should hold rather than step back when a poll reads behind the extrapolation")
+    void testSnapshotMonotonic() throws Exception {
+        AudioHandle audioHandle = loadingManager.loadAudio(SAMPLE_WAV);
+        FmodListenerManager.PositionSnapshot sampled =
+                new FmodListenerManager.PositionSnapshot(
+                        new FmodPlaybackHandle(audioHandle, MemorySegment.NULL, 0, 2_000),
+                        0,
+                        0,
+                        1_000,
+                        1_000,
+                        0,
+                        false,
+                        1_000,
+                        2_000);
+        long second = TimeUnit.SECONDS.toNanos(1);
+
+        // Readers saw 1500 by half a second; the DSP clock reports only 1200 then
+        var behind = sampled.withPosition(1_200, second / 2, false, second);
+        assertEquals(1_500, behind.positionAt(second / 2, second));
+        assertEquals(1_500, behind.positionAt(second / 2 + second / 5, second));
+        assertEquals(1_600, behind.positionAt(second / 2 + 2 * second / 5, second));
+        assertEquals(1_500, behind.withPosition(1_200, second / 2, true, second).positionAt(0, 0));
+    }
+
+    @Test
+    @DisplayName("Should snap back to the channel's reading on pause and resume")
+    void testSnapshotResetOnPause() throws Exception {
+        AudioHandle audioHandle = loadingManager.loadAudio(SAMPLE_WAV);
+        FmodListenerManager.PositionSnapshot sampled =
+                new FmodListenerManager.PositionSnapshot(
+                        new FmodPlaybackHandle(audioHandle, MemorySegment.NULL, 0, 2_000),
+                        0,
+                        0,
+                        1_000,
+                        1_000,
+                        0,
+                        false,
+                        1_000,
+                        2_000);
+        long second = TimeUnit.SECONDS.toNanos(1);
+
+        // Extrapolated to 1500, but the channel paused at 1200: the playhead goes back to it
+        assertEquals(1_500, sampled.positionAt(second / 2, second));
+        var paused = sampled.resetTo(1_200, second / 2, true);
+        assertEquals(1_200, paused.positionAt(second, second));
+
+        // Resuming advances from the channel's reading, not from the old floor
+        var resumed = paused.resetTo(1_200, second, false);
+        assertEquals(1_300, resumed.positionAt(second + second / 10, second));
+    }
+
     // ========== Latency Compensation Tests ==========
 
     @Test
@@ -0,0 +1,66 @@
+package core.audio.fmod;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import core.audio.AudioMetadata;
+import core.env.Platform;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.TimeUnit;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Tag;
+import org.junit.jupiter.api.Test;
+
+@Tag("audio")
+@DisplayName("FmodMetadataProbe")
+class FmodMetadataProbeTest {
+
+    private static final Path SAMPLE_WAV = Paths.get("src/test/resources/audio/freerecall.wav");
+    private static final Path SWEEP_WAV = Paths.get("src/test/resources/audio/sweep.wav");
+
+    private FmodMetadataProbe probe;
+    private FmodStreamingSampleReader reader;
+
+    @BeforeEach
+    void setUp() {
+        var libraryLoader =
+                new FmodLibraryLoader(new FmodProperties("unpackaged", "standard"), new Platform());
+        probe = new FmodMetadataProbe(libraryLoader);
+        reader = new FmodStreamingSampleReader(libraryLoader);
+    }
+
+    @AfterEach
+    void tearDown() throws Exception {
+        probe.close();
+        reader.close();
+    }
+
+    @Test
+    @DisplayName("should report the same metadata as opening the file for reading")
+    void matchesSampleReader() throws Exception {
+        List<CompletableFuture<AudioMetadata>> probes = new ArrayList<>();
+        for (int i = 0; i < 4 * FmodMetadataProbe.PROBE_THREADS; i++) {
+            probes.add(probe.probe(i % 2 == 0 ? SAMPLE_WAV : SWEEP_WAV));
+        }
+        var expectedSample = reader.getMetadata(SAMPLE_WAV).get(5, TimeUnit.SECONDS);
+        var expectedSweep = reader.getMetadata(SWEEP_WAV).get(5, TimeUnit.SECONDS);
+
+        for (int i = 0; i < probes.size(); i++) {
+            var expected = i % 2 == 0 ? expectedSample : expectedSweep;
+            assertEquals(expected, probes.get(i).get(5, TimeUnit.SECONDS));
+        }
+    }
+
+    @Test
+    @DisplayName("should fail for a file that does not exist")
+    void failsForMissingFile() {
+        var future = probe.probe(Paths.get("src/test/resources/audio/missing.wav"));
+        assertThrows(ExecutionException.class, () -> future.get(5, TimeUnit.SECONDS));
+    }
+}
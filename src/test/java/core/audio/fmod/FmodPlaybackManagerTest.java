@@ -5,8 +5,11 @@ import static org.junit.jupiter.api.Assertions.*;
 import core.audio.AudioHandle;
 import core.audio.AudioMetadata;
 import core.audio.exceptions.AudioPlaybackException;
+import core.audio.fmod.panama.FmodCore;
 import core.env.Platform;
+import java.lang.foreign.Arena;
 import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
 import java.util.concurrent.CountDownLatch;
 import java.util.concurrent.ExecutorService;
 import java.util.concurrent.Executors;
@@ -353,6 +356,58 @@ class FmodPlaybackManagerTest {
                 "Range playback should auto-stop at end but is still active");
     }
 
+    @Test
+    @Timeout(3)
+    void testReplayedRangeIsScheduledOnDspClock() throws Exception {
+        AudioHandle handle = loadingManager.loadAudio(SAMPLE_WAV);
+        MemorySegment sound = loadSound(SAMPLE_WAV);
+        int sampleRate = loadingManager.getCurrentMetadata().orElseThrow().sampleRate();
+
+        long startFrame = sampleRate;
+        long endFrame = startFrame + sampleRate / 5; // 200ms
+        playbackManager.prewarm(sound, startFrame);
+
+        // The first replay takes the pre-warmed channel, the second the one it readied
+        for (int i = 0; i < 2; i++) {
+            FmodPlaybackHandle ph =
+                    playbackManager.playRange(sound, handle, startFrame, endFrame, true);
+            assertTrue(ph.getStartClock() > 0, "Range should start on a scheduled DSP clock");
+
+            Thread.sleep(400);
+            assertFalse(
+                    playbackManager.hasActivePlayback(),
+                    "Range playback should stop at its scheduled end");
+        }
+    }
+
+    @Test
+    void testStopAndShutdownReleaseThePrewarmedChannel() throws Exception {
+        MemorySegment sound = loadSound(SAMPLE_WAV);
+        int before = channelsPlaying();
+
+        playbackManager.prewarm(sound, 0);
+        assertEquals(before + 1, channelsPlaying(), "The warm channel waits paused");
+        playbackManager.stop();
+        assertEquals(before, channelsPlaying(), "Stop should release the warm channel");
+
+        playbackManager.prewarm(sound, 0);
+        playbackManager.shutdown();
+        assertEquals(before, channelsPlaying(), "Shutdown should release the warm channel");
+        playbackManager.prewarm(sound, 0);
+        assertEquals(before, channelsPlaying(), "Nothing should be pre-warmed after shutdown");
+    }
+
+    private int channelsPlaying() {
+        try (var arena = Arena.ofConfined()) {
+            var channelsRef = arena.allocate(ValueLayout.JAVA_INT);
+            int result =
+                    FmodCore.FMOD_System_GetChannelsPlaying(
+                            system, channelsRef, MemorySegment.NULL);
+            assertEquals(FmodConstants.FMOD_OK, result);
+            return channelsRef.get(ValueLayout.JAVA_INT, 0);
+        }
+    }
+
     @Test
     void testGetCurrentPlayback() throws Exception {
         assertFalse(playbackManager.getCurrentPlayback().isPresent());
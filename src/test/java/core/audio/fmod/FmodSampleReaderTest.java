@@ -51,6 +51,8 @@ class FmodSampleReaderTest {
         assertEquals(SAMPLE_WAV_CHANNELS, metadata.channelCount());
         assertEquals(SAMPLE_WAV_BITS, metadata.bitsPerSample());
         assertEquals(SAMPLE_WAV_FRAMES, metadata.frameCount());
+        // The same description the streaming reader gives, not the engine's container name
+        assertEquals("44100 Hz, 16 bit, Mono", metadata.format());
     }
 
     @Test
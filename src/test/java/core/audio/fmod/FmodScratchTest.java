@@ -0,0 +1,75 @@
+package core.audio.fmod;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.util.concurrent.CompletableFuture;
+import org.junit.jupiter.api.Test;
+
+class FmodScratchTest {
+
+    @Test
+    void testCloseReusesMemory() {
+        long first;
+        try (FmodScratch scratch = FmodScratch.open()) {
+            first = scratch.allocate(ValueLayout.JAVA_LONG).address();
+        }
+        try (FmodScratch scratch = FmodScratch.open()) {
+            assertEquals(first, scratch.allocate(ValueLayout.JAVA_LONG).address());
+        }
+    }
+
+    @Test
+    void testNestedFramesDoNotOverlap() {
+        try (FmodScratch outer = FmodScratch.open()) {
+            MemorySegment a = outer.allocate(ValueLayout.JAVA_INT);
+            a.set(ValueLayout.JAVA_INT, 0, 42);
+            try (FmodScratch inner = FmodScratch.open()) {
+                MemorySegment b = inner.allocate(ValueLayout.JAVA_LONG);
+                assertTrue(b.address() >= a.address() + a.byteSize());
+                assertEquals(0, b.address() % ValueLayout.JAVA_LONG.byteAlignment());
+                b.set(ValueLayout.JAVA_LONG, 0, -1L);
+            }
+            assertEquals(42, a.get(ValueLayout.JAVA_INT, 0));
+        }
+    }
+
+    @Test
+    void testAllocationsAreZeroed() {
+        try (FmodScratch scratch = FmodScratch.open()) {
+            scratch.allocate(ValueLayout.JAVA_LONG).set(ValueLayout.JAVA_LONG, 0, -1L);
+        }
+        try (FmodScratch scratch = FmodScratch.open()) {
+            assertEquals(0L, scratch.allocate(ValueLayout.JAVA_LONG).get(ValueLayout.JAVA_LONG, 0));
+        }
+    }
+
+    @Test
+    void testExhaustionThrows() {
+        try (FmodScratch scratch = FmodScratch.open()) {
+            assertThrows(IllegalStateException.class, () -> scratch.allocate(1 << 20));
+        }
+        // The failed request leaves the frame usable
+        try (FmodScratch scratch = FmodScratch.open()) {
+            assertDoesNotThrow(() -> scratch.allocate(ValueLayout.ADDRESS));
+        }
+    }
+
+    @Test
+    void testThreadsHaveTheirOwnScratch() {
+        long mine;
+        try (FmodScratch scratch = FmodScratch.open()) {
+            mine = scratch.allocate(ValueLayout.JAVA_LONG).address();
+            long theirs =
+                    CompletableFuture.supplyAsync(
+                                    () -> {
+                                        try (FmodScratch other = FmodScratch.open()) {
+                                            return other.allocate(ValueLayout.JAVA_LONG).address();
+                                        }
+                                    })
+                            .join();
+            assertNotEquals(mine, theirs);
+        }
+    }
+}
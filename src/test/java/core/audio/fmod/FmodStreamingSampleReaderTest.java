@@ -0,0 +1,127 @@
+package core.audio.fmod;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import core.audio.AudioData;
+import core.audio.AudioMetadata;
+import core.env.Platform;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.concurrent.TimeUnit;
+import org.junit.jupiter.api.*;
+import org.junit.jupiter.api.Tag;
+
+/** Tests for FmodStreamingSampleReader that decodes bounded windows on demand. */
+@TestInstance(TestInstance.Lifecycle.PER_CLASS)
+@Tag("audio")
+class FmodStreamingSampleReaderTest {
+
+    private FmodStreamingSampleReader reader;
+    private FmodSampleReader memoryReader;
+
+    private static final Path SAMPLE_WAV = Paths.get("src/test/resources/audio/freerecall.wav");
+    private static final Path SWEEP_WAV = Paths.get("src/test/resources/audio/sweep.wav");
+
+    // Known properties of freerecall.wav (mono, 44100Hz, 16-bit)
+    private static final int SAMPLE_WAV_RATE = 44100;
+    private static final int SAMPLE_WAV_CHANNELS = 1;
+    private static final int SAMPLE_WAV_BITS = 16;
+    private static final long SAMPLE_WAV_FRAMES = 1993624;
+
+    @BeforeEach
+    void setUp() {
+        var libraryLoader =
+                new FmodLibraryLoader(new FmodProperties("unpackaged", "standard"), new Platform());
+        reader = new FmodStreamingSampleReader(libraryLoader);
+        memoryReader = new FmodSampleReader(libraryLoader);
+    }
+
+    @AfterEach
+    void tearDown() throws Exception {
+        if (reader != null) {
+            reader.close();
+        }
+        if (memoryReader != null) {
+            memoryReader.close();
+        }
+    }
+
+    @Test
+    void testGetMetadata() throws Exception {
+        AudioMetadata metadata = reader.getMetadata(SAMPLE_WAV).get(5, TimeUnit.SECONDS);
+
+        assertEquals(SAMPLE_WAV_RATE, metadata.sampleRate());
+        assertEquals(SAMPLE_WAV_CHANNELS, metadata.channelCount());
+        assertEquals(SAMPLE_WAV_BITS, metadata.bitsPerSample());
+        assertEquals(SAMPLE_WAV_FRAMES, metadata.frameCount());
+    }
+
+    @Test
+    void testMatchesInMemoryReaderAcrossWindowBoundary() throws Exception {
+        // Straddle the boundary between the first and second decode windows
+        long startFrame = FmodStreamingSampleReader.WINDOW_FRAMES - 500;
+        long frameCount = 1000;
+
+        AudioData streamed =
+                reader.readSamples(SAMPLE_WAV, startFrame, frameCount).get(5, TimeUnit.SECONDS);
+        AudioData loaded =
+                memoryReader.readSamples(SAMPLE_WAV, startFrame, frameCount)
+                        .get(5, TimeUnit.SECONDS);
+
+        assertEquals(frameCount, streamed.frameCount());
+        assertArrayEquals(loaded.samples(), streamed.samples(), 1e-9);
+    }
+
+    @Test
+    void testRandomAccessReadsAreConsistent() throws Exception {
+        long startFrame = SAMPLE_WAV_FRAMES / 2;
+
+        AudioData first = reader.readSamples(SAMPLE_WAV, startFrame, 2000).get(5, TimeUnit.SECONDS);
+        // Force a seek elsewhere, then come back
+        reader.readSamples(SAMPLE_WAV, 0, 2000).get(5, TimeUnit.SECONDS);
+        AudioData second =
+                reader.readSamples(SAMPLE_WAV, startFrame, 2000).get(5, TimeUnit.SECONDS);
+
+        assertArrayEquals(first.samples(), second.samples(), 1e-12);
+    }
+
+    @Test
+    void testReadPastEof() throws Exception {
+        long startFrame = SAMPLE_WAV_FRAMES - 50;
+
+        AudioData data = reader.readSamples(SAMPLE_WAV, startFrame, 100).get(5, TimeUnit.SECONDS);
+
+        assertEquals(startFrame, data.startFrame());
+        assertEquals(50, data.frameCount());
+        assertEquals(50 * SAMPLE_WAV_CHANNELS, data.samples().length);
+    }
+
+    @Test
+    void testReadBeyondEof() throws Exception {
+        AudioData data =
+                reader.readSamples(SAMPLE_WAV, SAMPLE_WAV_FRAMES + 100, 100)
+                        .get(5, TimeUnit.SECONDS);
+
+        assertEquals(0, data.frameCount());
+        assertEquals(0, data.samples().length);
+    }
+
+    @Test
+    void testMultipleFiles() throws Exception {
+        AudioData data1 = reader.readSamples(SAMPLE_WAV, 0, 100).get(5, TimeUnit.SECONDS);
+        AudioData data2 = reader.readSamples(SWEEP_WAV, 0, 100).get(5, TimeUnit.SECONDS);
+
+        assertEquals(100, data1.frameCount());
+        assertEquals(100, data2.frameCount());
+    }
+
+    @Test
+    void testReadAfterCloseFails() throws Exception {
+        reader.readSamples(SAMPLE_WAV, 0, 100).get(5, TimeUnit.SECONDS);
+
+        reader.close();
+
+        var future = reader.readSamples(SAMPLE_WAV, 0, 100);
+        assertThrows(Exception.class, () -> future.get(1, TimeUnit.SECONDS));
+    }
+}
@@ -3,7 +3,13 @@ package core.audio.fmod;
 import static org.junit.jupiter.api.Assertions.*;
 
 import core.audio.exceptions.AudioEngineException;
+import core.audio.fmod.panama.FmodCore;
 import core.env.Platform;
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.nio.file.Files;
+import java.nio.file.Path;
 import java.util.concurrent.CountDownLatch;
 import java.util.concurrent.ExecutorService;
 import java.util.concurrent.Executors;
@@ -114,6 +120,26 @@ class FmodSystemManagerTest {
         assertTrue(formatInfo.contains("48000") || formatInfo.contains("44100"));
     }
 
+    @Test
+    @DisplayName("Should request the configured DSP buffer size")
+    void testDspBufferConfiguration() {
+        manager =
+                new FmodSystemManager(
+                        new FmodLibraryLoader(
+                                new FmodProperties("unpackaged", "standard"), new Platform()),
+                        0,
+                        FmodSystemManager.DspBufferConfig.FMOD_DEFAULT);
+        manager.initialize();
+
+        assertEquals(FmodSystemManager.DspBufferConfig.FMOD_DEFAULT, manager.getDspBufferConfig());
+        // FMOD may round the request for the output device
+        String bufferInfo = manager.getBufferInfo();
+        assertTrue(bufferInfo.contains("1024") || bufferInfo.contains("2048"));
+        assertThrows(
+                IllegalArgumentException.class,
+                () -> new FmodSystemManager.DspBufferConfig(256, 1));
+    }
+
     @Test
     @DisplayName("Update should work when initialized")
     void testUpdate() {
@@ -347,4 +373,38 @@ class FmodSystemManagerTest {
         assertDoesNotThrow(() -> manager.update());
         assertEquals("", manager.getVersionInfo());
     }
+
+    @Test
+    @DisplayName("Should serve sound loading through the mapped file system")
+    void testMappedFileSystem() throws Exception {
+        manager.shutdown();
+        manager =
+                new FmodSystemManager(
+                        new FmodLibraryLoader(
+                                new FmodProperties("unpackaged", "standard"), new Platform()),
+                        2);
+        assertTrue(manager.getFileSystemStats().isEmpty());
+        manager.initialize();
+        assertEquals(0, manager.getFileSystemStats().orElseThrow().reads());
+
+        Path wav = Path.of("src/test/resources/audio/freerecall.wav");
+        try (Arena arena = Arena.ofConfined()) {
+            MemorySegment soundRef = arena.allocate(ValueLayout.ADDRESS);
+            int result =
+                    FmodCore.FMOD_System_CreateSound(
+                            manager.getSystem(),
+                            arena.allocateFrom(wav.toString()),
+                            FmodConstants.FMOD_CREATESAMPLE,
+                            MemorySegment.NULL,
+                            soundRef);
+            assertEquals(FmodConstants.FMOD_OK, result);
+            FmodCore.FMOD_Sound_Release(soundRef.get(ValueLayout.ADDRESS, 0));
+        }
+
+        FmodFileSystem.Stats stats = manager.getFileSystemStats().orElseThrow();
+        assertTrue(stats.reads() > 0);
+        // A sample load reads at least the whole data chunk
+        assertTrue(stats.bytesRead() >= Files.size(wav) / 2);
+        assertTrue(stats.maxLatencyNanos() > 0);
+    }
 }
@@ -0,0 +1,179 @@
+package core.dispatch;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import core.events.SeekByAmountEvent;
+import core.events.SeekByAmountEvent.Direction;
+import core.events.ZoomEvent;
+import java.util.ArrayDeque;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Queue;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+@DisplayName("EventDispatchBus")
+class EventDispatchBusTest {
+
+    private QueueingDispatcher dispatcher;
+    private EventDispatchBus bus;
+    private Recorder recorder;
+
+    @BeforeEach
+    void setUp() {
+        dispatcher = new QueueingDispatcher();
+        bus = new EventDispatchBus(dispatcher);
+        recorder = new Recorder();
+        bus.subscribe(recorder);
+    }
+
+    @Test
+    @DisplayName("should deliver events to handlers of their supertypes and interfaces")
+    void dispatchesToSupertypes() {
+        bus.publish(new Child());
+        assertEquals(
+                List.of("child", "marker", "parent"), recorder.calls.stream().sorted().toList());
+        recorder.calls.clear();
+        bus.publish(new Parent());
+        assertEquals(List.of("parent"), recorder.calls);
+    }
+
+    @Test
+    @DisplayName("should deliver once to an object subscribed twice, and not after unsubscribe")
+    void subscribesOnce() {
+        bus.subscribe(recorder);
+        bus.publish(new Parent());
+        assertEquals(List.of("parent"), recorder.calls);
+
+        bus.unsubscribe(recorder);
+        bus.publish(new Parent());
+        assertEquals(List.of("parent"), recorder.calls);
+    }
+
+    @Test
+    @DisplayName("should merge queued seeks and zooms in one direction, keeping reversals apart")
+    void coalescesSeeks() {
+        bus.publish(new SeekByAmountEvent(Direction.FORWARD, 100));
+        bus.publish(new SeekByAmountEvent(Direction.FORWARD, 100));
+        bus.publish(new SeekByAmountEvent(Direction.BACKWARD, 250));
+        bus.publish(new ZoomEvent(ZoomEvent.Direction.IN));
+        bus.publish(new ZoomEvent(ZoomEvent.Direction.IN));
+        bus.publish(new ZoomEvent(ZoomEvent.Direction.IN));
+        bus.publish(new ZoomEvent(ZoomEvent.Direction.OUT));
+        assertTrue(recorder.seeks.isEmpty());
+        assertEquals(2, dispatcher.queued.size());
+
+        dispatcher.drain();
+        assertEquals(
+                List.of(
+                        new SeekByAmountEvent(Direction.FORWARD, 200),
+                        new SeekByAmountEvent(Direction.BACKWARD, 250)),
+                recorder.seeks);
+        assertEquals(
+                List.of(
+                        new ZoomEvent(ZoomEvent.Direction.IN, 3),
+                        new ZoomEvent(ZoomEvent.Direction.OUT, 1)),
+                recorder.zooms);
+
+        bus.publish(new SeekByAmountEvent(Direction.FORWARD, 10));
+        dispatcher.drain();
+        assertEquals(new SeekByAmountEvent(Direction.FORWARD, 10), recorder.seeks.get(2));
+    }
+
+    @Test
+    @DisplayName("should leave clamping handlers where the separate events would have")
+    void coalescingRespectsClamps() {
+        // Backward from the start clamps at 0, so the forward seek then lands 300 ms in
+        bus.publish(new SeekByAmountEvent(Direction.BACKWARD, 300));
+        bus.publish(new SeekByAmountEvent(Direction.FORWARD, 300));
+        bus.publish(new SeekByAmountEvent(Direction.FORWARD, 300));
+        // Zooming in past the closest level clamps there, so the zoom out then steps back one
+        bus.publish(new ZoomEvent(ZoomEvent.Direction.IN, 2));
+        bus.publish(new ZoomEvent(ZoomEvent.Direction.IN, 2));
+        bus.publish(new ZoomEvent(ZoomEvent.Direction.OUT));
+        dispatcher.drain();
+
+        assertEquals(600, recorder.positionMs);
+        assertEquals(Recorder.MAX_ZOOM - 1, recorder.zoomLevel);
+    }
+
+    /** Runs dispatches at once, as if on the EDT, and holds deferred ones until drained. */
+    private static final class QueueingDispatcher implements EventDispatcher {
+        final Queue<Runnable> queued = new ArrayDeque<>();
+
+        @Override
+        public boolean isEventDispatchThread() {
+            return true;
+        }
+
+        @Override
+        public void dispatch(Runnable task) {
+            task.run();
+        }
+
+        @Override
+        public void dispatchLater(Runnable task) {
+            queued.add(task);
+        }
+
+        void drain() {
+            Runnable task;
+            while ((task = queued.poll()) != null) {
+                task.run();
+            }
+        }
+    }
+
+    interface Marker {}
+
+    static class Parent {}
+
+    static class Child extends Parent implements Marker {}
+
+    public static class Recorder {
+        static final int MAX_ZOOM = 3;
+        static final int LENGTH_MS = 1000;
+
+        final List<String> calls = new ArrayList<>();
+        final List<SeekByAmountEvent> seeks = new ArrayList<>();
+        final List<ZoomEvent> zooms = new ArrayList<>();
+
+        // Clamped as the real handlers clamp: the playhead to the file, the zoom to its limits
+        int positionMs = 0;
+        int zoomLevel = 0;
+
+        @Subscribe
+        public void onChild(Child event) {
+            calls.add("child");
+        }
+
+        @Subscribe
+        public void onParent(Parent event) {
+            calls.add("parent");
+        }
+
+        @Subscribe
+        public void onMarker(Marker event) {
+            calls.add("marker");
+        }
+
+        @Subscribe
+        public void onSeek(SeekByAmountEvent event) {
+            seeks.add(event);
+            int delta =
+                    event.direction() == Direction.BACKWARD
+                            ? -event.milliseconds()
+                            : event.milliseconds();
+            positionMs = Math.clamp((long) positionMs + delta, 0, LENGTH_MS);
+        }
+
+        @Subscribe
+        public void onZoom(ZoomEvent event) {
+            zooms.add(event);
+            int delta =
+                    event.direction() == ZoomEvent.Direction.OUT ? -event.steps() : event.steps();
+            zoomLevel = Math.clamp((long) zoomLevel + delta, 0, MAX_ZOOM);
+        }
+    }
+}
@@ -0,0 +1,90 @@
+package core.telemetry;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.util.concurrent.TimeUnit;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+@DisplayName("PerformanceTelemetry")
+class PerformanceTelemetryTest {
+
+    private final PerformanceTelemetry telemetry = new PerformanceTelemetry();
+
+    @BeforeEach
+    @AfterEach
+    void reset() {
+        StageTimings.reset();
+    }
+
+    private static void runFilterStage(long nanos) {
+        var event = new FilterEvent();
+        event.start();
+        long until = System.nanoTime() + nanos;
+        while (System.nanoTime() < until) {
+            Thread.onSpinWait();
+        }
+        event.samples = 1024;
+        event.channels = 1;
+        event.finish();
+    }
+
+    @Test
+    @DisplayName("should report the durations of finished stage events")
+    void shouldReportStageDurations() {
+        for (int i = 0; i < 10; i++) {
+            runFilterStage(TimeUnit.MILLISECONDS.toNanos(1));
+        }
+
+        PerformanceTelemetry.StageStats filter = telemetry.snapshot().stages().get(Stage.FILTER);
+        assertEquals(10, filter.total());
+        assertTrue(filter.meanMillis() >= 1, "mean " + filter.meanMillis());
+        assertTrue(filter.maxMillis() >= filter.p95Millis());
+        assertTrue(filter.p95Millis() >= 1);
+        assertTrue(filter.perSecond() > 0);
+        assertEquals(0, telemetry.snapshot().stages().get(Stage.DECODE).total());
+    }
+
+    @Test
+    @DisplayName("should count cache lookups and dropped frames")
+    void shouldCountCacheLookupsAndFrames() {
+        CacheLookupEvent.record(true, 0, 100);
+        CacheLookupEvent.record(true, 2, 100);
+        CacheLookupEvent.record(true, 4, 100);
+        CacheLookupEvent.record(false, 6, 100);
+        telemetry.recordFrame(0);
+        telemetry.recordFrame(2);
+
+        PerformanceTelemetry.Snapshot snapshot = telemetry.snapshot();
+        assertEquals(3, snapshot.cacheHits());
+        assertEquals(1, snapshot.cacheMisses());
+        assertEquals(0.75, snapshot.cacheHitRate(), 1e-9);
+        assertEquals(2, snapshot.framesDelivered());
+        assertEquals(2, snapshot.framesDropped());
+    }
+
+    @Test
+    @DisplayName("should only show audio engine usage while it is fresh")
+    void shouldDropStaleAudioUsage() {
+        assertTrue(telemetry.snapshot().audioUsage().isEmpty());
+
+        long now = System.nanoTime();
+        long old = now - TimeUnit.SECONDS.toNanos(10);
+        telemetry.recordAudioUsage(new AudioEngineUsage(12.5f, 1, 0.5f, 4_000_000, 8_000_000, old));
+        assertTrue(telemetry.snapshot().audioUsage().isEmpty());
+
+        telemetry.recordAudioUsage(new AudioEngineUsage(12.5f, 1, 0.5f, 4_000_000, 8_000_000, now));
+        PerformanceTelemetry.Snapshot snapshot = telemetry.snapshot();
+        assertEquals(12.5f, snapshot.audioUsage().orElseThrow().dspPercent());
+
+        String[] lines = PerformanceTelemetry.overlayLines(snapshot);
+        assertTrue(lines[lines.length - 1].contains("dsp 12.5%"), lines[lines.length - 1]);
+        String report = PerformanceTelemetry.report(snapshot);
+        assertTrue(report.contains("FMOD memory: 4.00 MB (peak 8.00 MB)"), report);
+        for (Stage stage : Stage.values()) {
+            assertTrue(report.contains(stage.label()), report);
+        }
+    }
+}
@@ -0,0 +1,94 @@
+package core.util;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+@DisplayName("ByteBoundedLruCache")
+class ByteBoundedLruCacheTest {
+
+    private ByteBoundedLruCache<String, byte[]> cache;
+
+    @BeforeEach
+    void setUp() {
+        cache = new ByteBoundedLruCache<>(100, value -> value.length);
+    }
+
+    @Test
+    @DisplayName("should evict least recently used entries when over budget")
+    void shouldEvictLeastRecentlyUsed() {
+        cache.put("a", new byte[40]);
+        cache.put("b", new byte[40]);
+        // Touch "a" so "b" becomes the eldest
+        assertNotNull(cache.get("a"));
+
+        cache.put("c", new byte[40]);
+
+        assertNotNull(cache.get("a"));
+        assertNull(cache.get("b"));
+        assertNotNull(cache.get("c"));
+        assertEquals(80, cache.weightedSize());
+        assertEquals(1, cache.getEvictions());
+        assertEquals(40, cache.getEvictedBytes());
+    }
+
+    @Test
+    @DisplayName("should keep a single value larger than the budget")
+    void shouldKeepOversizedNewestValue() {
+        cache.put("small", new byte[10]);
+        cache.put("huge", new byte[500]);
+
+        assertNull(cache.get("small"));
+        assertNotNull(cache.get("huge"));
+        assertEquals(1, cache.size());
+        assertEquals(500, cache.weightedSize());
+    }
+
+    @Test
+    @DisplayName("should account for replaced values")
+    void shouldAccountForReplacement() {
+        cache.put("a", new byte[60]);
+        cache.put("a", new byte[20]);
+
+        assertEquals(1, cache.size());
+        assertEquals(20, cache.weightedSize());
+        assertEquals(0, cache.getEvictions());
+    }
+
+    @Test
+    @DisplayName("should count hits and misses")
+    void shouldCountHitsAndMisses() {
+        cache.put("a", new byte[1]);
+
+        cache.get("a");
+        cache.get("a");
+        cache.get("missing");
+
+        assertEquals(2, cache.getHits());
+        assertEquals(1, cache.getMisses());
+        assertEquals(2.0 / 3.0, cache.getHitRate(), 1e-9);
+    }
+
+    @Test
+    @DisplayName("should release all bytes on clear")
+    void shouldReleaseBytesOnClear() {
+        cache.put("a", new byte[30]);
+        cache.put("b", new byte[30]);
+
+        cache.clear();
+
+        assertEquals(0, cache.size());
+        assertEquals(0, cache.weightedSize());
+        assertEquals(0, cache.getEvictions());
+    }
+
+    @Test
+    @DisplayName("should reject a non-positive budget")
+    void shouldRejectNonPositiveBudget() {
+        assertThrows(
+                IllegalArgumentException.class,
+                () -> new ByteBoundedLruCache<String, byte[]>(0, v -> 1));
+    }
+}
@@ -0,0 +1,129 @@
+package core.util.simd;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.lang.foreign.Arena;
+import java.lang.foreign.MemorySegment;
+import java.lang.foreign.ValueLayout;
+import java.util.Arrays;
+import java.util.Random;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.params.ParameterizedTest;
+import org.junit.jupiter.params.provider.ValueSource;
+
+@DisplayName("SampleKernels")
+class SampleKernelsTest {
+
+    // Odd length so every kernel exercises its scalar tail
+    private static final int LENGTH = 1037;
+
+    private final Kernels scalar = new ScalarKernels();
+    private final Kernels vector = new VectorKernels();
+    private Random random;
+
+    @BeforeEach
+    void setUp() {
+        random = new Random(42);
+    }
+
+    private double[] randomSamples() {
+        double[] samples = new double[LENGTH];
+        for (int i = 0; i < samples.length; i++) {
+            samples[i] = random.nextDouble() * 2 - 1;
+        }
+        return samples;
+    }
+
+    @Test
+    @DisplayName("should load the vector kernels when the module is resolved")
+    void shouldSelectVectorKernels() {
+        assertTrue(ModuleLayer.boot().findModule("jdk.incubator.vector").isPresent());
+        assertEquals(VectorKernels.isWorthwhile(), SampleKernels.isVectorized());
+    }
+
+    @ParameterizedTest
+    @ValueSource(ints = {16, 24, 32})
+    @DisplayName("should convert PCM exactly as the scalar loops do")
+    void shouldConvertPcmIdentically(int bitsPerSample) {
+        int bytesPerSample = bitsPerSample / 8;
+        byte[] pcm = new byte[3 + LENGTH * bytesPerSample];
+        random.nextBytes(pcm);
+
+        double[] expected = new double[LENGTH + 1];
+        double[] actual = new double[LENGTH + 1];
+        scalar.pcmToDouble(pcm, 3, expected, 1, bitsPerSample, LENGTH);
+        vector.pcmToDouble(pcm, 3, actual, 1, bitsPerSample, LENGTH);
+        assertArrayEquals(expected, actual);
+
+        Arena arena = Arena.ofAuto();
+        MemorySegment expectedFloats = arena.allocate(ValueLayout.JAVA_FLOAT, LENGTH + 2);
+        MemorySegment actualFloats = arena.allocate(ValueLayout.JAVA_FLOAT, LENGTH + 2);
+        scalar.pcmToFloat(pcm, 3, expectedFloats, 2, bitsPerSample, LENGTH);
+        vector.pcmToFloat(pcm, 3, actualFloats, 2, bitsPerSample, LENGTH);
+        assertArrayEquals(
+                expectedFloats.toArray(ValueLayout.JAVA_FLOAT),
+                actualFloats.toArray(ValueLayout.JAVA_FLOAT));
+    }
+
+    @Test
+    @DisplayName("should reject unsupported bit depths")
+    void shouldRejectUnsupportedBitDepth() {
+        assertThrows(
+                UnsupportedOperationException.class,
+                () -> vector.pcmToDouble(new byte[8], 0, new double[8], 0, 8, 8));
+    }
+
+    @Test
+    @DisplayName("should reduce min, max and sum of squares")
+    void shouldReduceMinMaxSumSquares() {
+        double[] samples = randomSamples();
+        double[] expected = {Double.POSITIVE_INFINITY, Double.NEGATIVE_INFINITY, 0};
+        double[] actual = expected.clone();
+
+        scalar.minMaxSumSquares(samples, 5, LENGTH - 2, expected);
+        vector.minMaxSumSquares(samples, 5, LENGTH - 2, actual);
+
+        assertEquals(expected[0], actual[0]);
+        assertEquals(expected[1], actual[1]);
+        assertEquals(expected[2], actual[2], 1e-9);
+    }
+
+    @Test
+    @DisplayName("should find the largest minimum of adjacent values")
+    void shouldFindMaxOfAdjacentMin() {
+        double[] values = randomSamples();
+
+        assertEquals(scalar.maxOfAdjacentMin(values, 7), vector.maxOfAdjacentMin(values, 7));
+        assertEquals(0.0, vector.maxOfAdjacentMin(new double[] {1.0}, 0));
+    }
+
+    @Test
+    @DisplayName("should smooth peaks and valleys like the scalar pass")
+    void shouldSmoothPeaksAndValleys() {
+        double[] src = randomSamples();
+        double[] expected = src.clone();
+        double[] actual = src.clone();
+
+        scalar.smoothPeaksAndValleys(src, expected);
+        vector.smoothPeaksAndValleys(src, actual);
+
+        assertArrayEquals(expected, actual);
+    }
+
+    @ParameterizedTest
+    @ValueSource(ints = {-1, 0, 1, 3, 20, 700, 5000})
+    @DisplayName("should match the deque sliding maximum for any window")
+    void shouldMatchSlidingAbsMax(int window) {
+        double[] src = randomSamples();
+        double[] expected = new double[LENGTH];
+        double[] actual = new double[LENGTH];
+        Arrays.fill(actual, 1.0); // Every output must be written, even for an empty window
+
+        scalar.slidingAbsMax(src, window, expected);
+        vector.slidingAbsMax(src, window, actual);
+
+        assertArrayEquals(expected, actual);
+    }
+}
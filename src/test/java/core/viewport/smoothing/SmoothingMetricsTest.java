@@ -0,0 +1,66 @@
+package core.viewport.smoothing;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import core.audio.session.AudioSessionStateMachine;
+import java.util.concurrent.TimeUnit;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+@DisplayName("SmoothingMetrics")
+class SmoothingMetricsTest {
+
+    private static final long PERIOD_NANOS = TimeUnit.SECONDS.toNanos(1) / 60;
+
+    @Test
+    @DisplayName("should report no jitter for evenly spaced frames")
+    void shouldReportNoJitterForEvenFrames() {
+        SmoothingMetrics metrics = new SmoothingMetrics(100);
+        for (int i = 0; i < 20; i++) {
+            metrics.addFrame(i * PERIOD_NANOS, 0);
+        }
+
+        SmoothingMetrics.FrameTimingStats timing = metrics.calculateFrameTiming();
+        assertNotNull(timing);
+        assertEquals(19, timing.frameCount());
+        assertEquals(PERIOD_NANOS / 1e6, timing.meanIntervalMs(), 1e-6);
+        assertEquals(0, timing.jitterMs(), 1e-6);
+        assertEquals(0, timing.droppedFrames());
+    }
+
+    @Test
+    @DisplayName("should report jitter and dropped frames for uneven frames")
+    void shouldReportJitterAndDrops() {
+        SmoothingMetrics metrics = new SmoothingMetrics(100);
+        long time = 0;
+        for (int i = 0; i < 20; i++) {
+            // Every fifth frame arrives a refresh late, having dropped one
+            boolean late = i % 5 == 4;
+            time += late ? 2 * PERIOD_NANOS : PERIOD_NANOS;
+            metrics.addFrame(time, late ? 1 : 0);
+        }
+
+        SmoothingMetrics.FrameTimingStats timing = metrics.calculateFrameTiming();
+        assertNotNull(timing);
+        assertTrue(timing.jitterMs() > 1, "jitter " + timing.jitterMs());
+        assertEquals(2 * PERIOD_NANOS / 1e6, timing.p99IntervalMs(), 1e-6);
+        assertEquals(4, timing.droppedFrames());
+
+        metrics.reset();
+        assertNull(metrics.calculateFrameTiming());
+    }
+
+    @Test
+    @DisplayName("should advance the playhead by frame time, not by call count")
+    void shouldAdvanceByFrameTime() {
+        PlayheadSmoother smoother = new PhaseLockedLoopSmoother();
+        var playing = AudioSessionStateMachine.State.PLAYING;
+        long start = System.nanoTime();
+        smoother.updateAndGetSmoothedPosition(44_100, start, playing);
+
+        long frame = start + PERIOD_NANOS;
+        long first = smoother.updateAndGetSmoothedPosition(44_100, frame, playing).smoothedFrame();
+        long again = smoother.updateAndGetSmoothedPosition(44_100, frame, playing).smoothedFrame();
+        assertEquals(first, again);
+    }
+}
@@ -0,0 +1,136 @@
+package core.waveform;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import core.audio.AudioMetadata;
+import core.waveform.signal.PeakPyramid;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.attribute.FileTime;
+import java.util.Optional;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+@DisplayName("PeakPyramidStore")
+class PeakPyramidStoreTest {
+
+    private static final String PARAMS = "test-params";
+
+    @TempDir Path tempDir;
+
+    private Path audioFile;
+    private PeakPyramidStore store;
+    private PeakPyramid pyramid;
+    private AudioMetadata metadata;
+
+    @BeforeEach
+    void setUp() throws Exception {
+        audioFile = Files.write(tempDir.resolve("audio.wav"), new byte[] {1, 2, 3, 4});
+        store = new PeakPyramidStore(tempDir.resolve("sidecars"), true);
+
+        double[] samples = new double[PeakPyramid.BASE_BIN_FRAMES * 5 + 3];
+        for (int i = 0; i < samples.length; i++) {
+            samples[i] = Math.sin(i * 0.1) * 0.5;
+        }
+        pyramid =
+                new PeakPyramid.Builder(8000, 1, samples.length)
+                        .accept(samples, 0, samples.length)
+                        .build();
+        metadata =
+                new AudioMetadata(
+                        8000,
+                        1,
+                        16,
+                        "8000 Hz, 16 bit, Mono",
+                        samples.length,
+                        samples.length / 8000.0);
+    }
+
+    @Test
+    @DisplayName("should round-trip a pyramid, its peak and the metadata through a mapped sidecar")
+    void shouldRoundTrip() {
+        store.save(audioFile, PARAMS, pyramid, metadata);
+
+        PeakPyramidStore.Sidecar sidecar = store.loadSidecar(audioFile, PARAMS).orElseThrow();
+        PeakPyramid loaded = sidecar.pyramid();
+
+        assertEquals(metadata, sidecar.metadata());
+        assertEquals(pyramid.peak(), loaded.peak());
+        assertEquals(pyramid.sampleRate(), loaded.sampleRate());
+        assertEquals(pyramid.frameCount(), loaded.frameCount());
+        assertEquals(pyramid.levelCount(), loaded.levelCount());
+        for (int l = 0; l < pyramid.levelCount(); l++) {
+            PeakPyramid.Level expected = pyramid.level(l);
+            PeakPyramid.Level actual = loaded.level(l);
+            assertEquals(expected.binFrames(), actual.binFrames());
+            assertEquals(expected.binCount(), actual.binCount());
+            for (int b = 0; b < expected.binCount(); b++) {
+                assertEquals(expected.min(b), actual.min(b));
+                assertEquals(expected.max(b), actual.max(b));
+                assertEquals(expected.rms(b), actual.rms(b));
+            }
+        }
+    }
+
+    @Test
+    @DisplayName("should miss when the audio file or parameters change")
+    void shouldMissOnChangedKey() throws Exception {
+        store.save(audioFile, PARAMS, pyramid, metadata);
+
+        assertEquals(Optional.empty(), store.load(audioFile, "other-params"));
+
+        Files.setLastModifiedTime(
+                audioFile,
+                FileTime.fromMillis(Files.getLastModifiedTime(audioFile).toMillis() + 10_000));
+        assertEquals(Optional.empty(), store.load(audioFile, PARAMS));
+    }
+
+    @Test
+    @DisplayName("should treat a corrupt sidecar as a miss")
+    void shouldIgnoreCorruptSidecar() throws Exception {
+        store.save(audioFile, PARAMS, pyramid, metadata);
+        Files.write(store.sidecarFor(audioFile, PARAMS), new byte[] {0, 1, 2});
+
+        assertTrue(store.load(audioFile, PARAMS).isEmpty());
+    }
+
+    @Test
+    @DisplayName("should neither read nor write when disabled")
+    void shouldDoNothingWhenDisabled() throws Exception {
+        PeakPyramidStore disabled = new PeakPyramidStore(tempDir.resolve("off"), false);
+
+        disabled.save(audioFile, PARAMS, pyramid, metadata);
+
+        assertFalse(Files.exists(tempDir.resolve("off")));
+        assertTrue(disabled.load(audioFile, PARAMS).isEmpty());
+    }
+
+    @Test
+    @DisplayName("should evict the least recently used sidecars beyond the size limit")
+    void shouldEvictLeastRecentlyUsed() throws Exception {
+        store.save(audioFile, PARAMS, pyramid, metadata);
+        long sidecarBytes = Files.size(store.sidecarFor(audioFile, PARAMS));
+        PeakPyramidStore bounded =
+                new PeakPyramidStore(tempDir.resolve("sidecars"), true, 2 * sidecarBytes);
+
+        Path second = Files.write(tempDir.resolve("second.wav"), new byte[] {5});
+        Path third = Files.write(tempDir.resolve("third.wav"), new byte[] {6});
+        bounded.save(second, PARAMS, pyramid, metadata);
+        age(bounded.sidecarFor(audioFile, PARAMS), 20_000);
+        age(bounded.sidecarFor(second, PARAMS), 10_000);
+
+        // Loading the oldest makes it the most recently used
+        assertTrue(bounded.load(audioFile, PARAMS).isPresent());
+        bounded.save(third, PARAMS, pyramid, metadata);
+
+        assertTrue(Files.exists(bounded.sidecarFor(audioFile, PARAMS)));
+        assertFalse(Files.exists(bounded.sidecarFor(second, PARAMS)));
+        assertTrue(Files.exists(bounded.sidecarFor(third, PARAMS)));
+    }
+
+    private static void age(Path file, long millis) throws Exception {
+        Files.setLastModifiedTime(file, FileTime.fromMillis(System.currentTimeMillis() - millis));
+    }
+}
@@ -0,0 +1,146 @@
+package core.waveform;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import core.dispatch.EventDispatchBus;
+import java.awt.Image;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CompletableFuture;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+@DisplayName("PrefetchScheduler")
+class PrefetchSchedulerTest {
+
+    private static final long FRAME_NANOS = 16_000_000L;
+
+    private WaveformSegmentCache cache;
+    private List<CompletableFuture<Image>> renders;
+    private long now;
+    private PrefetchScheduler scheduler;
+
+    @BeforeEach
+    void setUp() {
+        EventDispatchBus quietBus =
+                new EventDispatchBus(null) {
+                    @Override
+                    public void subscribe(Object subscriber) {}
+
+                    @Override
+                    public void unsubscribe(Object subscriber) {}
+
+                    @Override
+                    public void publish(Object event) {}
+                };
+        cache = new WaveformSegmentCache(new CacheStats(quietBus));
+        renders = new ArrayList<>();
+        scheduler =
+                new PrefetchScheduler(
+                        cache,
+                        _ -> {
+                            CompletableFuture<Image> future = new CompletableFuture<>();
+                            renders.add(future);
+                            return future;
+                        },
+                        () -> now);
+    }
+
+    private static WaveformViewportSpec viewportAt(double startSeconds) {
+        return new WaveformViewportSpec(startSeconds, startSeconds + 10.0, 1000, 200, 100, 600.0);
+    }
+
+    @Test
+    @DisplayName("should prefetch symmetrically while idle")
+    void shouldBeSymmetricWhenIdle() {
+        int count = WaveformSegmentCache.PREFETCH_COUNT;
+        assertEquals(
+                new PrefetchScheduler.Window(count, count), PrefetchScheduler.windowFor(0, 100));
+    }
+
+    @Test
+    @DisplayName("should lean toward the direction of motion and grow with speed")
+    void shouldBiasTowardMotion() {
+        int count = WaveformSegmentCache.PREFETCH_COUNT;
+        int trailing = PrefetchScheduler.TRAILING_PREFETCH;
+
+        assertEquals(
+                new PrefetchScheduler.Window(count, trailing),
+                PrefetchScheduler.windowFor(1.0, 100));
+        assertEquals(
+                new PrefetchScheduler.Window(trailing, 15),
+                PrefetchScheduler.windowFor(-1.5, 1000));
+        assertEquals(
+                new PrefetchScheduler.Window(PrefetchScheduler.MAX_PREFETCH, trailing),
+                PrefetchScheduler.windowFor(50.0, 1000));
+    }
+
+    @Test
+    @DisplayName("should estimate velocity from successive viewports and reset on a jump")
+    void shouldTrackMotionAndResetOnJump() {
+        PrefetchScheduler.Window window = null;
+        for (int frame = 0; frame < 30; frame++) {
+            now = frame * FRAME_NANOS;
+            window = scheduler.observe(viewportAt(frame * 0.016));
+        }
+        assertTrue(window.forward() > window.backward());
+
+        now += FRAME_NANOS;
+        window = scheduler.observe(viewportAt(300.0));
+        assertEquals(window.forward(), window.backward());
+    }
+
+    @Test
+    @DisplayName("should render each prefetched segment once across repeated schedules")
+    void shouldCoalesceDuplicateRequests() {
+        WaveformViewportSpec viewport = viewportAt(100.0);
+        cache.updateViewport(viewport);
+
+        scheduler.schedule(viewport);
+        int firstPass = renders.size();
+        now += FRAME_NANOS;
+        scheduler.schedule(viewport);
+
+        assertEquals(2 * WaveformSegmentCache.PREFETCH_COUNT, firstPass);
+        assertEquals(firstPass, renders.size());
+    }
+
+    @Test
+    @DisplayName("should cancel unfinished prefetches left behind by a seek")
+    void shouldCancelStalePrefetchesOnJump() {
+        cache.updateViewport(viewportAt(0.0));
+        scheduler.schedule(viewportAt(0.0));
+        List<CompletableFuture<Image>> before = List.copyOf(renders);
+
+        now += FRAME_NANOS;
+        WaveformViewportSpec seeked = viewportAt(400.0);
+        cache.updateViewport(seeked);
+        scheduler.schedule(seeked);
+
+        assertTrue(before.stream().allMatch(CompletableFuture::isCancelled));
+        assertEquals(renders.size() - before.size(), scheduler.outstandingCount());
+        var stale = new WaveformSegmentCache.SegmentKey(6, 100, 200);
+        assertNull(cache.get(stale, false));
+    }
+
+    @Test
+    @DisplayName("should schedule on the executor, keeping only the latest queued viewport")
+    void shouldScheduleOffThread() {
+        List<Runnable> queued = new ArrayList<>();
+        WaveformViewportSpec first = viewportAt(0.0);
+        WaveformViewportSpec latest = viewportAt(400.0);
+        cache.updateViewport(latest);
+
+        scheduler.scheduleOn(first, queued::add);
+        now += FRAME_NANOS;
+        scheduler.scheduleOn(latest, queued::add);
+        assertTrue(renders.isEmpty());
+        assertEquals(1, queued.size());
+
+        queued.getFirst().run();
+        assertEquals(2 * WaveformSegmentCache.PREFETCH_COUNT, renders.size());
+        var nearLatest = new WaveformSegmentCache.SegmentKey(206, 100, 200);
+        assertNotNull(cache.get(nearLatest, false));
+    }
+}
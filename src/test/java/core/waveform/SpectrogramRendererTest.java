@@ -0,0 +1,139 @@
+package core.waveform;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import core.audio.AudioData;
+import core.audio.AudioMetadata;
+import core.audio.SampleReader;
+import core.dispatch.EventDispatchBus;
+import java.awt.image.BufferedImage;
+import java.nio.file.Path;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicLong;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+@DisplayName("SpectrogramRenderer")
+class SpectrogramRendererTest {
+
+    private static final int SAMPLE_RATE = 16000;
+    private static final double TONE_HZ = 2000;
+    private static final double DURATION_SECONDS = 3600; // An hour, generated on demand
+    private static final int HEIGHT = 80;
+
+    private final AtomicLong framesRead = new AtomicLong();
+    private ExecutorService renderPool;
+    private SpectrogramRenderer renderer;
+
+    /** Stereo reader of a steady tone, counting what it is asked for. */
+    private final SampleReader toneReader =
+            new SampleReader() {
+                @Override
+                public CompletableFuture<AudioData> readSamples(
+                        Path audioFile, long startFrame, long frameCount) {
+                    framesRead.addAndGet(frameCount);
+                    double[] samples = new double[(int) frameCount * 2];
+                    for (int i = 0; i < frameCount; i++) {
+                        double t = (startFrame + i) / (double) SAMPLE_RATE;
+                        samples[2 * i] = samples[2 * i + 1] = Math.sin(2 * Math.PI * TONE_HZ * t);
+                    }
+                    return CompletableFuture.completedFuture(
+                            new AudioData(samples, SAMPLE_RATE, 2, startFrame, frameCount));
+                }
+
+                @Override
+                public CompletableFuture<AudioMetadata> getMetadata(Path audioFile) {
+                    return CompletableFuture.completedFuture(metadata());
+                }
+
+                @Override
+                public void close() {}
+            };
+
+    private static AudioMetadata metadata() {
+        long frames = (long) (DURATION_SECONDS * SAMPLE_RATE);
+        return new AudioMetadata(SAMPLE_RATE, 2, 16, "wav", frames, DURATION_SECONDS);
+    }
+
+    @BeforeEach
+    void setUp() {
+        EventDispatchBus quietBus =
+                new EventDispatchBus(null) {
+                    @Override
+                    public void subscribe(Object subscriber) {}
+
+                    @Override
+                    public void unsubscribe(Object subscriber) {}
+
+                    @Override
+                    public void publish(Object event) {}
+                };
+        WaveformSegmentCache cache = new WaveformSegmentCache(new CacheStats(quietBus));
+        renderPool = Executors.newFixedThreadPool(2);
+        renderer = new SpectrogramRenderer("tone.wav", cache, renderPool, toneReader, metadata());
+    }
+
+    @AfterEach
+    void tearDown() {
+        renderer.clear();
+        renderPool.shutdownNow();
+    }
+
+    private static int grey(BufferedImage image, int x, int y) {
+        return image.getRGB(x, y) & 0xFF;
+    }
+
+    @Test
+    @DisplayName("should draw a tone as a dark band at its frequency")
+    void shouldDrawToneAtItsFrequency() throws Exception {
+        var viewport = new WaveformViewportSpec(10, 14, 400, HEIGHT, 100, DURATION_SECONDS);
+        WaveformTileSet tiles = renderer.renderTiles(viewport).get(10, TimeUnit.SECONDS);
+        assertNotNull(tiles);
+
+        BufferedImage tile = (BufferedImage) tiles.tiles().get(1);
+        assertEquals(WaveformTileSet.TILE_WIDTH_PX, tile.getWidth());
+        assertEquals(HEIGHT, tile.getHeight());
+
+        // Rows span 100 Hz each from the top down to 0 Hz at the bottom
+        int toneRow = HEIGHT - 1 - (int) (TONE_HZ / 100);
+        assertTrue(grey(tile, 100, toneRow) < 40, "tone row " + grey(tile, 100, toneRow));
+        assertTrue(grey(tile, 100, 10) > 200, "quiet row " + grey(tile, 100, 10));
+    }
+
+    @Test
+    @DisplayName("should only analyse the visible and prefetch segments of a long file")
+    void shouldAnalyseLazily() throws Exception {
+        var viewport = new WaveformViewportSpec(1800, 1804, 400, HEIGHT, 100, DURATION_SECONDS);
+        renderer.renderTiles(viewport).get(10, TimeUnit.SECONDS);
+        renderer.clear();
+
+        // Visible segments plus the idle prefetch either side, each 2 s plus a window
+        int segments = 3 + 2 * WaveformSegmentCache.PREFETCH_COUNT;
+        long bound = segments * (long) Math.ceil(2.1 * SAMPLE_RATE);
+        assertTrue(framesRead.get() > 0);
+        assertTrue(framesRead.get() <= bound, framesRead.get() + " frames read");
+    }
+
+    @Test
+    @DisplayName("should read only each column's window when zoomed far out")
+    void shouldReadColumnWindowsWhenZoomedOut() throws Exception {
+        var viewport = new WaveformViewportSpec(1800, 2200, 400, HEIGHT, 1, DURATION_SECONDS);
+        WaveformTileSet tiles = renderer.renderTiles(viewport).get(10, TimeUnit.SECONDS);
+        renderer.clear();
+
+        int toneRow = HEIGHT - 1 - (int) (TONE_HZ / 100);
+        BufferedImage tile = (BufferedImage) tiles.tiles().get(1);
+        assertTrue(grey(tile, 100, toneRow) < 40, "tone row " + grey(tile, 100, toneRow));
+
+        // Each 200 s segment reads one 25 ms window per column, not its whole span
+        int segments = 3 + 2 * WaveformSegmentCache.PREFETCH_COUNT;
+        int windowFrames = (int) Math.round(SpectrogramRenderer.WINDOW_SECONDS * SAMPLE_RATE);
+        long bound = segments * (long) WaveformTileSet.TILE_WIDTH_PX * windowFrames;
+        assertTrue(framesRead.get() <= bound, framesRead.get() + " frames read");
+    }
+}
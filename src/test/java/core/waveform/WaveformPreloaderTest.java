@@ -0,0 +1,55 @@
+package core.waveform;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import annotations.Audio;
+import app.headless.HeadlessTestFixture;
+import core.events.UpcomingAudioFilesEvent;
+import java.io.File;
+import java.nio.file.Path;
+import java.util.List;
+import java.util.concurrent.TimeUnit;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.Timeout;
+
+@Audio
+@DisplayName("WaveformPreloader")
+class WaveformPreloaderTest extends HeadlessTestFixture {
+
+    private static final String SAMPLE_WAV = "src/test/resources/audio/freerecall.wav";
+    private static final String SWEEP_WAV = "src/test/resources/audio/sweep.wav";
+
+    @Test
+    @Timeout(20)
+    @DisplayName("should prepare the next file with its first screen already rendered")
+    void shouldPrepareUpcomingFile() throws Exception {
+        WaveformPreloader preloader = getInstance(WaveformPreloader.class);
+        preloader.onUpcomingFiles(new UpcomingAudioFilesEvent(List.of(new File(SWEEP_WAV))));
+        preloader.idle().get(15, TimeUnit.SECONDS);
+
+        Waveform waveform = preloader.take(Path.of(SWEEP_WAV)).orElseThrow();
+        try {
+            WaveformViewportSpec first = waveform.getLastViewport().orElseThrow();
+            // Served from the warmed segment cache, so complete without rendering
+            assertTrue(waveform.renderViewport(first).isDone());
+            assertTrue(preloader.take(Path.of(SWEEP_WAV)).isEmpty());
+        } finally {
+            waveform.shutdown();
+        }
+    }
+
+    @Test
+    @Timeout(20)
+    @DisplayName("should drop files that are no longer upcoming")
+    void shouldDropStalePreloads() throws Exception {
+        WaveformPreloader preloader = getInstance(WaveformPreloader.class);
+        preloader.onUpcomingFiles(new UpcomingAudioFilesEvent(List.of(new File(SWEEP_WAV))));
+        preloader.onUpcomingFiles(new UpcomingAudioFilesEvent(List.of(new File(SAMPLE_WAV))));
+        preloader.idle().get(15, TimeUnit.SECONDS);
+
+        assertTrue(preloader.take(Path.of(SWEEP_WAV)).isEmpty());
+        Waveform waveform = preloader.take(Path.of(SAMPLE_WAV)).orElseThrow();
+        waveform.shutdown();
+    }
+}
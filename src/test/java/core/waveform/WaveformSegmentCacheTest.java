@@ -5,6 +5,7 @@ import static org.junit.jupiter.api.Assertions.*;
 import core.dispatch.EventDispatchBus;
 import java.awt.Image;
 import java.awt.image.BufferedImage;
+import java.util.Optional;
 import java.util.concurrent.*;
 import java.util.stream.Stream;
 import org.junit.jupiter.api.BeforeEach;
@@ -59,9 +60,8 @@ class WaveformSegmentCacheTest {
 
     @SuppressWarnings("unchecked")
     @Test
-    void testCircularOverwrite() {
-        // Fill cache beyond capacity to test circular overwrite
-        // Get actual cache size from the cache itself
+    void testOverflowEvictsSegmentsFarthestFromViewport() {
+        // Fill cache beyond capacity; viewport is 0-10s, so low indices are the near segments
         int cacheSize = cache.getSize();
         int entriesToAdd = cacheSize + 10; // Add 10 more than capacity
 
@@ -72,15 +72,57 @@ class WaveformSegmentCacheTest {
             cache.put(key, futures[i]);
         }
 
-        // Early entries should be overwritten (first 10 entries)
-        assertNull(cache.get(new WaveformSegmentCache.SegmentKey(0L, 100, 200)));
-        assertNull(cache.get(new WaveformSegmentCache.SegmentKey(2L, 100, 200)));
+        // Segments inside the viewport survive
+        assertNotNull(cache.get(new WaveformSegmentCache.SegmentKey(0L, 100, 200)));
+        assertNotNull(cache.get(new WaveformSegmentCache.SegmentKey(2L, 100, 200)));
 
-        // Recent entries should still exist (last added)
+        // The most recent insertion is kept even though it is far away
         assertNotNull(
                 cache.get(
                         new WaveformSegmentCache.SegmentKey(
                                 (long) ((entriesToAdd - 1) * 2), 100, 200)));
+
+        // Far segments inserted earlier were evicted
+        assertNull(
+                cache.get(
+                        new WaveformSegmentCache.SegmentKey(
+                                (long) ((entriesToAdd - 2) * 2), 100, 200)));
+        assertEquals(10, cacheStats.getEvictions());
+    }
+
+    @Test
+    void testEvictionFollowsViewportCentre() {
+        int cacheSize = cache.getSize();
+        for (int i = 0; i < cacheSize; i++) {
+            cache.put(
+                    new WaveformSegmentCache.SegmentKey(i, 100, 200),
+                    CompletableFuture.completedFuture(mockImage));
+        }
+
+        // Scroll to the end of the cached range, then overflow: the start is now farthest
+        double end = cacheSize * 2.0;
+        cache.updateViewport(new WaveformViewportSpec(end - 10, end, 1000, 200, 100, 600.0));
+        var key = new WaveformSegmentCache.SegmentKey(cacheSize, 100, 200);
+        cache.put(key, CompletableFuture.completedFuture(mockImage));
+
+        assertNull(cache.get(new WaveformSegmentCache.SegmentKey(0, 100, 200)));
+        assertNotNull(cache.get(new WaveformSegmentCache.SegmentKey(cacheSize - 1, 100, 200)));
+        assertNotNull(cache.get(key));
+    }
+
+    @Test
+    void testWaitForPendingLoadsReturnsOnCompletion() throws Exception {
+        var future = new CompletableFuture<Image>();
+        cache.put(new WaveformSegmentCache.SegmentKey(0L, 100, 200), future);
+        assertTrue(cache.hasPendingLoads());
+
+        CompletableFuture.delayedExecutor(20, TimeUnit.MILLISECONDS)
+                .execute(() -> future.complete(mockImage));
+        long start = System.nanoTime();
+        cache.waitForPendingLoads(5000);
+
+        assertFalse(cache.hasPendingLoads());
+        assertTrue(TimeUnit.NANOSECONDS.toMillis(System.nanoTime() - start) < 5000);
     }
 
     @Test
@@ -125,31 +167,54 @@ class WaveformSegmentCacheTest {
     }
 
     @Test
-    void testViewportPixelsPerSecondChangeClearsCache() {
+    void testViewportPixelsPerSecondChangeKeepsCompletedTier() {
         var key = new WaveformSegmentCache.SegmentKey(0L, 100, 200);
-        cache.put(key, CompletableFuture.completedFuture(mockImage));
+        var future = CompletableFuture.completedFuture(mockImage);
+        cache.put(key, future);
 
         // Change pixels per second
-        var newViewport = new WaveformViewportSpec(0.0, 10.0, 1000, 200, 200, 60.0);
+        var newViewport = new WaveformViewportSpec(0.0, 10.0, 1000, 200, 150, 60.0);
         cache.updateViewport(newViewport);
 
-        // Cache should be cleared
-        assertNull(cache.get(key));
+        // The finished segment stays available as a preview tier
+        assertSame(future, cache.get(key));
+        assertEquals(
+                Optional.of(new WaveformSegmentCache.Tier(100, 200)),
+                cache.nearestCompletedTier(new WaveformSegmentCache.Tier(150, 200)));
+        assertSame(mockImage, cache.getCompleted(key));
     }
 
     @Test
-    void testViewportHeightChangeClearsCache() {
+    void testViewportChangeCancelsPendingRendersOfOldTier() {
         var key = new WaveformSegmentCache.SegmentKey(0L, 100, 200);
-        cache.put(key, CompletableFuture.completedFuture(mockImage));
+        var pending = new CompletableFuture<Image>();
+        cache.put(key, pending);
 
         // Change height
         var newViewport = new WaveformViewportSpec(0.0, 10.0, 1000, 400, 100, 60.0);
         cache.updateViewport(newViewport);
 
-        // Cache should be cleared
+        assertTrue(pending.isCancelled());
         assertNull(cache.get(key));
     }
 
+    @Test
+    void testViewportChangeKeepsOnlyNearestTiers() {
+        int[] zoomLevels = {100, 150, 225, 338};
+        for (int pps : zoomLevels) {
+            cache.updateViewport(new WaveformViewportSpec(0.0, 10.0, 1000, 200, pps, 60.0));
+            cache.put(
+                    new WaveformSegmentCache.SegmentKey(0L, pps, 200),
+                    CompletableFuture.completedFuture(mockImage));
+        }
+
+        // Current tier (338) plus the two nearest (225, 150); the farthest (100) was dropped
+        assertNull(cache.get(new WaveformSegmentCache.SegmentKey(0L, 100, 200)));
+        assertNotNull(cache.get(new WaveformSegmentCache.SegmentKey(0L, 150, 200)));
+        assertNotNull(cache.get(new WaveformSegmentCache.SegmentKey(0L, 225, 200)));
+        assertNotNull(cache.get(new WaveformSegmentCache.SegmentKey(0L, 338, 200)));
+    }
+
     @Test
     void testViewportWidthChangePreservesEntries() {
         var key1 = new WaveformSegmentCache.SegmentKey(0L, 100, 200);
@@ -206,7 +271,7 @@ class WaveformSegmentCacheTest {
             assertNotNull(cache.get(key), "Entry " + i + " should exist");
         }
 
-        // Add one more - should overwrite oldest
+        // Add one more - should evict another entry, never the new one
         var overflowKey = new WaveformSegmentCache.SegmentKey((long) (expectedSize * 2), 100, 200);
         cache.put(overflowKey, CompletableFuture.completedFuture(mockImage));
         assertNotNull(cache.get(overflowKey));
@@ -349,30 +414,6 @@ class WaveformSegmentCacheTest {
         assertEquals(6.0, key2.endTime(), 0.001);
     }
 
-    @Test
-    void testHeadPointerWraparound() {
-        // Test the subtle head = (head + 1 >= size) ? 0 : head + 1 logic
-        var smallViewport = new WaveformViewportSpec(0.0, 10.0, 200, 200, 100, 60.0);
-        var smallCache = new WaveformSegmentCache(cacheStats);
-        smallCache.initialize(smallViewport);
-        int cacheSize = smallCache.getSize(); // Get actual size from cache
-
-        // Fill exactly to size
-        for (int i = 0; i < cacheSize; i++) {
-            smallCache.put(
-                    new WaveformSegmentCache.SegmentKey(i, 100, 200),
-                    CompletableFuture.completedFuture(mockImage));
-        }
-
-        // Verify next put wraps to index 0
-        var key = new WaveformSegmentCache.SegmentKey(99, 100, 200);
-        smallCache.put(key, CompletableFuture.completedFuture(mockImage));
-
-        // First entry should be overwritten
-        assertNull(smallCache.get(new WaveformSegmentCache.SegmentKey(0, 100, 200)));
-        assertNotNull(smallCache.get(key));
-    }
-
     @Test
     void testResizeWhileCacheFull() {
         // Fill cache completely
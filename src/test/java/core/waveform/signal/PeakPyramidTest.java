@@ -0,0 +1,124 @@
+package core.waveform.signal;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.util.Arrays;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+@DisplayName("PeakPyramid")
+class PeakPyramidTest {
+
+    private static final int SAMPLE_RATE = 1000;
+
+    private static PeakPyramid buildMono(double[] samples, int chunkSize) {
+        PeakPyramid.Builder builder = new PeakPyramid.Builder(SAMPLE_RATE, 1, samples.length);
+        for (int offset = 0; offset < samples.length; offset += chunkSize) {
+            builder.accept(samples, offset, Math.min(chunkSize, samples.length - offset));
+        }
+        return builder.build();
+    }
+
+    @Test
+    @DisplayName("should halve bin count per level down to a single bin")
+    void shouldBuildPowerOfTwoLevels() {
+        double[] samples = new double[PeakPyramid.BASE_BIN_FRAMES * 8];
+        PeakPyramid pyramid = buildMono(samples, 100);
+
+        assertEquals(4, pyramid.levelCount());
+        assertEquals(8, pyramid.level(0).binCount());
+        assertEquals(1, pyramid.level(3).binCount());
+        assertEquals(PeakPyramid.BASE_BIN_FRAMES * 8, pyramid.level(3).binFrames());
+        assertEquals(samples.length, pyramid.frameCount());
+    }
+
+    @Test
+    @DisplayName("should keep min, max and RMS through coarser levels")
+    void shouldAggregateMinMaxRms() {
+        double[] samples = new double[PeakPyramid.BASE_BIN_FRAMES * 4];
+        Arrays.fill(samples, 0.5);
+        samples[3] = 0.9;
+        samples[PeakPyramid.BASE_BIN_FRAMES * 3] = -0.7;
+        PeakPyramid pyramid = buildMono(samples, 7);
+
+        PeakPyramid.Level top = pyramid.level(pyramid.levelCount() - 1);
+        assertEquals(0.9f, top.max(0));
+        assertEquals(-0.7f, top.min(0));
+        assertEquals(0.5, top.rms(0), 0.05);
+    }
+
+    @Test
+    @DisplayName("should report the true global peak magnitude")
+    void shouldReportGlobalPeak() {
+        double[] samples = new double[PeakPyramid.BASE_BIN_FRAMES * 37 + 5];
+        samples[samples.length - 1] = -0.75;
+        samples[100] = 0.5;
+
+        assertEquals(0.75, buildMono(samples, 333).peak(), 1e-6);
+        assertEquals(0.0, buildMono(new double[0], 1).peak());
+    }
+
+    @Test
+    @DisplayName("should pick the coarsest level no wider than a pixel")
+    void shouldChooseLevelForZoom() {
+        PeakPyramid pyramid = buildMono(new double[PeakPyramid.BASE_BIN_FRAMES * 64], 1024);
+
+        assertEquals(0, pyramid.levelFor(1));
+        assertEquals(0, pyramid.levelFor(PeakPyramid.BASE_BIN_FRAMES * 2 - 1));
+        assertEquals(1, pyramid.levelFor(PeakPyramid.BASE_BIN_FRAMES * 2));
+        assertEquals(pyramid.levelCount() - 1, pyramid.levelFor(1e12));
+    }
+
+    @Test
+    @DisplayName("should report absolute peaks per pixel and zero outside the file")
+    void shouldComputeEnvelope() {
+        double[] samples = new double[PeakPyramid.BASE_BIN_FRAMES * 4];
+        samples[5] = -0.8;
+        samples[PeakPyramid.BASE_BIN_FRAMES * 2 + 1] = 0.4;
+        PeakPyramid pyramid = buildMono(samples, 64);
+
+        double[] pixels =
+                pyramid.envelope(
+                        -PeakPyramid.BASE_BIN_FRAMES * 2, PeakPyramid.BASE_BIN_FRAMES * 2, 4);
+
+        assertArrayEquals(new double[] {0.0, 0.8f, 0.4f, 0.0}, pixels, 1e-6);
+    }
+
+    @Test
+    @DisplayName("should bin interleaved samples by frame")
+    void shouldBinInterleavedFrames() {
+        double[] stereo = new double[PeakPyramid.BASE_BIN_FRAMES * 2 * 2];
+        stereo[1] = 0.3;
+        stereo[stereo.length - 1] = -0.6;
+        PeakPyramid pyramid =
+                new PeakPyramid.Builder(SAMPLE_RATE, 2, PeakPyramid.BASE_BIN_FRAMES * 2)
+                        .accept(stereo, 0, stereo.length)
+                        .build();
+
+        assertEquals(PeakPyramid.BASE_BIN_FRAMES * 2, pyramid.frameCount());
+        assertEquals(2, pyramid.level(0).binCount());
+        assertEquals(0.3f, pyramid.level(0).max(0));
+        assertEquals(-0.6f, pyramid.level(0).min(1));
+    }
+
+    @Test
+    @DisplayName("should snapshot whole bins so far and keep building")
+    void shouldSnapshotWhileBuilding() {
+        double[] samples = new double[PeakPyramid.BASE_BIN_FRAMES * 6];
+        samples[PeakPyramid.BASE_BIN_FRAMES] = 0.4;
+        samples[samples.length - 1] = -0.9;
+        PeakPyramid.Builder builder = new PeakPyramid.Builder(SAMPLE_RATE, 1, samples.length);
+
+        builder.accept(samples, 0, PeakPyramid.BASE_BIN_FRAMES * 2 + 3);
+        PeakPyramid partial = builder.snapshot();
+        assertEquals(PeakPyramid.BASE_BIN_FRAMES * 2, partial.frameCount());
+        assertEquals(2, partial.level(0).binCount());
+        assertEquals(0.4, partial.peak(), 1e-6);
+
+        int rest = PeakPyramid.BASE_BIN_FRAMES * 2 + 3;
+        PeakPyramid whole = builder.accept(samples, rest, samples.length - rest).build();
+        assertEquals(samples.length, whole.frameCount());
+        assertEquals(0.9, whole.peak(), 1e-6);
+        assertEquals(2, partial.level(0).binCount(), "snapshot must not change afterwards");
+    }
+}
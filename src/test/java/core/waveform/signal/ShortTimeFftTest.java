@@ -0,0 +1,69 @@
+package core.waveform.signal;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+@DisplayName("ShortTimeFft")
+class ShortTimeFftTest {
+
+    private static final int SAMPLE_RATE = 16000;
+
+    private static double[] sine(double hz, double amplitude, int frames) {
+        double[] samples = new double[frames];
+        for (int i = 0; i < frames; i++) {
+            samples[i] = amplitude * Math.sin(2 * Math.PI * hz * i / SAMPLE_RATE);
+        }
+        return samples;
+    }
+
+    private static int loudestBin(double[] spectrum) {
+        int loudest = 0;
+        for (int bin = 1; bin < spectrum.length; bin++) {
+            if (spectrum[bin] > spectrum[loudest]) {
+                loudest = bin;
+            }
+        }
+        return loudest;
+    }
+
+    @Test
+    @DisplayName("should zero-pad the window to a power of two")
+    void shouldPadToPowerOfTwo() {
+        ShortTimeFft fft = new ShortTimeFft(400);
+        assertEquals(512, fft.fftSize());
+        assertEquals(257, fft.binCount());
+        assertEquals(256, new ShortTimeFft(256).fftSize());
+    }
+
+    @Test
+    @DisplayName("should put a full-scale sine at its bin near 0 dB")
+    void shouldLocateSine() {
+        ShortTimeFft fft = new ShortTimeFft(512);
+        double[] samples = sine(1000, 1.0, 2048);
+        double[] spectrum = new double[fft.binCount()];
+        fft.spectrum(samples, samples.length, 100, spectrum);
+
+        // 1 kHz at 16 kHz over 512 points is exactly bin 32
+        assertEquals(32, loudestBin(spectrum));
+        assertEquals(0, spectrum[32], 0.1);
+        assertTrue(spectrum[100] < -60, "far bin at " + spectrum[100] + " dB");
+    }
+
+    @Test
+    @DisplayName("should scale with amplitude and treat samples outside the range as silence")
+    void shouldTreatOutsideAsSilence() {
+        ShortTimeFft fft = new ShortTimeFft(512);
+        double[] samples = sine(1000, 0.1, 2048);
+        double[] spectrum = new double[fft.binCount()];
+
+        fft.spectrum(samples, samples.length, 100, spectrum);
+        assertEquals(-20, spectrum[32], 0.1);
+
+        fft.spectrum(samples, 100, 100, spectrum);
+        assertEquals(ShortTimeFft.FLOOR_DB, spectrum[32]);
+        fft.spectrum(samples, samples.length, -1000, spectrum);
+        assertEquals(ShortTimeFft.FLOOR_DB, spectrum[32]);
+    }
+}
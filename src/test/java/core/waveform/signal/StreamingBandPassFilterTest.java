@@ -0,0 +1,75 @@
+package core.waveform.signal;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.util.Arrays;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+@DisplayName("StreamingBandPassFilter")
+class StreamingBandPassFilterTest {
+
+    private static final FrequencyRange BAND = new FrequencyRange(0.001, 0.45);
+
+    private static double[] sine(double normalizedFrequency, int frames, int channels) {
+        double[] samples = new double[frames * channels];
+        for (int i = 0; i < frames; i++) {
+            for (int c = 0; c < channels; c++) {
+                samples[i * channels + c] = Math.sin(2 * Math.PI * normalizedFrequency * i);
+            }
+        }
+        return samples;
+    }
+
+    private static double peak(double[] samples, int from) {
+        double peak = 0;
+        for (int i = from; i < samples.length; i++) {
+            peak = Math.max(peak, Math.abs(samples[i]));
+        }
+        return peak;
+    }
+
+    @Test
+    @DisplayName("should give the same output in blocks as in one pass")
+    void shouldMatchAcrossBlockBoundaries() {
+        double[] input = sine(0.01, 4000, 2);
+        for (int i = 0; i < input.length; i += 7) {
+            input[i] += 0.3; // Add a DC step on some samples so the state matters
+        }
+
+        double[] whole = new double[input.length];
+        new StreamingBandPassFilter(BAND, 2).process(input, 0, whole, 0, input.length);
+
+        StreamingBandPassFilter streaming = new StreamingBandPassFilter(BAND, 2);
+        double[] blocks = input.clone();
+        int offset = 0;
+        for (int block : new int[] {2, 998, 3000, 4000}) {
+            streaming.process(blocks, offset, blocks, offset, block);
+            offset += block;
+        }
+
+        assertArrayEquals(whole, blocks, 1e-12);
+    }
+
+    @Test
+    @DisplayName("should pass the band and reject DC")
+    void shouldPassBandAndRejectDc() {
+        double[] inBand = sine(0.05, 20_000, 1);
+        new StreamingBandPassFilter(BAND, 1).process(inBand, 0, inBand, 0, inBand.length);
+        assertEquals(1.0, peak(inBand, 10_000), 0.02);
+
+        double[] dc = new double[20_000];
+        Arrays.fill(dc, 1.0);
+        new StreamingBandPassFilter(BAND, 1).process(dc, 0, dc, 0, dc.length);
+        assertEquals(0.0, peak(dc, 10_000), 1e-3);
+    }
+
+    @Test
+    @DisplayName("should reject partial frames")
+    void shouldRejectPartialFrames() {
+        StreamingBandPassFilter filter = new StreamingBandPassFilter(BAND, 2);
+        assertThrows(
+                IllegalArgumentException.class,
+                () -> filter.process(new double[3], 0, new double[3], 0, 3));
+    }
+}
@@ -77,4 +77,79 @@ class WaveformProcessorTest {
                         + (actualSkippedSamples / (double) SAMPLE_RATE)
                         + " seconds)");
     }
+
+    @Test
+    @DisplayName("Sequential chunks should continue the filter without re-reading overlap")
+    void testSequentialChunksReadNoOverlap() throws Exception {
+        long chunkFrames = (long) (CHUNK_DURATION * SAMPLE_RATE);
+        when(sampleReader.readSamples(any(Path.class), anyLong(), anyLong()))
+                .thenAnswer(
+                        invocation -> {
+                            long start = invocation.getArgument(1);
+                            long frames = invocation.getArgument(2);
+                            double[] silence = new double[(int) frames];
+                            return CompletableFuture.completedFuture(
+                                    new AudioData(silence, SAMPLE_RATE, 1, start, frames));
+                        });
+        when(pixelScaler.toPixelResolution(any(double[].class), anyInt(), anyInt(), anyInt()))
+                .thenReturn(new double[TARGET_PIXEL_WIDTH]);
+
+        processor.processAudioForDisplay(TEST_AUDIO_PATH, 0, TARGET_PIXEL_WIDTH);
+        processor.processAudioForDisplay(TEST_AUDIO_PATH, 1, TARGET_PIXEL_WIDTH);
+        processor.processAudioForDisplay(TEST_AUDIO_PATH, 5, TARGET_PIXEL_WIDTH);
+
+        verify(sampleReader).readSamples(any(Path.class), eq(0L), eq(chunkFrames));
+        verify(sampleReader).readSamples(any(Path.class), eq(chunkFrames), eq(chunkFrames));
+        // A jump has to warm the filter up again
+        verify(sampleReader)
+                .readSamples(
+                        any(Path.class),
+                        longThat(start -> start < 5 * chunkFrames),
+                        longThat(frames -> frames > chunkFrames));
+    }
+
+    @Test
+    @DisplayName("Zooms finer than a pyramid bin should resolve pixels from a bounded read")
+    void testSegmentEnvelopeResolvesFinerThanPyramid() throws Exception {
+        // A 5 kHz burst 50 pixels into a segment at 1000 px/s, 5 s into a 10 s file
+        double framesPerPixel = SAMPLE_RATE / 1000.0;
+        long segmentStart = 5L * SAMPLE_RATE;
+        long burstStart = segmentStart + (long) (50 * framesPerPixel);
+        double[] file = new double[10 * SAMPLE_RATE];
+        for (int i = 0; i < 10 * framesPerPixel; i++) {
+            file[(int) burstStart + i] = 0.5 * Math.sin(2 * Math.PI * 5000 * i / SAMPLE_RATE);
+        }
+        when(sampleReader.readSamples(any(Path.class), anyLong(), anyLong()))
+                .thenAnswer(
+                        invocation -> {
+                            long start = invocation.getArgument(1);
+                            long frames = invocation.getArgument(2);
+                            double[] read = new double[(int) frames];
+                            System.arraycopy(file, (int) start, read, 0, (int) frames);
+                            return CompletableFuture.completedFuture(
+                                    new AudioData(read, SAMPLE_RATE, 1, start, frames));
+                        });
+
+        double[] pixels =
+                processor.segmentEnvelope(
+                        TEST_AUDIO_PATH, segmentStart, framesPerPixel, TARGET_PIXEL_WIDTH);
+
+        // Only the segment and a short warm-up are read, not the file
+        verify(sampleReader)
+                .readSamples(
+                        any(Path.class),
+                        longThat(start -> start < segmentStart && start > segmentStart - 4096),
+                        longThat(frames -> frames < TARGET_PIXEL_WIDTH * framesPerPixel + 4096));
+        assertEquals(0.0, pixels[47], "pixel before the burst should be silent");
+        assertTrue(pixels[50] > 0.3, "burst should start at its own pixel: " + pixels[50]);
+
+        // The pyramid's base bins are wider than a pixel here, so it smears the burst leftward
+        PeakPyramid pyramid =
+                new PeakPyramid.Builder(SAMPLE_RATE, 1, file.length)
+                        .accept(file, 0, file.length)
+                        .build();
+        assertTrue(framesPerPixel < PeakPyramid.BASE_BIN_FRAMES);
+        double[] binned = pyramid.envelope(segmentStart, framesPerPixel, TARGET_PIXEL_WIDTH);
+        assertTrue(binned[47] > 0.3);
+    }
 }
@@ -187,6 +187,7 @@ class AppMenuBarTest extends SwingTestFixture {
         assertNotNull(viewMenu, "View menu should exist");
         verifyMenuItemFromConfig(viewMenu, "ZoomInAction", configsByClass);
         verifyMenuItemFromConfig(viewMenu, "ZoomOutAction", configsByClass);
+        verifyMenuItemFromConfig(viewMenu, "ToggleSpectrogramAction", configsByClass);
     }
 
     private void verifyMenuItemFromConfig(
@@ -0,0 +1,75 @@
+package ui.viewport;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import core.waveform.WaveformTileSet;
+import java.awt.Color;
+import java.awt.Graphics2D;
+import java.awt.Image;
+import java.awt.image.BufferedImage;
+import java.util.List;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+@DisplayName("WaveformLayer")
+class WaveformLayerTest {
+
+    private static final int WIDTH = 500;
+    private static final int HEIGHT = 40;
+
+    private static BufferedImage tile(Color color) {
+        int width = WaveformTileSet.TILE_WIDTH_PX;
+        BufferedImage image = new BufferedImage(width, HEIGHT, BufferedImage.TYPE_INT_ARGB);
+        Graphics2D g = image.createGraphics();
+        g.setColor(color);
+        g.fillRect(0, 0, width / 2, HEIGHT);
+        g.dispose();
+        return image;
+    }
+
+    private static int[] paintWith(WaveformLayer layer, WaveformTileSet tiles) {
+        BufferedImage target = new BufferedImage(WIDTH, HEIGHT, BufferedImage.TYPE_INT_ARGB);
+        Graphics2D g = target.createGraphics();
+        try {
+            if (layer == null) {
+                tiles.paint(g, 0, 0);
+            } else {
+                layer.paint(g, 0, 0, tiles);
+            }
+        } finally {
+            g.dispose();
+        }
+        return target.getRGB(0, 0, WIDTH, HEIGHT, null, 0, WIDTH);
+    }
+
+    @Test
+    @DisplayName("should draw the same pixels as the tiles after scrolling in place")
+    void shouldMatchDirectPaintWhileScrolling() {
+        List<Image> strip =
+                List.of(tile(Color.RED), tile(Color.GREEN), tile(Color.BLUE), tile(Color.CYAN));
+        WaveformLayer layer = new WaveformLayer(new WaveformTileRing());
+
+        List<WaveformTileSet> frames =
+                List.of(
+                        new WaveformTileSet(WIDTH, HEIGHT, 100, 0, -10, strip.subList(0, 3)),
+                        new WaveformTileSet(WIDTH, HEIGHT, 100, 0, -45, strip.subList(0, 3)),
+                        new WaveformTileSet(WIDTH, HEIGHT, 100, 1, -5, strip.subList(1, 4)),
+                        new WaveformTileSet(WIDTH, HEIGHT, 100, 0, -120, strip.subList(0, 3)));
+        for (WaveformTileSet frame : frames) {
+            assertArrayEquals(paintWith(null, frame), paintWith(layer, frame));
+        }
+    }
+
+    @Test
+    @DisplayName("should redraw rather than scroll when the zoom changes")
+    void shouldRedrawOnZoomChange() {
+        List<Image> strip = List.of(tile(Color.RED), tile(Color.GREEN), tile(Color.BLUE));
+        WaveformLayer layer = new WaveformLayer(new WaveformTileRing());
+
+        paintWith(layer, new WaveformTileSet(WIDTH, HEIGHT, 100, 0, -10, strip));
+        List<Image> zoomed = List.of(tile(Color.ORANGE), tile(Color.MAGENTA), tile(Color.PINK));
+        WaveformTileSet next = new WaveformTileSet(WIDTH, HEIGHT, 200, 0, -10, zoomed);
+
+        assertArrayEquals(paintWith(null, next), paintWith(layer, next));
+    }
+}
@@ -0,0 +1,76 @@
+package ui.viewport;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import core.waveform.WaveformTileSet;
+import java.awt.Color;
+import java.awt.Graphics2D;
+import java.awt.Image;
+import java.awt.image.BufferedImage;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+@DisplayName("WaveformTileRing")
+class WaveformTileRingTest {
+
+    private static final int WIDTH = 500;
+    private static final int HEIGHT = 40;
+
+    private static BufferedImage tile(Color color) {
+        int width = WaveformTileSet.TILE_WIDTH_PX;
+        BufferedImage image = new BufferedImage(width, HEIGHT, BufferedImage.TYPE_INT_ARGB);
+        Graphics2D g = image.createGraphics();
+        g.setColor(color);
+        g.fillRect(0, 0, width / 2, HEIGHT);
+        g.dispose();
+        return image;
+    }
+
+    private static int[] paintWith(WaveformTileRing ring, WaveformTileSet tiles) {
+        BufferedImage target = new BufferedImage(WIDTH, HEIGHT, BufferedImage.TYPE_INT_ARGB);
+        Graphics2D g = target.createGraphics();
+        try {
+            if (ring == null) {
+                tiles.paint(g, 0, 0);
+            } else {
+                ring.paint(g, 0, 0, tiles);
+            }
+        } finally {
+            g.dispose();
+        }
+        return target.getRGB(0, 0, WIDTH, HEIGHT, null, 0, WIDTH);
+    }
+
+    @Test
+    @DisplayName("should draw the same pixels as the tiles themselves")
+    void shouldMatchDirectPaint() {
+        // A leading null tile lies before time 0
+        List<Image> images =
+                new ArrayList<>(Arrays.asList(null, tile(Color.RED), tile(Color.BLUE)));
+        WaveformTileSet tiles = new WaveformTileSet(WIDTH, HEIGHT, 100, -1, -70, images);
+
+        assertArrayEquals(paintWith(null, tiles), paintWith(new WaveformTileRing(), tiles));
+    }
+
+    @Test
+    @DisplayName("should upload only newly exposed tiles while scrolling")
+    void shouldUploadOnlyNewTiles() {
+        List<Image> strip =
+                List.of(tile(Color.RED), tile(Color.GREEN), tile(Color.BLUE), tile(Color.CYAN));
+        WaveformTileRing ring = new WaveformTileRing();
+
+        paintWith(ring, new WaveformTileSet(WIDTH, HEIGHT, 100, 0, -10, strip.subList(0, 3)));
+        assertEquals(3, ring.uploads());
+
+        // Same tiles, shifted: nothing new to upload
+        paintWith(ring, new WaveformTileSet(WIDTH, HEIGHT, 100, 0, -90, strip.subList(0, 3)));
+        assertEquals(3, ring.uploads());
+
+        // One tile scrolled in
+        paintWith(ring, new WaveformTileSet(WIDTH, HEIGHT, 100, 1, -10, strip.subList(1, 4)));
+        assertEquals(4, ring.uploads());
+    }
+}
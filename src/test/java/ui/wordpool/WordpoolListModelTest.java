@@ -0,0 +1,78 @@
+package ui.wordpool;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.util.ArrayList;
+import java.util.List;
+import org.junit.jupiter.api.BeforeEach;
+import org.junit.jupiter.api.DisplayName;
+import org.junit.jupiter.api.Test;
+
+@DisplayName("WordpoolListModel")
+class WordpoolListModelTest {
+
+    private WordpoolListModel model;
+
+    @BeforeEach
+    void setUp() {
+        model = new WordpoolListModel();
+        model.addElements(
+                words("CAT", "DOG", "CAR", "CARROT", "APPLE", "DOG", "BANANA", "CARD", "ZEBRA"));
+    }
+
+    private static List<WordpoolWord> words(String... texts) {
+        List<WordpoolWord> words = new ArrayList<>();
+        for (int i = 0; i < texts.length; i++) {
+            words.add(new WordpoolWord(texts[i], i));
+        }
+        return words;
+    }
+
+    private static List<String> shown(WordpoolListModel model) {
+        List<String> texts = new ArrayList<>();
+        for (int i = 0; i < model.getSize(); i++) {
+            texts.add(model.getElementAt(i).getText());
+        }
+        return texts;
+    }
+
+    @Test
+    @DisplayName("should keep one copy of each word, alphabetically")
+    void sortsAndDeduplicates() {
+        assertEquals(
+                List.of("APPLE", "BANANA", "CAR", "CARD", "CARROT", "CAT", "DOG", "ZEBRA"),
+                shown(model));
+        model.addElements(words("BEAR", "apple"));
+        assertEquals(
+                List.of("APPLE", "BANANA", "BEAR", "CAR", "CARD", "CARROT", "CAT", "DOG", "ZEBRA"),
+                shown(model));
+    }
+
+    @Test
+    @DisplayName("should show only the words starting with the typed prefix, lst words first")
+    void filtersByPrefixWithLstFirst() {
+        model.distinguishAsLst(words("CAT", "ZEBRA", "MISSING"));
+        assertEquals(
+                List.of("CAT", "ZEBRA", "APPLE", "BANANA", "CAR", "CARD", "CARROT", "DOG"),
+                shown(model));
+
+        model.hideWordsStartingWith("C");
+        assertEquals(List.of("CAT", "CAR", "CARD", "CARROT"), shown(model));
+        model.hideWordsStartingWith("car");
+        assertEquals(List.of("CAR", "CARD", "CARROT"), shown(model));
+        assertNotNull(model.findMatchingWordpoolWord("CARD"));
+        assertNull(model.findMatchingWordpoolWord("CAT"));
+        model.hideWordsStartingWith("CARX");
+        assertEquals(List.of(), shown(model));
+
+        model.restoreWordsStartingWith("CA");
+        assertEquals(List.of("CAT", "CAR", "CARD", "CARROT"), shown(model));
+        model.undistinguishAllWords();
+        assertEquals(List.of("CAR", "CARD", "CARROT", "CAT"), shown(model));
+        model.restoreWordsStartingWith("");
+        assertEquals(8, model.getSize());
+
+        model.removeAllWords();
+        assertEquals(0, model.getSize());
+    }
+}